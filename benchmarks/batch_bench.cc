@@ -0,0 +1,678 @@
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+#include "graphmath/expression.h"
+#include "graphmath/fast.h"
+#include "graphmath/float3_soa.h"
+#include "graphmath/frustum.h"
+#include "graphmath/half.h"
+#include "graphmath/packed_float3.h"
+#include "graphmath/quaternion.h"
+#include "graphmath/ray.h"
+#include "graphmath/ray_aabb.h"
+#include "graphmath/transform.h"
+#include "graphmath/transform_batch.h"
+#include "helpers.h"
+
+using namespace graphmath;
+using bench::sample_affine_float4x4;
+using bench::sample_float3;
+using bench::sample_float3s;
+using bench::sample_float4x4;
+using bench::sample_quaternion;
+
+// 1 Ki to 1 Mi vectors, from L1 resident to memory bound
+#define GRAPHMATH_BATCH_RANGE RangeMultiplier(32)->Range(1 << 10, 1 << 20)
+
+static void aos_normalize(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+
+  for (auto _ : state) {
+    for (float3 &value : values) {
+      value = normalize(value);
+    }
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(aos_normalize)->GRAPHMATH_BATCH_RANGE;
+
+static void soa_normalize(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  float3_soa soa{values.data(), values.size()};
+
+  for (auto _ : state) {
+    normalize(soa, soa);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(soa_normalize)->GRAPHMATH_BATCH_RANGE;
+
+static void soa_fast_normalize(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  float3_soa soa{values.data(), values.size()};
+
+  for (auto _ : state) {
+    fast::normalize(soa, soa);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(soa_fast_normalize)->GRAPHMATH_BATCH_RANGE;
+
+static void aos_dot(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  std::vector<float> result(values.size());
+  float3 other = sample_float3(7);
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < values.size(); i++) {
+      result[i] = dot(values[i], other);
+    }
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(aos_dot)->GRAPHMATH_BATCH_RANGE;
+
+static void soa_dot(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  float3_soa soa{values.data(), values.size()};
+  std::vector<float> result(values.size());
+
+  for (auto _ : state) {
+    dot(soa, soa, result.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(soa_dot)->GRAPHMATH_BATCH_RANGE;
+
+static void soa_cross(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  float3_soa soa{values.data(), values.size()};
+  float3_soa result;
+
+  for (auto _ : state) {
+    cross(soa, soa, result);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(soa_cross)->GRAPHMATH_BATCH_RANGE;
+
+static void soa_length(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  float3_soa soa{values.data(), values.size()};
+  std::vector<float> result(values.size());
+
+  for (auto _ : state) {
+    length(soa, result.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(soa_length)->GRAPHMATH_BATCH_RANGE;
+
+static void soa_fast_length(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  float3_soa soa{values.data(), values.size()};
+  std::vector<float> result(values.size());
+
+  for (auto _ : state) {
+    fast::length(soa, result.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(soa_fast_length)->GRAPHMATH_BATCH_RANGE;
+
+static void soa_clamp_sqrt(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  float3_soa soa{values.data(), values.size()};
+  float3_soa result;
+
+  for (auto _ : state) {
+    clamp(soa, float3{0.75f, 0.75f, 0.75f}, float3{1.5f, 1.5f, 1.5f}, result);
+    sqrt(result, result);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(soa_clamp_sqrt)->GRAPHMATH_BATCH_RANGE;
+
+static void soa_round_trip(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  float3_soa soa;
+
+  for (auto _ : state) {
+    soa.load(values.data(), values.size());
+    soa.store(values.data());
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(soa_round_trip)->GRAPHMATH_BATCH_RANGE;
+
+static void aos_transform_points(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  std::vector<float3> result(values.size());
+  float4x4 m = sample_float4x4(0);
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < values.size(); i++) {
+      float4 r = m * float4{values[i], 1};
+      result[i] = float3{r.x(), r.y(), r.z()};
+    }
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(aos_transform_points)->GRAPHMATH_BATCH_RANGE;
+
+static void batch_transform_points(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  std::vector<float3> result(values.size());
+  float4x4 m = sample_float4x4(0);
+
+  for (auto _ : state) {
+    transform_points(m, values, result);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(batch_transform_points)->GRAPHMATH_BATCH_RANGE;
+
+static void batch_transform_vectors(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  std::vector<float3> result(values.size());
+  float4x4 m = sample_float4x4(0);
+
+  for (auto _ : state) {
+    transform_vectors(m, values, result);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(batch_transform_vectors)->GRAPHMATH_BATCH_RANGE;
+
+static void batch_transform_and_project(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  std::vector<float3> result(values.size());
+  float4x4 m = sample_float4x4(0);
+
+  for (auto _ : state) {
+    transform_and_project(m, values, result);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(batch_transform_and_project)->GRAPHMATH_BATCH_RANGE;
+
+static std::vector<float4x4> sample_float4x4s(size_t count, bool affine) {
+  std::vector<float4x4> values;
+  values.reserve(count);
+
+  for (size_t i = 0; i < count; i++) {
+    unsigned seed = static_cast<unsigned>(i);
+
+    values.push_back(affine ? sample_affine_float4x4(seed)
+                            : sample_float4x4(seed));
+  }
+
+  return values;
+}
+
+static void batch_inverse(benchmark::State &state) {
+  std::vector<float4x4> values = sample_float4x4s(state.range(0), false);
+  std::vector<float4x4> result(values.size(), float4x4{0.0f});
+
+  for (auto _ : state) {
+    inverse(values, result);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(batch_inverse)->GRAPHMATH_BATCH_RANGE;
+
+static void batch_inverse_affine(benchmark::State &state) {
+  std::vector<float4x4> values = sample_float4x4s(state.range(0), true);
+  std::vector<float4x4> result(values.size(), float4x4{0.0f});
+
+  for (auto _ : state) {
+    inverse_affine(values, result);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(batch_inverse_affine)->GRAPHMATH_BATCH_RANGE;
+
+static void packed_unpack(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  std::vector<packed_float3> packed(values.size());
+  std::vector<float3> result(values.size());
+
+  pack(values, packed);
+
+  for (auto _ : state) {
+    unpack(packed, result);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(packed_unpack)->GRAPHMATH_BATCH_RANGE;
+
+static void packed_pack(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  std::vector<packed_float3> packed(values.size());
+
+  for (auto _ : state) {
+    pack(values, packed);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(packed_pack)->GRAPHMATH_BATCH_RANGE;
+
+static std::vector<float4> sample_float4s(size_t count) {
+  std::vector<float3> values = sample_float3s(count);
+  std::vector<float4> result;
+  result.reserve(count);
+
+  for (const float3 &value : values) {
+    result.push_back(float4{value, 1.0f});
+  }
+
+  return result;
+}
+
+static void aos_to_half4(benchmark::State &state) {
+  std::vector<float4> values = sample_float4s(state.range(0));
+  std::vector<half4> halves(values.size());
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < values.size(); i++) {
+      halves[i] = half4{values[i]};
+    }
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(aos_to_half4)->GRAPHMATH_BATCH_RANGE;
+
+static void batch_to_half4(benchmark::State &state) {
+  std::vector<float4> values = sample_float4s(state.range(0));
+  std::vector<half4> halves(values.size());
+
+  for (auto _ : state) {
+    to_half(values, halves);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(batch_to_half4)->GRAPHMATH_BATCH_RANGE;
+
+static void batch_to_float4(benchmark::State &state) {
+  std::vector<float4> values = sample_float4s(state.range(0));
+  std::vector<half4> halves(values.size());
+
+  to_half(values, halves);
+
+  for (auto _ : state) {
+    to_float(halves, values);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(batch_to_float4)->GRAPHMATH_BATCH_RANGE;
+
+static void batch_to_half3(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  std::vector<half3> halves(values.size());
+
+  for (auto _ : state) {
+    to_half(values, halves);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(batch_to_half3)->GRAPHMATH_BATCH_RANGE;
+
+static void batch_to_float3(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  std::vector<half3> halves(values.size());
+
+  to_half(values, halves);
+
+  for (auto _ : state) {
+    to_float(halves, values);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(batch_to_float3)->GRAPHMATH_BATCH_RANGE;
+
+static void aos_chain(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  std::vector<float3> velocities = sample_float3s(state.range(0));
+  float3 offset = sample_float3(7);
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < values.size(); i++) {
+      values[i] = values[i] + velocities[i] * 0.25f - offset;
+    }
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(aos_chain)->GRAPHMATH_BATCH_RANGE;
+
+static void expression_aos_chain(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  std::vector<float3> velocities = sample_float3s(state.range(0));
+  float3 offset = sample_float3(7);
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < values.size(); i++) {
+      values[i] =
+          expr::evaluate(expr::lazy(velocities[i]) * 0.25f + values[i] -
+                         offset);
+    }
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(expression_aos_chain)->GRAPHMATH_BATCH_RANGE;
+
+static void expression_soa_chain(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  float3_soa soa{values.data(), values.size()};
+  float3_soa velocities{values.data(), values.size()};
+  float3 offset = sample_float3(7);
+
+  for (auto _ : state) {
+    expr::evaluate(expr::lazy(velocities) * 0.25f + soa - offset, soa);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(expression_soa_chain)->GRAPHMATH_BATCH_RANGE;
+
+static std::vector<quaternion> sample_quaternions(size_t count, unsigned seed) {
+  std::vector<quaternion> values;
+  values.reserve(count);
+
+  for (size_t i = 0; i < count; i++) {
+    values.push_back(sample_quaternion(seed + static_cast<unsigned>(i)));
+  }
+
+  return values;
+}
+
+static void aos_slerp(benchmark::State &state) {
+  std::vector<quaternion> a = sample_quaternions(state.range(0), 0);
+  std::vector<quaternion> b = sample_quaternions(state.range(0), 7);
+  std::vector<quaternion> result(a.size());
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < a.size(); i++) {
+      result[i] = slerp(a[i], b[i], 0.3f);
+    }
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(aos_slerp)->GRAPHMATH_BATCH_RANGE;
+
+static void batch_slerp(benchmark::State &state) {
+  std::vector<quaternion> a = sample_quaternions(state.range(0), 0);
+  std::vector<quaternion> b = sample_quaternions(state.range(0), 7);
+  std::vector<quaternion> result(a.size());
+
+  for (auto _ : state) {
+    slerp(a, b, 0.3f, result);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(batch_slerp)->GRAPHMATH_BATCH_RANGE;
+
+static void batch_nlerp(benchmark::State &state) {
+  std::vector<quaternion> a = sample_quaternions(state.range(0), 0);
+  std::vector<quaternion> b = sample_quaternions(state.range(0), 7);
+  std::vector<quaternion> result(a.size());
+
+  for (auto _ : state) {
+    nlerp(a, b, 0.3f, result);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(batch_nlerp)->GRAPHMATH_BATCH_RANGE;
+
+static frustum sample_frustum() {
+  return frustum{perspective(1.0f, 1.5f, 0.1f, 100.0f) *
+                 look_at(float3{0, 0, 0}, float3{1, 1, 1}, float3{0, 1, 0})};
+}
+
+static std::vector<aabb> sample_aabbs(size_t count) {
+  std::vector<float3> centers = sample_float3s(count);
+  std::vector<aabb> boxes;
+  boxes.reserve(count);
+
+  // centers in `[0.5, 2)` spread out to roughly half visible
+  for (size_t i = 0; i < count; i++) {
+    float3 c = centers[i] * 20.0f - float3{25.0f, 25.0f, 25.0f};
+    float3 e = sample_float3(static_cast<unsigned>(i) + 3) * 0.5f;
+    boxes.push_back(aabb{c - e, c + e});
+  }
+
+  return boxes;
+}
+
+static void aos_cull(benchmark::State &state) {
+  frustum f = sample_frustum();
+  std::vector<aabb> boxes = sample_aabbs(state.range(0));
+  std::vector<std::uint8_t> visible((boxes.size() + 7) / 8);
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < boxes.size(); i += 8) {
+      unsigned bits = 0;
+
+      for (size_t k = 0; k < 8 && i + k < boxes.size(); k++) {
+        bits |= static_cast<unsigned>(intersects(f, boxes[i + k])) << k;
+      }
+
+      visible[i / 8] = static_cast<std::uint8_t>(bits);
+    }
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(aos_cull)->GRAPHMATH_BATCH_RANGE;
+
+static void batch_cull(benchmark::State &state) {
+  frustum f = sample_frustum();
+  std::vector<aabb> boxes = sample_aabbs(state.range(0));
+  std::vector<std::uint8_t> visible((boxes.size() + 7) / 8);
+
+  for (auto _ : state) {
+    cull(f, boxes, visible);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(batch_cull)->GRAPHMATH_BATCH_RANGE;
+
+static void batch_cull_spheres(benchmark::State &state) {
+  frustum f = sample_frustum();
+  std::vector<aabb> boxes = sample_aabbs(state.range(0));
+  std::vector<bounding_sphere> spheres(boxes.begin(), boxes.end());
+  std::vector<std::uint8_t> visible((spheres.size() + 7) / 8);
+
+  for (auto _ : state) {
+    cull(f, spheres, visible);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(batch_cull_spheres)->GRAPHMATH_BATCH_RANGE;
+
+static std::vector<float3> sample_triangles(size_t count) {
+  // vertices in `[0.5, 2)` spread out, 3 per triangle
+  std::vector<float3> vertices = sample_float3s(3 * count);
+
+  for (float3 &vertex : vertices) {
+    vertex = vertex * 4.0f - float3{5.0f, 5.0f, 5.0f};
+  }
+
+  return vertices;
+}
+
+static std::vector<ray> sample_rays(size_t count) {
+  std::vector<float3> targets = sample_float3s(count);
+  std::vector<ray> rays;
+  rays.reserve(count);
+
+  for (const float3 &target : targets) {
+    rays.push_back(ray{float3{0.0f, 0.0f, 10.0f},
+                       target - float3{1.25f, 1.25f, 11.25f}});
+  }
+
+  return rays;
+}
+
+static void aos_ray_triangles(benchmark::State &state) {
+  std::vector<float3> vertices = sample_triangles(state.range(0));
+  std::vector<ray> rays = sample_rays(64);
+  size_t next = 0;
+
+  for (auto _ : state) {
+    const ray &r = rays[next++ % rays.size()];
+    triangle_hit hit;
+    size_t closest = no_hit;
+
+    for (size_t i = 0; i < vertices.size(); i += 3) {
+      if (intersect(r, vertices[i], vertices[i + 1], vertices[i + 2], hit)) {
+        closest = i / 3;
+      }
+    }
+
+    benchmark::DoNotOptimize(closest);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(aos_ray_triangles)->RangeMultiplier(32)->Range(1 << 10, 1 << 15);
+
+static void packet_ray_triangles(benchmark::State &state) {
+  std::vector<float3> vertices = sample_triangles(state.range(0));
+  std::vector<triangle_packet> packets(state.range(0) / packet_lanes);
+  std::vector<ray> rays = sample_rays(64);
+  size_t next = 0;
+
+  for (size_t i = 0; i < vertices.size(); i += 3) {
+    size_t triangle = i / 3;
+    packets[triangle / packet_lanes].set(triangle % packet_lanes, vertices[i],
+                                         vertices[i + 1], vertices[i + 2]);
+  }
+
+  for (auto _ : state) {
+    triangle_hit hit;
+    const ray &r = rays[next++ % rays.size()];
+    benchmark::DoNotOptimize(intersect(r, packets, hit));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(packet_ray_triangles)->RangeMultiplier(32)->Range(1 << 10, 1 << 15);
+
+static void aos_ray_aabb(benchmark::State &state) {
+  std::vector<aabb> boxes = sample_aabbs(state.range(0));
+  std::vector<ray> rays = sample_rays(64);
+  size_t next = 0;
+
+  for (auto _ : state) {
+    inverse_ray r{rays[next++ % rays.size()]};
+    size_t hit_count = 0;
+
+    for (const aabb &box : boxes) {
+      float t_near;
+      hit_count += ray_aabb_intersect(r, box, 100.0f, t_near);
+    }
+
+    benchmark::DoNotOptimize(hit_count);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(aos_ray_aabb)->RangeMultiplier(32)->Range(1 << 10, 1 << 15);
+
+static void packet_ray_aabb(benchmark::State &state) {
+  std::vector<aabb> boxes = sample_aabbs(state.range(0));
+  std::vector<aabb_packet<8>> packets(boxes.size() / 8);
+  std::vector<ray> rays = sample_rays(64);
+  size_t next = 0;
+
+  for (size_t i = 0; i < boxes.size(); i++) {
+    packets[i / 8].set(i % 8, boxes[i]);
+  }
+
+  for (auto _ : state) {
+    inverse_ray r{rays[next++ % rays.size()]};
+    size_t hit_count = 0;
+
+    for (const aabb_packet<8> &packet : packets) {
+      float t_near[8];
+      hit_count +=
+          std::bitset<8>{ray_aabb_intersect(r, packet, 100.0f, t_near)}.count();
+    }
+
+    benchmark::DoNotOptimize(hit_count);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(packet_ray_aabb)->RangeMultiplier(32)->Range(1 << 10, 1 << 15);
@@ -0,0 +1,71 @@
+#include "graphmath/binary.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "helpers.h"
+
+using namespace graphmath;
+using bench::sample_float3s;
+
+/// @brief a file with one chunk of `count` `packed_float3`
+static std::string sample_file(size_t count) {
+  std::string path = "graphmath_bench_" + std::to_string(count) + ".bin";
+  std::vector<float3> points = sample_float3s(count);
+
+  binary_writer writer{path.c_str()};
+  writer.add("points", span<const float3>{points});
+  writer.close();
+
+  return path;
+}
+
+static void binary_write(benchmark::State &state) {
+  std::vector<float3> points = sample_float3s(state.range(0));
+
+  for (auto _ : state) {
+    binary_writer writer{"graphmath_bench_write.bin"};
+    writer.add("points", span<const float3>{points});
+    writer.close();
+  }
+
+  std::remove("graphmath_bench_write.bin");
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(binary_write)->Arg(1 << 20);
+
+static void binary_open(benchmark::State &state) {
+  std::string path = sample_file(state.range(0));
+
+  for (auto _ : state) {
+    binary_reader reader{path.c_str()};
+    span<const packed_float3> points = reader.packed_float3s(0);
+
+    benchmark::DoNotOptimize(points.data());
+  }
+
+  std::remove(path.c_str());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(binary_open)->Arg(1 << 20);
+
+static void fread_copy(benchmark::State &state) {
+  std::string path = sample_file(state.range(0));
+  std::vector<packed_float3> points(state.range(0));
+
+  for (auto _ : state) {
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    std::fseek(file, binary_alignment, SEEK_SET);
+    size_t read =
+        std::fread(points.data(), sizeof(packed_float3), points.size(), file);
+    std::fclose(file);
+
+    benchmark::DoNotOptimize(read);
+    benchmark::ClobberMemory();
+  }
+
+  std::remove(path.c_str());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(fread_copy)->Arg(1 << 20);
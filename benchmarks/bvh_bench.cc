@@ -0,0 +1,116 @@
+#include "graphmath/bvh.h"
+
+#include <vector>
+
+#include "helpers.h"
+
+using namespace graphmath;
+using bench::sample_float3;
+using bench::sample_float3s;
+
+/// @brief `count` small triangles scattered in a cube of side 100
+static std::vector<float3> sample_triangles(size_t count) {
+  std::vector<float3> centers = sample_float3s(count);
+  std::vector<float3> vertices;
+  vertices.reserve(3 * count);
+
+  for (size_t i = 0; i < count; i++) {
+    float3 center = centers[i] * 66.0f;
+
+    vertices.push_back(center);
+    vertices.push_back(center + sample_float3(static_cast<unsigned>(i % 64)));
+    vertices.push_back(center + float3{0.0f, 0.0f, 1.0f});
+  }
+
+  return vertices;
+}
+
+/// @brief rays from outside the cube through it
+static std::vector<ray> sample_rays(size_t count) {
+  std::vector<float3> targets = sample_float3s(count);
+  std::vector<ray> rays;
+  rays.reserve(count);
+
+  for (const float3 &target : targets) {
+    float3 origin{-10.0f, 60.0f, 200.0f};
+    rays.push_back(ray{origin, target * 66.0f - origin});
+  }
+
+  return rays;
+}
+
+/// @brief Build over `state.range(0)` triangles on `state.range(1)` threads
+static void bvh_build(benchmark::State &state) {
+  std::vector<float3> vertices = sample_triangles(state.range(0));
+  size_t thread_count = static_cast<size_t>(state.range(1));
+
+  for (auto _ : state) {
+    bvh tree;
+    tree.build(vertices, thread_count);
+    benchmark::DoNotOptimize(tree.nodes().data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(bvh_build)
+    ->ArgsProduct({{1 << 16, 1 << 20}, {1, 4}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static void linear_closest_hit(benchmark::State &state) {
+  std::vector<float3> vertices = sample_triangles(state.range(0));
+  std::vector<ray> rays = sample_rays(256);
+  size_t next = 0;
+
+  for (auto _ : state) {
+    const ray &r = rays[next++ % rays.size()];
+    triangle_hit hit;
+    size_t closest = no_hit;
+
+    for (size_t i = 0; i < vertices.size(); i += 3) {
+      if (intersect(r, vertices[i], vertices[i + 1], vertices[i + 2], hit)) {
+        closest = i / 3;
+      }
+    }
+
+    benchmark::DoNotOptimize(closest);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(linear_closest_hit)->Arg(1 << 16);
+
+static void bvh_closest_hit(benchmark::State &state) {
+  std::vector<float3> vertices = sample_triangles(state.range(0));
+  std::vector<ray> rays = sample_rays(256);
+  size_t next = 0;
+
+  bvh tree;
+  tree.build(vertices, 1);
+
+  for (auto _ : state) {
+    triangle_hit hit;
+    const ray &r = rays[next++ % rays.size()];
+    benchmark::DoNotOptimize(tree.closest_hit(r, vertices, hit));
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(bvh_closest_hit)->Arg(1 << 16)->Arg(1 << 20);
+
+static void bvh_any_hit(benchmark::State &state) {
+  std::vector<float3> vertices = sample_triangles(state.range(0));
+  std::vector<ray> rays = sample_rays(256);
+  size_t next = 0;
+
+  bvh tree;
+  tree.build(vertices, 1);
+
+  for (auto _ : state) {
+    const ray &r = rays[next++ % rays.size()];
+    benchmark::DoNotOptimize(tree.any_hit(r, vertices));
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(bvh_any_hit)->Arg(1 << 16)->Arg(1 << 20);
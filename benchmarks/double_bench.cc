@@ -0,0 +1,60 @@
+#include "graphmath/double3.h"
+#include "graphmath/double4.h"
+#include "graphmath/double4x4.h"
+
+#include "helpers.h"
+
+using namespace graphmath;
+using bench::binary;
+using bench::sample_float3;
+using bench::sample_float4;
+using bench::sample_float4x4;
+
+// the samples are the `float` samples widened, so that the numbers match
+// the `float` benchmarks they are compared with
+
+static double3 sample_double3(unsigned seed) {
+  return double3{sample_float3(seed)};
+}
+
+static double4 sample_double4(unsigned seed) {
+  return double4{sample_float4(seed)};
+}
+
+static double4x4 sample_double4x4(unsigned seed) {
+  return double4x4{sample_float4x4(seed)};
+}
+
+BENCHMARK_CAPTURE(binary, double3_add, sample_double3(0), sample_double3(3),
+                  [](const double3 &a, const double3 &b) { return a + b; });
+BENCHMARK_CAPTURE(binary, double3_cross, sample_double3(0),
+                  sample_double3(3), [](const double3 &a, const double3 &b) {
+                    return cross(a, b);
+                  });
+BENCHMARK_CAPTURE(binary, double3_dot, sample_double3(0), sample_double3(3),
+                  [](const double3 &a, const double3 &b) {
+                    return dot(a, b);
+                  });
+BENCHMARK_CAPTURE(binary, double3_relative, sample_double3(0),
+                  sample_double3(3), [](const double3 &a, const double3 &b) {
+                    return relative(a, b);
+                  });
+
+BENCHMARK_CAPTURE(binary, double4_dot, sample_double4(0), sample_double4(4),
+                  [](const double4 &a, const double4 &b) {
+                    return dot(a, b);
+                  });
+
+BENCHMARK_CAPTURE(binary, double4x4_multiply_double4, sample_double4x4(0),
+                  sample_double4(16),
+                  [](const double4x4 &m, const double4 &v) { return m * v; });
+BENCHMARK_CAPTURE(binary, double4x4_multiply, sample_double4x4(0),
+                  sample_double4x4(16),
+                  [](const double4x4 &a, const double4x4 &b) {
+                    return a * b;
+                  });
+BENCHMARK_CAPTURE(binary, double4x4_relative, sample_double4x4(0),
+                  sample_double3(16),
+                  [](const double4x4 &m, const double3 &origin) {
+                    return relative(m, origin);
+                  });
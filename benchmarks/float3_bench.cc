@@ -0,0 +1,65 @@
+#include "graphmath/fast.h"
+#include "graphmath/float3.h"
+
+#include "helpers.h"
+
+using namespace graphmath;
+using bench::binary;
+using bench::sample_float;
+using bench::sample_float3;
+using bench::ternary;
+using bench::unary;
+
+BENCHMARK_CAPTURE(binary, float3_construct, sample_float(0), sample_float(1),
+                  [](float x, float y) { return float3{x, y, x}; });
+
+BENCHMARK_CAPTURE(unary, float3_x, sample_float3(0),
+                  [](const float3 &a) { return a.x(); });
+BENCHMARK_CAPTURE(unary, float3_y, sample_float3(0),
+                  [](const float3 &a) { return a.y(); });
+BENCHMARK_CAPTURE(unary, float3_z, sample_float3(0),
+                  [](const float3 &a) { return a.z(); });
+
+BENCHMARK_CAPTURE(binary, float3_add, sample_float3(0), sample_float3(3),
+                  [](const float3 &a, const float3 &b) { return a + b; });
+BENCHMARK_CAPTURE(binary, float3_subtract_float, sample_float3(0),
+                  sample_float(3),
+                  [](const float3 &a, float b) { return a - b; });
+BENCHMARK_CAPTURE(binary, float3_subtract, sample_float3(0), sample_float3(3),
+                  [](const float3 &a, const float3 &b) { return a - b; });
+BENCHMARK_CAPTURE(binary, float3_multiply_float, sample_float3(0),
+                  sample_float(3),
+                  [](const float3 &a, float b) { return a * b; });
+BENCHMARK_CAPTURE(binary, float3_multiply, sample_float3(0), sample_float3(3),
+                  [](const float3 &a, const float3 &b) { return a * b; });
+BENCHMARK_CAPTURE(binary, float3_divide_float, sample_float3(0),
+                  sample_float(3),
+                  [](const float3 &a, float b) { return a / b; });
+BENCHMARK_CAPTURE(binary, float3_equal, sample_float3(0), sample_float3(3),
+                  [](const float3 &a, const float3 &b) { return a == b; });
+BENCHMARK_CAPTURE(binary, float3_not_equal, sample_float3(0), sample_float3(3),
+                  [](const float3 &a, const float3 &b) { return a != b; });
+
+BENCHMARK_CAPTURE(unary, float3_sqrt, sample_float3(0),
+                  [](const float3 &a) { return sqrt(a); });
+BENCHMARK_CAPTURE(unary, float3_normalize, sample_float3(0),
+                  [](const float3 &a) { return normalize(a); });
+BENCHMARK_CAPTURE(unary, float3_length, sample_float3(0),
+                  [](const float3 &a) { return length(a); });
+BENCHMARK_CAPTURE(unary, float3_fast_normalize, sample_float3(0),
+                  [](const float3 &a) { return fast::normalize(a); });
+BENCHMARK_CAPTURE(unary, float3_fast_length, sample_float3(0),
+                  [](const float3 &a) { return fast::length(a); });
+BENCHMARK_CAPTURE(unary, float_fast_rsqrt, sample_float(0),
+                  [](float a) { return fast::rsqrt(a); });
+BENCHMARK_CAPTURE(unary, float_fast_rcp, sample_float(0),
+                  [](float a) { return fast::rcp(a); });
+BENCHMARK_CAPTURE(binary, float3_cross, sample_float3(0), sample_float3(3),
+                  [](const float3 &a, const float3 &b) { return cross(a, b); });
+BENCHMARK_CAPTURE(binary, float3_dot, sample_float3(0), sample_float3(3),
+                  [](const float3 &a, const float3 &b) { return dot(a, b); });
+BENCHMARK_CAPTURE(ternary, float3_clamp, sample_float3(0), sample_float3(3),
+                  sample_float3(6),
+                  [](const float3 &a, const float3 &low, const float3 &high) {
+                    return clamp(a, low, high);
+                  });
@@ -0,0 +1,41 @@
+#include "graphmath/fast.h"
+#include "graphmath/float4.h"
+
+#include "helpers.h"
+
+using namespace graphmath;
+using bench::binary;
+using bench::sample_float;
+using bench::sample_float3;
+using bench::sample_float4;
+using bench::unary;
+
+BENCHMARK_CAPTURE(binary, float4_construct_from_float3, sample_float3(0),
+                  sample_float(3),
+                  [](const float3 &a, float w) { return float4{a, w}; });
+
+BENCHMARK_CAPTURE(unary, float4_w, sample_float4(0),
+                  [](const float4 &a) { return a.w(); });
+
+BENCHMARK_CAPTURE(binary, float4_add, sample_float4(0), sample_float4(4),
+                  [](const float4 &a, const float4 &b) { return a + b; });
+BENCHMARK_CAPTURE(binary, float4_subtract, sample_float4(0), sample_float4(4),
+                  [](const float4 &a, const float4 &b) { return a - b; });
+BENCHMARK_CAPTURE(binary, float4_multiply_float, sample_float4(0),
+                  sample_float(4),
+                  [](const float4 &a, float b) { return a * b; });
+BENCHMARK_CAPTURE(binary, float4_multiply, sample_float4(0), sample_float4(4),
+                  [](const float4 &a, const float4 &b) { return a * b; });
+BENCHMARK_CAPTURE(binary, float4_equal, sample_float4(0), sample_float4(4),
+                  [](const float4 &a, const float4 &b) { return a == b; });
+
+BENCHMARK_CAPTURE(binary, float4_dot, sample_float4(0), sample_float4(4),
+                  [](const float4 &a, const float4 &b) { return dot(a, b); });
+BENCHMARK_CAPTURE(unary, float4_normalize, sample_float4(0),
+                  [](const float4 &a) { return normalize(a); });
+BENCHMARK_CAPTURE(unary, float4_length, sample_float4(0),
+                  [](const float4 &a) { return length(a); });
+BENCHMARK_CAPTURE(unary, float4_fast_normalize, sample_float4(0),
+                  [](const float4 &a) { return fast::normalize(a); });
+BENCHMARK_CAPTURE(unary, float4_fast_length, sample_float4(0),
+                  [](const float4 &a) { return fast::length(a); });
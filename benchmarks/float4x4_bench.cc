@@ -0,0 +1,77 @@
+#include "graphmath/float4x4.h"
+
+#include "helpers.h"
+
+using namespace graphmath;
+using bench::binary;
+using bench::sample_affine_float4x4;
+using bench::sample_float;
+using bench::sample_float4;
+using bench::sample_float4x4;
+using bench::unary;
+
+BENCHMARK_CAPTURE(unary, float4x4_construct_diagonal, sample_float(0),
+                  [](float value) { return float4x4{value}; });
+BENCHMARK_CAPTURE(binary, float4x4_construct_rows, sample_float4(0),
+                  sample_float4(4), [](const float4 &a, const float4 &b) {
+                    return float4x4{a, b, a, b};
+                  });
+
+BENCHMARK_CAPTURE(unary, float4x4_get, sample_float4x4(0),
+                  [](const float4x4 &m) { return m.get(2, 1); });
+
+static void float4x4_set(benchmark::State &state) {
+  float4x4 m = sample_float4x4(0);
+  float value = sample_float(16);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(value);
+    m.set(2, 1, value);
+    benchmark::DoNotOptimize(m);
+  }
+}
+BENCHMARK(float4x4_set);
+
+BENCHMARK_CAPTURE(unary, float4x4_row, sample_float4x4(0),
+                  [](const float4x4 &m) { return m.row(2); });
+BENCHMARK_CAPTURE(unary, float4x4_column, sample_float4x4(0),
+                  [](const float4x4 &m) { return m.column(2); });
+
+static void float4x4_set_row(benchmark::State &state) {
+  float4x4 m = sample_float4x4(0);
+  float4 value = sample_float4(16);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(value);
+    m.set_row(2, value);
+    benchmark::DoNotOptimize(m);
+  }
+}
+BENCHMARK(float4x4_set_row);
+
+static void float4x4_set_column(benchmark::State &state) {
+  float4x4 m = sample_float4x4(0);
+  float4 value = sample_float4(16);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(value);
+    m.set_column(2, value);
+    benchmark::DoNotOptimize(m);
+  }
+}
+BENCHMARK(float4x4_set_column);
+
+BENCHMARK_CAPTURE(binary, float4x4_multiply_float4, sample_float4x4(0),
+                  sample_float4(16),
+                  [](const float4x4 &m, const float4 &v) { return m * v; });
+BENCHMARK_CAPTURE(binary, float4x4_multiply, sample_float4x4(0),
+                  sample_float4x4(16),
+                  [](const float4x4 &a, const float4x4 &b) { return a * b; });
+BENCHMARK_CAPTURE(unary, float4x4_transpose, sample_float4x4(0),
+                  [](const float4x4 &m) { return transpose(m); });
+BENCHMARK_CAPTURE(unary, float4x4_determinant, sample_float4x4(0),
+                  [](const float4x4 &m) { return determinant(m); });
+BENCHMARK_CAPTURE(unary, float4x4_inverse, sample_float4x4(0),
+                  [](const float4x4 &m) { return inverse(m); });
+BENCHMARK_CAPTURE(unary, float4x4_inverse_affine, sample_affine_float4x4(0),
+                  [](const float4x4 &m) { return inverse_affine(m); });
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "graphmath/graphmath.h"
+
+namespace bench {
+/// @brief Get a deterministic pseudo random float in `[0.5, 2)`
+/// @param seed the seed
+/// @returns the float
+inline float sample_float(unsigned seed) {
+  std::mt19937 engine{seed};
+  return std::uniform_real_distribution<float>{0.5f, 2.0f}(engine);
+}
+
+inline graphmath::float3 sample_float3(unsigned seed) {
+  return graphmath::float3{sample_float(seed), sample_float(seed + 1),
+                           sample_float(seed + 2)};
+}
+
+inline graphmath::float4 sample_float4(unsigned seed) {
+  return graphmath::float4{sample_float(seed), sample_float(seed + 1),
+                           sample_float(seed + 2), sample_float(seed + 3)};
+}
+
+inline graphmath::float4x4 sample_float4x4(unsigned seed) {
+  return graphmath::float4x4{sample_float4(seed), sample_float4(seed + 4),
+                             sample_float4(seed + 8),
+                             sample_float4(seed + 12)};
+}
+
+inline graphmath::float4x4 sample_affine_float4x4(unsigned seed) {
+  return graphmath::float4x4{sample_float4(seed), sample_float4(seed + 4),
+                             sample_float4(seed + 8),
+                             graphmath::float4{0.0f, 0.0f, 0.0f, 1.0f}};
+}
+
+inline graphmath::quaternion sample_quaternion(unsigned seed) {
+  return graphmath::normalize(graphmath::quaternion{sample_float4(seed)});
+}
+
+inline std::vector<graphmath::float3> sample_float3s(size_t count) {
+  std::vector<graphmath::float3> values;
+  values.reserve(count);
+
+  for (size_t i = 0; i < count; i++) {
+    values.push_back(sample_float3(static_cast<unsigned>(i)));
+  }
+
+  return values;
+}
+
+/// @brief Measure `op(a)`
+/// `a` is laundered through `DoNotOptimize` on every iteration, so the
+/// compiler can neither hoist nor constant fold the operation
+template <typename A, typename Op>
+void unary(benchmark::State &state, A a, Op op) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    auto result = op(a);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+/// @brief Measure `op(a, b)`
+template <typename A, typename B, typename Op>
+void binary(benchmark::State &state, A a, B b, Op op) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(b);
+    auto result = op(a, b);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+/// @brief Measure `op(a, b, c)`
+template <typename A, typename B, typename C, typename Op>
+void ternary(benchmark::State &state, A a, B b, C c, Op op) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a);
+    benchmark::DoNotOptimize(b);
+    benchmark::DoNotOptimize(c);
+    auto result = op(a, b, c);
+    benchmark::DoNotOptimize(result);
+  }
+}
+}  // namespace bench
@@ -0,0 +1,20 @@
+#include "benchmark/benchmark.h"
+#include "graphmath/backend.h"
+
+int main(int argc, char **argv) {
+  // recorded in the JSON output, so that results of different backends can
+  // be told apart
+  benchmark::AddCustomContext("graphmath_backend",
+                              graphmath::current_backend_traits::name);
+
+  benchmark::Initialize(&argc, argv);
+
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  return 0;
+}
@@ -0,0 +1,83 @@
+#include "graphmath/parse.h"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "graphmath/print.h"
+#include "helpers.h"
+
+using namespace graphmath;
+using bench::sample_float3s;
+
+/// @brief `count` OBJ vertex lines
+static std::string sample_obj(size_t count) {
+  std::vector<float3> values = sample_float3s(count);
+  std::string text;
+
+  for (const float3 &value : values) {
+    char line[print::max_float3_chars];
+    char *last = format_to(line, value);
+
+    // `[x, y, z]` to `v x y z`
+    text += "v ";
+    text.append(line + 1, last - 1);
+    text += '\n';
+  }
+
+  return text;
+}
+
+static void strtof_lines(benchmark::State &state) {
+  std::string text = sample_obj(state.range(0));
+  std::vector<float3> values;
+
+  for (auto _ : state) {
+    values.clear();
+
+    for (const char *p = text.c_str(); *p != '\0';) {
+      char *end = nullptr;
+      float x = std::strtof(p + 2, &end);
+      float y = std::strtof(end + 1, &end);
+      float z = std::strtof(end + 1, &end);
+
+      values.push_back(float3{x, y, z});
+      p = end + 1;
+    }
+
+    benchmark::DoNotOptimize(values.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(strtof_lines)->Arg(1 << 16);
+
+static void parse_obj_lines(benchmark::State &state) {
+  std::string text = sample_obj(state.range(0));
+  std::vector<float3> values;
+
+  for (auto _ : state) {
+    values.clear();
+    parse_lines(text.data(), text.data() + text.size(), values, "v");
+
+    benchmark::DoNotOptimize(values.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(parse_obj_lines)->Arg(1 << 16);
+
+static void parse_obj_lines_soa(benchmark::State &state) {
+  std::string text = sample_obj(state.range(0));
+  float3_soa values;
+
+  for (auto _ : state) {
+    values.resize(0);
+    parse_lines(text.data(), text.data() + text.size(), values, "v");
+
+    benchmark::DoNotOptimize(values.x());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(parse_obj_lines_soa)->Arg(1 << 16);
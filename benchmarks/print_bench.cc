@@ -0,0 +1,57 @@
+#include "graphmath/print.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "helpers.h"
+
+using namespace graphmath;
+using bench::sample_float3s;
+
+static void ostream_float3s(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+
+  for (auto _ : state) {
+    std::ostringstream out;
+
+    for (const float3 &value : values) {
+      out << value << '\n';
+    }
+
+    benchmark::DoNotOptimize(out.str().data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(ostream_float3s)->Arg(1 << 16);
+
+static void write_text_float3s(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+  std::string text;
+
+  for (auto _ : state) {
+    text.clear();
+    write_text(values,
+               [&](const char *data, size_t size) { text.append(data, size); });
+
+    benchmark::DoNotOptimize(text.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(write_text_float3s)->Arg(1 << 16);
+
+static void write_text_ostream_float3s(benchmark::State &state) {
+  std::vector<float3> values = sample_float3s(state.range(0));
+
+  for (auto _ : state) {
+    std::ostringstream out;
+    write_text(values, out);
+
+    benchmark::DoNotOptimize(out.str().data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(write_text_ostream_float3s)->Arg(1 << 16);
@@ -0,0 +1,36 @@
+#include "graphmath/quaternion.h"
+
+#include "helpers.h"
+
+using namespace graphmath;
+using bench::binary;
+using bench::sample_float3;
+using bench::sample_float4x4;
+using bench::sample_quaternion;
+using bench::unary;
+
+BENCHMARK_CAPTURE(binary, quaternion_multiply, sample_quaternion(0),
+                  sample_quaternion(4),
+                  [](const quaternion &a, const quaternion &b) {
+                    return a * b;
+                  });
+BENCHMARK_CAPTURE(binary, quaternion_rotate, sample_quaternion(0),
+                  sample_float3(4),
+                  [](const quaternion &q, const float3 &v) {
+                    return rotate(q, v);
+                  });
+BENCHMARK_CAPTURE(binary, quaternion_slerp, sample_quaternion(0),
+                  sample_quaternion(4),
+                  [](const quaternion &a, const quaternion &b) {
+                    return slerp(a, b, 0.3f);
+                  });
+BENCHMARK_CAPTURE(binary, quaternion_nlerp, sample_quaternion(0),
+                  sample_quaternion(4),
+                  [](const quaternion &a, const quaternion &b) {
+                    return nlerp(a, b, 0.3f);
+                  });
+BENCHMARK_CAPTURE(unary, quaternion_to_float4x4, sample_quaternion(0),
+                  [](const quaternion &q) { return to_float4x4(q); });
+BENCHMARK_CAPTURE(unary, quaternion_from_float4x4,
+                  to_float4x4(sample_quaternion(0)),
+                  [](const float4x4 &m) { return from_float4x4(m); });
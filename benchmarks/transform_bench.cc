@@ -0,0 +1,33 @@
+#include "graphmath/transform.h"
+
+#include "helpers.h"
+
+using namespace graphmath;
+using bench::binary;
+using bench::sample_float;
+using bench::sample_float3;
+using bench::ternary;
+using bench::unary;
+
+BENCHMARK_CAPTURE(unary, transform_translation, sample_float3(0),
+                  [](const float3 &offset) { return translation(offset); });
+BENCHMARK_CAPTURE(unary, transform_scaling, sample_float3(0),
+                  [](const float3 &scale) { return scaling(scale); });
+BENCHMARK_CAPTURE(binary, transform_rotation_axis_angle,
+                  normalize(sample_float3(0)), sample_float(3),
+                  [](const float3 &axis, float radians) {
+                    return rotation_axis_angle(axis, radians);
+                  });
+BENCHMARK_CAPTURE(ternary, transform_look_at, sample_float3(0),
+                  sample_float3(3) * -1.0f, float3{0.0f, 1.0f, 0.0f},
+                  [](const float3 &eye, const float3 &target,
+                     const float3 &up) { return look_at(eye, target, up); });
+BENCHMARK_CAPTURE(binary, transform_perspective, sample_float(0),
+                  sample_float(1), [](float fov_y, float aspect) {
+                    return perspective(fov_y, aspect, 0.1f, 100.0f);
+                  });
+BENCHMARK_CAPTURE(binary, transform_orthographic, sample_float(0),
+                  sample_float(1), [](float width, float height) {
+                    return orthographic(-width, width, -height, height, 0.1f,
+                                        100.0f);
+                  });
@@ -0,0 +1,83 @@
+#include "graphmath/transform_hierarchy.h"
+
+#include <vector>
+
+#include "helpers.h"
+
+using namespace graphmath;
+using bench::sample_affine_float4x4;
+
+// about the size of a large scene
+constexpr size_t node_count = 200000;
+
+// the nodes of an object form a binary tree
+constexpr size_t object_size = 100;
+
+/// @brief `node_count / object_size` objects under one scene root
+static transform_hierarchy sample_hierarchy() {
+  transform_hierarchy hierarchy;
+  hierarchy.reserve(node_count);
+
+  for (size_t i = 0; i < node_count; i++) {
+    size_t parent = transform_hierarchy::no_parent;
+    size_t object = (i - 1) / object_size * object_size + 1;
+
+    if (i == 0) {
+      parent = transform_hierarchy::no_parent;
+    } else if (i == object) {
+      parent = 0;
+    } else {
+      parent = object + (i - object - 1) / 2;
+    }
+
+    hierarchy.add(sample_affine_float4x4(static_cast<unsigned>(i % 64)),
+                  parent);
+  }
+
+  hierarchy.update(1);
+
+  return hierarchy;
+}
+
+static void hierarchy_rebuild(benchmark::State &state) {
+  transform_hierarchy hierarchy = sample_hierarchy();
+  std::vector<float4x4> worlds(node_count, float4x4{1.0f});
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < node_count; i++) {
+      size_t parent = hierarchy.parent(i);
+
+      worlds[i] = parent == transform_hierarchy::no_parent
+                      ? hierarchy.local(i)
+                      : worlds[parent] * hierarchy.local(i);
+    }
+
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * node_count);
+}
+BENCHMARK(hierarchy_rebuild)->Unit(benchmark::kMicrosecond);
+
+/// @brief Mark one node in `state.range(0)` dirty, then `update` on
+/// `state.range(1)` threads
+static void hierarchy_update(benchmark::State &state) {
+  transform_hierarchy hierarchy = sample_hierarchy();
+  size_t stride = static_cast<size_t>(state.range(0));
+  size_t thread_count = static_cast<size_t>(state.range(1));
+
+  for (auto _ : state) {
+    for (size_t i = stride / 2; i < node_count; i += stride) {
+      hierarchy.set_local(i, hierarchy.local(i));
+    }
+
+    hierarchy.update(thread_count);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations() * node_count);
+}
+BENCHMARK(hierarchy_update)
+    ->ArgsProduct({{1, 100, 10000}, {1, 4}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
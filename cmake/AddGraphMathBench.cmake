@@ -0,0 +1,42 @@
+function(add_graphmath_bench target)
+  set(PREFIX "BENCH")
+  cmake_parse_arguments(PARSE_ARGV 1 "${PREFIX}" "" "" "SOURCES")
+
+  add_executable("${target}")
+
+  target_compile_features(
+    "${target}"
+    PRIVATE
+      cxx_std_17)
+
+  target_link_libraries(
+    "${target}"
+    PRIVATE
+      benchmark::benchmark)
+
+  target_sources(
+    "${target}"
+    PRIVATE
+      "${BENCH_SOURCES}")
+
+  if(NOT MSVC)
+    target_compile_options(
+      "${target}"
+      PRIVATE
+        "-Wall"
+        "-Werror")
+  endif()
+
+  # Run the benchmarks and write the results as JSON, so that results of
+  # different releases (or backends) can be compared with
+  # `compare.py` from Google Benchmark
+  add_custom_target(
+    "${target}_json"
+    COMMAND
+      "${target}"
+      "--benchmark_out=${CMAKE_BINARY_DIR}/${target}.json"
+      "--benchmark_out_format=json"
+    DEPENDS
+      "${target}"
+    USES_TERMINAL)
+endfunction()
@@ -0,0 +1,192 @@
+//
+//  aabb.h
+//  CS 419
+//
+//  Axis aligned bounding boxes
+//
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "graphmath/backend.h"
+#include "graphmath/float3.h"
+#include "graphmath/float4.h"
+#include "graphmath/float4x4.h"
+
+#if defined(GRAPHMATH_BACKEND_APPLE)
+#include <simd/simd.h>
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+#include <DirectXMath.h>
+#elif defined(GRAPHMATH_BACKEND_SSE)
+#include "graphmath/sse.h"
+#endif
+
+// Declarations
+
+namespace graphmath {
+/// @brief an axis aligned box between two corners
+struct aabb final {
+ public:
+  /// @brief create an empty box, which `merge` grows to what it is given
+  GRAPHMATH_CONSTEXPR aabb();
+
+  /// @brief create a box between two corners
+  /// @param lower the corner with the smallest coordinates
+  /// @param upper the corner with the largest coordinates
+  GRAPHMATH_CONSTEXPR aabb(const float3 &lower, const float3 &upper);
+
+  float3 lower;
+  float3 upper;
+};
+
+static_assert(std::is_trivially_copyable_v<aabb>,
+              "aabb must be trivially copyable");
+static_assert(sizeof(aabb) == 2 * sizeof(float3),
+              "aabb must be two float3 without padding");
+
+/// @brief Check if a box is empty
+/// @param box the box
+/// @returns true if `lower` is above `upper` on any axis; false otherwise
+GRAPHMATH_CONSTEXPR bool empty(const aabb &box);
+
+/// @brief Get the center of a box
+/// @param box the box, not empty
+/// @returns the center
+GRAPHMATH_CONSTEXPR float3 center(const aabb &box);
+
+/// @brief Get half the size of a box on each axis
+/// @param box the box, not empty
+/// @returns the half extents
+GRAPHMATH_CONSTEXPR float3 half_extents(const aabb &box);
+
+/// @brief Grow a box to contain a point
+/// @param box the box
+/// @param point the point
+/// @returns the smallest box containing `box` and `point`
+GRAPHMATH_CONSTEXPR aabb merge(const aabb &box, const float3 &point);
+
+/// @brief Grow a box to contain another
+/// @param a a
+/// @param b b
+/// @returns the smallest box containing `a` and `b`
+GRAPHMATH_CONSTEXPR aabb merge(const aabb &a, const aabb &b);
+
+/// @brief Check if a box contains a point, boundary included
+/// @param box the box
+/// @param point the point
+/// @returns true if `point` is in `box`; false otherwise
+GRAPHMATH_CONSTEXPR bool contains(const aabb &box, const float3 &point);
+
+/// @brief Check if two boxes overlap, touching included
+/// @param a a
+/// @param b b
+/// @returns true if `a` and `b` overlap; false otherwise
+GRAPHMATH_CONSTEXPR bool intersects(const aabb &a, const aabb &b);
+
+/// @brief Get the box around a transformed box
+/// @param m the affine transform
+/// @param box the box, not empty
+/// @returns the smallest axis aligned box around the 8 transformed corners
+aabb transform(const float4x4 &m, const aabb &box);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+inline GRAPHMATH_CONSTEXPR aabb::aabb()
+    : lower{std::numeric_limits<float>::infinity(),
+            std::numeric_limits<float>::infinity(),
+            std::numeric_limits<float>::infinity()},
+      upper{-std::numeric_limits<float>::infinity(),
+            -std::numeric_limits<float>::infinity(),
+            -std::numeric_limits<float>::infinity()} {}
+
+inline GRAPHMATH_CONSTEXPR aabb::aabb(const float3 &lower, const float3 &upper)
+    : lower(lower), upper(upper) {}
+
+inline GRAPHMATH_CONSTEXPR bool empty(const aabb &box) {
+  return box.lower.x() > box.upper.x() || box.lower.y() > box.upper.y() ||
+         box.lower.z() > box.upper.z();
+}
+
+inline GRAPHMATH_CONSTEXPR float3 center(const aabb &box) {
+  return (box.lower + box.upper) * 0.5f;
+}
+
+inline GRAPHMATH_CONSTEXPR float3 half_extents(const aabb &box) {
+  return (box.upper - box.lower) * 0.5f;
+}
+
+inline GRAPHMATH_CONSTEXPR aabb merge(const aabb &box, const float3 &point) {
+  return aabb{min(box.lower, point), max(box.upper, point)};
+}
+
+inline GRAPHMATH_CONSTEXPR aabb merge(const aabb &a, const aabb &b) {
+  return aabb{min(a.lower, b.lower), max(a.upper, b.upper)};
+}
+
+inline GRAPHMATH_CONSTEXPR bool contains(const aabb &box,
+                                         const float3 &point) {
+  // clamping `point` to the box leaves it unchanged
+  return max(box.lower, point) == point &&
+         min(box.upper, point) == point;
+}
+
+inline GRAPHMATH_CONSTEXPR bool intersects(const aabb &a, const aabb &b) {
+  // the overlap is not empty
+  return !empty(aabb{max(a.lower, b.lower),
+                     min(a.upper, b.upper)});
+}
+
+inline aabb transform(const float4x4 &m, const aabb &box) {
+  // the center moves with `m`, and each new half extent sums the old ones
+  // weighted by the absolute values of a row of the upper 3x3
+  float3 c = center(box);
+  float3 e = half_extents(box);
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+  const __m128(&columns)[4] = m.native.columns;
+  const __m128 sign = _mm_set1_ps(-0.0f);
+
+  __m128 new_center =
+      sse::multiply(columns, _mm_blend_ps(c.native, _mm_set1_ps(1.0f), 0x8));
+  __m128 new_extents =
+      _mm_mul_ps(_mm_andnot_ps(sign, columns[0]), sse::splat<0>(e.native));
+  new_extents = sse::madd(_mm_andnot_ps(sign, columns[1]),
+                          sse::splat<1>(e.native), new_extents);
+  new_extents = sse::madd(_mm_andnot_ps(sign, columns[2]),
+                          sse::splat<2>(e.native), new_extents);
+
+  // `w` goes back to zero, like in every `float3`
+  new_center = _mm_blend_ps(new_center, _mm_setzero_ps(), 0x8);
+  new_extents = _mm_blend_ps(new_extents, _mm_setzero_ps(), 0x8);
+
+  return aabb{float3{_mm_sub_ps(new_center, new_extents)},
+              float3{_mm_add_ps(new_center, new_extents)}};
+#else
+  const float old_center[3] = {c.x(), c.y(), c.z()};
+  const float old_extents[3] = {e.x(), e.y(), e.z()};
+  float new_center[3];
+  float new_extents[3];
+
+  for (size_t y = 0; y < 3; y++) {
+    new_center[y] = m(y, 3);
+    new_extents[y] = 0.0f;
+
+    for (size_t x = 0; x < 3; x++) {
+      new_center[y] += m(y, x) * old_center[x];
+      new_extents[y] += std::abs(m(y, x)) * old_extents[x];
+    }
+  }
+
+  float3 moved{new_center[0], new_center[1], new_center[2]};
+  float3 extents{new_extents[0], new_extents[1], new_extents[2]};
+
+  return aabb{moved - extents, moved + extents};
+#endif
+}
+}  // namespace graphmath
@@ -0,0 +1,87 @@
+//
+//  aligned_allocator.h
+//  CS 419
+//
+//  Allocator for containers whose storage must start on a SIMD boundary
+//
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+// Declarations
+
+namespace graphmath {
+/// @brief default alignment of `aligned_allocator`, one cache line, which is
+/// also the width of an AVX-512 register
+constexpr size_t default_alignment = 64;
+
+/// @brief an allocator that aligns its allocations to `Alignment` bytes
+/// @tparam T the value type
+/// @tparam Alignment the alignment in bytes, a power of two
+template <typename T, size_t Alignment = default_alignment>
+class aligned_allocator {
+ public:
+  static_assert((Alignment & (Alignment - 1)) == 0,
+                "alignment must be a power of two");
+  static_assert(Alignment >= alignof(T), "alignment is too small for T");
+
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = aligned_allocator<U, Alignment>;
+  };
+
+  aligned_allocator() noexcept = default;
+
+  template <typename U>
+  aligned_allocator(const aligned_allocator<U, Alignment> &) noexcept {}
+
+  /// @brief Allocate storage for `count` values
+  /// @param count the number of values
+  /// @returns storage aligned to `Alignment`
+  T *allocate(size_t count);
+
+  /// @brief Release storage returned by `allocate`
+  /// @param pointer the storage
+  /// @param count the number of values passed to `allocate`
+  void deallocate(T *pointer, size_t count) noexcept;
+};
+
+template <typename T, typename U, size_t Alignment>
+bool operator==(const aligned_allocator<T, Alignment> &,
+                const aligned_allocator<U, Alignment> &) noexcept;
+
+template <typename T, typename U, size_t Alignment>
+bool operator!=(const aligned_allocator<T, Alignment> &,
+                const aligned_allocator<U, Alignment> &) noexcept;
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+template <typename T, size_t Alignment>
+T *aligned_allocator<T, Alignment>::allocate(size_t count) {
+  return static_cast<T *>(
+      ::operator new(count * sizeof(T), std::align_val_t{Alignment}));
+}
+
+template <typename T, size_t Alignment>
+void aligned_allocator<T, Alignment>::deallocate(T *pointer,
+                                                 size_t) noexcept {
+  ::operator delete(pointer, std::align_val_t{Alignment});
+}
+
+template <typename T, typename U, size_t Alignment>
+bool operator==(const aligned_allocator<T, Alignment> &,
+                const aligned_allocator<U, Alignment> &) noexcept {
+  return true;
+}
+
+template <typename T, typename U, size_t Alignment>
+bool operator!=(const aligned_allocator<T, Alignment> &,
+                const aligned_allocator<U, Alignment> &) noexcept {
+  return false;
+}
+}  // namespace graphmath
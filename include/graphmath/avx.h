@@ -0,0 +1,128 @@
+//
+//  avx.h
+//  CS 419
+//
+//  Helpers shared by the AVX implementations of `double3`, `double4` and
+//  `double4x4`
+//
+#pragma once
+
+#include <immintrin.h>
+
+#include "graphmath/backend.h"
+
+// Declarations
+
+namespace graphmath {
+namespace avx {
+/// @brief Compute `a * b + c`, fused into a single instruction
+/// @param a a
+/// @param b b
+/// @param c c
+/// @returns `a * b + c`
+__m256d madd(__m256d a, __m256d b, __m256d c);
+
+/// @brief Read one lane of a vector, also during constant evaluation
+/// @tparam Lane the lane to read, in `[0, 4)`
+/// @param v the vector
+/// @returns `v[Lane]`
+template <int Lane>
+constexpr double lane(__m256d v);
+
+/// @brief Broadcast one lane of a vector to all four lanes
+/// @tparam Lane the lane to broadcast, in `[0, 4)`
+/// @param v the vector
+/// @returns `(v[Lane], v[Lane], v[Lane], v[Lane])`
+template <int Lane>
+__m256d splat(__m256d v);
+
+/// @brief Reorder the lanes of a vector, across the two 128 bit halves
+/// @tparam X the lane of `v` written to lane 0
+/// @tparam Y the lane of `v` written to lane 1
+/// @tparam Z the lane of `v` written to lane 2
+/// @tparam W the lane of `v` written to lane 3
+/// @param v the vector
+/// @returns `(v[X], v[Y], v[Z], v[W])`
+template <int X, int Y, int Z, int W>
+__m256d swizzle(__m256d v);
+
+/// @brief Add the four lanes of a vector
+/// @param v the vector
+/// @returns `v[0] + v[1] + v[2] + v[3]`
+double sum(__m256d v);
+
+/// @brief Multiply a column major matrix by a column vector
+/// @param columns the four columns of the matrix
+/// @param v the column vector
+/// @returns `columns * v`
+__m256d multiply(const __m256d (&columns)[4], __m256d v);
+
+/// @brief Transpose a 4x4 matrix held in four registers
+/// @param in the four columns (or rows) of the matrix
+/// @param out the four columns (or rows) of the transpose; may be `in`
+void transpose(const __m256d (&in)[4], __m256d (&out)[4]);
+}  // namespace avx
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+namespace avx {
+inline __m256d madd(__m256d a, __m256d b, __m256d c) {
+  return _mm256_fmadd_pd(a, b, c);
+}
+
+template <int Lane>
+constexpr double lane(__m256d v) {
+  static_assert(Lane >= 0 && Lane < 4, "lane must be in [0, 4)");
+
+#if defined(_MSC_VER) && !defined(__clang__)
+  return v.m256d_f64[Lane];
+#else
+  return v[Lane];
+#endif
+}
+
+template <int Lane>
+inline __m256d splat(__m256d v) {
+  static_assert(Lane >= 0 && Lane < 4, "lane must be in [0, 4)");
+
+  return _mm256_permute4x64_pd(v, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+}
+
+template <int X, int Y, int Z, int W>
+inline __m256d swizzle(__m256d v) {
+  return _mm256_permute4x64_pd(v, _MM_SHUFFLE(W, Z, Y, X));
+}
+
+inline double sum(__m256d v) {
+  // `(v0 + v2, v1 + v3)`, then the two halves
+  __m128d pairs =
+      _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+  return _mm_cvtsd_f64(_mm_add_sd(pairs, _mm_unpackhi_pd(pairs, pairs)));
+}
+
+inline __m256d multiply(const __m256d (&columns)[4], __m256d v) {
+  __m256d result = _mm256_mul_pd(columns[0], splat<0>(v));
+
+  result = madd(columns[1], splat<1>(v), result);
+  result = madd(columns[2], splat<2>(v), result);
+  result = madd(columns[3], splat<3>(v), result);
+
+  return result;
+}
+
+inline void transpose(const __m256d (&in)[4], __m256d (&out)[4]) {
+  // `(a0, b0, a2, b2)`, `(a1, b1, a3, b3)`, and the same for `c` and `d`
+  __m256d ab_even = _mm256_unpacklo_pd(in[0], in[1]);
+  __m256d ab_odd = _mm256_unpackhi_pd(in[0], in[1]);
+  __m256d cd_even = _mm256_unpacklo_pd(in[2], in[3]);
+  __m256d cd_odd = _mm256_unpackhi_pd(in[2], in[3]);
+
+  out[0] = _mm256_permute2f128_pd(ab_even, cd_even, 0x20);
+  out[1] = _mm256_permute2f128_pd(ab_odd, cd_odd, 0x20);
+  out[2] = _mm256_permute2f128_pd(ab_even, cd_even, 0x31);
+  out[3] = _mm256_permute2f128_pd(ab_odd, cd_odd, 0x31);
+}
+}  // namespace avx
+}  // namespace graphmath
@@ -0,0 +1,147 @@
+//
+//  backend.h
+//  CS 419
+//
+//  Selects the implementation behind `float3`, `float4` and `float4x4`
+//
+#pragma once
+
+#include <cstddef>
+
+// Declarations
+
+// A backend can be forced by defining exactly one of the following macros
+// (the `GRAPHMATH_BACKEND` CMake option does this)
+// - GRAPHMATH_BACKEND_SCALAR: portable reference implementation
+// - GRAPHMATH_BACKEND_SSE: SSE4.1 intrinsics
+// - GRAPHMATH_BACKEND_AVX2: SSE4.1 intrinsics for single vectors, with FMA,
+//   and 256 bit kernels for batches
+// - GRAPHMATH_BACKEND_APPLE: `simd`
+// - GRAPHMATH_BACKEND_DIRECTX: `DirectXMath`
+//
+// Otherwise the backend is chosen from the platform
+#if !defined(GRAPHMATH_BACKEND_SCALAR) && !defined(GRAPHMATH_BACKEND_SSE) && \
+    !defined(GRAPHMATH_BACKEND_AVX2) && !defined(GRAPHMATH_BACKEND_APPLE) &&  \
+    !defined(GRAPHMATH_BACKEND_DIRECTX)
+#if defined(__APPLE__)
+#define GRAPHMATH_BACKEND_APPLE
+#elif defined(_WIN32)
+#define GRAPHMATH_BACKEND_DIRECTX
+#elif defined(__AVX2__) && defined(__FMA__)
+#define GRAPHMATH_BACKEND_AVX2
+#elif defined(__SSE4_1__)
+#define GRAPHMATH_BACKEND_SSE
+#else
+#define GRAPHMATH_BACKEND_SCALAR
+#endif
+#endif
+
+// The AVX2 backend shares the 128 bit implementation of the SSE backend
+#if defined(GRAPHMATH_BACKEND_AVX2) && !defined(GRAPHMATH_BACKEND_SSE)
+#define GRAPHMATH_BACKEND_SSE
+#endif
+
+#if !defined(_MSC_VER)
+#if defined(GRAPHMATH_BACKEND_SSE) && !defined(__SSE4_1__)
+#error "graphmath: the sse backend requires SSE4.1 (-msse4.1)"
+#endif
+
+#if defined(GRAPHMATH_BACKEND_AVX2) && \
+    !(defined(__AVX2__) && defined(__FMA__))
+#error "graphmath: the avx2 backend requires AVX2 and FMA (-mavx2 -mfma)"
+#endif
+#endif
+
+// Compile time evaluation
+//
+// The scalar backend is `constexpr` throughout. The SSE backend keeps its
+// intrinsics at run time and takes lane-wise code during constant
+// evaluation, which needs `__builtin_is_constant_evaluated` and `__m128` in
+// constant expressions (GCC and Clang). `GRAPHMATH_HAS_CONSTEXPR` is defined
+// when `GRAPHMATH_CONSTEXPR` expands to `constexpr`
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define GRAPHMATH_HAS_IS_CONSTANT_EVALUATED
+#endif
+#endif
+
+#if defined(GRAPHMATH_BACKEND_SCALAR) ||                     \
+    (defined(GRAPHMATH_BACKEND_SSE) && !defined(_MSC_VER) && \
+     defined(GRAPHMATH_HAS_IS_CONSTANT_EVALUATED))
+#define GRAPHMATH_HAS_CONSTEXPR
+#define GRAPHMATH_CONSTEXPR constexpr
+#else
+#define GRAPHMATH_CONSTEXPR
+#endif
+
+namespace graphmath {
+/// @brief backends that can implement `float3`, `float4` and `float4x4`
+enum class backend { scalar, sse, avx2, apple, directx };
+
+/// @brief compile time information about a backend
+/// @tparam Backend the backend
+template <backend Backend>
+struct backend_traits;
+
+template <>
+struct backend_traits<backend::scalar> {
+  /// @brief name used by the `GRAPHMATH_BACKEND` CMake option
+  static constexpr const char *name = "scalar";
+
+  /// @brief number of `float` processed by one instruction
+  static constexpr size_t float_lanes = 1;
+};
+
+template <>
+struct backend_traits<backend::sse> {
+  static constexpr const char *name = "sse";
+  static constexpr size_t float_lanes = 4;
+};
+
+template <>
+struct backend_traits<backend::avx2> {
+  static constexpr const char *name = "avx2";
+  static constexpr size_t float_lanes = 8;
+};
+
+template <>
+struct backend_traits<backend::apple> {
+  static constexpr const char *name = "apple";
+  static constexpr size_t float_lanes = 4;
+};
+
+template <>
+struct backend_traits<backend::directx> {
+  static constexpr const char *name = "directx";
+  static constexpr size_t float_lanes = 4;
+};
+
+/// @brief the backend this translation unit is compiled with
+#if defined(GRAPHMATH_BACKEND_APPLE)
+constexpr backend current_backend = backend::apple;
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+constexpr backend current_backend = backend::directx;
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+constexpr backend current_backend = backend::avx2;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+constexpr backend current_backend = backend::sse;
+#else
+constexpr backend current_backend = backend::scalar;
+#endif
+
+/// @brief traits of `current_backend`
+using current_backend_traits = backend_traits<current_backend>;
+
+namespace detail {
+/// @brief Check if the caller is being evaluated at compile time, where
+/// intrinsics are not available
+/// @returns true during constant evaluation; false otherwise
+constexpr bool is_constant_evaluated() noexcept {
+#if defined(GRAPHMATH_HAS_IS_CONSTANT_EVALUATED)
+  return __builtin_is_constant_evaluated();
+#else
+  return false;
+#endif
+}
+}  // namespace detail
+}  // namespace graphmath
@@ -0,0 +1,790 @@
+//
+//  binary.h
+//  CS 419
+//
+//  A versioned binary container of vector and matrix arrays, opened with a
+//  memory map
+//
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "graphmath/backend.h"
+#include "graphmath/float3.h"
+#include "graphmath/float3_soa.h"
+#include "graphmath/float4.h"
+#include "graphmath/float4_soa.h"
+#include "graphmath/float4x4.h"
+#include "graphmath/packed_float3.h"
+#include "graphmath/span.h"
+
+#if defined(_WIN32)
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Declarations
+
+// File layout, in the byte order of the writer, which the reader checks
+// - header, 64 bytes: `GMBINARY`, the version and a byte order mark
+// - the chunks, each at a multiple of `binary_alignment`
+// - the chunk table, one `binary_chunk` per chunk
+// - footer, 16 bytes: the offset of the chunk table and the number of chunks
+//
+// The table comes last so that a writer streams chunks without seeking
+
+namespace graphmath {
+/// @brief the version `binary_writer` writes, and the newest `binary_reader`
+/// opens
+constexpr uint32_t binary_version = 1;
+
+/// @brief the alignment in bytes of every chunk, and of every component
+/// array of a structure-of-arrays chunk
+constexpr size_t binary_alignment = 64;
+
+/// @brief the longest name of a chunk, without its null character
+constexpr size_t binary_max_name = 31;
+
+/// @brief returned by `binary_reader::find` for a missing chunk
+constexpr size_t no_chunk = static_cast<size_t>(-1);
+
+/// @brief what a chunk stores
+enum class binary_kind : uint32_t {
+  /// @brief `count` `packed_float3`
+  packed_float3 = 1,
+  /// @brief `count` `x`, then `count` `y` and `z`, `stride` bytes apart
+  float3_soa = 2,
+  /// @brief `count` `float4`
+  float4 = 3,
+  /// @brief like `float3_soa`, with `w`
+  float4_soa = 4,
+  /// @brief `count` column major `float4x4`, `(y, x)` at float `x * 4 + y`
+  float4x4 = 5
+};
+
+/// @brief an entry of the chunk table
+struct binary_chunk final {
+  /// @brief what the chunk stores
+  binary_kind kind;
+
+  /// @brief zero
+  uint32_t reserved;
+
+  /// @brief the number of values
+  uint64_t count;
+
+  /// @brief the offset of the first value from the start of the file
+  uint64_t offset;
+
+  /// @brief the bytes between component arrays of structure-of-arrays
+  /// chunks, zero for other chunks
+  uint64_t stride;
+
+  /// @brief the name, null terminated
+  char name[binary_max_name + 1];
+};
+
+static_assert(sizeof(binary_chunk) == 64, "binary_chunk must be 64 bytes");
+
+/// @brief the components of a `float3_soa` chunk
+struct float3_soa_view final {
+  span<const float> x;
+  span<const float> y;
+  span<const float> z;
+};
+
+/// @brief the components of a `float4_soa` chunk
+struct float4_soa_view final {
+  span<const float> x;
+  span<const float> y;
+  span<const float> z;
+  span<const float> w;
+};
+
+/// @brief Write a binary file one chunk at a time
+///
+/// Write errors are remembered and reported by `close`
+class binary_writer final {
+ public:
+  /// @brief create a writer without a file
+  binary_writer() = default;
+
+  /// @brief create a writer and open a file, see `open`
+  /// @param path the path of the file
+  explicit binary_writer(const char *path);
+
+  binary_writer(const binary_writer &) = delete;
+  binary_writer &operator=(const binary_writer &) = delete;
+
+  /// @brief finish the file if it is open
+  ~binary_writer();
+
+  /// @brief Create or truncate a file and write its header
+  /// @param path the path of the file
+  /// @returns true if the file is open
+  bool open(const char *path);
+
+  /// @brief Check if a file is open
+  /// @returns true if a file is open
+  bool is_open() const;
+
+  /// @brief Add a chunk of `packed_float3`
+  /// @param name the name, at most `binary_max_name` characters
+  /// @param values the values
+  void add(const char *name, span<const packed_float3> values);
+
+  /// @brief Add a chunk of `float3`, stored as `packed_float3`
+  /// @param name the name, at most `binary_max_name` characters
+  /// @param values the values
+  void add(const char *name, span<const float3> values);
+
+  /// @brief Add a structure-of-arrays chunk of `float3`
+  /// @param name the name, at most `binary_max_name` characters
+  /// @param values the values
+  void add(const char *name, const float3_soa &values);
+
+  /// @brief Add a chunk of `float4`
+  /// @param name the name, at most `binary_max_name` characters
+  /// @param values the values
+  void add(const char *name, span<const float4> values);
+
+  /// @brief Add a structure-of-arrays chunk of `float4`
+  /// @param name the name, at most `binary_max_name` characters
+  /// @param values the values
+  void add(const char *name, const float4_soa &values);
+
+  /// @brief Add a chunk of `float4x4`
+  /// @param name the name, at most `binary_max_name` characters
+  /// @param values the values
+  void add(const char *name, span<const float4x4> values);
+
+  /// @brief Write the chunk table and close the file
+  /// @returns true if everything since `open` was written
+  bool close();
+
+ private:
+  void begin_chunk(binary_kind kind, const char *name, size_t count,
+                   size_t stride);
+
+  void write(const void *data, size_t size);
+
+  void pad();
+
+  std::FILE *file_ = nullptr;
+  uint64_t offset_ = 0;
+  bool good_ = false;
+  std::vector<binary_chunk> chunks_;
+};
+
+/// @brief Map a binary file into memory and view its chunks in place
+///
+/// Opening checks the header and that every chunk lies in the file, without
+/// reading the chunks, so opening a file of any size takes about as long.
+/// Views stay valid until the reader is closed
+class binary_reader final {
+ public:
+  /// @brief create a reader without a file
+  binary_reader() = default;
+
+  /// @brief create a reader and open a file, see `open`
+  /// @param path the path of the file
+  explicit binary_reader(const char *path);
+
+  binary_reader(const binary_reader &) = delete;
+  binary_reader &operator=(const binary_reader &) = delete;
+
+  /// @brief take the file of another reader
+  /// @param other the reader, closed afterwards
+  binary_reader(binary_reader &&other) noexcept;
+
+  /// @brief close the file and take the file of another reader
+  /// @param other the reader, closed afterwards
+  /// @returns this reader
+  binary_reader &operator=(binary_reader &&other) noexcept;
+
+  /// @brief close the file
+  ~binary_reader();
+
+  /// @brief Map a file, closing the current one
+  /// @param path the path of the file
+  /// @returns true if the file is a valid binary file of version
+  /// `binary_version` or older
+  bool open(const char *path);
+
+  /// @brief Check if a file is open
+  /// @returns true if a file is open
+  bool is_open() const;
+
+  /// @brief Unmap the file
+  void close();
+
+  /// @brief Get the version of the file
+  /// @returns the version
+  uint32_t version() const;
+
+  /// @brief Get the number of chunks
+  /// @returns the number of chunks
+  size_t size() const;
+
+  /// @brief Get a chunk
+  /// @param index the index, `index < size()`
+  /// @returns the chunk
+  const binary_chunk &chunk(size_t index) const;
+
+  /// @brief Find a chunk by name
+  /// @param name the name
+  /// @returns the index of the first chunk called `name`, or `no_chunk`
+  size_t find(const char *name) const;
+
+  /// @brief View a `packed_float3` chunk
+  /// @param index the index of the chunk
+  /// @returns the values
+  span<const packed_float3> packed_float3s(size_t index) const;
+
+  /// @brief View a `float3_soa` chunk
+  /// @param index the index of the chunk
+  /// @returns the components
+  float3_soa_view soa_float3s(size_t index) const;
+
+  /// @brief View a `float4` chunk
+  /// @param index the index of the chunk
+  /// @returns the values
+  span<const float4> float4s(size_t index) const;
+
+  /// @brief View a `float4_soa` chunk
+  /// @param index the index of the chunk
+  /// @returns the components
+  float4_soa_view soa_float4s(size_t index) const;
+
+#if !defined(GRAPHMATH_BACKEND_DIRECTX)
+  /// @brief View a `float4x4` chunk
+  /// Only the column major backends can view the matrices of a file; the
+  /// DirectX backend stores rows and copies them instead
+  /// @param index the index of the chunk
+  /// @returns the values
+  span<const float4x4> float4x4s(size_t index) const;
+#endif
+
+  /// @brief Copy a `float4x4` chunk, on every backend
+  /// @param index the index of the chunk
+  /// @param out the matrices, `out.size()` must be the count of the chunk
+  void float4x4s(size_t index, span<float4x4> out) const;
+
+ private:
+  const float *component(const binary_chunk &chunk, size_t component) const;
+
+  const unsigned char *data_ = nullptr;
+  size_t size_ = 0;
+  const binary_chunk *chunks_ = nullptr;
+  size_t chunk_count_ = 0;
+};
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+namespace detail {
+/// @brief `binary_header::byte_order` as written
+constexpr uint32_t binary_byte_order = 0x01020304;
+
+struct binary_header final {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  unsigned char reserved[48];
+};
+
+struct binary_footer final {
+  uint64_t table_offset;
+  uint64_t chunk_count;
+};
+
+static_assert(sizeof(binary_header) == binary_alignment,
+              "binary_header must fill one alignment");
+static_assert(sizeof(binary_footer) == 16, "binary_footer must be 16 bytes");
+
+constexpr char binary_magic[8] = {'G', 'M', 'B', 'I', 'N', 'A', 'R', 'Y'};
+
+/// @brief Round up to a multiple of `binary_alignment`
+inline uint64_t binary_align(uint64_t offset) {
+  return (offset + binary_alignment - 1) / binary_alignment *
+         binary_alignment;
+}
+
+/// @brief the bytes between components of a structure-of-arrays chunk
+inline uint64_t binary_soa_stride(size_t count) {
+  return binary_align(static_cast<uint64_t>(count) * sizeof(float));
+}
+
+/// @brief Check that a chunk is known and lies between the header and
+/// `end`, without overflowing
+inline bool binary_chunk_valid(const binary_chunk &chunk, uint64_t end) {
+  if (chunk.name[binary_max_name] != '\0' ||
+      chunk.offset % binary_alignment != 0 ||
+      chunk.offset < sizeof(binary_header) || chunk.offset > end) {
+    return false;
+  }
+
+  uint64_t room = end - chunk.offset;
+  uint64_t value_size = 0;
+  uint64_t components = 1;
+
+  switch (chunk.kind) {
+    case binary_kind::packed_float3:
+      value_size = sizeof(packed_float3);
+      break;
+    case binary_kind::float4:
+      value_size = 4 * sizeof(float);
+      break;
+    case binary_kind::float4x4:
+      value_size = 16 * sizeof(float);
+      break;
+    case binary_kind::float3_soa:
+      components = 3;
+      break;
+    case binary_kind::float4_soa:
+      components = 4;
+      break;
+    default:
+      return false;
+  }
+
+  if (components == 1) {
+    return chunk.count <= room / value_size;
+  }
+
+  // the last component only needs `count` floats, the others `stride` bytes
+  return chunk.stride % binary_alignment == 0 &&
+         chunk.count <= chunk.stride / sizeof(float) &&
+         chunk.stride <= room / (components - 1) &&
+         (components - 1) * chunk.stride + chunk.count * sizeof(float) <=
+             room;
+}
+}  // namespace detail
+
+inline binary_writer::binary_writer(const char *path) { open(path); }
+
+inline binary_writer::~binary_writer() {
+  if (is_open()) {
+    close();
+  }
+}
+
+inline bool binary_writer::open(const char *path) {
+  if (is_open()) {
+    close();
+  }
+
+  file_ = std::fopen(path, "wb");
+  offset_ = 0;
+  good_ = file_ != nullptr;
+  chunks_.clear();
+
+  if (!good_) {
+    return false;
+  }
+
+  detail::binary_header header{};
+  std::memcpy(header.magic, detail::binary_magic, sizeof(header.magic));
+  header.version = binary_version;
+  header.byte_order = detail::binary_byte_order;
+
+  write(&header, sizeof(header));
+  return true;
+}
+
+inline bool binary_writer::is_open() const { return file_ != nullptr; }
+
+inline void binary_writer::add(const char *name,
+                               span<const packed_float3> values) {
+  begin_chunk(binary_kind::packed_float3, name, values.size(), 0);
+  write(values.data(), values.size() * sizeof(packed_float3));
+}
+
+inline void binary_writer::add(const char *name, span<const float3> values) {
+  begin_chunk(binary_kind::packed_float3, name, values.size(), 0);
+
+  // pack a block at a time, so that large arrays need no copy of their size
+  constexpr size_t block_size = 4096;
+  packed_float3 block[block_size];
+
+  for (size_t first = 0; first < values.size(); first += block_size) {
+    span<const float3> in = values.subspan(first, block_size);
+
+    pack(in, span<packed_float3>{block, in.size()});
+    write(block, in.size() * sizeof(packed_float3));
+  }
+}
+
+inline void binary_writer::add(const char *name, const float3_soa &values) {
+  size_t stride = detail::binary_soa_stride(values.size());
+  const float *components[3] = {values.x(), values.y(), values.z()};
+
+  begin_chunk(binary_kind::float3_soa, name, values.size(), stride);
+
+  for (const float *component : components) {
+    pad();
+    write(component, values.size() * sizeof(float));
+  }
+}
+
+inline void binary_writer::add(const char *name, span<const float4> values) {
+  static_assert(sizeof(float4) == 4 * sizeof(float),
+                "float4 must be stored as x, y, z, w");
+
+  begin_chunk(binary_kind::float4, name, values.size(), 0);
+  write(values.data(), values.size() * sizeof(float4));
+}
+
+inline void binary_writer::add(const char *name, const float4_soa &values) {
+  size_t stride = detail::binary_soa_stride(values.size());
+  const float *components[4] = {values.x(), values.y(), values.z(),
+                                values.w()};
+
+  begin_chunk(binary_kind::float4_soa, name, values.size(), stride);
+
+  for (const float *component : components) {
+    pad();
+    write(component, values.size() * sizeof(float));
+  }
+}
+
+inline void binary_writer::add(const char *name,
+                               span<const float4x4> values) {
+  static_assert(sizeof(float4x4) == 16 * sizeof(float),
+                "float4x4 must not be padded");
+
+  begin_chunk(binary_kind::float4x4, name, values.size(), 0);
+
+#if defined(GRAPHMATH_BACKEND_DIRECTX)
+  // rows in memory, which transpose to the columns of the file
+  for (size_t i = 0; i < values.size(); i++) {
+    float4x4 columns = transpose(values[i]);
+    write(&columns, sizeof(float4x4));
+  }
+#else
+  write(values.data(), values.size() * sizeof(float4x4));
+#endif
+}
+
+inline bool binary_writer::close() {
+  if (!is_open()) {
+    return false;
+  }
+
+  pad();
+
+  detail::binary_footer footer{};
+  footer.table_offset = offset_;
+  footer.chunk_count = chunks_.size();
+
+  write(chunks_.data(), chunks_.size() * sizeof(binary_chunk));
+  write(&footer, sizeof(footer));
+
+  bool good = std::fclose(file_) == 0 && good_;
+
+  file_ = nullptr;
+  chunks_.clear();
+
+  return good;
+}
+
+inline void binary_writer::begin_chunk(binary_kind kind, const char *name,
+                                       size_t count, size_t stride) {
+  assert(is_open());
+  assert(std::strlen(name) <= binary_max_name);
+
+  pad();
+
+  binary_chunk chunk{};
+  chunk.kind = kind;
+  chunk.count = count;
+  chunk.offset = offset_;
+  chunk.stride = stride;
+  std::strncpy(chunk.name, name, binary_max_name);
+
+  chunks_.push_back(chunk);
+}
+
+inline void binary_writer::write(const void *data, size_t size) {
+  if (size == 0 || !good_) {
+    return;
+  }
+
+  good_ = std::fwrite(data, 1, size, file_) == size;
+  offset_ += size;
+}
+
+inline void binary_writer::pad() {
+  static constexpr unsigned char zeroes[binary_alignment] = {};
+
+  write(zeroes, detail::binary_align(offset_) - offset_);
+}
+
+inline binary_reader::binary_reader(const char *path) { open(path); }
+
+inline binary_reader::binary_reader(binary_reader &&other) noexcept
+    : data_(other.data_),
+      size_(other.size_),
+      chunks_(other.chunks_),
+      chunk_count_(other.chunk_count_) {
+  other.data_ = nullptr;
+  other.size_ = 0;
+  other.chunks_ = nullptr;
+  other.chunk_count_ = 0;
+}
+
+inline binary_reader &binary_reader::operator=(
+    binary_reader &&other) noexcept {
+  if (this != &other) {
+    close();
+
+    data_ = other.data_;
+    size_ = other.size_;
+    chunks_ = other.chunks_;
+    chunk_count_ = other.chunk_count_;
+
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.chunks_ = nullptr;
+    other.chunk_count_ = 0;
+  }
+
+  return *this;
+}
+
+inline binary_reader::~binary_reader() { close(); }
+
+inline bool binary_reader::open(const char *path) {
+  close();
+
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+
+  LARGE_INTEGER file_size{};
+  HANDLE mapping = nullptr;
+
+  if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0) {
+    mapping =
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  }
+
+  CloseHandle(file);
+
+  if (mapping == nullptr) {
+    return false;
+  }
+
+  void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+
+  if (data == nullptr) {
+    return false;
+  }
+
+  data_ = static_cast<const unsigned char *>(data);
+  size_ = static_cast<size_t>(file_size.QuadPart);
+#else
+  int file = ::open(path, O_RDONLY);
+  if (file < 0) {
+    return false;
+  }
+
+  struct stat status {};
+  void *data = MAP_FAILED;
+
+  if (::fstat(file, &status) == 0 && status.st_size > 0) {
+    data = ::mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ,
+                  MAP_PRIVATE, file, 0);
+  }
+
+  ::close(file);
+
+  if (data == MAP_FAILED) {
+    return false;
+  }
+
+  data_ = static_cast<const unsigned char *>(data);
+  size_ = static_cast<size_t>(status.st_size);
+#endif
+
+  detail::binary_header header{};
+  detail::binary_footer footer{};
+
+  if (size_ < sizeof(header) + sizeof(footer)) {
+    close();
+    return false;
+  }
+
+  std::memcpy(&header, data_, sizeof(header));
+  std::memcpy(&footer, data_ + size_ - sizeof(footer), sizeof(footer));
+
+  uint64_t table_end = size_ - sizeof(footer);
+
+  if (std::memcmp(header.magic, detail::binary_magic, sizeof(header.magic)) !=
+          0 ||
+      header.byte_order != detail::binary_byte_order || header.version == 0 ||
+      header.version > binary_version ||
+      footer.table_offset % binary_alignment != 0 ||
+      footer.table_offset < sizeof(header) ||
+      footer.table_offset > table_end ||
+      footer.chunk_count >
+          (table_end - footer.table_offset) / sizeof(binary_chunk)) {
+    close();
+    return false;
+  }
+
+  chunks_ = reinterpret_cast<const binary_chunk *>(data_ + footer.table_offset);
+  chunk_count_ = static_cast<size_t>(footer.chunk_count);
+
+  for (size_t i = 0; i < chunk_count_; i++) {
+    if (!detail::binary_chunk_valid(chunks_[i], footer.table_offset)) {
+      close();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+inline bool binary_reader::is_open() const { return data_ != nullptr; }
+
+inline void binary_reader::close() {
+  if (data_ != nullptr) {
+#if defined(_WIN32)
+    UnmapViewOfFile(data_);
+#else
+    ::munmap(const_cast<unsigned char *>(data_), size_);
+#endif
+  }
+
+  data_ = nullptr;
+  size_ = 0;
+  chunks_ = nullptr;
+  chunk_count_ = 0;
+}
+
+inline uint32_t binary_reader::version() const {
+  assert(is_open());
+
+  detail::binary_header header{};
+  std::memcpy(&header, data_, sizeof(header));
+
+  return header.version;
+}
+
+inline size_t binary_reader::size() const { return chunk_count_; }
+
+inline const binary_chunk &binary_reader::chunk(size_t index) const {
+  assert(index < chunk_count_);
+
+  return chunks_[index];
+}
+
+inline size_t binary_reader::find(const char *name) const {
+  for (size_t i = 0; i < chunk_count_; i++) {
+    if (std::strcmp(chunks_[i].name, name) == 0) {
+      return i;
+    }
+  }
+
+  return no_chunk;
+}
+
+inline span<const packed_float3> binary_reader::packed_float3s(
+    size_t index) const {
+  const binary_chunk &c = chunk(index);
+  assert(c.kind == binary_kind::packed_float3);
+
+  return span<const packed_float3>{
+      reinterpret_cast<const packed_float3 *>(data_ + c.offset),
+      static_cast<size_t>(c.count)};
+}
+
+inline float3_soa_view binary_reader::soa_float3s(size_t index) const {
+  const binary_chunk &c = chunk(index);
+  assert(c.kind == binary_kind::float3_soa);
+
+  size_t count = static_cast<size_t>(c.count);
+
+  return float3_soa_view{span<const float>{component(c, 0), count},
+                         span<const float>{component(c, 1), count},
+                         span<const float>{component(c, 2), count}};
+}
+
+inline span<const float4> binary_reader::float4s(size_t index) const {
+  const binary_chunk &c = chunk(index);
+  assert(c.kind == binary_kind::float4);
+
+  return span<const float4>{
+      reinterpret_cast<const float4 *>(data_ + c.offset),
+      static_cast<size_t>(c.count)};
+}
+
+inline float4_soa_view binary_reader::soa_float4s(size_t index) const {
+  const binary_chunk &c = chunk(index);
+  assert(c.kind == binary_kind::float4_soa);
+
+  size_t count = static_cast<size_t>(c.count);
+
+  return float4_soa_view{span<const float>{component(c, 0), count},
+                         span<const float>{component(c, 1), count},
+                         span<const float>{component(c, 2), count},
+                         span<const float>{component(c, 3), count}};
+}
+
+#if !defined(GRAPHMATH_BACKEND_DIRECTX)
+inline span<const float4x4> binary_reader::float4x4s(size_t index) const {
+  const binary_chunk &c = chunk(index);
+  assert(c.kind == binary_kind::float4x4);
+
+  return span<const float4x4>{
+      reinterpret_cast<const float4x4 *>(data_ + c.offset),
+      static_cast<size_t>(c.count)};
+}
+#endif
+
+inline void binary_reader::float4x4s(size_t index,
+                                     span<float4x4> out) const {
+  const binary_chunk &c = chunk(index);
+  assert(c.kind == binary_kind::float4x4);
+  assert(out.size() == c.count);
+
+#if defined(GRAPHMATH_BACKEND_DIRECTX)
+  // the columns of the file transpose to the rows in memory
+  for (size_t i = 0; i < out.size(); i++) {
+    float4x4 columns;
+    std::memcpy(&columns, data_ + c.offset + i * sizeof(float4x4),
+                sizeof(float4x4));
+    out[i] = transpose(columns);
+  }
+#else
+  std::memcpy(out.data(), data_ + c.offset, out.size() * sizeof(float4x4));
+#endif
+}
+
+inline const float *binary_reader::component(const binary_chunk &chunk,
+                                             size_t component) const {
+  return reinterpret_cast<const float *>(data_ + chunk.offset +
+                                         component * chunk.stride);
+}
+}  // namespace graphmath
@@ -0,0 +1,137 @@
+//
+//  bounding_sphere.h
+//  CS 419
+//
+//  Bounding spheres
+//
+#pragma once
+
+#include <type_traits>
+
+#include "graphmath/aabb.h"
+#include "graphmath/backend.h"
+#include "graphmath/float3.h"
+#include "graphmath/float4.h"
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+#include "graphmath/sse.h"
+#endif
+
+// Declarations
+
+namespace graphmath {
+/// @brief a sphere around a center, stored in one `float4` as
+/// `(x, y, z, radius)`
+struct bounding_sphere final {
+ public:
+  /// @brief create a sphere of radius zero at the origin
+  GRAPHMATH_CONSTEXPR bounding_sphere();
+
+  /// @brief create a sphere
+  /// @param center the center
+  /// @param radius the radius, not negative
+  GRAPHMATH_CONSTEXPR bounding_sphere(const float3 &center, float radius);
+
+  /// @brief create the sphere around a box
+  /// @param box the box, not empty
+  explicit bounding_sphere(const aabb &box);
+
+  /// @brief Get the center
+  /// @returns the center
+  GRAPHMATH_CONSTEXPR float3 center() const;
+
+  /// @brief Get the radius
+  /// @returns the radius
+  GRAPHMATH_CONSTEXPR float radius() const;
+
+  /// @brief `(x, y, z)` of the center and the radius in `w`
+  float4 center_radius;
+};
+
+static_assert(std::is_trivially_copyable_v<bounding_sphere>,
+              "bounding_sphere must be trivially copyable");
+static_assert(sizeof(bounding_sphere) == sizeof(float4),
+              "bounding_sphere must be the size of float4");
+
+/// @brief Check if a sphere contains a point, boundary included
+/// @param sphere the sphere
+/// @param point the point
+/// @returns true if `point` is in `sphere`; false otherwise
+GRAPHMATH_CONSTEXPR bool contains(const bounding_sphere &sphere,
+                                  const float3 &point);
+
+/// @brief Check if two spheres overlap, touching included
+/// @param a a
+/// @param b b
+/// @returns true if `a` and `b` overlap; false otherwise
+GRAPHMATH_CONSTEXPR bool intersects(const bounding_sphere &a,
+                                    const bounding_sphere &b);
+
+/// @brief Grow a sphere to contain another
+/// @param a a
+/// @param b b
+/// @returns the smallest sphere containing `a` and `b`
+bounding_sphere merge(const bounding_sphere &a, const bounding_sphere &b);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+inline GRAPHMATH_CONSTEXPR bounding_sphere::bounding_sphere()
+    : center_radius{0.0f, 0.0f, 0.0f, 0.0f} {}
+
+inline GRAPHMATH_CONSTEXPR bounding_sphere::bounding_sphere(
+    const float3 &center, float radius)
+    : center_radius{center, radius} {}
+
+inline bounding_sphere::bounding_sphere(const aabb &box)
+    : center_radius{graphmath::center(box), length(half_extents(box))} {}
+
+inline GRAPHMATH_CONSTEXPR float3 bounding_sphere::center() const {
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float3{_mm_blend_ps(center_radius.native, _mm_setzero_ps(), 0x8)};
+  }
+#endif
+
+  return float3{center_radius.x(), center_radius.y(), center_radius.z()};
+}
+
+inline GRAPHMATH_CONSTEXPR float bounding_sphere::radius() const {
+  return center_radius.w();
+}
+
+inline GRAPHMATH_CONSTEXPR bool contains(const bounding_sphere &sphere,
+                                         const float3 &point) {
+  float3 offset = point - sphere.center();
+  return dot(offset, offset) <= sphere.radius() * sphere.radius();
+}
+
+inline GRAPHMATH_CONSTEXPR bool intersects(const bounding_sphere &a,
+                                           const bounding_sphere &b) {
+  float3 offset = b.center() - a.center();
+  float reach = a.radius() + b.radius();
+
+  return dot(offset, offset) <= reach * reach;
+}
+
+inline bounding_sphere merge(const bounding_sphere &a,
+                             const bounding_sphere &b) {
+  float3 offset = b.center() - a.center();
+  float distance = length(offset);
+
+  if (distance + b.radius() <= a.radius()) {
+    return a;
+  }
+
+  if (distance + a.radius() <= b.radius()) {
+    return b;
+  }
+
+  // the new sphere spans from the far side of `a` to the far side of `b`
+  float radius = 0.5f * (distance + a.radius() + b.radius());
+  float3 center = a.center() + offset * ((radius - a.radius()) / distance);
+
+  return bounding_sphere{center, radius};
+}
+}  // namespace graphmath
@@ -0,0 +1,843 @@
+//
+//  bvh.h
+//  CS 419
+//
+//  Bounding volume hierarchies of 4-wide nodes, built with the binned surface
+//  area heuristic
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "graphmath/aabb.h"
+#include "graphmath/aligned_allocator.h"
+#include "graphmath/backend.h"
+#include "graphmath/float3.h"
+#include "graphmath/ray.h"
+#include "graphmath/ray_aabb.h"
+#include "graphmath/span.h"
+
+// Declarations
+
+namespace graphmath {
+/// @brief a bounding volume hierarchy over primitives given by their boxes
+///
+/// Each node holds up to 4 children, with their boxes stored component by
+/// component so that a ray is tested against all 4 at once. A child is
+/// another node or a leaf of up to 4 primitives. The nodes are flat in one
+/// array, the root first, and the leaves are ranges of `primitives()`.
+/// `build` splits large ranges with the binned surface area heuristic,
+/// binning the largest ones on several threads, then builds the smaller
+/// subtrees in parallel
+class bvh final {
+ public:
+  /// @brief a node of up to 4 children
+  struct alignas(64) node final {
+    /// @brief the box of each child, empty for an unused child
+    aabb_packet<4> bounds;
+
+    /// @brief the index of a child node, or of the first primitive of a leaf
+    /// in `primitives()`
+    std::uint32_t children[4];
+
+    /// @brief the number of primitives of a leaf; `0` for a child node or an
+    /// unused child, whose box is empty
+    std::uint32_t counts[4];
+  };
+
+  /// @brief create an empty hierarchy
+  bvh() = default;
+
+  /// @brief Build the hierarchy of boxes, replacing the current one, on up
+  /// to `std::thread::hardware_concurrency()` threads
+  /// @param bounds the box of each primitive, fewer than `2^32`
+  void build(span<const aabb> bounds);
+
+  /// @brief Build the hierarchy of boxes, replacing the current one
+  /// @param bounds the box of each primitive, fewer than `2^32`
+  /// @param thread_count the maximum number of threads, including the
+  /// calling thread
+  void build(span<const aabb> bounds, size_t thread_count);
+
+  /// @brief Build the hierarchy of triangles, replacing the current one, on
+  /// up to `std::thread::hardware_concurrency()` threads
+  /// @param vertices 3 vertices per triangle
+  void build(span<const float3> vertices);
+
+  /// @brief Build the hierarchy of triangles, replacing the current one
+  /// @param vertices 3 vertices per triangle
+  /// @param thread_count the maximum number of threads, including the
+  /// calling thread
+  void build(span<const float3> vertices, size_t thread_count);
+
+  /// @brief Get the nodes
+  /// @returns the nodes, the root first; empty without primitives
+  span<const node> nodes() const;
+
+  /// @brief Get the primitives in leaf order
+  /// @returns the index of each primitive, leaves refer to ranges of it
+  span<const std::uint32_t> primitives() const;
+
+  /// @brief Find the closest primitive a ray hits
+  /// @param r the ray
+  /// @param t the farthest distance to look at; updated to the closest hit
+  /// @param intersect called as `bool intersect(size_t primitive, float
+  /// &t)`, returns true and updates `t` if the ray hits `primitive` closer
+  /// @returns the closest primitive hit, `no_hit` if none
+  template <typename Intersect>
+  size_t closest_hit(const ray &r, float &t, Intersect intersect) const;
+
+  /// @brief Find the closest triangle a ray hits
+  /// @param r the ray
+  /// @param vertices the vertices the hierarchy was built with
+  /// @param hit the hit; updated if the ray hits closer than `hit.t`
+  /// @returns the closest triangle hit, `no_hit` if none
+  size_t closest_hit(const ray &r, span<const float3> vertices,
+                     triangle_hit &hit) const;
+
+  /// @brief Check if a ray hits any primitive, stopping at the first found
+  /// @param r the ray
+  /// @param t the farthest distance to look at
+  /// @param intersect called as `bool intersect(size_t primitive, float t)`,
+  /// returns true if the ray hits `primitive` closer than `t`
+  /// @returns true if the ray hits a primitive closer than `t`
+  template <typename Intersect>
+  bool any_hit(const ray &r, float t, Intersect intersect) const;
+
+  /// @brief Check if a ray hits any triangle
+  /// @param r the ray
+  /// @param vertices the vertices the hierarchy was built with
+  /// @param t the farthest distance to look at
+  /// @returns true if the ray hits a triangle closer than `t`
+  bool any_hit(const ray &r, span<const float3> vertices,
+               float t = std::numeric_limits<float>::infinity()) const;
+
+ private:
+  std::vector<node, aligned_allocator<node>> nodes_;
+  std::vector<std::uint32_t> primitives_;
+};
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+namespace detail {
+/// @brief the number of bins per axis the surface area heuristic tries
+constexpr size_t bvh_bins = 16;
+
+/// @brief the largest number of primitives in a leaf
+constexpr size_t bvh_leaf_size = 4;
+
+/// @brief the smallest number of primitives per thread worth binning in
+/// parallel
+constexpr size_t bvh_parallel_size = 1 << 16;
+
+/// @brief the depth past which splits cut ranges in half, bounding the depth
+/// of the hierarchy whatever the primitives
+constexpr size_t bvh_median_depth = 48;
+
+/// @brief the capacity of the traversal stacks, enough for 3 entries per
+/// level of the deepest hierarchy `build` makes
+constexpr size_t bvh_stack_size = 256;
+
+/// @brief Get a component of a `float3` by index
+inline float component(const float3 &f3, size_t axis) {
+  return axis == 0 ? f3.x() : axis == 1 ? f3.y() : f3.z();
+}
+
+/// @brief Get half the surface area of a box
+inline float half_area(const aabb &box) {
+  float3 e = box.upper - box.lower;
+  return e.x() * e.y() + e.y() * e.z() + e.z() * e.x();
+}
+
+/// @brief Run `function(chunk, begin, end)` over `chunk_count` chunks of
+/// `[0, count)`, one per thread
+template <typename Function>
+void parallel_chunks(size_t count, size_t chunk_count, Function function) {
+  std::vector<std::thread> threads;
+  threads.reserve(chunk_count - 1);
+
+  for (size_t chunk = 1; chunk < chunk_count; chunk++) {
+    threads.emplace_back(function, chunk, count * chunk / chunk_count,
+                         count * (chunk + 1) / chunk_count);
+  }
+
+  function(0, 0, count / chunk_count);
+
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+}
+
+/// @brief a primitive being sorted into the hierarchy, with its box next to
+/// it so that binning and partitioning stream through memory
+struct bvh_primitive final {
+  aabb bounds;
+  std::uint32_t index;
+};
+
+/// @brief primitives `[begin, end)` with their boxes merged, and their
+/// centroids merged
+struct bvh_range final {
+  size_t size() const { return end - begin; }
+
+  size_t begin;
+  size_t end;
+  aabb bounds;
+  aabb centroids;
+};
+
+/// @brief maps the centroids of a range to bins on each axis, as many bins
+/// as primitives for small ranges
+struct bvh_binning final {
+  explicit bvh_binning(const bvh_range &range)
+      : lower(range.centroids.lower),
+        count(std::min(bvh_bins, range.size())),
+        last(static_cast<int>(count) - 1) {
+    float3 extent = range.centroids.upper - range.centroids.lower;
+    float scales[3];
+
+    // an axis without extent puts every centroid in bin `0`
+    for (size_t axis = 0; axis < 3; axis++) {
+      float e = component(extent, axis);
+      scales[axis] = e > 0.0f ? static_cast<float>(count) / e : 0.0f;
+    }
+
+    scale = float3{scales[0], scales[1], scales[2]};
+  }
+
+  /// @brief Get the bins of a centroid on the 3 axes
+  void index(const float3 &centroid, size_t (&bins)[3]) const {
+    float3 position = (centroid - lower) * scale;
+
+    // through `int`, which converts from `float` in one instruction
+    bins[0] = static_cast<size_t>(
+        std::min(static_cast<int>(position.x()), last));
+    bins[1] = static_cast<size_t>(
+        std::min(static_cast<int>(position.y()), last));
+    bins[2] = static_cast<size_t>(
+        std::min(static_cast<int>(position.z()), last));
+  }
+
+  /// @brief Get the bin of a centroid on one axis
+  size_t index(const float3 &centroid, size_t axis) const {
+    float position = (component(centroid, axis) - component(lower, axis)) *
+                     component(scale, axis);
+
+    return static_cast<size_t>(std::min(static_cast<int>(position), last));
+  }
+
+  float3 lower;
+  float3 scale;
+
+  /// @brief the number of bins, and the last bin
+  size_t count;
+  int last;
+};
+
+/// @brief the primitives falling in one bin of an axis
+struct bvh_bin final {
+  aabb bounds;
+  size_t count = 0;
+};
+
+/// @brief the bins of the 3 axes
+struct bvh_bins_xyz final {
+  void merge(const bvh_bins_xyz &other) {
+    for (size_t axis = 0; axis < 3; axis++) {
+      for (size_t i = 0; i < bvh_bins; i++) {
+        bvh_bin &bin = bins[axis][i];
+        const bvh_bin &other_bin = other.bins[axis][i];
+
+        bin.bounds = graphmath::merge(bin.bounds, other_bin.bounds);
+        bin.count += other_bin.count;
+      }
+    }
+  }
+
+  bvh_bin bins[3][bvh_bins];
+};
+
+/// @brief a subtree left for a thread: `range` becomes child `slot` of
+/// `parent`
+struct bvh_task final {
+  bvh_range range;
+  size_t depth;
+  size_t parent;
+  size_t slot;
+};
+
+/// @brief splits ranges of primitives and writes nodes
+class bvh_builder final {
+ public:
+  using node_vector = std::vector<bvh::node, aligned_allocator<bvh::node>>;
+
+  bvh_builder(bvh_primitive *primitives, size_t thread_count)
+      : primitives_(primitives),
+        thread_count_(thread_count) {}
+
+  /// @brief Build the subtree of `range` with its root at `nodes[root]`
+  /// Ranges of at most `task_size` primitives are left to `tasks` instead
+  void build(const bvh_range &range, size_t depth, node_vector &nodes,
+             size_t root, size_t task_size,
+             std::vector<bvh_task> &tasks) const {
+    struct pending {
+      bvh_range range;
+      size_t depth;
+      size_t node;
+    };
+
+    std::vector<pending> stack{pending{range, depth, root}};
+
+    while (!stack.empty()) {
+      pending current = stack.back();
+      stack.pop_back();
+
+      bvh_range children[4] = {current.range};
+      size_t child_count = split(children, current.depth);
+
+      for (size_t slot = 0; slot < child_count; slot++) {
+        const bvh_range &child = children[slot];
+        nodes[current.node].bounds.set(slot, child.bounds);
+
+        if (child.size() <= bvh_leaf_size) {
+          nodes[current.node].children[slot] =
+              static_cast<std::uint32_t>(child.begin);
+          nodes[current.node].counts[slot] =
+              static_cast<std::uint32_t>(child.size());
+        } else if (child.size() <= task_size) {
+          tasks.push_back(
+              bvh_task{child, current.depth + 1, current.node, slot});
+        } else {
+          nodes[current.node].children[slot] =
+              static_cast<std::uint32_t>(nodes.size());
+          stack.push_back(pending{child, current.depth + 1, nodes.size()});
+          nodes.push_back(empty_node());
+        }
+      }
+    }
+  }
+
+  /// @brief Get a node whose children are all unused
+  static bvh::node empty_node() {
+    bvh::node result;
+
+    for (size_t slot = 0; slot < 4; slot++) {
+      result.children[slot] = 0;
+      result.counts[slot] = 0;
+    }
+
+    return result;
+  }
+
+ private:
+  /// @brief Split `children[0]` into up to 4 ranges, always splitting the
+  /// range of the largest area until none is larger than a leaf
+  /// @returns the number of ranges
+  size_t split(bvh_range (&children)[4], size_t depth) const {
+    size_t count = 1;
+
+    while (count < 4) {
+      size_t largest = count;
+      float largest_area = -1.0f;
+
+      for (size_t i = 0; i < count; i++) {
+        float area = half_area(children[i].bounds);
+
+        if (children[i].size() > bvh_leaf_size && area > largest_area) {
+          largest = i;
+          largest_area = area;
+        }
+      }
+
+      if (largest == count) {
+        break;
+      }
+
+      std::pair<bvh_range, bvh_range> halves = split(children[largest], depth);
+      children[largest] = halves.first;
+      children[count++] = halves.second;
+    }
+
+    return count;
+  }
+
+  /// @brief Split a range in two with the surface area heuristic, or in
+  /// half when there is no better split
+  std::pair<bvh_range, bvh_range> split(const bvh_range &range,
+                                        size_t depth) const {
+    float3 extent = range.centroids.upper - range.centroids.lower;
+
+    if (depth < bvh_median_depth &&
+        (extent.x() > 0.0f || extent.y() > 0.0f || extent.z() > 0.0f)) {
+      bvh_binning binning{range};
+      bvh_bins_xyz binned = bin(range, binning);
+
+      size_t best_axis = 0;
+      size_t best_bin = bvh_bins;
+      float best_cost = std::numeric_limits<float>::infinity();
+
+      for (size_t axis = 0; axis < 3; axis++) {
+        const bvh_bin(&bins)[bvh_bins] = binned.bins[axis];
+
+        // the cost of every right side, then of every left side as the
+        // split moves right: `area * count` on both sides
+        float right_costs[bvh_bins];
+        aabb right;
+        size_t right_count = 0;
+
+        for (size_t i = binning.count; i-- > 1;) {
+          right = merge(right, bins[i].bounds);
+          right_count += bins[i].count;
+          right_costs[i] = right_count == 0
+                               ? std::numeric_limits<float>::infinity()
+                               : half_area(right) * right_count;
+        }
+
+        aabb left;
+        size_t left_count = 0;
+
+        for (size_t i = 0; i + 1 < binning.count; i++) {
+          left = merge(left, bins[i].bounds);
+          left_count += bins[i].count;
+
+          if (left_count == 0) {
+            continue;
+          }
+
+          float cost = half_area(left) * left_count + right_costs[i + 1];
+
+          if (cost < best_cost) {
+            best_axis = axis;
+            best_bin = i;
+            best_cost = cost;
+          }
+        }
+      }
+
+      if (best_bin != bvh_bins) {
+        return partition(range, binning, binned.bins[best_axis], best_axis,
+                         best_bin);
+      }
+    }
+
+    return split_half(range);
+  }
+
+  /// @brief Sort the primitives of a range into bins, on several threads
+  /// for large ranges
+  bvh_bins_xyz bin(const bvh_range &range, const bvh_binning &binning) const {
+    const auto bin_chunk = [&](size_t begin, size_t end, bvh_bins_xyz &out) {
+      for (size_t i = begin; i < end; i++) {
+        const aabb &bounds = primitives_[i].bounds;
+        float3 centroid = center(bounds);
+        size_t indices[3];
+
+        binning.index(centroid, indices);
+
+        for (size_t axis = 0; axis < 3; axis++) {
+          bvh_bin &bin = out.bins[axis][indices[axis]];
+
+          bin.bounds = merge(bin.bounds, bounds);
+          bin.count++;
+        }
+      }
+    };
+
+    size_t chunk_count =
+        std::min(thread_count_, range.size() / bvh_parallel_size);
+
+    if (chunk_count <= 1) {
+      bvh_bins_xyz result;
+      bin_chunk(range.begin, range.end, result);
+
+      return result;
+    }
+
+    std::vector<bvh_bins_xyz> chunks(chunk_count);
+
+    parallel_chunks(range.size(), chunk_count,
+                    [&](size_t chunk, size_t begin, size_t end) {
+                      bin_chunk(range.begin + begin, range.begin + end,
+                                chunks[chunk]);
+                    });
+
+    for (size_t chunk = 1; chunk < chunk_count; chunk++) {
+      chunks[0].merge(chunks[chunk]);
+    }
+
+    return chunks[0];
+  }
+
+  /// @brief Move the primitives in bins `[0, last]` of an axis before the
+  /// others, merging the centroids of each side on the way
+  std::pair<bvh_range, bvh_range> partition(
+      const bvh_range &range, const bvh_binning &binning,
+      const bvh_bin (&bins)[bvh_bins], size_t axis, size_t last) const {
+    aabb left_centroids;
+    aabb right_centroids;
+    size_t i = range.begin;
+    size_t j = range.end;
+
+    while (true) {
+      for (; i < j; i++) {
+        float3 centroid = center(primitives_[i].bounds);
+
+        if (binning.index(centroid, axis) > last) {
+          break;
+        }
+
+        left_centroids = merge(left_centroids, centroid);
+      }
+
+      for (; i < j; j--) {
+        float3 centroid = center(primitives_[j - 1].bounds);
+
+        if (binning.index(centroid, axis) <= last) {
+          break;
+        }
+
+        right_centroids = merge(right_centroids, centroid);
+      }
+
+      if (i == j) {
+        break;
+      }
+
+      std::swap(primitives_[i], primitives_[j - 1]);
+    }
+
+    bvh_range left{range.begin, i, aabb{}, left_centroids};
+    bvh_range right{i, range.end, aabb{}, right_centroids};
+
+    for (size_t bin = 0; bin < binning.count; bin++) {
+      bvh_range &side = bin <= last ? left : right;
+      side.bounds = merge(side.bounds, bins[bin].bounds);
+    }
+
+    return {left, right};
+  }
+
+  /// @brief Split a range in half along the largest extent of its centroids
+  std::pair<bvh_range, bvh_range> split_half(const bvh_range &range) const {
+    float3 extent = range.centroids.upper - range.centroids.lower;
+    size_t axis = extent.x() >= extent.y() && extent.x() >= extent.z() ? 0
+                  : extent.y() >= extent.z()                           ? 1
+                                                                       : 2;
+    size_t middle = range.begin + range.size() / 2;
+
+    std::nth_element(primitives_ + range.begin, primitives_ + middle,
+                     primitives_ + range.end,
+                     [&](const bvh_primitive &a, const bvh_primitive &b) {
+                       return component(center(a.bounds), axis) <
+                              component(center(b.bounds), axis);
+                     });
+
+    return {gather(range.begin, middle), gather(middle, range.end)};
+  }
+
+  /// @brief Get the range of primitives `[begin, end)`
+  bvh_range gather(size_t begin, size_t end) const {
+    bvh_range result{begin, end, aabb{}, aabb{}};
+
+    for (size_t i = begin; i < end; i++) {
+      const aabb &bounds = primitives_[i].bounds;
+
+      result.bounds = merge(result.bounds, bounds);
+      result.centroids = merge(result.centroids, center(bounds));
+    }
+
+    return result;
+  }
+
+  bvh_primitive *primitives_;
+  size_t thread_count_;
+};
+
+/// @brief a child on a traversal stack
+struct bvh_entry final {
+  std::uint32_t index;
+  std::uint32_t count;
+  float t_near;
+};
+}  // namespace detail
+
+inline void bvh::build(span<const aabb> bounds) {
+  build(bounds, std::max(std::thread::hardware_concurrency(), 1u));
+}
+
+inline void bvh::build(span<const aabb> bounds, size_t thread_count) {
+  assert(bounds.size() < (size_t{1} << 32));
+
+  const size_t count = bounds.size();
+  thread_count = std::max(thread_count, size_t{1});
+
+  nodes_.clear();
+  primitives_.resize(count);
+
+  if (count == 0) {
+    return;
+  }
+
+  // the root range, in chunks of at least `bvh_parallel_size`
+  std::vector<detail::bvh_primitive> sorted(count);
+  size_t chunk_count = std::max(
+      size_t{1}, std::min(thread_count, count / detail::bvh_parallel_size));
+  std::vector<detail::bvh_range> chunks(chunk_count);
+
+  detail::parallel_chunks(
+      count, chunk_count, [&](size_t chunk, size_t begin, size_t end) {
+        detail::bvh_range &range = chunks[chunk];
+        range = detail::bvh_range{begin, end, aabb{}, aabb{}};
+
+        for (size_t i = begin; i < end; i++) {
+          sorted[i] = detail::bvh_primitive{bounds[i],
+                                            static_cast<std::uint32_t>(i)};
+          range.bounds = merge(range.bounds, bounds[i]);
+          range.centroids = merge(range.centroids, center(bounds[i]));
+        }
+      });
+
+  detail::bvh_range root{0, count, aabb{}, aabb{}};
+
+  for (const detail::bvh_range &chunk : chunks) {
+    root.bounds = merge(root.bounds, chunk.bounds);
+    root.centroids = merge(root.centroids, chunk.centroids);
+  }
+
+  detail::bvh_builder builder{sorted.data(), thread_count};
+
+  // the large ranges split first, with parallel binning, and leave enough
+  // subtrees to keep every thread busy
+  size_t task_size = thread_count > 1 ? count / (thread_count * 16) : 0;
+  std::vector<detail::bvh_task> tasks;
+
+  nodes_.push_back(detail::bvh_builder::empty_node());
+  builder.build(root, 0, nodes_, 0, task_size, tasks);
+
+  std::vector<detail::bvh_builder::node_vector> subtrees(tasks.size());
+  std::atomic<size_t> next_task{0};
+
+  const auto work = [&]() {
+    std::vector<detail::bvh_task> no_tasks;
+
+    for (size_t task = next_task++; task < tasks.size(); task = next_task++) {
+      subtrees[task].push_back(detail::bvh_builder::empty_node());
+      builder.build(tasks[task].range, tasks[task].depth, subtrees[task], 0, 0,
+                    no_tasks);
+    }
+  };
+
+  size_t worker_count = std::min(thread_count, tasks.size());
+  std::vector<std::thread> threads;
+
+  for (size_t i = 1; i < worker_count; i++) {
+    threads.emplace_back(work);
+  }
+
+  work();
+
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  // each subtree moves after the others, so its child nodes move by the
+  // same offset; the root of a subtree is never a child, so `0` only marks
+  // leaves and unused children
+  for (size_t task = 0; task < tasks.size(); task++) {
+    auto offset = static_cast<std::uint32_t>(nodes_.size());
+
+    nodes_[tasks[task].parent].children[tasks[task].slot] = offset;
+
+    for (node n : subtrees[task]) {
+      for (size_t slot = 0; slot < 4; slot++) {
+        if (n.counts[slot] == 0 && n.children[slot] != 0) {
+          n.children[slot] += offset;
+        }
+      }
+
+      nodes_.push_back(n);
+    }
+  }
+
+  detail::parallel_chunks(count, chunk_count,
+                          [&](size_t, size_t begin, size_t end) {
+                            for (size_t i = begin; i < end; i++) {
+                              primitives_[i] = sorted[i].index;
+                            }
+                          });
+}
+
+inline void bvh::build(span<const float3> vertices) {
+  build(vertices, std::max(std::thread::hardware_concurrency(), 1u));
+}
+
+inline void bvh::build(span<const float3> vertices, size_t thread_count) {
+  assert(vertices.size() % 3 == 0);
+
+  const size_t count = vertices.size() / 3;
+  std::vector<aabb> bounds(count);
+
+  size_t chunk_count = std::max(
+      size_t{1}, std::min(thread_count, count / detail::bvh_parallel_size));
+
+  detail::parallel_chunks(count, chunk_count,
+                          [&](size_t, size_t begin, size_t end) {
+                            for (size_t i = begin; i < end; i++) {
+                              aabb box = merge(aabb{}, vertices[3 * i]);
+                              box = merge(box, vertices[3 * i + 1]);
+                              bounds[i] = merge(box, vertices[3 * i + 2]);
+                            }
+                          });
+
+  build(bounds, thread_count);
+}
+
+inline span<const bvh::node> bvh::nodes() const {
+  return span<const node>{nodes_.data(), nodes_.size()};
+}
+
+inline span<const std::uint32_t> bvh::primitives() const {
+  return span<const std::uint32_t>{primitives_.data(), primitives_.size()};
+}
+
+template <typename Intersect>
+size_t bvh::closest_hit(const ray &r, float &t, Intersect intersect) const {
+  if (nodes_.empty()) {
+    return no_hit;
+  }
+
+  inverse_ray prepared{r};
+  detail::bvh_entry stack[detail::bvh_stack_size];
+  size_t stack_size = 0;
+  size_t closest = no_hit;
+
+  stack[stack_size++] = detail::bvh_entry{0, 0, 0.0f};
+
+  while (stack_size != 0) {
+    detail::bvh_entry entry = stack[--stack_size];
+
+    // a closer hit was found since the child was pushed
+    if (entry.t_near > t) {
+      continue;
+    }
+
+    if (entry.count != 0) {
+      for (size_t i = entry.index; i < entry.index + entry.count; i++) {
+        if (intersect(static_cast<size_t>(primitives_[i]), t)) {
+          closest = primitives_[i];
+        }
+      }
+
+      continue;
+    }
+
+    const node &n = nodes_[entry.index];
+    float t_near[4];
+    unsigned mask = ray_aabb_intersect(prepared, n.bounds, t, t_near);
+
+    // the children hit, farthest first, so the nearest is popped first
+    detail::bvh_entry hits[4];
+    size_t hit_count = 0;
+
+    for (size_t slot = 0; slot < 4; slot++) {
+      if ((mask >> slot & 1) == 0) {
+        continue;
+      }
+
+      detail::bvh_entry child{n.children[slot], n.counts[slot], t_near[slot]};
+      size_t i = hit_count++;
+
+      for (; i > 0 && hits[i - 1].t_near < child.t_near; i--) {
+        hits[i] = hits[i - 1];
+      }
+
+      hits[i] = child;
+    }
+
+    assert(stack_size + hit_count <= detail::bvh_stack_size);
+
+    for (size_t i = 0; i < hit_count; i++) {
+      stack[stack_size++] = hits[i];
+    }
+  }
+
+  return closest;
+}
+
+inline size_t bvh::closest_hit(const ray &r, span<const float3> vertices,
+                               triangle_hit &hit) const {
+  float t = hit.t;
+
+  return closest_hit(r, t, [&](size_t triangle, float &t_max) {
+    if (!intersect(r, vertices[3 * triangle], vertices[3 * triangle + 1],
+                   vertices[3 * triangle + 2], hit)) {
+      return false;
+    }
+
+    t_max = hit.t;
+    return true;
+  });
+}
+
+template <typename Intersect>
+bool bvh::any_hit(const ray &r, float t, Intersect intersect) const {
+  if (nodes_.empty()) {
+    return false;
+  }
+
+  inverse_ray prepared{r};
+  detail::bvh_entry stack[detail::bvh_stack_size];
+  size_t stack_size = 0;
+
+  stack[stack_size++] = detail::bvh_entry{0, 0, 0.0f};
+
+  while (stack_size != 0) {
+    detail::bvh_entry entry = stack[--stack_size];
+
+    if (entry.count != 0) {
+      for (size_t i = entry.index; i < entry.index + entry.count; i++) {
+        if (intersect(static_cast<size_t>(primitives_[i]), t)) {
+          return true;
+        }
+      }
+
+      continue;
+    }
+
+    const node &n = nodes_[entry.index];
+    float t_near[4];
+    unsigned mask = ray_aabb_intersect(prepared, n.bounds, t, t_near);
+
+    for (size_t slot = 0; slot < 4; slot++) {
+      if ((mask >> slot & 1) != 0) {
+        assert(stack_size < detail::bvh_stack_size);
+        stack[stack_size++] =
+            detail::bvh_entry{n.children[slot], n.counts[slot], t_near[slot]};
+      }
+    }
+  }
+
+  return false;
+}
+
+inline bool bvh::any_hit(const ray &r, span<const float3> vertices,
+                         float t) const {
+  return any_hit(r, t, [&](size_t triangle, float t_max) {
+    triangle_hit hit;
+    hit.t = t_max;
+
+    return intersect(r, vertices[3 * triangle], vertices[3 * triangle + 1],
+                     vertices[3 * triangle + 2], hit);
+  });
+}
+}  // namespace graphmath
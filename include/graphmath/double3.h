@@ -0,0 +1,461 @@
+//
+//  double3.h
+//  CS 419
+//
+//  Three `double` numbers, for coordinates of large worlds
+//
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "graphmath/backend.h"
+#include "graphmath/float3.h"
+#include "graphmath/vec.h"
+
+#if defined(GRAPHMATH_BACKEND_APPLE)
+#include <simd/simd.h>
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+#include "graphmath/avx.h"
+#else
+#include <array>
+#endif
+
+// Declarations
+
+namespace graphmath {
+/// @brief three `float64` numbers `(x, y, z)`
+/// `float` runs out of precision a few kilometres from the origin; positions
+/// of large worlds are kept as `double3` and turned into `float3` relative
+/// to the camera with `relative`
+template <>
+struct vec<double, 3> final {
+ public:
+  /// @brief the type of the numbers
+  using value_type = double;
+
+  /// @brief the number of numbers
+  static constexpr size_t size = 3;
+
+  /// @brief the native `double3` type
+  /// `simd::double3` on Apple Platform, `__m256d` (with `w` kept at zero) on
+  /// the AVX2 backend, and an array elsewhere
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  using native_double3 = simd::double3;
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  using native_double3 = __m256d;
+#else
+  using native_double3 = std::array<double, 3>;
+#endif
+
+  /// @brief create a `double3` of zeroes
+  GRAPHMATH_CONSTEXPR vec();
+
+  /// @brief create a `double3` with values
+  /// @param x x
+  /// @param y y
+  /// @param z z
+  GRAPHMATH_CONSTEXPR vec(double x, double y, double z);
+
+  /// @brief copy constructor
+  /// @param other another `double3`
+  vec(const double3 &other) = default;
+
+  /// @brief create a `double3` with `native_double3`
+  /// @param native the native `double3` instance
+  GRAPHMATH_CONSTEXPR vec(const native_double3 &native);
+
+  /// @brief create a `double3` from a `float3`, which is exact
+  /// @param f3 the `float3`
+  GRAPHMATH_CONSTEXPR explicit vec(const float3 &f3);
+
+  /// @brief Get `x` of `double3`
+  /// @returns the `x` value of `double3`
+  GRAPHMATH_CONSTEXPR double x() const;
+
+  /// @brief Get `y` of `double3`
+  /// @returns the `y` value of `double3`
+  GRAPHMATH_CONSTEXPR double y() const;
+
+  /// @brief Get `z` of `double3`
+  /// @returns the `z` value of `double3`
+  GRAPHMATH_CONSTEXPR double z() const;
+
+  /// @brief Round to the nearest `float3`
+  /// @returns the `float3`
+  GRAPHMATH_CONSTEXPR float3 to_float3() const;
+
+  /// @brief Add one `a` to `b` from another
+  /// @param rhs `b`
+  /// @returns the result
+  GRAPHMATH_CONSTEXPR double3 operator+(const double3 &rhs) const;
+
+  /// @brief Subtract one `a` from `b` from another
+  /// @param rhs `b`
+  /// @returns the result
+  GRAPHMATH_CONSTEXPR double3 operator-(const double3 &rhs) const;
+
+  /// @brief Multiply all values of `double3` by a multiplier
+  /// @param rhs the multiplier
+  /// @returns the multiplied `double3`
+  GRAPHMATH_CONSTEXPR double3 operator*(double rhs) const;
+
+  /// @brief Component-wise multiply `a`, `b`
+  /// @param rhs `b`
+  /// @returns the result
+  GRAPHMATH_CONSTEXPR double3 operator*(const double3 &rhs) const;
+
+  /// @brief Divide all values of `double3` by a divisor
+  /// @param rhs the divisor
+  /// @returns the divided `double3`
+  GRAPHMATH_CONSTEXPR double3 operator/(double rhs) const;
+
+  /// @brief Compare `this` with another `double3`
+  /// @param rhs the other `double3`
+  /// @returns true if equal; false otherwise
+  GRAPHMATH_CONSTEXPR bool operator==(const double3 &rhs) const;
+
+  /// @brief Compare `this` with another `double3`
+  /// @param rhs the other `double3`
+  /// @returns false if equal; true otherwise
+  GRAPHMATH_CONSTEXPR bool operator!=(const double3 &rhs) const;
+
+  native_double3 native;
+};
+
+static_assert(std::is_trivially_copyable_v<double3>,
+              "double3 must be trivially copyable");
+static_assert(std::is_standard_layout_v<double3>,
+              "double3 must be standard layout");
+static_assert(sizeof(double3) == sizeof(double3::native_double3),
+              "double3 must be the size of its native type");
+static_assert(alignof(double3) == alignof(double3::native_double3),
+              "double3 must be aligned like its native type");
+
+/// @brief Compute the dot product of two `double3`
+/// @param a one `double3`
+/// @param b one `double3`
+/// @returns the resulting number
+GRAPHMATH_CONSTEXPR double dot(const double3 &a, const double3 &b);
+
+/// @brief Compute the cross product of two `double3`
+/// @param a one `double3`
+/// @param b one `double3`
+/// @returns the result `double3`
+GRAPHMATH_CONSTEXPR double3 cross(const double3 &a, const double3 &b);
+
+/// @brief Compute `a * b + c` component-wise, fused into one instruction on
+/// the AVX2 backend
+/// @param a a
+/// @param b b
+/// @param c c
+/// @returns the result
+GRAPHMATH_CONSTEXPR double3 madd(const double3 &a, const double3 &b,
+                                 const double3 &c);
+
+/// @brief Get the length of a `double3`
+/// @param d3 the `double3`
+/// @returns the length
+double length(const double3 &d3);
+
+/// @brief Get a normalized version of `double3`
+/// @param d3 the `double3` to normalize
+/// @returns the normalized `double3`
+double3 normalize(const double3 &d3);
+
+/// @brief Get a position relative to an origin, such as the camera
+/// The difference is taken in `double` and only then rounded, so that it is
+/// as precise as a `float3` near the origin of the world
+/// @param position the position
+/// @param origin the origin
+/// @returns `position - origin` as a `float3`
+GRAPHMATH_CONSTEXPR float3 relative(const double3 &position,
+                                    const double3 &origin);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+inline GRAPHMATH_CONSTEXPR double3::vec()
+#if defined(GRAPHMATH_BACKEND_APPLE)
+    : native{simd::make_double3(0, 0, 0)} {
+}
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+    : native{__m256d{0.0, 0.0, 0.0, 0.0}} {
+}
+#else
+    : native{{0, 0, 0}} {
+}
+#endif
+
+inline GRAPHMATH_CONSTEXPR double3::vec(double x, double y, double z)
+#if defined(GRAPHMATH_BACKEND_APPLE)
+    : native{simd::make_double3(x, y, z)} {
+}
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+    : native{__m256d{x, y, z, 0.0}} {
+}
+#else
+    : native{{x, y, z}} {
+}
+#endif
+
+inline GRAPHMATH_CONSTEXPR double3::vec(const native_double3 &values)
+    : native(values) {}
+
+namespace detail {
+/// @brief Widen a `float3` to the native type of `double3`
+inline GRAPHMATH_CONSTEXPR double3::native_double3 widen(const float3 &f3) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd_double(f3.native);
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!is_constant_evaluated()) {
+    return _mm256_cvtps_pd(f3.native);
+  }
+#endif
+
+  return double3{f3.x(), f3.y(), f3.z()}.native;
+#endif
+}
+}  // namespace detail
+
+inline GRAPHMATH_CONSTEXPR double3::vec(const float3 &f3)
+    : native(detail::widen(f3)) {}
+
+inline GRAPHMATH_CONSTEXPR double double3::x() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.x;
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  if (detail::is_constant_evaluated()) {
+    return avx::lane<0>(native);
+  }
+
+  return _mm256_cvtsd_f64(native);
+#else
+  return native[0];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR double double3::y() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.y;
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  if (detail::is_constant_evaluated()) {
+    return avx::lane<1>(native);
+  }
+
+  return _mm_cvtsd_f64(
+      _mm_unpackhi_pd(_mm256_castpd256_pd128(native),
+                      _mm256_castpd256_pd128(native)));
+#else
+  return native[1];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR double double3::z() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.z;
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  if (detail::is_constant_evaluated()) {
+    return avx::lane<2>(native);
+  }
+
+  return _mm_cvtsd_f64(_mm256_extractf128_pd(native, 1));
+#else
+  return native[2];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float3 double3::to_float3() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float3{simd_float(native)};
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    return float3{_mm256_cvtpd_ps(native)};
+  }
+#endif
+
+  return float3{static_cast<float>(x()), static_cast<float>(y()),
+                static_cast<float>(z())};
+#endif
+}
+
+// Below, the AVX2 backend returns early unless it is evaluated at compile
+// time, in which case it shares the lane-wise code of the other backends
+
+inline GRAPHMATH_CONSTEXPR double3
+double3::operator+(const double3 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native + rhs.native;
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    return double3{_mm256_add_pd(native, rhs.native)};
+  }
+#endif
+
+  return double3{x() + rhs.x(), y() + rhs.y(), z() + rhs.z()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR double3
+double3::operator-(const double3 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native - rhs.native;
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    return double3{_mm256_sub_pd(native, rhs.native)};
+  }
+#endif
+
+  return double3{x() - rhs.x(), y() - rhs.y(), z() - rhs.z()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR double3 double3::operator*(double rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native * rhs;
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    // multiply `w` by zero so that it stays zero even when `rhs` is infinite
+    return double3{_mm256_mul_pd(native, _mm256_set_pd(0, rhs, rhs, rhs))};
+  }
+#endif
+
+  return double3{x() * rhs, y() * rhs, z() * rhs};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR double3
+double3::operator*(const double3 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native * rhs.native;
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    return double3{_mm256_mul_pd(native, rhs.native)};
+  }
+#endif
+
+  return double3{x() * rhs.x(), y() * rhs.y(), z() * rhs.z()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR double3 double3::operator/(double rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native / rhs;
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    // divide `w` by one so that it stays zero even when `rhs` is zero
+    return double3{_mm256_div_pd(native, _mm256_set_pd(1, rhs, rhs, rhs))};
+  }
+#endif
+
+  return double3{x() / rhs, y() / rhs, z() / rhs};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool double3::operator==(
+    const double3 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd::equal(native, rhs.native);
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    __m256d equal = _mm256_cmp_pd(native, rhs.native, _CMP_EQ_OQ);
+    return (_mm256_movemask_pd(equal) & 0x7) == 0x7;
+  }
+#endif
+
+  return x() == rhs.x() && y() == rhs.y() && z() == rhs.z();
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool double3::operator!=(
+    const double3 &rhs) const {
+  return !(*this == rhs);
+}
+
+inline GRAPHMATH_CONSTEXPR double dot(const double3 &a, const double3 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd::dot(a.native, b.native);
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    // `w` is zero in both
+    return avx::sum(_mm256_mul_pd(a.native, b.native));
+  }
+#endif
+
+  return a.x() * b.x() + a.y() * b.y() + a.z() * b.z();
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR double3 cross(const double3 &a,
+                                         const double3 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return double3{simd::cross(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    __m256d a_yzx = avx::swizzle<1, 2, 0, 3>(a.native);
+    __m256d b_yzx = avx::swizzle<1, 2, 0, 3>(b.native);
+    __m256d c_zxy = _mm256_sub_pd(_mm256_mul_pd(a.native, b_yzx),
+                                  _mm256_mul_pd(a_yzx, b.native));
+
+    return double3{avx::swizzle<1, 2, 0, 3>(c_zxy)};
+  }
+#endif
+
+  return double3{a.y() * b.z() - a.z() * b.y(),
+                 a.z() * b.x() - a.x() * b.z(),
+                 a.x() * b.y() - a.y() * b.x()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR double3 madd(const double3 &a, const double3 &b,
+                                        const double3 &c) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return double3{simd::fma(a.native, b.native, c.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    return double3{avx::madd(a.native, b.native, c.native)};
+  }
+#endif
+
+  return double3{a.x() * b.x() + c.x(), a.y() * b.y() + c.y(),
+                 a.z() * b.z() + c.z()};
+#endif
+}
+
+inline double length(const double3 &d3) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd::length(d3.native);
+#else
+  return std::sqrt(dot(d3, d3));
+#endif
+}
+
+inline double3 normalize(const double3 &d3) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return double3{simd::normalize(d3.native)};
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  __m256d length = _mm256_sqrt_pd(_mm256_set1_pd(dot(d3, d3)));
+  return double3{_mm256_div_pd(d3.native, length)};
+#else
+  return d3 / length(d3);
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float3 relative(const double3 &position,
+                                           const double3 &origin) {
+  return (position - origin).to_float3();
+}
+}  // namespace graphmath
@@ -0,0 +1,437 @@
+//
+//  double4.h
+//  CS 419
+//
+//  Four `double` numbers, for coordinates of large worlds
+//
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "graphmath/backend.h"
+#include "graphmath/double3.h"
+#include "graphmath/float4.h"
+#include "graphmath/vec.h"
+
+#if defined(GRAPHMATH_BACKEND_APPLE)
+#include <simd/simd.h>
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+#include "graphmath/avx.h"
+#else
+#include <array>
+#endif
+
+// Declarations
+
+namespace graphmath {
+/// @brief four `float64` numbers `(x, y, z, w)`
+template <>
+struct vec<double, 4> final {
+ public:
+  /// @brief the type of the numbers
+  using value_type = double;
+
+  /// @brief the number of numbers
+  static constexpr size_t size = 4;
+
+  /// @brief the native `double4` type
+  /// `simd::double4` on Apple Platform, `__m256d` on the AVX2 backend, and an
+  /// array elsewhere
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  using native_double4 = simd::double4;
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  using native_double4 = __m256d;
+#else
+  using native_double4 = std::array<double, 4>;
+#endif
+
+  /// @brief create a `double4` of zeroes
+  GRAPHMATH_CONSTEXPR vec();
+
+  /// @brief create a `double4` with values
+  /// @param x x
+  /// @param y y
+  /// @param z z
+  /// @param w w
+  GRAPHMATH_CONSTEXPR vec(double x, double y, double z, double w);
+
+  /// @brief create a `double4` from a `double3`
+  /// @param d3 `x`, `y` and `z`
+  /// @param w w
+  GRAPHMATH_CONSTEXPR vec(const double3 &d3, double w = 1.0);
+
+  /// @brief copy constructor
+  /// @param other another `double4`
+  vec(const double4 &other) = default;
+
+  /// @brief create a `double4` with `native_double4`
+  /// @param values the native `double4` instance
+  GRAPHMATH_CONSTEXPR vec(const native_double4 &values);
+
+  /// @brief create a `double4` from a `float4`, which is exact
+  /// @param f4 the `float4`
+  GRAPHMATH_CONSTEXPR explicit vec(const float4 &f4);
+
+  /// @brief Get `x` of `double4`
+  /// @returns the `x` value of `double4`
+  GRAPHMATH_CONSTEXPR double x() const;
+
+  /// @brief Get `y` of `double4`
+  /// @returns the `y` value of `double4`
+  GRAPHMATH_CONSTEXPR double y() const;
+
+  /// @brief Get `z` of `double4`
+  /// @returns the `z` value of `double4`
+  GRAPHMATH_CONSTEXPR double z() const;
+
+  /// @brief Get `w` of `double4`
+  /// @returns the `w` value of `double4`
+  GRAPHMATH_CONSTEXPR double w() const;
+
+  /// @brief Round to the nearest `float4`
+  /// @returns the `float4`
+  GRAPHMATH_CONSTEXPR float4 to_float4() const;
+
+  /// @brief Add one `a` to `b` from another
+  /// @param rhs `b`
+  /// @returns the result
+  GRAPHMATH_CONSTEXPR double4 operator+(const double4 &rhs) const;
+
+  /// @brief Subtract one `a` from `b` from another
+  /// @param rhs `b`
+  /// @returns the result
+  GRAPHMATH_CONSTEXPR double4 operator-(const double4 &rhs) const;
+
+  /// @brief Multiply all values of `double4` by a multiplier
+  /// @param rhs the multiplier
+  /// @returns the multiplied `double4`
+  GRAPHMATH_CONSTEXPR double4 operator*(double rhs) const;
+
+  /// @brief Component-wise multiply `a`, `b`
+  /// @param rhs `b`
+  /// @returns the result
+  GRAPHMATH_CONSTEXPR double4 operator*(const double4 &rhs) const;
+
+  /// @brief Compare `this` with another `double4`
+  /// @param rhs the other `double4`
+  /// @returns true if equal; false otherwise
+  GRAPHMATH_CONSTEXPR bool operator==(const double4 &rhs) const;
+
+  /// @brief Compare `this` with another `double4`
+  /// @param rhs the other `double4`
+  /// @returns false if equal; true otherwise
+  GRAPHMATH_CONSTEXPR bool operator!=(const double4 &rhs) const;
+
+  native_double4 native;
+};
+
+static_assert(std::is_trivially_copyable_v<double4>,
+              "double4 must be trivially copyable");
+static_assert(std::is_standard_layout_v<double4>,
+              "double4 must be standard layout");
+static_assert(sizeof(double4) == sizeof(double4::native_double4),
+              "double4 must be the size of its native type");
+static_assert(alignof(double4) == alignof(double4::native_double4),
+              "double4 must be aligned like its native type");
+
+/// @brief Compute the dot product of two `double4`
+/// @param a one `double4`
+/// @param b one `double4`
+/// @returns the resulting number
+GRAPHMATH_CONSTEXPR double dot(const double4 &a, const double4 &b);
+
+/// @brief Compute `a * b + c` component-wise, fused into one instruction on
+/// the AVX2 backend
+/// @param a a
+/// @param b b
+/// @param c c
+/// @returns the result
+GRAPHMATH_CONSTEXPR double4 madd(const double4 &a, const double4 &b,
+                                 const double4 &c);
+
+/// @brief Get the magnitude of `double4`
+/// @param d4 the `double4`
+/// @returns the magnitude
+double length(const double4 &d4);
+
+/// @brief Get a normalized version of `double4`
+/// @param d4 the `double4` to normalize
+/// @returns the normalized `double4`
+double4 normalize(const double4 &d4);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+inline GRAPHMATH_CONSTEXPR double4::vec()
+#if defined(GRAPHMATH_BACKEND_APPLE)
+    : native{simd::make_double4(0, 0, 0, 0)} {
+}
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+    : native{__m256d{0.0, 0.0, 0.0, 0.0}} {
+}
+#else
+    : native{{0, 0, 0, 0}} {
+}
+#endif
+
+inline GRAPHMATH_CONSTEXPR double4::vec(double x, double y, double z,
+                                        double w)
+#if defined(GRAPHMATH_BACKEND_APPLE)
+    : native{simd::make_double4(x, y, z, w)} {
+}
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+    : native{__m256d{x, y, z, w}} {
+}
+#else
+    : native{{x, y, z, w}} {
+}
+#endif
+
+inline GRAPHMATH_CONSTEXPR double4::vec(const double3 &d3, double w)
+#if defined(GRAPHMATH_BACKEND_APPLE)
+    : native{simd::make_double4(d3.native, w)} {
+}
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+    // 0x8: take lane 3 from the broadcast `w`
+    : native{detail::is_constant_evaluated()
+                 ? __m256d{d3.x(), d3.y(), d3.z(), w}
+                 : _mm256_blend_pd(d3.native, _mm256_set1_pd(w), 0x8)} {
+}
+#else
+    : vec(d3.x(), d3.y(), d3.z(), w) {
+}
+#endif
+
+inline GRAPHMATH_CONSTEXPR double4::vec(const native_double4 &values)
+    : native(values) {}
+
+namespace detail {
+/// @brief Widen a `float4` to the native type of `double4`
+inline GRAPHMATH_CONSTEXPR double4::native_double4 widen(const float4 &f4) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd_double(f4.native);
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!is_constant_evaluated()) {
+    return _mm256_cvtps_pd(f4.native);
+  }
+#endif
+
+  return double4{f4.x(), f4.y(), f4.z(), f4.w()}.native;
+#endif
+}
+}  // namespace detail
+
+inline GRAPHMATH_CONSTEXPR double4::vec(const float4 &f4)
+    : native(detail::widen(f4)) {}
+
+inline GRAPHMATH_CONSTEXPR double double4::x() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.x;
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  if (detail::is_constant_evaluated()) {
+    return avx::lane<0>(native);
+  }
+
+  return _mm256_cvtsd_f64(native);
+#else
+  return native[0];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR double double4::y() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.y;
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  if (detail::is_constant_evaluated()) {
+    return avx::lane<1>(native);
+  }
+
+  return _mm_cvtsd_f64(
+      _mm_unpackhi_pd(_mm256_castpd256_pd128(native),
+                      _mm256_castpd256_pd128(native)));
+#else
+  return native[1];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR double double4::z() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.z;
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  if (detail::is_constant_evaluated()) {
+    return avx::lane<2>(native);
+  }
+
+  return _mm_cvtsd_f64(_mm256_extractf128_pd(native, 1));
+#else
+  return native[2];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR double double4::w() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.w;
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  if (detail::is_constant_evaluated()) {
+    return avx::lane<3>(native);
+  }
+
+  __m128d high = _mm256_extractf128_pd(native, 1);
+  return _mm_cvtsd_f64(_mm_unpackhi_pd(high, high));
+#else
+  return native[3];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float4 double4::to_float4() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float4{simd_float(native)};
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    return float4{_mm256_cvtpd_ps(native)};
+  }
+#endif
+
+  return float4{static_cast<float>(x()), static_cast<float>(y()),
+                static_cast<float>(z()), static_cast<float>(w())};
+#endif
+}
+
+// Below, the AVX2 backend returns early unless it is evaluated at compile
+// time, in which case it shares the lane-wise code of the other backends
+
+inline GRAPHMATH_CONSTEXPR double4
+double4::operator+(const double4 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native + rhs.native;
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    return double4{_mm256_add_pd(native, rhs.native)};
+  }
+#endif
+
+  return double4{x() + rhs.x(), y() + rhs.y(), z() + rhs.z(), w() + rhs.w()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR double4
+double4::operator-(const double4 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native - rhs.native;
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    return double4{_mm256_sub_pd(native, rhs.native)};
+  }
+#endif
+
+  return double4{x() - rhs.x(), y() - rhs.y(), z() - rhs.z(), w() - rhs.w()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR double4 double4::operator*(double rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native * rhs;
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    return double4{_mm256_mul_pd(native, _mm256_set1_pd(rhs))};
+  }
+#endif
+
+  return double4{x() * rhs, y() * rhs, z() * rhs, w() * rhs};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR double4
+double4::operator*(const double4 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native * rhs.native;
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    return double4{_mm256_mul_pd(native, rhs.native)};
+  }
+#endif
+
+  return double4{x() * rhs.x(), y() * rhs.y(), z() * rhs.z(), w() * rhs.w()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool double4::operator==(
+    const double4 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd::equal(native, rhs.native);
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    __m256d equal = _mm256_cmp_pd(native, rhs.native, _CMP_EQ_OQ);
+    return _mm256_movemask_pd(equal) == 0xF;
+  }
+#endif
+
+  return x() == rhs.x() && y() == rhs.y() && z() == rhs.z() &&
+         w() == rhs.w();
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool double4::operator!=(
+    const double4 &rhs) const {
+  return !(*this == rhs);
+}
+
+inline GRAPHMATH_CONSTEXPR double dot(const double4 &a, const double4 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd::dot(a.native, b.native);
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    return avx::sum(_mm256_mul_pd(a.native, b.native));
+  }
+#endif
+
+  return a.x() * b.x() + a.y() * b.y() + a.z() * b.z() + a.w() * b.w();
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR double4 madd(const double4 &a, const double4 &b,
+                                        const double4 &c) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return double4{simd::fma(a.native, b.native, c.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    return double4{avx::madd(a.native, b.native, c.native)};
+  }
+#endif
+
+  return double4{a.x() * b.x() + c.x(), a.y() * b.y() + c.y(),
+                 a.z() * b.z() + c.z(), a.w() * b.w() + c.w()};
+#endif
+}
+
+inline double length(const double4 &d4) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd::length(d4.native);
+#else
+  return std::sqrt(dot(d4, d4));
+#endif
+}
+
+inline double4 normalize(const double4 &d4) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return double4{simd::normalize(d4.native)};
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  __m256d length = _mm256_sqrt_pd(_mm256_set1_pd(dot(d4, d4)));
+  return double4{_mm256_div_pd(d4.native, length)};
+#else
+  return d4 * (1.0 / length(d4));
+#endif
+}
+}  // namespace graphmath
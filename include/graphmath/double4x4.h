@@ -0,0 +1,372 @@
+//
+//  double4x4.h
+//  CS 419
+//
+//  A 4x4 `double` matrix, for transforms of large worlds
+//
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#include "graphmath/backend.h"
+#include "graphmath/double3.h"
+#include "graphmath/double4.h"
+#include "graphmath/float4x4.h"
+#include "graphmath/vec.h"
+
+#if defined(GRAPHMATH_BACKEND_APPLE)
+#include <simd/simd.h>
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+#include "graphmath/avx.h"
+#else
+#include <array>
+#endif
+
+// Declarations
+
+namespace graphmath {
+/// @brief a 4x4 `float64` matrix
+/// World transforms are composed in `double`, then made relative to the
+/// camera and rounded to a `float4x4` with `relative`
+template <>
+struct mat<double, 4, 4> final {
+ public:
+  /// @brief the type of the numbers
+  using value_type = double;
+
+  /// @brief the number of rows
+  static constexpr size_t rows = 4;
+
+  /// @brief the number of columns
+  static constexpr size_t columns = 4;
+
+  /// @brief The native `double4x4` type
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  using native_double4x4 = simd::double4x4;
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  /// @brief four `__m256d` columns, laid out like `simd::double4x4`
+  struct native_double4x4 {
+    __m256d columns[4];
+  };
+#else
+  /// @brief column major, `(y, x)` is stored at `native[x * 4 + y]`
+  using native_double4x4 = std::array<double, 16>;
+#endif
+
+  /// @brief Create a `double4x4` matrix using a native matrix
+  /// @param native the native matrix
+  GRAPHMATH_CONSTEXPR mat(const native_double4x4 &native);
+
+  /// @brief Create a `double4x4` matrix with `value` on the diagonal
+  /// @param value the value on the diagonal
+  GRAPHMATH_CONSTEXPR mat(double value);
+
+  /// @brief Create a `double4x4` matrix using rows
+  /// @param row0 row 0
+  /// @param row1 row 1
+  /// @param row2 row 2
+  /// @param row3 row 3
+  GRAPHMATH_CONSTEXPR mat(const double4 &row0, const double4 &row1,
+                          const double4 &row2, const double4 &row3);
+
+  /// @brief Create a `double4x4` matrix from a `float4x4`, which is exact
+  /// @param f4x4 the `float4x4`
+  GRAPHMATH_CONSTEXPR explicit mat(const float4x4 &f4x4);
+
+  /// @brief Get the value at `(x, y)`
+  /// @param y y
+  /// @param x x
+  /// @returns the value at `(row, column)`
+  GRAPHMATH_CONSTEXPR double get(size_t y, size_t x) const;
+
+  /// @brief Set the value at `(x, y)`
+  /// @param y y
+  /// @param x x
+  /// @param value the value at `(x, y)`
+  void set(size_t y, size_t x, double value);
+
+  /// @brief Get the value at `(x, y)`
+  /// @param y y
+  /// @param x x
+  /// @returns the value at `(x, y)`
+  GRAPHMATH_CONSTEXPR double operator()(size_t y, size_t x) const;
+
+  /// @brief Get a row
+  /// @param y the index of the row, in `[0, 4)`
+  /// @returns row `y`
+  GRAPHMATH_CONSTEXPR double4 row(size_t y) const;
+
+  /// @brief Get a column
+  /// @param x the index of the column, in `[0, 4)`
+  /// @returns column `x`
+  GRAPHMATH_CONSTEXPR double4 column(size_t x) const;
+
+  /// @brief Round to the nearest `float4x4`
+  /// @returns the `float4x4`
+  GRAPHMATH_CONSTEXPR float4x4 to_float4x4() const;
+
+  /// @brief Multiply a `double4x4` by a `double4`
+  /// @param rhs the `double4`
+  /// @returns the result of multiplication
+  GRAPHMATH_CONSTEXPR double4 operator*(const double4 &rhs) const;
+
+  /// @brief Multiply a `double4x4` by a `double4x4`
+  /// @param rhs the `double4x4`
+  /// @returns the result of multiplication
+  GRAPHMATH_CONSTEXPR double4x4 operator*(const double4x4 &rhs) const;
+
+  native_double4x4 native;
+};
+
+static_assert(std::is_trivially_copyable_v<double4x4>,
+              "double4x4 must be trivially copyable");
+static_assert(std::is_standard_layout_v<double4x4>,
+              "double4x4 must be standard layout");
+static_assert(sizeof(double4x4) == sizeof(double4x4::native_double4x4),
+              "double4x4 must be the size of its native type");
+static_assert(alignof(double4x4) == alignof(double4x4::native_double4x4),
+              "double4x4 must be aligned like its native type");
+
+/// @brief Transpose a `double4x4` matrix
+/// @param d4x4 the matrix to transpose
+/// @returns the transposed matrix
+GRAPHMATH_CONSTEXPR double4x4 transpose(const double4x4 &d4x4);
+
+/// @brief Make a transform relative to an origin, such as the camera
+/// The translation is moved by `-origin` in `double` before the matrix is
+/// rounded, so that the result is as precise as a transform near the origin
+/// of the world
+/// @param transform the transform, its last row must be `(0, 0, 0, 1)`
+/// @param origin the origin
+/// @returns the transform followed by a translation by `-origin`
+GRAPHMATH_CONSTEXPR float4x4 relative(const double4x4 &transform,
+                                      const double3 &origin);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+inline GRAPHMATH_CONSTEXPR double4x4::mat(const native_double4x4 &native)
+    : native(native) {}
+
+inline GRAPHMATH_CONSTEXPR double4x4::mat(double value)
+#if defined(GRAPHMATH_BACKEND_APPLE)
+    : native{simd::double4x4(value)} {
+}
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+    : native{{__m256d{value, 0.0, 0.0, 0.0}, __m256d{0.0, value, 0.0, 0.0},
+              __m256d{0.0, 0.0, value, 0.0}, __m256d{0.0, 0.0, 0.0, value}}} {
+}
+#else
+    : native{{value, 0.0, 0.0, 0.0, 0.0, value, 0.0, 0.0, 0.0, 0.0, value,
+              0.0, 0.0, 0.0, 0.0, value}} {
+}
+#endif
+
+inline GRAPHMATH_CONSTEXPR double4x4::mat(const double4 &row0,
+                                          const double4 &row1,
+                                          const double4 &row2,
+                                          const double4 &row3)
+#if defined(GRAPHMATH_BACKEND_APPLE)
+    : native{simd::transpose(simd::double4x4{row0.native, row1.native,
+                                             row2.native, row3.native})} {
+}
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+    : native{{row0.native, row1.native, row2.native, row3.native}} {
+  if (!detail::is_constant_evaluated()) {
+    avx::transpose(native.columns, native.columns);
+  } else {
+    native.columns[0] = __m256d{row0.x(), row1.x(), row2.x(), row3.x()};
+    native.columns[1] = __m256d{row0.y(), row1.y(), row2.y(), row3.y()};
+    native.columns[2] = __m256d{row0.z(), row1.z(), row2.z(), row3.z()};
+    native.columns[3] = __m256d{row0.w(), row1.w(), row2.w(), row3.w()};
+  }
+}
+#else
+    : native{{row0.x(), row1.x(), row2.x(), row3.x(), row0.y(), row1.y(),
+              row2.y(), row3.y(), row0.z(), row1.z(), row2.z(), row3.z(),
+              row0.w(), row1.w(), row2.w(), row3.w()}} {
+}
+#endif
+
+namespace detail {
+/// @brief Widen a `float4x4` to the native type of `double4x4`
+inline GRAPHMATH_CONSTEXPR double4x4::native_double4x4 widen(
+    const float4x4 &f4x4) {
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!is_constant_evaluated()) {
+    const __m128(&c)[4] = f4x4.native.columns;
+
+    return double4x4::native_double4x4{
+        {_mm256_cvtps_pd(c[0]), _mm256_cvtps_pd(c[1]), _mm256_cvtps_pd(c[2]),
+         _mm256_cvtps_pd(c[3])}};
+  }
+#endif
+
+  return double4x4{double4{f4x4.row(0)}, double4{f4x4.row(1)},
+                   double4{f4x4.row(2)}, double4{f4x4.row(3)}}
+      .native;
+}
+}  // namespace detail
+
+inline GRAPHMATH_CONSTEXPR double4x4::mat(const float4x4 &f4x4)
+    : native(detail::widen(f4x4)) {}
+
+inline GRAPHMATH_CONSTEXPR double double4x4::get(size_t y, size_t x) const {
+#if defined(GRAPHMATH_BACKEND_AVX2) && defined(_MSC_VER) && !defined(__clang__)
+  return native.columns[x].m256d_f64[y];
+#elif defined(GRAPHMATH_BACKEND_APPLE) || defined(GRAPHMATH_BACKEND_AVX2)
+  return native.columns[x][y];
+#else
+  return native[x * 4 + y];
+#endif
+}
+
+inline void double4x4::set(size_t y, size_t x, double value) {
+#if defined(GRAPHMATH_BACKEND_AVX2) && defined(_MSC_VER) && !defined(__clang__)
+  native.columns[x].m256d_f64[y] = value;
+#elif defined(GRAPHMATH_BACKEND_APPLE) || defined(GRAPHMATH_BACKEND_AVX2)
+  native.columns[x][y] = value;
+#else
+  native[x * 4 + y] = value;
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR double double4x4::operator()(size_t y,
+                                                        size_t x) const {
+  return get(y, x);
+}
+
+inline GRAPHMATH_CONSTEXPR double4 double4x4::row(size_t y) const {
+  assert(y < 4);
+
+  return double4{get(y, 0), get(y, 1), get(y, 2), get(y, 3)};
+}
+
+inline GRAPHMATH_CONSTEXPR double4 double4x4::column(size_t x) const {
+  assert(x < 4);
+
+#if defined(GRAPHMATH_BACKEND_APPLE) || defined(GRAPHMATH_BACKEND_AVX2)
+  return double4{native.columns[x]};
+#else
+  return double4{native[x * 4], native[x * 4 + 1], native[x * 4 + 2],
+                 native[x * 4 + 3]};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float4x4 double4x4::to_float4x4() const {
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    return float4x4{float4x4::native_float4x4{
+        {_mm256_cvtpd_ps(native.columns[0]), _mm256_cvtpd_ps(native.columns[1]),
+         _mm256_cvtpd_ps(native.columns[2]),
+         _mm256_cvtpd_ps(native.columns[3])}}};
+  }
+#endif
+
+  return float4x4{row(0).to_float4(), row(1).to_float4(), row(2).to_float4(),
+                  row(3).to_float4()};
+}
+
+// Below, the AVX2 backend returns early unless it is evaluated at compile
+// time, in which case it shares the code of the other backends, written with
+// `get` so that it works with either representation
+
+inline GRAPHMATH_CONSTEXPR double4
+double4x4::operator*(const double4 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return double4{native * rhs.native};
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    return double4{avx::multiply(native.columns, rhs.native)};
+  }
+#endif
+
+  const double v[4] = {rhs.x(), rhs.y(), rhs.z(), rhs.w()};
+  double result[4] = {0.0, 0.0, 0.0, 0.0};
+
+  for (size_t x = 0; x < 4; x++) {
+    for (size_t y = 0; y < 4; y++) {
+      result[y] += get(y, x) * v[x];
+    }
+  }
+
+  return double4{result[0], result[1], result[2], result[3]};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR double4x4
+double4x4::operator*(const double4x4 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return double4x4{native * rhs.native};
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    native_double4x4 result{};
+
+    result.columns[0] = avx::multiply(native.columns, rhs.native.columns[0]);
+    result.columns[1] = avx::multiply(native.columns, rhs.native.columns[1]);
+    result.columns[2] = avx::multiply(native.columns, rhs.native.columns[2]);
+    result.columns[3] = avx::multiply(native.columns, rhs.native.columns[3]);
+
+    return double4x4{result};
+  }
+#endif
+
+  // row `y` of the result is the sum of the rows of `rhs`, scaled by row `y`
+  // of `this`
+  double4 rows[4];
+
+  for (size_t k = 0; k < 4; k++) {
+    double4 rhs_row = rhs.row(k);
+
+    for (size_t y = 0; y < 4; y++) {
+      rows[y] = rows[y] + rhs_row * get(y, k);
+    }
+  }
+
+  return double4x4{rows[0], rows[1], rows[2], rows[3]};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR double4x4 transpose(const double4x4 &d4x4) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return double4x4{simd::transpose(d4x4.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    double4x4::native_double4x4 result{};
+    avx::transpose(d4x4.native.columns, result.columns);
+
+    return double4x4{result};
+  }
+#endif
+
+  // the rows of the transpose are the columns of `d4x4`
+  return double4x4{d4x4.column(0), d4x4.column(1), d4x4.column(2),
+                   d4x4.column(3)};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float4x4 relative(const double4x4 &transform,
+                                             const double3 &origin) {
+  double4 translation = transform.column(3) - double4{origin, 0.0};
+
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (!detail::is_constant_evaluated()) {
+    double4x4 moved = transform;
+    moved.native.columns[3] = translation.native;
+
+    return moved.to_float4x4();
+  }
+#endif
+
+  // the columns, rounded, are the rows of the transpose
+  return transpose(float4x4{
+      transform.column(0).to_float4(), transform.column(1).to_float4(),
+      transform.column(2).to_float4(), translation.to_float4()});
+}
+}  // namespace graphmath
@@ -0,0 +1,476 @@
+//
+//  expression.h
+//  CS 419
+//
+//  Opt-in expression templates that evaluate chained vector arithmetic in
+//  one pass
+//
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "graphmath/backend.h"
+#include "graphmath/float3.h"
+#include "graphmath/float3_soa.h"
+#include "graphmath/float4.h"
+#include "graphmath/float4_soa.h"
+#include "graphmath/wide.h"
+
+// Declarations
+
+namespace graphmath {
+/// @brief expression templates over `float3`, `float4`, `float3_soa` and
+/// `float4_soa`
+///
+/// `lazy(a) * s + b - c` builds a tree instead of computing temporaries;
+/// `evaluate` then computes it in one pass, fusing every `x * y + z` into a
+/// `madd`. Over SoA batches the whole chain runs per `wide_float` of every
+/// component, so each input is loaded and the output is stored exactly once.
+///
+/// Vectors and scalars are captured by value, `float3_soa` and `float4_soa`
+/// by reference: an expression must not outlive the batches it reads.
+namespace expr {
+/// @brief base of every expression node
+/// @tparam E the node
+template <typename E>
+struct expression {
+  /// @brief Get the node
+  /// @returns the node
+  constexpr const E &derived() const;
+};
+
+/// @brief an operand: a vector, a scalar or a batch of vectors
+/// @tparam T `float`, `float3`, `float4`, `float3_soa` or `float4_soa`
+template <typename T>
+class terminal;
+
+/// @brief an operation on two operands
+/// @tparam Op `add`, `subtract`, `multiply` or `divide`
+/// @tparam L the left hand side
+/// @tparam R the right hand side
+template <typename Op, typename L, typename R>
+class binary;
+
+/// @brief Start an expression
+/// @param value the vector
+/// @returns the expression
+constexpr terminal<float3> lazy(const float3 &value);
+
+/// @brief Start an expression
+/// @param value the vector
+/// @returns the expression
+constexpr terminal<float4> lazy(const float4 &value);
+
+/// @brief Start an expression over a batch
+/// @param value the batch, must outlive the expression
+/// @returns the expression
+terminal<float3_soa> lazy(const float3_soa &value);
+
+/// @brief Start an expression over a batch
+/// @param value the batch, must outlive the expression
+/// @returns the expression
+terminal<float4_soa> lazy(const float4_soa &value);
+
+terminal<float3_soa> lazy(const float3_soa &&value) = delete;
+
+terminal<float4_soa> lazy(const float4_soa &&value) = delete;
+
+/// @brief Evaluate an expression without batches
+/// @param e the expression
+/// @returns the resulting `float3` or `float4`
+template <typename E>
+GRAPHMATH_CONSTEXPR typename E::vector_type evaluate(const expression<E> &e);
+
+/// @brief Evaluate an expression over `float3_soa` batches
+/// @param e the expression, all of its batches must have the same size
+/// @param out the results, resized to the size of the batches; may be one of
+/// the batches of `e`
+template <typename E>
+void evaluate(const expression<E> &e, float3_soa &out);
+
+/// @brief Evaluate an expression over `float4_soa` batches
+/// @param e the expression, all of its batches must have the same size
+/// @param out the results, resized to the size of the batches; may be one of
+/// the batches of `e`
+template <typename E>
+void evaluate(const expression<E> &e, float4_soa &out);
+}  // namespace expr
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+namespace expr {
+struct add {};
+
+struct subtract {};
+
+struct multiply {};
+
+struct divide {};
+
+namespace detail {
+template <typename T>
+struct is_expression : std::is_base_of<expression<T>, T> {};
+
+template <typename T>
+constexpr bool is_expression_v = is_expression<T>::value;
+
+template <typename T>
+constexpr bool is_batch_v =
+    std::is_same_v<T, float3_soa> || std::is_same_v<T, float4_soa>;
+
+/// @brief the vector an operand holds, `void` for scalars
+template <typename T>
+struct vector_of {
+  using type = void;
+};
+
+template <>
+struct vector_of<float3_soa> {
+  using type = float3;
+};
+
+template <>
+struct vector_of<float4_soa> {
+  using type = float4;
+};
+
+template <>
+struct vector_of<float3> {
+  using type = float3;
+};
+
+template <>
+struct vector_of<float4> {
+  using type = float4;
+};
+
+template <typename T>
+constexpr bool is_multiply_v = false;
+
+template <typename L, typename R>
+constexpr bool is_multiply_v<binary<multiply, L, R>> = true;
+
+/// @brief Get component `C` of a vector or of a batch
+template <size_t C, typename T>
+constexpr auto component(T &value) {
+  if constexpr (C == 0) {
+    return value.x();
+  } else if constexpr (C == 1) {
+    return value.y();
+  } else if constexpr (C == 2) {
+    return value.z();
+  } else {
+    return value.w();
+  }
+}
+}  // namespace detail
+
+template <typename E>
+constexpr const E &expression<E>::derived() const {
+  return static_cast<const E &>(*this);
+}
+
+template <typename T>
+class terminal final : public expression<terminal<T>> {
+ public:
+  using vector_type = typename detail::vector_of<T>::type;
+
+  static constexpr bool batched = detail::is_batch_v<T>;
+
+  constexpr explicit terminal(const T &value) : value_(value) {}
+
+  /// @brief Get the number of vectors of the batch
+  /// @returns the number of vectors
+  size_t size() const {
+    if constexpr (batched) {
+      return value_.size();
+    } else {
+      return 0;
+    }
+  }
+
+  template <typename Evaluator>
+  constexpr auto evaluate(const Evaluator &evaluator) const {
+    return evaluator.load(value_);
+  }
+
+ private:
+  std::conditional_t<batched, const T &, T> value_;
+};
+
+template <typename Op, typename L, typename R>
+class binary final : public expression<binary<Op, L, R>> {
+ public:
+  using vector_type =
+      std::conditional_t<std::is_void_v<typename L::vector_type>,
+                         typename R::vector_type, typename L::vector_type>;
+
+  static constexpr bool batched = L::batched || R::batched;
+
+  constexpr binary(const L &lhs, const R &rhs) : lhs(lhs), rhs(rhs) {}
+
+  /// @brief Get the number of vectors of the batches
+  /// @returns the number of vectors
+  size_t size() const {
+    if constexpr (L::batched && R::batched) {
+      assert(lhs.size() == rhs.size());
+      return lhs.size();
+    } else if constexpr (L::batched) {
+      return lhs.size();
+    } else {
+      return rhs.size();
+    }
+  }
+
+  template <typename Evaluator>
+  constexpr auto evaluate(const Evaluator &evaluator) const {
+    if constexpr (std::is_same_v<Op, add> && detail::is_multiply_v<L>) {
+      return evaluator.madd(lhs.lhs.evaluate(evaluator),
+                            lhs.rhs.evaluate(evaluator),
+                            rhs.evaluate(evaluator));
+    } else if constexpr (std::is_same_v<Op, add> && detail::is_multiply_v<R>) {
+      return evaluator.madd(rhs.lhs.evaluate(evaluator),
+                            rhs.rhs.evaluate(evaluator),
+                            lhs.evaluate(evaluator));
+    } else {
+      return evaluator.apply(Op{}, lhs.evaluate(evaluator),
+                             rhs.evaluate(evaluator));
+    }
+  }
+
+  L lhs;
+  R rhs;
+};
+
+namespace detail {
+/// @brief Turn an operand into an expression node
+template <typename T>
+constexpr auto wrap(const T &value) {
+  if constexpr (is_expression_v<T>) {
+    return value;
+  } else if constexpr (std::is_arithmetic_v<T>) {
+    return terminal<float>{static_cast<float>(value)};
+  } else {
+    return terminal<T>{value};
+  }
+}
+
+template <typename T>
+constexpr bool is_operand_v = is_expression_v<T> || std::is_arithmetic_v<T> ||
+                              !std::is_void_v<typename vector_of<T>::type>;
+
+/// @brief Combine two operands, at least one of them an expression
+template <typename Op, typename L, typename R>
+constexpr auto make(const L &lhs, const R &rhs) {
+  using lhs_type = decltype(wrap(lhs));
+  using rhs_type = decltype(wrap(rhs));
+  using lhs_vector = typename lhs_type::vector_type;
+  using rhs_vector = typename rhs_type::vector_type;
+
+  static_assert(std::is_void_v<lhs_vector> || std::is_void_v<rhs_vector> ||
+                    std::is_same_v<lhs_vector, rhs_vector>,
+                "float3 and float4 can not be mixed in one expression");
+  static_assert(std::is_same_v<Op, multiply> ||
+                    (!std::is_void_v<lhs_vector> &&
+                     (std::is_same_v<Op, divide> ||
+                      !std::is_void_v<rhs_vector>)),
+                "only multiply and divide take a scalar operand");
+  static_assert(!std::is_same_v<Op, divide> || std::is_void_v<rhs_vector>,
+                "vectors can only be divided by a scalar");
+
+  return binary<Op, lhs_type, rhs_type>{wrap(lhs), wrap(rhs)};
+}
+
+template <typename L, typename R>
+using enable_operator_t =
+    std::enable_if_t<(is_expression_v<L> || is_expression_v<R>) &&
+                     is_operand_v<L> && is_operand_v<R>>;
+
+/// @brief computes a node of vectors and scalars
+template <typename T>
+struct vector_evaluator {
+  static constexpr T broadcast(float value) {
+    if constexpr (std::is_same_v<T, float3>) {
+      return float3{value, value, value};
+    } else {
+      return float4{value, value, value, value};
+    }
+  }
+
+  static constexpr const T &broadcast(const T &value) { return value; }
+
+  constexpr T load(const T &value) const { return value; }
+
+  constexpr float load(float value) const { return value; }
+
+  constexpr T apply(add, const T &a, const T &b) const { return a + b; }
+
+  constexpr T apply(subtract, const T &a, const T &b) const { return a - b; }
+
+  template <typename A, typename B>
+  constexpr T apply(multiply, const A &a, const B &b) const {
+    if constexpr (std::is_same_v<A, float>) {
+      return b * a;
+    } else {
+      return a * b;
+    }
+  }
+
+  constexpr T apply(divide, const T &a, float b) const {
+    if constexpr (std::is_same_v<T, float3>) {
+      return a / b;
+    } else {
+      return T{a.x() / b, a.y() / b, a.z() / b, a.w() / b};
+    }
+  }
+
+  template <typename A, typename B>
+  constexpr T madd(const A &a, const B &b, const T &c) const {
+    return graphmath::madd(broadcast(a), broadcast(b), c);
+  }
+};
+
+/// @brief computes component `C` of a node for the vectors starting at
+/// `index`
+/// @tparam Value `wide_float` for `wide_float::lanes` vectors, `float` for
+/// one
+template <typename Value, size_t C>
+struct component_evaluator {
+  size_t index;
+
+  template <typename T>
+  Value load(const T &value) const {
+    if constexpr (std::is_same_v<T, float>) {
+      return Value{value};
+    } else if constexpr (!is_batch_v<T>) {
+      return Value{component<C>(value)};
+    } else if constexpr (std::is_same_v<Value, float>) {
+      return component<C>(value)[index];
+    } else {
+      return Value::load(component<C>(value) + index);
+    }
+  }
+
+  Value apply(add, const Value &a, const Value &b) const { return a + b; }
+
+  Value apply(subtract, const Value &a, const Value &b) const { return a - b; }
+
+  Value apply(multiply, const Value &a, const Value &b) const { return a * b; }
+
+  Value apply(divide, const Value &a, const Value &b) const { return a / b; }
+
+  Value madd(const Value &a, const Value &b, const Value &c) const {
+    if constexpr (std::is_same_v<Value, float>) {
+      return a * b + c;
+    } else {
+      return graphmath::madd(a, b, c);
+    }
+  }
+};
+
+template <typename Value, typename E, typename Batch, size_t... C>
+inline void evaluate_components(const E &e, Batch &out, size_t index,
+                                std::index_sequence<C...>) {
+  if constexpr (std::is_same_v<Value, float>) {
+    ((component<C>(out)[index] =
+          e.evaluate(component_evaluator<Value, C>{index})),
+     ...);
+  } else {
+    (e.evaluate(component_evaluator<Value, C>{index})
+         .store(component<C>(out) + index),
+     ...);
+  }
+}
+
+/// @brief Evaluate `e` into `out`
+/// Every operation is component-wise, so component `C` of a result only reads
+/// component `C` of the same vector; `out` may therefore be read by `e`
+template <size_t Components, typename E, typename Batch>
+inline void evaluate_batch(const E &e, Batch &out) {
+  static_assert(E::batched, "use evaluate(e) for expressions without batches");
+
+  const size_t size = e.size();
+  out.resize(size);
+
+  constexpr auto components = std::make_index_sequence<Components>{};
+
+  size_t i = 0;
+
+  for (; i + wide_float::lanes <= size; i += wide_float::lanes) {
+    evaluate_components<wide_float>(e, out, i, components);
+  }
+
+  for (; i < size; i++) {
+    evaluate_components<float>(e, out, i, components);
+  }
+}
+}  // namespace detail
+
+template <typename L, typename R, typename = detail::enable_operator_t<L, R>>
+constexpr auto operator+(const L &lhs, const R &rhs) {
+  return detail::make<add>(lhs, rhs);
+}
+
+template <typename L, typename R, typename = detail::enable_operator_t<L, R>>
+constexpr auto operator-(const L &lhs, const R &rhs) {
+  return detail::make<subtract>(lhs, rhs);
+}
+
+template <typename L, typename R, typename = detail::enable_operator_t<L, R>>
+constexpr auto operator*(const L &lhs, const R &rhs) {
+  return detail::make<multiply>(lhs, rhs);
+}
+
+template <typename L, typename R, typename = detail::enable_operator_t<L, R>>
+constexpr auto operator/(const L &lhs, const R &rhs) {
+  return detail::make<divide>(lhs, rhs);
+}
+
+inline constexpr terminal<float3> lazy(const float3 &value) {
+  return terminal<float3>{value};
+}
+
+inline constexpr terminal<float4> lazy(const float4 &value) {
+  return terminal<float4>{value};
+}
+
+inline terminal<float3_soa> lazy(const float3_soa &value) {
+  return terminal<float3_soa>{value};
+}
+
+inline terminal<float4_soa> lazy(const float4_soa &value) {
+  return terminal<float4_soa>{value};
+}
+
+template <typename E>
+inline GRAPHMATH_CONSTEXPR typename E::vector_type evaluate(
+    const expression<E> &e) {
+  static_assert(!E::batched, "expressions over batches need an output batch");
+
+  using vector_type = typename E::vector_type;
+
+  return e.derived().evaluate(detail::vector_evaluator<vector_type>{});
+}
+
+template <typename E>
+inline void evaluate(const expression<E> &e, float3_soa &out) {
+  static_assert(std::is_same_v<typename E::vector_type, float3>,
+                "a float3_soa holds the results of float3 expressions");
+
+  detail::evaluate_batch<3>(e.derived(), out);
+}
+
+template <typename E>
+inline void evaluate(const expression<E> &e, float4_soa &out) {
+  static_assert(std::is_same_v<typename E::vector_type, float4>,
+                "a float4_soa holds the results of float4 expressions");
+
+  detail::evaluate_batch<4>(e.derived(), out);
+}
+}  // namespace expr
+}  // namespace graphmath
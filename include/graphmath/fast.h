@@ -0,0 +1,309 @@
+//
+//  fast.h
+//  CS 419
+//
+//  Approximate `rsqrt`, `rcp`, `normalize` and `length`
+//
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+#include "graphmath/backend.h"
+#include "graphmath/float3.h"
+#include "graphmath/float3_soa.h"
+#include "graphmath/float4.h"
+#include "graphmath/float4_soa.h"
+#include "graphmath/wide.h"
+
+#if defined(GRAPHMATH_BACKEND_APPLE)
+#include <simd/simd.h>
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+#include <DirectXMath.h>
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+#include <immintrin.h>
+#endif
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+#include "graphmath/sse.h"
+#endif
+
+// Declarations
+
+namespace graphmath {
+/// @brief approximate versions of the functions of the same name in
+/// `graphmath`, for code that tolerates a small relative error
+///
+/// The SSE, AVX2 and DirectX backends start from the hardware estimate (12
+/// bits, 14 bits with AVX-512F) and refine it with one Newton-Raphson step.
+/// The relative error of every function is below `2^-21` (about `4.8e-7`, at
+/// most 4 ulp) for normal, finite inputs, and the error of `normalize` is
+/// below `2^-21` in length. The Apple backend uses `simd::fast`, and the
+/// scalar backend computes exact results.
+///
+/// `length` is exact outside of the Apple backend: `sqrt` is as fast as the
+/// refined estimate on current x86 cores and, unlike `x * rsqrt(x)`, handles
+/// zero vectors.
+namespace fast {
+/// @brief Approximate `1 / sqrt(value)`
+/// @param value the value, positive and finite
+/// @returns `1 / sqrt(value)`
+float rsqrt(float value);
+
+/// @brief Approximate `1 / value`
+/// @param value the value, nonzero with `|value| < 2^126`
+/// @returns `1 / value`
+float rcp(float value);
+
+/// @brief Get an approximately normalized version of `float3`
+/// @param f3 the `float3`, not zero
+/// @returns the normalized `float3`
+float3 normalize(const float3 &f3);
+
+/// @brief Get the length of a `float3`
+/// @param f3 the `float3`
+/// @returns the length, zero for a zero vector
+float length(const float3 &f3);
+
+/// @brief Get an approximately normalized version of `float4`
+/// @param f4 the `float4`, not zero
+/// @returns the normalized `float4`
+float4 normalize(const float4 &f4);
+
+/// @brief Get the length of a `float4`
+/// @param f4 the `float4`
+/// @returns the length, zero for a zero vector
+float length(const float4 &f4);
+
+/// @brief Approximate `1 / sqrt(value)` of every lane
+/// @param value the values, positive and finite
+/// @returns `1 / sqrt(value)`
+wide_float rsqrt(const wide_float &value);
+
+/// @brief Approximate `1 / value` of every lane
+/// @param value the values, nonzero with `|value| < 2^126`
+/// @returns `1 / value`
+wide_float rcp(const wide_float &value);
+
+/// @brief Approximately normalize every vector
+/// @param f3 the vectors, not zero
+/// @param out the results, resized to `f3.size()`; may be `f3`
+void normalize(const float3_soa &f3, float3_soa &out);
+
+/// @brief Get the length of every vector
+/// @param f3 the vectors
+/// @param out the results, must hold `f3.size()` floats
+void length(const float3_soa &f3, float *out);
+
+/// @brief Approximately normalize every vector
+/// @param f4 the vectors, not zero
+/// @param out the results, resized to `f4.size()`; may be `f4`
+void normalize(const float4_soa &f4, float4_soa &out);
+
+/// @brief Get the length of every vector
+/// @param f4 the vectors
+/// @param out the results, must hold `f4.size()` floats
+void length(const float4_soa &f4, float *out);
+}  // namespace fast
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+namespace fast {
+namespace detail {
+#if defined(GRAPHMATH_BACKEND_DIRECTX)
+inline DirectX::XMVECTOR rsqrt(DirectX::XMVECTOR v) {
+  using namespace DirectX;
+
+  XMVECTOR y = XMVectorReciprocalSqrtEst(v);
+
+  // y * (1.5 - 0.5 * v * y * y)
+  XMVECTOR half_v_y = XMVectorMultiply(XMVectorScale(v, 0.5f), y);
+  XMVECTOR three_halves = XMVectorReplicate(1.5f);
+  return XMVectorMultiply(
+      y, XMVectorNegativeMultiplySubtract(half_v_y, y, three_halves));
+}
+
+inline DirectX::XMVECTOR rcp(DirectX::XMVECTOR v) {
+  using namespace DirectX;
+
+  XMVECTOR y = XMVectorReciprocalEst(v);
+
+  // y + y * (1 - v * y)
+  XMVECTOR error = XMVectorNegativeMultiplySubtract(v, y, XMVectorSplatOne());
+  return XMVectorMultiplyAdd(y, error, y);
+}
+#endif
+
+#if defined(GRAPHMATH_BACKEND_AVX2)
+/// @brief Refine an estimate `y` of `1 / sqrt(v)` with one Newton-Raphson step
+inline wide_float refine_rsqrt(const wide_float &v, const wide_float &y) {
+  wide_float half_v_y = wide_float{0.5f} * v * y;
+  return y * (wide_float{1.5f} - half_v_y * y);
+}
+
+/// @brief Refine an estimate `y` of `1 / v` with one Newton-Raphson step
+inline wide_float refine_rcp(const wide_float &v, const wide_float &y) {
+  return madd(y, wide_float{1.0f} - v * y, y);
+}
+#endif
+}  // namespace detail
+
+inline float rsqrt(float value) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd::fast::rsqrt(value);
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  using namespace DirectX;
+
+  return XMVectorGetX(detail::rsqrt(XMVectorReplicate(value)));
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return _mm_cvtss_f32(sse::rsqrt(_mm_set_ss(value)));
+#else
+  return 1.0f / std::sqrt(value);
+#endif
+}
+
+inline float rcp(float value) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd::fast::recip(value);
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  using namespace DirectX;
+
+  return XMVectorGetX(detail::rcp(XMVectorReplicate(value)));
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return _mm_cvtss_f32(sse::rcp(_mm_set_ss(value)));
+#else
+  return 1.0f / value;
+#endif
+}
+
+inline float3 normalize(const float3 &f3) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float3{simd::fast::normalize(f3.native)};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  using namespace DirectX;
+
+  return XMVectorMultiply(f3.native,
+                          detail::rsqrt(XMVector3Dot(f3.native, f3.native)));
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  // 0x7F: dot `xyz` and broadcast the result to all four lanes
+  __m128 squared = _mm_dp_ps(f3.native, f3.native, 0x7F);
+  return float3{_mm_mul_ps(f3.native, sse::rsqrt(squared))};
+#else
+  return graphmath::normalize(f3);
+#endif
+}
+
+inline float length(const float3 &f3) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd::fast::length(f3.native);
+#else
+  return graphmath::length(f3);
+#endif
+}
+
+inline float4 normalize(const float4 &f4) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float4{simd::fast::normalize(f4.native)};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  using namespace DirectX;
+
+  return float4{XMVectorMultiply(
+      f4.native, detail::rsqrt(XMVector4Dot(f4.native, f4.native)))};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  // 0xFF: dot `xyzw` and broadcast the result to all four lanes
+  __m128 squared = _mm_dp_ps(f4.native, f4.native, 0xFF);
+  return float4{_mm_mul_ps(f4.native, sse::rsqrt(squared))};
+#else
+  return graphmath::normalize(f4);
+#endif
+}
+
+inline float length(const float4 &f4) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd::fast::length(f4.native);
+#else
+  return graphmath::length(f4);
+#endif
+}
+
+inline wide_float rsqrt(const wide_float &value) {
+#if defined(GRAPHMATH_BACKEND_AVX2) && defined(__AVX512F__)
+  return detail::refine_rsqrt(value,
+                              wide_float{_mm512_rsqrt14_ps(value.native)});
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  return detail::refine_rsqrt(value, wide_float{_mm256_rsqrt_ps(value.native)});
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return wide_float{sse::rsqrt(value.native)};
+#else
+  wide_float::native_wide_float result;
+
+  for (size_t i = 0; i < wide_float::lanes; i++) {
+    result[i] = 1.0f / std::sqrt(value.native[i]);
+  }
+
+  return wide_float{result};
+#endif
+}
+
+inline wide_float rcp(const wide_float &value) {
+#if defined(GRAPHMATH_BACKEND_AVX2) && defined(__AVX512F__)
+  return detail::refine_rcp(value, wide_float{_mm512_rcp14_ps(value.native)});
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  return detail::refine_rcp(value, wide_float{_mm256_rcp_ps(value.native)});
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return wide_float{sse::rcp(value.native)};
+#else
+  wide_float::native_wide_float result;
+
+  for (size_t i = 0; i < wide_float::lanes; i++) {
+    result[i] = 1.0f / value.native[i];
+  }
+
+  return wide_float{result};
+#endif
+}
+
+inline void normalize(const float3_soa &f3, float3_soa &out) {
+  out.resize(f3.size());
+
+  for_each_wide({f3.x(), f3.y(), f3.z()}, {out.x(), out.y(), out.z()},
+                f3.size(), [](const wide_float(&in)[3], wide_float(&r)[3]) {
+                  wide_float squared =
+                      madd(in[0], in[0], madd(in[1], in[1], in[2] * in[2]));
+                  wide_float scale = rsqrt(squared);
+
+                  r[0] = in[0] * scale;
+                  r[1] = in[1] * scale;
+                  r[2] = in[2] * scale;
+                });
+}
+
+inline void length(const float3_soa &f3, float *out) {
+  graphmath::length(f3, out);
+}
+
+inline void normalize(const float4_soa &f4, float4_soa &out) {
+  out.resize(f4.size());
+
+  for_each_wide({f4.x(), f4.y(), f4.z(), f4.w()},
+                {out.x(), out.y(), out.z(), out.w()}, f4.size(),
+                [](const wide_float(&in)[4], wide_float(&r)[4]) {
+                  wide_float squared = madd(
+                      in[0], in[0],
+                      madd(in[1], in[1], madd(in[2], in[2], in[3] * in[3])));
+                  wide_float scale = rsqrt(squared);
+
+                  r[0] = in[0] * scale;
+                  r[1] = in[1] * scale;
+                  r[2] = in[2] * scale;
+                  r[3] = in[3] * scale;
+                });
+}
+
+inline void length(const float4_soa &f4, float *out) {
+  graphmath::length(f4, out);
+}
+}  // namespace fast
+}  // namespace graphmath
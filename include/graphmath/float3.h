@@ -6,12 +6,19 @@
 //
 #pragma once
 
-#include "graphmath/not_implemented.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
 
-#if defined(__APPLE__)
+#include "graphmath/backend.h"
+#include "graphmath/vec.h"
+
+#if defined(GRAPHMATH_BACKEND_APPLE)
 #include <simd/simd.h>
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
 #include <DirectXMath.h>
+#elif defined(GRAPHMATH_BACKEND_SSE)
+#include "graphmath/sse.h"
 #else
 #include <array>
 #endif
@@ -20,91 +27,112 @@
 
 namespace graphmath {
 /// @brief three `float32` numbers `(x, y, z)`
-struct float3 final {
+template <>
+struct vec<float, 3> final {
  public:
+  /// @brief the type of the numbers
+  using value_type = float;
+
+  /// @brief the number of numbers
+  static constexpr size_t size = 3;
+
   /// @brief the native `float3` type
-  /// `simd::float3` on Apple Platform
-#if defined(__APPLE__)
+  /// `simd::float3` on Apple Platform, `DirectX::XMVECTOR` on Windows,
+  /// `__m128` (with `w` kept at zero) on SSE4.1 capable platforms
+#if defined(GRAPHMATH_BACKEND_APPLE)
   using native_float3 = simd::float3;
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   using native_float3 = DirectX::XMVECTOR;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  using native_float3 = __m128;
 #else
   using native_float3 = std::array<float, 3>;
 #endif
 
   /// @brief create a `float3` of zeroes
-  float3();
+  GRAPHMATH_CONSTEXPR vec();
 
   /// @brief create a `float3` with values
   /// @param x x
   /// @param y y
   /// @param z z
-  float3(float x, float y, float z);
+  GRAPHMATH_CONSTEXPR vec(float x, float y, float z);
 
   /// @brief copy constructor
   /// @param other another `float3`
-  float3(const float3 &other);
+  vec(const float3 &other) = default;
 
   /// @brief create a `float3` with `native_float3`
   ///
   /// @param native the native `float3` instance
-  float3(const native_float3 &native);
+  GRAPHMATH_CONSTEXPR vec(const native_float3 &native);
 
   /// @brief Get `x` of `float3`
   /// @returns the `x` value of `float3`
-  float x() const;
+  GRAPHMATH_CONSTEXPR float x() const;
 
   /// @brief Get `y` of `float3`
   /// @returns the `y` value of `float3`
-  float y() const;
+  GRAPHMATH_CONSTEXPR float y() const;
 
   /// @brief Get `z` of `float3`
   /// @returns the `z` value of `float3`
-  float z() const;
+  GRAPHMATH_CONSTEXPR float z() const;
 
   /// @brief Add one `a` to `b` from another
   /// @param rhs `b`
   /// @returns the result
-  float3 operator+(const float3 &rhs) const;
+  GRAPHMATH_CONSTEXPR float3 operator+(const float3 &rhs) const;
 
   /// @brief Subtract a value from all values of `float3`
   /// @param rhs the value to subtract with
   /// @returns the subtracted `float3`
-  float3 operator-(float rhs) const;
+  GRAPHMATH_CONSTEXPR float3 operator-(float rhs) const;
 
   /// @brief Subtract one `a` from `b` from another
   /// @param rhs `b`
   /// @returns the result
-  float3 operator-(const float3 &rhs) const;
+  GRAPHMATH_CONSTEXPR float3 operator-(const float3 &rhs) const;
 
   /// @brief Multiply all values of `float3` by a multiplier
   /// @param rhs the multiplier
   /// @returns the multiplied `float3`
-  float3 operator*(float rhs) const;
+  GRAPHMATH_CONSTEXPR float3 operator*(float rhs) const;
 
   /// @brief Component-wise multiply `a`, `b`
   /// @param rhs `b`
   /// @returns the result
-  float3 operator*(const float3 &rhs) const;
+  GRAPHMATH_CONSTEXPR float3 operator*(const float3 &rhs) const;
 
   /// @brief Divide all values of `float3` by a divisor
   /// @param rhs the divisor
   /// @returns the multiplied `float3`
-  float3 operator/(float rhs) const;
+  GRAPHMATH_CONSTEXPR float3 operator/(float rhs) const;
 
   /// @brief Compare `this` with another `float3`
   /// @param rhs the other `float3`
   /// @returns true if equal; false otherwise
-  bool operator==(const float3 &rhs) const;
+  GRAPHMATH_CONSTEXPR bool operator==(const float3 &rhs) const;
 
   /// @brief Compare `this` with another `float3`
   /// @param rhs the other `float3`
   /// @returns false if equal; true otherwise
-  bool operator!=(const float3 &rhs) const;
+  GRAPHMATH_CONSTEXPR bool operator!=(const float3 &rhs) const;
 
   native_float3 native;
 };
 
+// `float3` is copied with `memcpy` by containers and has the layout of its
+// native type
+static_assert(std::is_trivially_copyable_v<float3>,
+              "float3 must be trivially copyable");
+static_assert(std::is_standard_layout_v<float3>,
+              "float3 must be standard layout");
+static_assert(sizeof(float3) == sizeof(float3::native_float3),
+              "float3 must be the size of its native type");
+static_assert(alignof(float3) == alignof(float3::native_float3),
+              "float3 must be aligned like its native type");
+
 /// @brief Take `sqrt` of all values of a `float3`
 /// @param f3 the `float3`
 float3 sqrt(const float3 &f3);
@@ -118,287 +146,458 @@ float3 normalize(const float3 &f3);
 /// @param a one `float3`
 /// @param b one `float3`
 /// @returns the result `float3`
-float3 cross(const float3 &a, const float3 &b);
+GRAPHMATH_CONSTEXPR float3 cross(const float3 &a, const float3 &b);
 
 /// @brief clamp a float to a low and high bound
 /// @param value the value to clamp
 /// @param low the low bound (inclusive)
 /// @param high the high bound (inclusive)
 /// @returns the clammped float3
-float3 clamp(const float3 &value, const float3 &low, const float3 &high);
+GRAPHMATH_CONSTEXPR float3 clamp(const float3 &value, const float3 &low,
+                                 const float3 &high);
 
 /// @brief Compute the dot product of two `float3`
 /// @param a one `float3`
 /// @param b one `float3`
 /// @returns the resulting number`
-float dot(const float3 &a, const float3 &b);
+GRAPHMATH_CONSTEXPR float dot(const float3 &a, const float3 &b);
+
+/// @brief Compute `a * b + c` component-wise, fused into one instruction when
+/// the backend has FMA
+/// @param a a
+/// @param b b
+/// @param c c
+/// @returns the result
+GRAPHMATH_CONSTEXPR float3 madd(const float3 &a, const float3 &b,
+                               const float3 &c);
 
 /// @brief Get the length of a `float3`
 /// @param f3 the float 3
 /// @returns the length
 float length(const float3 &f3);
+
+/// @brief Get the smaller of each pair of values
+/// Each lane is `a < b ? a : b` like `minps`, so `b` wins when either is NaN
+/// (Apple's `simd::min` returns the number instead)
+/// @param a one `float3`
+/// @param b one `float3`
+/// @returns the component-wise minimum
+GRAPHMATH_CONSTEXPR float3 min(const float3 &a, const float3 &b);
+
+/// @brief Get the larger of each pair of values
+/// Each lane is `a > b ? a : b` like `maxps`, so `b` wins when either is NaN
+/// (Apple's `simd::max` returns the number instead)
+/// @param a one `float3`
+/// @param b one `float3`
+/// @returns the component-wise maximum
+GRAPHMATH_CONSTEXPR float3 max(const float3 &a, const float3 &b);
+
+/// @brief Get the absolute value of each value of a `float3`
+/// @param f3 the `float3`
+/// @returns the component-wise absolute value
+float3 abs(const float3 &f3);
 }  // namespace graphmath
 
 // Implementations
 
 namespace graphmath {
-inline float3::float3()
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float3::vec()
+#if defined(GRAPHMATH_BACKEND_APPLE)
     : native{simd::make_float3(0, 0, 0)} {
 }
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
     : native{DirectX::XMVectorSet(0, 0, 0, 1)} {
 }
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    : native{__m128{0.0f, 0.0f, 0.0f, 0.0f}} {
+}
 #else
-{
-  throw_not_implemented();
+    : native{{0, 0, 0}} {
 }
 #endif
 
-inline float3::float3(float x, float y, float z)
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float3::vec(float x, float y, float z)
+#if defined(GRAPHMATH_BACKEND_APPLE)
     : native{simd::make_float3(x, y, z)} {
 }
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
     : native{DirectX::XMVectorSet(x, y, z, 1)} {
 }
-#else
-{
-  throw_not_implemented();
-}
-#endif
-
-inline float3::float3(const float3 &other)
-#if defined(__APPLE__) || defined(_WIN32)
-    : native(other.native) {
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    // a braced `__m128` compiles to the same code as `_mm_set_ps` and can be
+    // evaluated at compile time
+    : native{__m128{x, y, z, 0.0f}} {
 }
 #else
-{
-  throw_not_implemented();
+    : native{{x, y, z}} {
 }
 #endif
 
-inline float3::float3(const native_float3 &values)
-#if defined(__APPLE__) || defined(_WIN32)
-    : native(values) {
-}
-#else
-{
-  throw_not_implemented();
-}
-#endif
+inline GRAPHMATH_CONSTEXPR float3::vec(const native_float3 &values)
+    : native(values) {}
 
-inline float float3::x() const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float float3::x() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return native.x;
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   return DirectX::XMVectorGetX(native);
-#else
-  throw_not_implemented();
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::lane<0>(native);
+  }
 
-  return -1.0f;
+  return _mm_cvtss_f32(native);
+#else
+  return native[0];
 #endif
 }
 
-inline float float3::y() const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float float3::y() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return native.y;
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   return DirectX::XMVectorGetY(native);
-#else
-  throw_not_implemented();
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::lane<1>(native);
+  }
 
-  return -1.0f;
+  return _mm_cvtss_f32(
+      _mm_shuffle_ps(native, native, _MM_SHUFFLE(1, 1, 1, 1)));
+#else
+  return native[1];
 #endif
 }
 
-inline float float3::z() const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float float3::z() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return native.z;
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   return DirectX::XMVectorGetZ(native);
-#else
-  throw_not_implemented();
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::lane<2>(native);
+  }
 
-  return -1.0f
+  return _mm_cvtss_f32(
+      _mm_shuffle_ps(native, native, _MM_SHUFFLE(2, 2, 2, 2)));
+#else
+  return native[2];
 #endif
 }
 
-inline float3 float3::operator+(const float3 &rhs) const {
-#if defined(__APPLE__)
+// Below, the SSE backend returns early unless it is evaluated at compile time,
+// in which case it shares the lane-wise code of the scalar backend
+
+inline GRAPHMATH_CONSTEXPR float3
+float3::operator+(const float3 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return native + rhs.native;
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   return float3{DirectX::XMVectorAdd(native, rhs.native)};
 #else
-  throw_not_implemented();
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float3{_mm_add_ps(native, rhs.native)};
+  }
+#endif
 
-  return float3{};
+  return float3{x() + rhs.x(), y() + rhs.y(), z() + rhs.z()};
 #endif
 }
 
-inline float3 float3::operator-(float rhs) const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float3 float3::operator-(float rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return native - rhs;
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   using namespace DirectX;
 
   XMVECTOR rhs_vec = XMVectorSet(rhs, rhs, rhs, 0.0f);
   return float3{XMVectorSubtract(native, rhs_vec)};
 #else
-  throw_not_implemented();
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float3{_mm_sub_ps(native, _mm_set_ps(0, rhs, rhs, rhs))};
+  }
+#endif
 
-  return float3{};
+  return float3{x() - rhs, y() - rhs, z() - rhs};
 #endif
 }
 
-inline float3 float3::operator-(const float3 &rhs) const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float3
+float3::operator-(const float3 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return native - rhs.native;
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   return float3{DirectX::XMVectorSubtract(native, rhs.native)};
 #else
-  throw_not_implemented();
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float3{_mm_sub_ps(native, rhs.native)};
+  }
+#endif
 
-  return float3{};
+  return float3{x() - rhs.x(), y() - rhs.y(), z() - rhs.z()};
 #endif
 }
 
-inline float3 float3::operator*(float rhs) const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float3 float3::operator*(float rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return native * rhs;
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   using namespace DirectX;
 
   XMVECTOR rhs_vec = XMVectorSet(rhs, rhs, rhs, 1.0f);
   return float3{XMVectorMultiply(native, rhs_vec)};
 #else
-  throw_not_implemented();
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    // multiply `w` by zero so that it stays zero even when `rhs` is infinite
+    return float3{_mm_mul_ps(native, _mm_set_ps(0, rhs, rhs, rhs))};
+  }
+#endif
 
-  return float3{};
+  return float3{x() * rhs, y() * rhs, z() * rhs};
 #endif
 }
 
-inline float3 float3::operator*(const float3 &rhs) const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float3
+float3::operator*(const float3 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return native * rhs.native;
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   return float3{DirectX::XMVectorMultiply(native, rhs.native)};
 #else
-  throw_not_implemented();
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float3{_mm_mul_ps(native, rhs.native)};
+  }
+#endif
 
-  return float3{};
+  return float3{x() * rhs.x(), y() * rhs.y(), z() * rhs.z()};
 #endif
 }
 
-inline float3 float3::operator/(float rhs) const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float3 float3::operator/(float rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return native / rhs;
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   using namespace DirectX;
 
   XMVECTOR rhs_vec = XMVectorSet(rhs, rhs, rhs, 1.0f);
   return float3{XMVectorDivide(native, rhs_vec)};
 #else
-  throw_not_implemented();
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    // divide `w` by one so that it stays zero even when `rhs` is zero
+    return float3{_mm_div_ps(native, _mm_set_ps(1, rhs, rhs, rhs))};
+  }
+#endif
 
-  return float3{};
+  return float3{x() / rhs, y() / rhs, z() / rhs};
 #endif
 }
 
-inline bool float3::operator==(const float3 &rhs) const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR bool float3::operator==(const float3 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return simd::equal(native, rhs.native);
-#elif defined(_WIN32)
-  using namespace DirectX;
-
-  XMVECTOR comparison = XMVectorEqual(native, rhs.native);
-  return XMVectorGetX(comparison) == 0xFFFFFFFF &&
-         XMVectorGetY(comparison) == 0xFFFFFFFF &&
-         XMVectorGetZ(comparison) == 0xFFFFFFFF;
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return DirectX::XMVector3Equal(native, rhs.native);
 #else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return (_mm_movemask_ps(_mm_cmpeq_ps(native, rhs.native)) & 0x7) == 0x7;
+  }
+#endif
+
   return x() == rhs.x() && y() == rhs.y() && z() == rhs.z();
 #endif
 }
 
-inline bool float3::operator!=(const float3 &rhs) const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR bool float3::operator!=(const float3 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return !simd::equal(native, rhs.native);
-#elif defined(_WIN32)
-  using namespace DirectX;
-
-  XMVECTOR comparison = XMVectorEqual(native, rhs.native);
-  return !(XMVectorGetX(comparison) == 0xFFFFFFFF &&
-           XMVectorGetY(comparison) == 0xFFFFFFFF &&
-           XMVectorGetZ(comparison) == 0xFFFFFFFF);
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return DirectX::XMVector3NotEqual(native, rhs.native);
 #else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return (_mm_movemask_ps(_mm_cmpeq_ps(native, rhs.native)) & 0x7) != 0x7;
+  }
+#endif
+
   return !(x() == rhs.x() && y() == rhs.y() && z() == rhs.z());
 #endif
 }
 
 inline float3 sqrt(const float3 &f3) {
-#if defined(__APPLE__)
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return simd::sqrt(f3.native);
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return float3{_mm_sqrt_ps(f3.native)};
 #else
-  throw_not_implemented();
-
-  return float3{};
+  return float3{std::sqrt(f3.x()), std::sqrt(f3.y()), std::sqrt(f3.z())};
 #endif
 }
 
 inline float3 normalize(const float3 &f3) {
-#if defined(__APPLE__)
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return float3{simd::normalize(f3.native)};
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   using namespace DirectX;
 
   return XMVector3Normalize(f3.native);
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  // 0x7F: dot `xyz` and broadcast the result to all four lanes
+  __m128 length = _mm_sqrt_ps(_mm_dp_ps(f3.native, f3.native, 0x7F));
+  return float3{_mm_div_ps(f3.native, length)};
 #else
-  throw_not_implemented();
-
-  return float3{};
+  return f3 / length(f3);
 #endif
 }
 
-inline float3 cross(const float3 &a, const float3 &b) {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float3 cross(const float3 &a, const float3 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return float3{simd::cross(a.native, b.native)};
 #else
-  throw_not_implemented();
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    __m128 a_yzx =
+        _mm_shuffle_ps(a.native, a.native, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 b_yzx =
+        _mm_shuffle_ps(b.native, b.native, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 c_zxy =
+        _mm_sub_ps(_mm_mul_ps(a.native, b_yzx), _mm_mul_ps(a_yzx, b.native));
+
+    return float3{_mm_shuffle_ps(c_zxy, c_zxy, _MM_SHUFFLE(3, 0, 2, 1))};
+  }
+#endif
+
+  return float3{a.y() * b.z() - a.z() * b.y(), a.z() * b.x() - a.x() * b.z(),
+                a.x() * b.y() - a.y() * b.x()};
 #endif
 }
 
-inline float3 clamp(const float3 &value, const float3 &low,
-                    const float3 &high) {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float3 clamp(const float3 &value,
+                                        const float3 &low,
+                                        const float3 &high) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return simd::clamp(value.native, low.native, high.native);
 #else
-  throw_not_implemented();
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float3{
+        _mm_min_ps(_mm_max_ps(value.native, low.native), high.native)};
+  }
+#endif
 
-  return float3{};
+  return float3{std::min(std::max(value.x(), low.x()), high.x()),
+                std::min(std::max(value.y(), low.y()), high.y()),
+                std::min(std::max(value.z(), low.z()), high.z())};
 #endif
 }
 
-inline float dot(const float3 &a, const float3 &b) {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float dot(const float3 &a, const float3 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return simd::dot(a.native, b.native);
 #else
-  throw_not_implemented();
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    // 0x71: dot `xyz` and write the result to `x`
+    return _mm_cvtss_f32(_mm_dp_ps(a.native, b.native, 0x71));
+  }
+#endif
+
+  return a.x() * b.x() + a.y() * b.y() + a.z() * b.z();
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float3 madd(const float3 &a, const float3 &b,
+                                     const float3 &c) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float3{simd::fma(a.native, b.native, c.native)};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return float3{DirectX::XMVectorMultiplyAdd(a.native, b.native, c.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float3{sse::madd(a.native, b.native, c.native)};
+  }
+#endif
 
-  return -1.0f;
+  return float3{a.x() * b.x() + c.x(), a.y() * b.y() + c.y(),
+                a.z() * b.z() + c.z()};
 #endif
 }
 
 inline float length(const float3 &f3) {
-#if defined(__APPLE__)
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return simd::length(f3.native);
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   using namespace DirectX;
 
   return XMVectorGetX(XMVector3Length(f3.native));
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return _mm_cvtss_f32(_mm_sqrt_ss(_mm_dp_ps(f3.native, f3.native, 0x71)));
+#else
+  return std::sqrt(dot(f3, f3));
+#endif
+}
+
+namespace detail {
+/// @brief `minps` of one lane, `b` for a NaN
+constexpr float min_lane(float a, float b) { return a < b ? a : b; }
+
+/// @brief `maxps` of one lane, `b` for a NaN
+constexpr float max_lane(float a, float b) { return a > b ? a : b; }
+}  // namespace detail
+
+inline GRAPHMATH_CONSTEXPR float3 min(const float3 &a, const float3 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float3{simd::min(a.native, b.native)};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return float3{DirectX::XMVectorMin(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float3{_mm_min_ps(a.native, b.native)};
+  }
+#endif
+
+  return float3{detail::min_lane(a.x(), b.x()),
+                detail::min_lane(a.y(), b.y()),
+                detail::min_lane(a.z(), b.z())};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float3 max(const float3 &a, const float3 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float3{simd::max(a.native, b.native)};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return float3{DirectX::XMVectorMax(a.native, b.native)};
 #else
-  throw_not_implemented();
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float3{_mm_max_ps(a.native, b.native)};
+  }
+#endif
 
-  return -1.0f;
+  return float3{detail::max_lane(a.x(), b.x()),
+                detail::max_lane(a.y(), b.y()),
+                detail::max_lane(a.z(), b.z())};
+#endif
+}
+
+inline float3 abs(const float3 &f3) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float3{simd::abs(f3.native)};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return float3{DirectX::XMVectorAbs(f3.native)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return float3{_mm_andnot_ps(_mm_set1_ps(-0.0f), f3.native)};
+#else
+  return float3{std::abs(f3.x()), std::abs(f3.y()), std::abs(f3.z())};
 #endif
 }
 }  // namespace graphmath
@@ -0,0 +1,296 @@
+//
+//  float3_soa.h
+//  CS 419
+//
+//  Structure-of-arrays storage for many `float3`
+//
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "graphmath/aligned_allocator.h"
+#include "graphmath/backend.h"
+#include "graphmath/float3.h"
+#include "graphmath/wide.h"
+
+// Declarations
+
+namespace graphmath {
+/// @brief many `float3` stored as three aligned arrays `x[]`, `y[]`, `z[]`,
+/// so that batch kernels can work on `wide_float::lanes` vectors at a time
+class float3_soa final {
+ public:
+  /// @brief storage of one component
+  using component_array = std::vector<float, aligned_allocator<float>>;
+
+  /// @brief create an empty `float3_soa`
+  float3_soa() = default;
+
+  /// @brief create a `float3_soa` of `size` zero vectors
+  /// @param size the number of vectors
+  explicit float3_soa(size_t size);
+
+  /// @brief create a `float3_soa` from an array of `float3`
+  /// @param values the first `float3`
+  /// @param count the number of `float3`
+  float3_soa(const float3 *values, size_t count);
+
+  /// @brief Get the number of vectors
+  /// @returns the number of vectors
+  size_t size() const;
+
+  /// @brief Resize to `size` vectors, new vectors are zeroes
+  /// @param size the number of vectors
+  void resize(size_t size);
+
+  /// @brief Get the vector at `index`
+  /// @param index the index
+  /// @returns the vector
+  float3 get(size_t index) const;
+
+  /// @brief Set the vector at `index`
+  /// @param index the index
+  /// @param value the vector
+  void set(size_t index, const float3 &value);
+
+  /// @brief Replace the contents with an array of `float3`
+  /// @param values the first `float3`
+  /// @param count the number of `float3`
+  void load(const float3 *values, size_t count);
+
+  /// @brief Write the contents to an array of `float3`
+  /// @param values the first `float3`, must hold `size()` vectors
+  void store(float3 *values) const;
+
+  /// @brief Get the `x` components
+  /// @returns the `x` components
+  float *x();
+
+  /// @brief Get the `x` components
+  /// @returns the `x` components
+  const float *x() const;
+
+  /// @brief Get the `y` components
+  /// @returns the `y` components
+  float *y();
+
+  /// @brief Get the `y` components
+  /// @returns the `y` components
+  const float *y() const;
+
+  /// @brief Get the `z` components
+  /// @returns the `z` components
+  float *z();
+
+  /// @brief Get the `z` components
+  /// @returns the `z` components
+  const float *z() const;
+
+ private:
+  component_array x_;
+  component_array y_;
+  component_array z_;
+};
+
+/// @brief Take `sqrt` of all values of every vector
+/// @param f3 the vectors
+/// @param out the results, resized to `f3.size()`; may be `f3`
+void sqrt(const float3_soa &f3, float3_soa &out);
+
+/// @brief Normalize every vector
+/// @param f3 the vectors
+/// @param out the results, resized to `f3.size()`; may be `f3`
+void normalize(const float3_soa &f3, float3_soa &out);
+
+/// @brief Compute the cross product of every pair of vectors
+/// @param a the left hand side vectors
+/// @param b the right hand side vectors, `b.size() == a.size()`
+/// @param out the results, resized to `a.size()`; may be `a` or `b`
+void cross(const float3_soa &a, const float3_soa &b, float3_soa &out);
+
+/// @brief Clamp every vector to a low and high bound
+/// @param value the vectors
+/// @param low the low bound (inclusive)
+/// @param high the high bound (inclusive)
+/// @param out the results, resized to `value.size()`; may be `value`
+void clamp(const float3_soa &value, const float3 &low, const float3 &high,
+           float3_soa &out);
+
+/// @brief Compute the dot product of every pair of vectors
+/// @param a the left hand side vectors
+/// @param b the right hand side vectors, `b.size() == a.size()`
+/// @param out the results, must hold `a.size()` floats
+void dot(const float3_soa &a, const float3_soa &b, float *out);
+
+/// @brief Get the length of every vector
+/// @param f3 the vectors
+/// @param out the results, must hold `f3.size()` floats
+void length(const float3_soa &f3, float *out);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+inline float3_soa::float3_soa(size_t size) : x_(size), y_(size), z_(size) {}
+
+inline float3_soa::float3_soa(const float3 *values, size_t count) {
+  load(values, count);
+}
+
+inline size_t float3_soa::size() const { return x_.size(); }
+
+inline void float3_soa::resize(size_t size) {
+  x_.resize(size);
+  y_.resize(size);
+  z_.resize(size);
+}
+
+inline float3 float3_soa::get(size_t index) const {
+  return float3{x_[index], y_[index], z_[index]};
+}
+
+inline void float3_soa::set(size_t index, const float3 &value) {
+  x_[index] = value.x();
+  y_[index] = value.y();
+  z_[index] = value.z();
+}
+
+inline void float3_soa::load(const float3 *values, size_t count) {
+  resize(count);
+
+  size_t i = 0;
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+  // four `__m128` hold `xyz0` of four vectors, transposing them yields four
+  // lanes of `x`, `y` and `z`
+  for (; i + 4 <= count; i += 4) {
+    __m128 r0 = values[i + 0].native;
+    __m128 r1 = values[i + 1].native;
+    __m128 r2 = values[i + 2].native;
+    __m128 r3 = values[i + 3].native;
+
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+    _mm_storeu_ps(&x_[i], r0);
+    _mm_storeu_ps(&y_[i], r1);
+    _mm_storeu_ps(&z_[i], r2);
+  }
+#endif
+
+  for (; i < count; i++) {
+    set(i, values[i]);
+  }
+}
+
+inline void float3_soa::store(float3 *values) const {
+  const size_t count = size();
+  size_t i = 0;
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+  for (; i + 4 <= count; i += 4) {
+    __m128 r0 = _mm_loadu_ps(&x_[i]);
+    __m128 r1 = _mm_loadu_ps(&y_[i]);
+    __m128 r2 = _mm_loadu_ps(&z_[i]);
+    __m128 r3 = _mm_setzero_ps();
+
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+    values[i + 0].native = r0;
+    values[i + 1].native = r1;
+    values[i + 2].native = r2;
+    values[i + 3].native = r3;
+  }
+#endif
+
+  for (; i < count; i++) {
+    values[i] = get(i);
+  }
+}
+
+inline float *float3_soa::x() { return x_.data(); }
+
+inline const float *float3_soa::x() const { return x_.data(); }
+
+inline float *float3_soa::y() { return y_.data(); }
+
+inline const float *float3_soa::y() const { return y_.data(); }
+
+inline float *float3_soa::z() { return z_.data(); }
+
+inline const float *float3_soa::z() const { return z_.data(); }
+
+inline void sqrt(const float3_soa &f3, float3_soa &out) {
+  out.resize(f3.size());
+
+  for_each_wide({f3.x(), f3.y(), f3.z()}, {out.x(), out.y(), out.z()},
+                f3.size(), [](const wide_float(&in)[3], wide_float(&r)[3]) {
+                  r[0] = sqrt(in[0]);
+                  r[1] = sqrt(in[1]);
+                  r[2] = sqrt(in[2]);
+                });
+}
+
+inline void normalize(const float3_soa &f3, float3_soa &out) {
+  out.resize(f3.size());
+
+  for_each_wide({f3.x(), f3.y(), f3.z()}, {out.x(), out.y(), out.z()},
+                f3.size(), [](const wide_float(&in)[3], wide_float(&r)[3]) {
+                  wide_float squared =
+                      madd(in[0], in[0], madd(in[1], in[1], in[2] * in[2]));
+                  wide_float length = sqrt(squared);
+
+                  r[0] = in[0] / length;
+                  r[1] = in[1] / length;
+                  r[2] = in[2] / length;
+                });
+}
+
+inline void cross(const float3_soa &a, const float3_soa &b, float3_soa &out) {
+  assert(a.size() == b.size());
+
+  out.resize(a.size());
+
+  for_each_wide(
+      {a.x(), a.y(), a.z(), b.x(), b.y(), b.z()}, {out.x(), out.y(), out.z()},
+      a.size(), [](const wide_float(&in)[6], wide_float(&r)[3]) {
+        r[0] = in[1] * in[5] - in[2] * in[4];
+        r[1] = in[2] * in[3] - in[0] * in[5];
+        r[2] = in[0] * in[4] - in[1] * in[3];
+      });
+}
+
+inline void clamp(const float3_soa &value, const float3 &low,
+                  const float3 &high, float3_soa &out) {
+  out.resize(value.size());
+
+  const wide_float low_x{low.x()}, low_y{low.y()}, low_z{low.z()};
+  const wide_float high_x{high.x()}, high_y{high.y()}, high_z{high.z()};
+
+  for_each_wide({value.x(), value.y(), value.z()},
+                {out.x(), out.y(), out.z()}, value.size(),
+                [&](const wide_float(&in)[3], wide_float(&r)[3]) {
+                  r[0] = clamp(in[0], low_x, high_x);
+                  r[1] = clamp(in[1], low_y, high_y);
+                  r[2] = clamp(in[2], low_z, high_z);
+                });
+}
+
+inline void dot(const float3_soa &a, const float3_soa &b, float *out) {
+  assert(a.size() == b.size());
+
+  for_each_wide({a.x(), a.y(), a.z(), b.x(), b.y(), b.z()}, {out}, a.size(),
+                [](const wide_float(&in)[6], wide_float(&r)[1]) {
+                  r[0] = madd(in[0], in[3], madd(in[1], in[4], in[2] * in[5]));
+                });
+}
+
+inline void length(const float3_soa &f3, float *out) {
+  for_each_wide({f3.x(), f3.y(), f3.z()}, {out}, f3.size(),
+                [](const wide_float(&in)[3], wide_float(&r)[1]) {
+                  r[0] = sqrt(
+                      madd(in[0], in[0], madd(in[1], in[1], in[2] * in[2])));
+                });
+}
+}  // namespace graphmath
@@ -7,14 +7,18 @@
 #pragma once
 
 #include <cmath>
+#include <type_traits>
 
+#include "graphmath/backend.h"
 #include "graphmath/float3.h"
-#include "graphmath/not_implemented.h"
+#include "graphmath/vec.h"
 
-#if defined(__APPLE__)
+#if defined(GRAPHMATH_BACKEND_APPLE)
 #include <simd/simd.h>
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
 #include <DirectXMath.h>
+#elif defined(GRAPHMATH_BACKEND_SSE)
+#include "graphmath/sse.h"
 #else
 #include <array>
 #endif
@@ -23,91 +27,121 @@
 
 namespace graphmath {
 /// @brief four `float32` numbers `(x, y, z, w)`
-struct float4 final {
+template <>
+struct vec<float, 4> final {
  public:
+  /// @brief the type of the numbers
+  using value_type = float;
+
+  /// @brief the number of numbers
+  static constexpr size_t size = 4;
+
   /// @brief the native `float3` type
-  /// `simd::float3` on Apple Platform, `DirectX::XMVECTOR` on Windows
-#if defined(__APPLE__)
+  /// `simd::float3` on Apple Platform, `DirectX::XMVECTOR` on Windows,
+  /// `__m128` on SSE4.1 capable platforms
+#if defined(GRAPHMATH_BACKEND_APPLE)
   using native_float4 = simd::float4;
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   using native_float4 = DirectX::XMVECTOR;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  using native_float4 = __m128;
 #else
   using native_float4 = std::array<float, 4>;
 #endif
 
   /// @brief create a `float4` of zeroes
-  float4();
+  GRAPHMATH_CONSTEXPR vec();
 
   /// @brief create a `float4` with values
   /// @param x x
   /// @param y y
   /// @param z z
   /// @param w w
-  float4(float x, float y, float z, float w);
+  GRAPHMATH_CONSTEXPR vec(float x, float y, float z, float w);
 
   /// @brief create a `float4` from a `float3`
   /// @param f3 the float 3
   /// @param w w
-  float4(const float3 &f3, float w = 1.0f);
+  GRAPHMATH_CONSTEXPR vec(const float3 &f3, float w = 1.0f);
 
   /// @brief copy constructor
   /// @param other another `float4`
-  float4(const float4 &other);
+  vec(const float4 &other) = default;
 
   /// @brief create a `float4` with a `native_float4`
   ///
   /// @param values the native `float4` instance
-  float4(const native_float4 &values);
+  GRAPHMATH_CONSTEXPR vec(const native_float4 &values);
 
   /// @brief Get `x` of `float4`
   /// @returns the `x` value of `float4`
-  float x() const;
+  GRAPHMATH_CONSTEXPR float x() const;
 
   /// @brief Get `y` of `float4`
   /// @returns the `y` value of `float4`
-  float y() const;
+  GRAPHMATH_CONSTEXPR float y() const;
 
   /// @brief Get `z` of `float4`
   /// @returns the `z` value of `float4`
-  float z() const;
+  GRAPHMATH_CONSTEXPR float z() const;
 
   /// @brief Get `w` of `float4`
   /// @returns the `w` value of `float4`
-  float w() const;
+  GRAPHMATH_CONSTEXPR float w() const;
 
   /// @brief Add `a` and `b`
   /// @param rhs `b`
   /// @returns the result
-  float4 operator+(const float4 &rhs) const;
+  GRAPHMATH_CONSTEXPR float4 operator+(const float4 &rhs) const;
 
   /// @brief `a - b`
   /// @param rhs `b`
   /// @returns the result
-  float4 operator-(const float4 &rhs) const;
+  GRAPHMATH_CONSTEXPR float4 operator-(const float4 &rhs) const;
 
   /// @brief Multiply all values of `float4` by a multiplier
   /// @param rhs the multiplier
   /// @returns the multiplied `float4`
-  float4 operator*(float rhs) const;
+  GRAPHMATH_CONSTEXPR float4 operator*(float rhs) const;
 
   /// @brief Component wise multiply `a` and `b`
   /// @param rhs `b`
   /// @returns the result
-  float4 operator*(const float4 &rhs) const;
+  GRAPHMATH_CONSTEXPR float4 operator*(const float4 &rhs) const;
 
   /// @brief Compare with another `float4`
   /// @param rhs another `float4`
   /// @returns true if equal; false otherwise
-  bool operator==(const float4 &rhs) const;
+  GRAPHMATH_CONSTEXPR bool operator==(const float4 &rhs) const;
 
   native_float4 native;
 };
 
+// `float4` is copied with `memcpy` by containers and has the layout of its
+// native type
+static_assert(std::is_trivially_copyable_v<float4>,
+              "float4 must be trivially copyable");
+static_assert(std::is_standard_layout_v<float4>,
+              "float4 must be standard layout");
+static_assert(sizeof(float4) == sizeof(float4::native_float4),
+              "float4 must be the size of its native type");
+static_assert(alignof(float4) == alignof(float4::native_float4),
+              "float4 must be aligned like its native type");
+
 /// @brief Compute the dot product of two `float4`
 /// @param a one `float4`
 /// @param b one `float4`
 /// @returns the result `float`
-float dot(const float4 &a, const float4 &b);
+GRAPHMATH_CONSTEXPR float dot(const float4 &a, const float4 &b);
+
+/// @brief Compute `a * b + c` component-wise, fused into one instruction when
+/// the backend has FMA
+/// @param a a
+/// @param b b
+/// @param c c
+/// @returns the result
+GRAPHMATH_CONSTEXPR float4 madd(const float4 &a, const float4 &b,
+                               const float4 &c);
 
 /// @brief Get a normalized version of `float4`
 /// @param f4 the `float4` to normalize
@@ -119,177 +153,349 @@ float4 normalize(const float4 &f4);
 /// @returns the magnitude
 float length(const float4 &f4);
 
+/// @brief Get the smaller of each pair of values
+/// Each lane is `a < b ? a : b`, see `min(const float3 &, const float3 &)`
+/// @param a one `float4`
+/// @param b one `float4`
+/// @returns the component-wise minimum
+GRAPHMATH_CONSTEXPR float4 min(const float4 &a, const float4 &b);
+
+/// @brief Get the larger of each pair of values
+/// Each lane is `a > b ? a : b`, see `max(const float3 &, const float3 &)`
+/// @param a one `float4`
+/// @param b one `float4`
+/// @returns the component-wise maximum
+GRAPHMATH_CONSTEXPR float4 max(const float4 &a, const float4 &b);
+
+/// @brief Get the absolute value of each value of a `float4`
+/// @param f4 the `float4`
+/// @returns the component-wise absolute value
+float4 abs(const float4 &f4);
+
 }  // namespace graphmath
 
 // Implementations
 
 namespace graphmath {
-inline float4::float4()
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float4::vec()
+#if defined(GRAPHMATH_BACKEND_APPLE)
     : native{simd::make_float4(0, 0, 0, 0)} {
 }
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
     : native{DirectX::XMVectorZero()} {
 }
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    : native{__m128{0.0f, 0.0f, 0.0f, 0.0f}} {
+}
 #else
-{
-  throw_not_implemented();
+    : native{{0, 0, 0, 0}} {
 }
 #endif
 
-inline float4::float4(float x, float y, float z, float w)
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float4::vec(float x, float y, float z, float w)
+#if defined(GRAPHMATH_BACKEND_APPLE)
     : native{simd::make_float4(x, y, z, w)} {
 }
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
     : native{DirectX::XMVectorSet(x, y, z, w)} {
 }
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    : native{__m128{x, y, z, w}} {
+}
 #else
-{
-  throw_not_implemented();
+    : native{{x, y, z, w}} {
 }
 #endif
 
-inline float4::float4(const float3 &f3, float w) {
-#if defined(__APPLE__)
-  native = simd::make_float4(f3.native, w);
+inline GRAPHMATH_CONSTEXPR float4::vec(const float3 &f3, float w)
+#if defined(GRAPHMATH_BACKEND_APPLE)
+    : native{simd::make_float4(f3.native, w)} {
+}
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    // 0x30: insert lane 0 of `_mm_set_ss(w)` into lane 3 of `f3.native`
+    : native{detail::is_constant_evaluated()
+                 ? __m128{f3.x(), f3.y(), f3.z(), w}
+                 : _mm_insert_ps(f3.native, _mm_set_ss(w), 0x30)} {
+}
 #else
-  throw_not_implemented();
-#endif
+    : vec(f3.x(), f3.y(), f3.z(), w) {
 }
+#endif
 
-inline float4::float4(const float4 &other) : native(other.native) {}
-
-inline float4::float4(const native_float4 &values) : native(values) {}
+inline GRAPHMATH_CONSTEXPR float4::vec(const native_float4 &values)
+    : native(values) {}
 
-inline float float4::x() const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float float4::x() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return native.x;
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   return DirectX::XMVectorGetX(native);
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::lane<0>(native);
+  }
+
+  return _mm_cvtss_f32(native);
 #else
-  throw_not_implemented();
+  return native[0];
 #endif
 }
 
-inline float float4::y() const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float float4::y() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return native.y;
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   return DirectX::XMVectorGetY(native);
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::lane<1>(native);
+  }
+
+  return _mm_cvtss_f32(
+      _mm_shuffle_ps(native, native, _MM_SHUFFLE(1, 1, 1, 1)));
 #else
-  throw_not_implemented();
+  return native[1];
 #endif
 }
 
-inline float float4::z() const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float float4::z() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return native.z;
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   return DirectX::XMVectorGetZ(native);
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::lane<2>(native);
+  }
+
+  return _mm_cvtss_f32(
+      _mm_shuffle_ps(native, native, _MM_SHUFFLE(2, 2, 2, 2)));
 #else
-  throw_not_implemented();
+  return native[2];
 #endif
 }
 
-inline float float4::w() const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float float4::w() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return native.w;
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   return DirectX::XMVectorGetW(native);
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::lane<3>(native);
+  }
+
+  return _mm_cvtss_f32(
+      _mm_shuffle_ps(native, native, _MM_SHUFFLE(3, 3, 3, 3)));
 #else
-  throw_not_implemented();
+  return native[3];
 #endif
 }
 
-inline float4 float4::operator+(const float4 &rhs) const {
-#if defined(__APPLE__)
+// Below, the SSE backend returns early unless it is evaluated at compile time,
+// in which case it shares the lane-wise code of the scalar backend
+
+inline GRAPHMATH_CONSTEXPR float4
+float4::operator+(const float4 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return float4{native + rhs.native};
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   return float4{DirectX::XMVectorAdd(native, rhs.native)};
 #else
-  throw_not_implemented();
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float4{_mm_add_ps(native, rhs.native)};
+  }
+#endif
+
+  return float4{x() + rhs.x(), y() + rhs.y(), z() + rhs.z(),
+                w() + rhs.w()};
 #endif
 }
 
-inline float4 float4::operator-(const float4 &rhs) const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float4
+float4::operator-(const float4 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return float4{native - rhs.native};
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   return float4{DirectX::XMVectorSubtract(native, rhs.native)};
 #else
-  throw_not_implemented();
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float4{_mm_sub_ps(native, rhs.native)};
+  }
+#endif
+
+  return float4{x() - rhs.x(), y() - rhs.y(), z() - rhs.z(),
+                w() - rhs.w()};
 #endif
 }
 
-inline float4 float4::operator*(float rhs) const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float4 float4::operator*(float rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return native * rhs;
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   using namespace DirectX;
 
   XMVECTOR rhs_vec = XMVectorSet(rhs, rhs, rhs, rhs);
   return float4{XMVectorMultiply(native, rhs_vec)};
 #else
-  throw_not_implemented();
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float4{_mm_mul_ps(native, _mm_set1_ps(rhs))};
+  }
+#endif
+
+  return float4{x() * rhs, y() * rhs, z() * rhs, w() * rhs};
 #endif
 }
 
-inline bool float4::operator==(const float4 &rhs) const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR bool float4::operator==(const float4 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return simd::equal(native, rhs.native);
-#elif defined(_WIN32)
-  using namespace DirectX;
-
-  XMVECTOR comparison = XMVectorEqual(native, rhs.native);
-  return XMVectorGetX(comparison) == 0xFFFFFFFF &&
-         XMVectorGetY(comparison) == 0xFFFFFFFF &&
-         XMVectorGetZ(comparison) == 0xFFFFFFFF &&
-         XMVectorGetW(comparison) == 0xFFFFFFFF;
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return DirectX::XMVector4Equal(native, rhs.native);
 #else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return _mm_movemask_ps(_mm_cmpeq_ps(native, rhs.native)) == 0xF;
+  }
+#endif
+
   return x() == rhs.x() && y() == rhs.y() && z() == rhs.z() && w() == rhs.w();
 #endif
 }
 
-inline float4 float4::operator*(const float4 &rhs) const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float4
+float4::operator*(const float4 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return float4{native * rhs.native};
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   return float4{DirectX::XMVectorMultiply(native, rhs.native)};
 #else
-  throw_not_implemented();
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float4{_mm_mul_ps(native, rhs.native)};
+  }
+#endif
+
+  return float4{x() * rhs.x(), y() * rhs.y(), z() * rhs.z(),
+                w() * rhs.w()};
 #endif
 }
 
-inline float dot(const float4 &a, const float4 &b) {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float dot(const float4 &a, const float4 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return simd::dot(a.native, b.native);
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   return DirectX::XMVectorGetX(DirectX::XMVector4Dot(a.native, b.native));
 #else
-  throw_not_implemented();
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    // 0xF1: dot `xyzw` and write the result to `x`
+    return _mm_cvtss_f32(_mm_dp_ps(a.native, b.native, 0xF1));
+  }
+#endif
+
+  return a.x() * b.x() + a.y() * b.y() + a.z() * b.z() + a.w() * b.w();
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float4 madd(const float4 &a, const float4 &b,
+                                     const float4 &c) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float4{simd::fma(a.native, b.native, c.native)};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return float4{DirectX::XMVectorMultiplyAdd(a.native, b.native, c.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float4{sse::madd(a.native, b.native, c.native)};
+  }
+#endif
+
+  return float4{a.x() * b.x() + c.x(), a.y() * b.y() + c.y(),
+                a.z() * b.z() + c.z(), a.w() * b.w() + c.w()};
 #endif
 }
 
 inline float4 normalize(const float4 &f4) {
-#if defined(__APPLE__)
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return float4{simd::normalize(f4.native)};
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   return float4{DirectX::XMVector4Normalize(f4.native)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  // 0xFF: dot `xyzw` and broadcast the result to all four lanes
+  __m128 length = _mm_sqrt_ps(_mm_dp_ps(f4.native, f4.native, 0xFF));
+  return float4{_mm_div_ps(f4.native, length)};
 #else
-  throw_not_implemented();
+  float magnitude = length(f4);
+
+  return float4{f4.x() / magnitude, f4.y() / magnitude, f4.z() / magnitude,
+                f4.w() / magnitude};
 #endif
 }
 
 inline float length(const float4 &f4) {
-#if defined(__APPLE__)
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return simd::length(f4.native);
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   using namespace DirectX;
 
   return XMVectorGetX(XMVector4Length(f4.native));
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return _mm_cvtss_f32(_mm_sqrt_ss(_mm_dp_ps(f4.native, f4.native, 0xF1)));
+#else
+  return std::sqrt(dot(f4, f4));
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float4 min(const float4 &a, const float4 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float4{simd::min(a.native, b.native)};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return float4{DirectX::XMVectorMin(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float4{_mm_min_ps(a.native, b.native)};
+  }
+#endif
+
+  return float4{
+      detail::min_lane(a.x(), b.x()), detail::min_lane(a.y(), b.y()),
+      detail::min_lane(a.z(), b.z()), detail::min_lane(a.w(), b.w())};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float4 max(const float4 &a, const float4 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float4{simd::max(a.native, b.native)};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return float4{DirectX::XMVectorMax(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float4{_mm_max_ps(a.native, b.native)};
+  }
+#endif
+
+  return float4{
+      detail::max_lane(a.x(), b.x()), detail::max_lane(a.y(), b.y()),
+      detail::max_lane(a.z(), b.z()), detail::max_lane(a.w(), b.w())};
+#endif
+}
+
+inline float4 abs(const float4 &f4) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float4{simd::abs(f4.native)};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return float4{DirectX::XMVectorAbs(f4.native)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return float4{_mm_andnot_ps(_mm_set1_ps(-0.0f), f4.native)};
 #else
-  throw_not_implemented();
+  return float4{std::abs(f4.x()), std::abs(f4.y()), std::abs(f4.z()),
+                std::abs(f4.w())};
 #endif
 }
 }  // namespace graphmath
@@ -0,0 +1,259 @@
+//
+//  float4_soa.h
+//  CS 419
+//
+//  Structure-of-arrays storage for many `float4`
+//
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "graphmath/aligned_allocator.h"
+#include "graphmath/backend.h"
+#include "graphmath/float4.h"
+#include "graphmath/wide.h"
+
+// Declarations
+
+namespace graphmath {
+/// @brief many `float4` stored as four aligned arrays `x[]`, `y[]`, `z[]`,
+/// `w[]`, so that batch kernels can work on `wide_float::lanes` vectors at a
+/// time
+class float4_soa final {
+ public:
+  /// @brief storage of one component
+  using component_array = std::vector<float, aligned_allocator<float>>;
+
+  /// @brief create an empty `float4_soa`
+  float4_soa() = default;
+
+  /// @brief create a `float4_soa` of `size` zero vectors
+  /// @param size the number of vectors
+  explicit float4_soa(size_t size);
+
+  /// @brief create a `float4_soa` from an array of `float4`
+  /// @param values the first `float4`
+  /// @param count the number of `float4`
+  float4_soa(const float4 *values, size_t count);
+
+  /// @brief Get the number of vectors
+  /// @returns the number of vectors
+  size_t size() const;
+
+  /// @brief Resize to `size` vectors, new vectors are zeroes
+  /// @param size the number of vectors
+  void resize(size_t size);
+
+  /// @brief Get the vector at `index`
+  /// @param index the index
+  /// @returns the vector
+  float4 get(size_t index) const;
+
+  /// @brief Set the vector at `index`
+  /// @param index the index
+  /// @param value the vector
+  void set(size_t index, const float4 &value);
+
+  /// @brief Replace the contents with an array of `float4`
+  /// @param values the first `float4`
+  /// @param count the number of `float4`
+  void load(const float4 *values, size_t count);
+
+  /// @brief Write the contents to an array of `float4`
+  /// @param values the first `float4`, must hold `size()` vectors
+  void store(float4 *values) const;
+
+  /// @brief Get the `x` components
+  /// @returns the `x` components
+  float *x();
+
+  /// @brief Get the `x` components
+  /// @returns the `x` components
+  const float *x() const;
+
+  /// @brief Get the `y` components
+  /// @returns the `y` components
+  float *y();
+
+  /// @brief Get the `y` components
+  /// @returns the `y` components
+  const float *y() const;
+
+  /// @brief Get the `z` components
+  /// @returns the `z` components
+  float *z();
+
+  /// @brief Get the `z` components
+  /// @returns the `z` components
+  const float *z() const;
+
+  /// @brief Get the `w` components
+  /// @returns the `w` components
+  float *w();
+
+  /// @brief Get the `w` components
+  /// @returns the `w` components
+  const float *w() const;
+
+ private:
+  component_array x_;
+  component_array y_;
+  component_array z_;
+  component_array w_;
+};
+
+/// @brief Compute the dot product of every pair of vectors
+/// @param a the left hand side vectors
+/// @param b the right hand side vectors, `b.size() == a.size()`
+/// @param out the results, must hold `a.size()` floats
+void dot(const float4_soa &a, const float4_soa &b, float *out);
+
+/// @brief Normalize every vector
+/// @param f4 the vectors
+/// @param out the results, resized to `f4.size()`; may be `f4`
+void normalize(const float4_soa &f4, float4_soa &out);
+
+/// @brief Get the length of every vector
+/// @param f4 the vectors
+/// @param out the results, must hold `f4.size()` floats
+void length(const float4_soa &f4, float *out);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+inline float4_soa::float4_soa(size_t size)
+    : x_(size), y_(size), z_(size), w_(size) {}
+
+inline float4_soa::float4_soa(const float4 *values, size_t count) {
+  load(values, count);
+}
+
+inline size_t float4_soa::size() const { return x_.size(); }
+
+inline void float4_soa::resize(size_t size) {
+  x_.resize(size);
+  y_.resize(size);
+  z_.resize(size);
+  w_.resize(size);
+}
+
+inline float4 float4_soa::get(size_t index) const {
+  return float4{x_[index], y_[index], z_[index], w_[index]};
+}
+
+inline void float4_soa::set(size_t index, const float4 &value) {
+  x_[index] = value.x();
+  y_[index] = value.y();
+  z_[index] = value.z();
+  w_[index] = value.w();
+}
+
+inline void float4_soa::load(const float4 *values, size_t count) {
+  resize(count);
+
+  size_t i = 0;
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+  for (; i + 4 <= count; i += 4) {
+    __m128 r0 = values[i + 0].native;
+    __m128 r1 = values[i + 1].native;
+    __m128 r2 = values[i + 2].native;
+    __m128 r3 = values[i + 3].native;
+
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+    _mm_storeu_ps(&x_[i], r0);
+    _mm_storeu_ps(&y_[i], r1);
+    _mm_storeu_ps(&z_[i], r2);
+    _mm_storeu_ps(&w_[i], r3);
+  }
+#endif
+
+  for (; i < count; i++) {
+    set(i, values[i]);
+  }
+}
+
+inline void float4_soa::store(float4 *values) const {
+  const size_t count = size();
+  size_t i = 0;
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+  for (; i + 4 <= count; i += 4) {
+    __m128 r0 = _mm_loadu_ps(&x_[i]);
+    __m128 r1 = _mm_loadu_ps(&y_[i]);
+    __m128 r2 = _mm_loadu_ps(&z_[i]);
+    __m128 r3 = _mm_loadu_ps(&w_[i]);
+
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+    values[i + 0].native = r0;
+    values[i + 1].native = r1;
+    values[i + 2].native = r2;
+    values[i + 3].native = r3;
+  }
+#endif
+
+  for (; i < count; i++) {
+    values[i] = get(i);
+  }
+}
+
+inline float *float4_soa::x() { return x_.data(); }
+
+inline const float *float4_soa::x() const { return x_.data(); }
+
+inline float *float4_soa::y() { return y_.data(); }
+
+inline const float *float4_soa::y() const { return y_.data(); }
+
+inline float *float4_soa::z() { return z_.data(); }
+
+inline const float *float4_soa::z() const { return z_.data(); }
+
+inline float *float4_soa::w() { return w_.data(); }
+
+inline const float *float4_soa::w() const { return w_.data(); }
+
+inline void dot(const float4_soa &a, const float4_soa &b, float *out) {
+  assert(a.size() == b.size());
+
+  for_each_wide({a.x(), a.y(), a.z(), a.w(), b.x(), b.y(), b.z(), b.w()},
+                {out}, a.size(),
+                [](const wide_float(&in)[8], wide_float(&r)[1]) {
+                  r[0] = madd(in[0], in[4],
+                              madd(in[1], in[5],
+                                   madd(in[2], in[6], in[3] * in[7])));
+                });
+}
+
+inline void normalize(const float4_soa &f4, float4_soa &out) {
+  out.resize(f4.size());
+
+  for_each_wide({f4.x(), f4.y(), f4.z(), f4.w()},
+                {out.x(), out.y(), out.z(), out.w()}, f4.size(),
+                [](const wide_float(&in)[4], wide_float(&r)[4]) {
+                  wide_float squared = madd(
+                      in[0], in[0],
+                      madd(in[1], in[1], madd(in[2], in[2], in[3] * in[3])));
+                  wide_float length = sqrt(squared);
+
+                  r[0] = in[0] / length;
+                  r[1] = in[1] / length;
+                  r[2] = in[2] / length;
+                  r[3] = in[3] / length;
+                });
+}
+
+inline void length(const float4_soa &f4, float *out) {
+  for_each_wide({f4.x(), f4.y(), f4.z(), f4.w()}, {out}, f4.size(),
+                [](const wide_float(&in)[4], wide_float(&r)[1]) {
+                  r[0] = sqrt(madd(
+                      in[0], in[0],
+                      madd(in[1], in[1], madd(in[2], in[2], in[3] * in[3]))));
+                });
+}
+}  // namespace graphmath
@@ -1,10 +1,21 @@
 #pragma once
 
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#include "graphmath/backend.h"
+#include "graphmath/float3.h"
 #include "graphmath/float4.h"
-#include "graphmath/not_implemented.h"
+#include "graphmath/span.h"
+#include "graphmath/vec.h"
 
-#if defined(__APPLE__)
+#if defined(GRAPHMATH_BACKEND_APPLE)
 #include <simd/simd.h>
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+#include <DirectXMath.h>
+#elif defined(GRAPHMATH_BACKEND_SSE)
+#include "graphmath/sse.h"
 #else
 #include <array>
 #endif
@@ -13,38 +24,54 @@
 
 namespace graphmath {
 /// @brief a 4x4 matrix
-struct float4x4 final {
+template <>
+struct mat<float, 4, 4> final {
  public:
+  /// @brief the type of the numbers
+  using value_type = float;
+
+  /// @brief the number of rows
+  static constexpr size_t rows = 4;
+
+  /// @brief the number of columns
+  static constexpr size_t columns = 4;
+
   /// @brief The native `float4x4` type
-#if defined(__APPLE__)
+#if defined(GRAPHMATH_BACKEND_APPLE)
   using native_float4x4 = simd::float4x4;
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   using native_float4x4 = DirectX::XMMATRIX;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  /// @brief four `__m128` columns, laid out like `simd::float4x4`
+  struct native_float4x4 {
+    __m128 columns[4];
+  };
 #else
+  /// @brief column major, `(y, x)` is stored at `native[x * 4 + y]`
   using native_float4x4 = std::array<float, 16>;
 #endif
 
   /// @brief Create a `float4x4` matrix using a native matrix
   /// @param native the native matrix
-  float4x4(const native_float4x4 &native);
+  GRAPHMATH_CONSTEXPR mat(const native_float4x4 &native);
 
   /// @brief Create a matrix with a single value along the diagonal
   /// @param value the value to use
-  float4x4(float value);
+  GRAPHMATH_CONSTEXPR mat(float value);
 
   /// @brief Create a matrix from four rows
   /// @param row0 row 0
   /// @param row1 row 1
   /// @param row2 row 2
   /// @param row3 row 3
-  float4x4(const float4 &row0, const float4 &row1, const float4 &row2,
-           const float4 &row3);
+  GRAPHMATH_CONSTEXPR mat(const float4 &row0, const float4 &row1,
+                               const float4 &row2, const float4 &row3);
 
   /// @brief Get the value at `(x, y)`
   /// @param y y
   /// @param x x
   /// @returns the value at `(row, column)`
-  float get(size_t y, size_t x) const;
+  GRAPHMATH_CONSTEXPR float get(size_t y, size_t x) const;
 
   /// @brief Set the value at `(x, y)`
   /// @param y y
@@ -52,46 +79,177 @@ struct float4x4 final {
   /// @param value the value at `(x, y)`
   void set(size_t y, size_t x, float value);
 
+  /// @brief a mutable view of one value of a `float4x4`, which reads and
+  /// writes the value in place
+  class element final {
+   public:
+    /// @brief create a view of the value at `(x, y)`
+    /// @param matrix the matrix, must outlive the view
+    /// @param y y
+    /// @param x x
+    GRAPHMATH_CONSTEXPR element(float4x4 &matrix, size_t y, size_t x);
+
+    /// @brief Get the value
+    /// @returns the value
+    GRAPHMATH_CONSTEXPR operator float() const;
+
+    /// @brief Set the value
+    /// @param value the new value
+    /// @returns the view
+    element &operator=(float value);
+
+    /// @brief Set the value to the value of another view
+    /// @param other the other view
+    /// @returns the view
+    element &operator=(const element &other);
+
+    /// @brief Add to the value
+    /// @param value the value to add
+    /// @returns the view
+    element &operator+=(float value);
+
+    /// @brief Subtract from the value
+    /// @param value the value to subtract
+    /// @returns the view
+    element &operator-=(float value);
+
+    /// @brief Multiply the value
+    /// @param value the value to multiply by
+    /// @returns the view
+    element &operator*=(float value);
+
+    /// @brief Divide the value
+    /// @param value the value to divide by
+    /// @returns the view
+    element &operator/=(float value);
+
+   private:
+    float4x4 &matrix_;
+    size_t y_;
+    size_t x_;
+  };
+
   /// @brief Get the value at `(x, y)`
   /// @param y y
   /// @param x x
   /// @returns the value at `(x, y)`
-  float operator()(size_t y, size_t x) const;
+  GRAPHMATH_CONSTEXPR float operator()(size_t y, size_t x) const &;
+
+  /// @brief Get a mutable view of the value at `(x, y)`, as in
+  /// `m(1, 3) = 2.0f`
+  /// @param y y
+  /// @param x x
+  /// @returns the view of the value at `(x, y)`
+  GRAPHMATH_CONSTEXPR element operator()(size_t y, size_t x) &;
+
+  /// @brief Get a row
+  /// @param y the index of the row, in `[0, 4)`
+  /// @returns row `y`
+  GRAPHMATH_CONSTEXPR float4 row(size_t y) const;
+
+  /// @brief Get a column
+  /// @param x the index of the column, in `[0, 4)`
+  /// @returns column `x`
+  GRAPHMATH_CONSTEXPR float4 column(size_t x) const;
+
+  /// @brief Set a row
+  /// @param y the index of the row, in `[0, 4)`
+  /// @param value the new row
+  void set_row(size_t y, const float4 &value);
+
+  /// @brief Set a column
+  /// @param x the index of the column, in `[0, 4)`
+  /// @param value the new column
+  void set_column(size_t x, const float4 &value);
 
   /// @brief Multiply a `float4x4` by a `float4`
   /// @param rhs the `float4`
   /// @returns the result of multiplication
-  float4 operator*(const float4 &rhs) const;
+  GRAPHMATH_CONSTEXPR float4 operator*(const float4 &rhs) const;
 
   /// @brief Multiply a `float4x4` by a `float4x4`
   /// @param rhs the `float4x4`
   /// @returns the result of multiplication
-  float4x4 operator*(const float4x4 &rhs) const;
+  GRAPHMATH_CONSTEXPR float4x4 operator*(const float4x4 &rhs) const;
 
   native_float4x4 native;
 };
 
+static_assert(std::is_trivially_copyable_v<float4x4>,
+              "float4x4 must be trivially copyable");
+static_assert(std::is_standard_layout_v<float4x4>,
+              "float4x4 must be standard layout");
+static_assert(sizeof(float4x4) == sizeof(float4x4::native_float4x4),
+              "float4x4 must be the size of its native type");
+static_assert(alignof(float4x4) == alignof(float4x4::native_float4x4),
+              "float4x4 must be aligned like its native type");
+
 /// @brief Transpose a `float4x4` matrix
 /// @param f4x4 the matrix to transpose
 /// @returns the transposed matrix
-float4x4 transpose(const float4x4 &f4x4);
+GRAPHMATH_CONSTEXPR float4x4 transpose(const float4x4 &f4x4);
+
+/// @brief Compute the determinant of a `float4x4` matrix
+/// @param f4x4 the matrix
+/// @returns the determinant
+GRAPHMATH_CONSTEXPR float determinant(const float4x4 &f4x4);
+
+/// @brief Invert a `float4x4` matrix
+/// @param f4x4 the matrix, must be invertible
+/// @returns the inverse
+GRAPHMATH_CONSTEXPR float4x4 inverse(const float4x4 &f4x4);
+
+/// @brief Invert an affine `float4x4` matrix, cheaper than `inverse`
+/// @param f4x4 the matrix, its last row must be `(0, 0, 0, 1)` and its upper
+/// 3x3 must be invertible
+/// @returns the inverse
+GRAPHMATH_CONSTEXPR float4x4 inverse_affine(const float4x4 &f4x4);
+
+/// @brief Invert many `float4x4` matrices
+/// A loop over `inverse(const float4x4 &)`: each matrix is inverted on its
+/// own, nothing is vectorized across matrices
+/// @param in the matrices, must be invertible
+/// @param out the inverses, `out.size() == in.size()`; may be `in`
+void inverse(span<const float4x4> in, span<float4x4> out);
+
+/// @brief Invert many affine `float4x4` matrices
+/// A loop over `inverse_affine(const float4x4 &)`, like `inverse`
+/// @param in the matrices, see `inverse_affine(const float4x4 &)`
+/// @param out the inverses, `out.size() == in.size()`; may be `in`
+void inverse_affine(span<const float4x4> in, span<float4x4> out);
 }  // namespace graphmath
 
 // Imlementations
 
 namespace graphmath {
-inline float4x4::float4x4(const native_float4x4 &native) : native(native) {}
+inline GRAPHMATH_CONSTEXPR float4x4::mat(const native_float4x4 &native)
+    : native(native) {}
 
-inline float4x4::float4x4(float value) {
+inline GRAPHMATH_CONSTEXPR float4x4::mat(float value)
+#if defined(GRAPHMATH_BACKEND_APPLE) || defined(GRAPHMATH_BACKEND_DIRECTX)
+{
   set(0, 0, value);
   set(1, 1, value);
   set(2, 2, value);
   set(3, 3, value);
 }
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    : native{{__m128{value, 0.0f, 0.0f, 0.0f}, __m128{0.0f, value, 0.0f, 0.0f},
+              __m128{0.0f, 0.0f, value, 0.0f},
+              __m128{0.0f, 0.0f, 0.0f, value}}} {
+}
+#else
+    : native{{value, 0.0f, 0.0f, 0.0f, 0.0f, value, 0.0f, 0.0f, 0.0f, 0.0f,
+              value, 0.0f, 0.0f, 0.0f, 0.0f, value}} {
+}
+#endif
 
-inline float4x4::float4x4(const float4 &row0, const float4 &row1,
-                          const float4 &row2, const float4 &row3) {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float4x4::mat(const float4 &row0,
+                                              const float4 &row1,
+                                              const float4 &row2,
+                                              const float4 &row3)
+#if defined(GRAPHMATH_BACKEND_APPLE)
+{
   simd::float4 col0{row0.x(), row1.x(), row2.x(), row3.x()};
   simd::float4 col1{row0.y(), row1.y(), row2.y(), row3.y()};
   simd::float4 col2{row0.z(), row1.z(), row2.z(), row3.z()};
@@ -101,77 +259,470 @@ inline float4x4::float4x4(const float4 &row0, const float4 &row1,
   native.columns[1] = col1;
   native.columns[2] = col2;
   native.columns[3] = col3;
-#elif defined(_WIN32)
-  native =
-      DirectX::XMMATRIX{row0.native, row1.native, row2.native, row3.native};
+}
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+    : native{row0.native, row1.native, row2.native, row3.native} {
+}
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    : native{{row0.native, row1.native, row2.native, row3.native}} {
+  if (!detail::is_constant_evaluated()) {
+    _MM_TRANSPOSE4_PS(native.columns[0], native.columns[1], native.columns[2],
+                      native.columns[3]);
+  } else {
+    native.columns[0] = __m128{row0.x(), row1.x(), row2.x(), row3.x()};
+    native.columns[1] = __m128{row0.y(), row1.y(), row2.y(), row3.y()};
+    native.columns[2] = __m128{row0.z(), row1.z(), row2.z(), row3.z()};
+    native.columns[3] = __m128{row0.w(), row1.w(), row2.w(), row3.w()};
+  }
+}
 #else
-  throw_not_implemented();
-#endif
+    : native{{row0.x(), row1.x(), row2.x(), row3.x(), row0.y(), row1.y(),
+              row2.y(), row3.y(), row0.z(), row1.z(), row2.z(), row3.z(),
+              row0.w(), row1.w(), row2.w(), row3.w()}} {
 }
+#endif
 
-inline float float4x4::get(size_t y, size_t x) const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float float4x4::get(size_t y, size_t x) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return native.columns[x][y];
-#elif defined(_WIN32)
-  using namespace DirectX;
-
-  XMFLOAT4X4 dump;
-
-  XMStoreFloat4x4(&dump, native);
-  return dump.m[y][x];
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return DirectX::XMVectorGetByIndex(native.r[y], x);
+#elif defined(GRAPHMATH_BACKEND_SSE)
+#if defined(_MSC_VER) && !defined(__clang__)
+  return native.columns[x].m128_f32[y];
 #else
-  throw_not_implemented();
+  return native.columns[x][y];
+#endif
+#else
+  return native[x * 4 + y];
 #endif
 }
 
 inline void float4x4::set(size_t y, size_t x, float value) {
-#if defined(__APPLE__)
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  native.columns[x][y] = value;
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  native.r[y] = DirectX::XMVectorSetByIndex(native.r[y], value, x);
+#elif defined(GRAPHMATH_BACKEND_SSE)
+#if defined(_MSC_VER) && !defined(__clang__)
+  native.columns[x].m128_f32[y] = value;
+#else
   native.columns[x][y] = value;
-#elif defined(_WIN32)
+#endif
+#else
+  native[x * 4 + y] = value;
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float float4x4::operator()(size_t y,
+                                                      size_t x) const & {
+  return get(y, x);
+}
+
+inline GRAPHMATH_CONSTEXPR float4x4::element float4x4::operator()(size_t y,
+                                                                  size_t x) & {
+  return element{*this, y, x};
+}
+
+inline GRAPHMATH_CONSTEXPR float4 float4x4::row(size_t y) const {
+  assert(y < 4);
+
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float4{simd::float4{native.columns[0][y], native.columns[1][y],
+                             native.columns[2][y], native.columns[3][y]}};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return float4{native.r[y]};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    const __m128(&c)[4] = native.columns;
+
+    // `(c0[y], c1[y], c0[y + 1], c1[y + 1])` and the same of `c2` and `c3`,
+    // for the even `y` at or below the row
+    __m128 c01 =
+        y < 2 ? _mm_unpacklo_ps(c[0], c[1]) : _mm_unpackhi_ps(c[0], c[1]);
+    __m128 c23 =
+        y < 2 ? _mm_unpacklo_ps(c[2], c[3]) : _mm_unpackhi_ps(c[2], c[3]);
+
+    return float4{y % 2 == 0 ? _mm_movelh_ps(c01, c23)
+                             : _mm_movehl_ps(c23, c01)};
+  }
+#endif
+
+  return float4{get(y, 0), get(y, 1), get(y, 2), get(y, 3)};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float4 float4x4::column(size_t x) const {
+  assert(x < 4);
+
+#if defined(GRAPHMATH_BACKEND_APPLE) || defined(GRAPHMATH_BACKEND_SSE)
+  return float4{native.columns[x]};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   using namespace DirectX;
 
-  XMFLOAT4X4 dump;
+  return float4{XMVectorSet(
+      XMVectorGetByIndex(native.r[0], x), XMVectorGetByIndex(native.r[1], x),
+      XMVectorGetByIndex(native.r[2], x), XMVectorGetByIndex(native.r[3], x))};
+#else
+  return float4{native[x * 4], native[x * 4 + 1], native[x * 4 + 2],
+                native[x * 4 + 3]};
+#endif
+}
+
+inline void float4x4::set_row(size_t y, const float4 &value) {
+  assert(y < 4);
 
-  XMStoreFloat4x4(&dump, native);
-  dump.m[y][x] = value;
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  native.columns[0][y] = value.native[0];
+  native.columns[1][y] = value.native[1];
+  native.columns[2][y] = value.native[2];
+  native.columns[3][y] = value.native[3];
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  native.r[y] = value.native;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  // lane `y` of every column takes one lane of `value`
+  __m128 mask = _mm_castsi128_ps(
+      _mm_cmpeq_epi32(_mm_set1_epi32(static_cast<int>(y)),
+                      _mm_setr_epi32(0, 1, 2, 3)));
 
-  native = XMLoadFloat4x4(&dump);
+  native.columns[0] =
+      _mm_blendv_ps(native.columns[0], sse::splat<0>(value.native), mask);
+  native.columns[1] =
+      _mm_blendv_ps(native.columns[1], sse::splat<1>(value.native), mask);
+  native.columns[2] =
+      _mm_blendv_ps(native.columns[2], sse::splat<2>(value.native), mask);
+  native.columns[3] =
+      _mm_blendv_ps(native.columns[3], sse::splat<3>(value.native), mask);
 #else
-  throw_not_implemented();
+  native[y] = value.x();
+  native[4 + y] = value.y();
+  native[8 + y] = value.z();
+  native[12 + y] = value.w();
 #endif
 }
 
-inline float float4x4::operator()(size_t y, size_t x) const {
-  return get(y, x);
+inline void float4x4::set_column(size_t x, const float4 &value) {
+  assert(x < 4);
+
+#if defined(GRAPHMATH_BACKEND_APPLE) || defined(GRAPHMATH_BACKEND_SSE)
+  native.columns[x] = value.native;
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  using namespace DirectX;
+
+  native.r[0] = XMVectorSetByIndex(native.r[0], XMVectorGetX(value.native), x);
+  native.r[1] = XMVectorSetByIndex(native.r[1], XMVectorGetY(value.native), x);
+  native.r[2] = XMVectorSetByIndex(native.r[2], XMVectorGetZ(value.native), x);
+  native.r[3] = XMVectorSetByIndex(native.r[3], XMVectorGetW(value.native), x);
+#else
+  native[x * 4] = value.x();
+  native[x * 4 + 1] = value.y();
+  native[x * 4 + 2] = value.z();
+  native[x * 4 + 3] = value.w();
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float4x4::element::element(float4x4 &matrix,
+                                                      size_t y, size_t x)
+    : matrix_(matrix), y_(y), x_(x) {}
+
+inline GRAPHMATH_CONSTEXPR float4x4::element::operator float() const {
+  return matrix_.get(y_, x_);
 }
 
-inline float4 float4x4::operator*(const float4 &rhs) const {
-#if defined(__APPLE__)
+inline float4x4::element &float4x4::element::operator=(float value) {
+  matrix_.set(y_, x_, value);
+  return *this;
+}
+
+inline float4x4::element &float4x4::element::operator=(const element &other) {
+  return *this = static_cast<float>(other);
+}
+
+inline float4x4::element &float4x4::element::operator+=(float value) {
+  return *this = static_cast<float>(*this) + value;
+}
+
+inline float4x4::element &float4x4::element::operator-=(float value) {
+  return *this = static_cast<float>(*this) - value;
+}
+
+inline float4x4::element &float4x4::element::operator*=(float value) {
+  return *this = static_cast<float>(*this) * value;
+}
+
+inline float4x4::element &float4x4::element::operator/=(float value) {
+  return *this = static_cast<float>(*this) / value;
+}
+
+// Below, the SSE backend returns early unless it is evaluated at compile time,
+// in which case it shares the code of the scalar backend, written with
+// `get` so that it works with either representation
+
+inline GRAPHMATH_CONSTEXPR float4
+float4x4::operator*(const float4 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return float4{native * rhs.native};
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   return float4{DirectX::XMVector4Transform(rhs.native, native)};
 #else
-  throw_not_implemented();
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float4{sse::multiply(native.columns, rhs.native)};
+  }
+#endif
+
+  const float v[4] = {rhs.x(), rhs.y(), rhs.z(), rhs.w()};
+  float result[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+  for (size_t x = 0; x < 4; x++) {
+    for (size_t y = 0; y < 4; y++) {
+      result[y] += get(y, x) * v[x];
+    }
+  }
+
+  return float4{result[0], result[1], result[2], result[3]};
 #endif
 }
 
-inline float4x4 float4x4::operator*(const float4x4 &rhs) const {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float4x4
+float4x4::operator*(const float4x4 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return float4x4{native * rhs.native};
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   return float4x4{DirectX::XMMatrixMultiply(native, rhs.native)};
 #else
-  throw_not_implemented();
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    native_float4x4 result{};
+
+    result.columns[0] = sse::multiply(native.columns, rhs.native.columns[0]);
+    result.columns[1] = sse::multiply(native.columns, rhs.native.columns[1]);
+    result.columns[2] = sse::multiply(native.columns, rhs.native.columns[2]);
+    result.columns[3] = sse::multiply(native.columns, rhs.native.columns[3]);
+
+    return float4x4{result};
+  }
+#endif
+
+  // row `y` of the result is the sum of the rows of `rhs`, scaled by row `y`
+  // of `this`
+  float4 rows[4];
+
+  for (size_t k = 0; k < 4; k++) {
+    float4 rhs_row{rhs(k, 0), rhs(k, 1), rhs(k, 2), rhs(k, 3)};
+
+    for (size_t y = 0; y < 4; y++) {
+      rows[y] = rows[y] + rhs_row * get(y, k);
+    }
+  }
+
+  return float4x4{rows[0], rows[1], rows[2], rows[3]};
 #endif
 }
 
-inline float4x4 transpose(const float4x4 &f4x4) {
-#if defined(__APPLE__)
+inline GRAPHMATH_CONSTEXPR float4x4 transpose(const float4x4 &f4x4) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
   return float4x4{simd::transpose(f4x4.native)};
-#elif defined(_WIN32)
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
   return float4x4{DirectX::XMMatrixTranspose(f4x4.native)};
 #else
-  throw_not_implemented();
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    float4x4::native_float4x4 result = f4x4.native;
+
+    _MM_TRANSPOSE4_PS(result.columns[0], result.columns[1], result.columns[2],
+                      result.columns[3]);
+
+    return float4x4{result};
+  }
+#endif
+
+  const float4x4 &m = f4x4;
+
+  // the rows of the transpose are the columns of `m`
+  return float4x4{float4{m(0, 0), m(1, 0), m(2, 0), m(3, 0)},
+                  float4{m(0, 1), m(1, 1), m(2, 1), m(3, 1)},
+                  float4{m(0, 2), m(1, 2), m(2, 2), m(3, 2)},
+                  float4{m(0, 3), m(1, 3), m(2, 3), m(3, 3)}};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float determinant(const float4x4 &f4x4) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd::determinant(f4x4.native);
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return DirectX::XMVectorGetX(DirectX::XMMatrixDeterminant(f4x4.native));
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return _mm_cvtss_f32(sse::determinant(f4x4.native.columns));
+  }
+#endif
+
+  const float4x4 &m = f4x4;
+
+  // expand along the first two rows using their 2x2 minors
+  float s0 = m(0, 0) * m(1, 1) - m(1, 0) * m(0, 1);
+  float s1 = m(0, 0) * m(1, 2) - m(1, 0) * m(0, 2);
+  float s2 = m(0, 0) * m(1, 3) - m(1, 0) * m(0, 3);
+  float s3 = m(0, 1) * m(1, 2) - m(1, 1) * m(0, 2);
+  float s4 = m(0, 1) * m(1, 3) - m(1, 1) * m(0, 3);
+  float s5 = m(0, 2) * m(1, 3) - m(1, 2) * m(0, 3);
+
+  float c0 = m(2, 0) * m(3, 1) - m(3, 0) * m(2, 1);
+  float c1 = m(2, 0) * m(3, 2) - m(3, 0) * m(2, 2);
+  float c2 = m(2, 0) * m(3, 3) - m(3, 0) * m(2, 3);
+  float c3 = m(2, 1) * m(3, 2) - m(3, 1) * m(2, 2);
+  float c4 = m(2, 1) * m(3, 3) - m(3, 1) * m(2, 3);
+  float c5 = m(2, 2) * m(3, 3) - m(3, 2) * m(2, 3);
+
+  return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
 #endif
 }
+
+inline GRAPHMATH_CONSTEXPR float4x4 inverse(const float4x4 &f4x4) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float4x4{simd::inverse(f4x4.native)};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return float4x4{DirectX::XMMatrixInverse(nullptr, f4x4.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    float4x4::native_float4x4 result{};
+
+    sse::inverse(f4x4.native.columns, result.columns);
+
+    return float4x4{result};
+  }
+#endif
+
+  const float4x4 &m = f4x4;
+
+  float s0 = m(0, 0) * m(1, 1) - m(1, 0) * m(0, 1);
+  float s1 = m(0, 0) * m(1, 2) - m(1, 0) * m(0, 2);
+  float s2 = m(0, 0) * m(1, 3) - m(1, 0) * m(0, 3);
+  float s3 = m(0, 1) * m(1, 2) - m(1, 1) * m(0, 2);
+  float s4 = m(0, 1) * m(1, 3) - m(1, 1) * m(0, 3);
+  float s5 = m(0, 2) * m(1, 3) - m(1, 2) * m(0, 3);
+
+  float c0 = m(2, 0) * m(3, 1) - m(3, 0) * m(2, 1);
+  float c1 = m(2, 0) * m(3, 2) - m(3, 0) * m(2, 2);
+  float c2 = m(2, 0) * m(3, 3) - m(3, 0) * m(2, 3);
+  float c3 = m(2, 1) * m(3, 2) - m(3, 1) * m(2, 2);
+  float c4 = m(2, 1) * m(3, 3) - m(3, 1) * m(2, 3);
+  float c5 = m(2, 2) * m(3, 3) - m(3, 2) * m(2, 3);
+
+  float scale =
+      1.0f / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+
+  // the transposed cofactors, scaled by `1 / |m|`
+  return float4x4{
+      float4{m(1, 1) * c5 - m(1, 2) * c4 + m(1, 3) * c3,
+             -m(0, 1) * c5 + m(0, 2) * c4 - m(0, 3) * c3,
+             m(3, 1) * s5 - m(3, 2) * s4 + m(3, 3) * s3,
+             -m(2, 1) * s5 + m(2, 2) * s4 - m(2, 3) * s3} *
+          scale,
+      float4{-m(1, 0) * c5 + m(1, 2) * c2 - m(1, 3) * c1,
+             m(0, 0) * c5 - m(0, 2) * c2 + m(0, 3) * c1,
+             -m(3, 0) * s5 + m(3, 2) * s2 - m(3, 3) * s1,
+             m(2, 0) * s5 - m(2, 2) * s2 + m(2, 3) * s1} *
+          scale,
+      float4{m(1, 0) * c4 - m(1, 1) * c2 + m(1, 3) * c0,
+             -m(0, 0) * c4 + m(0, 1) * c2 - m(0, 3) * c0,
+             m(3, 0) * s4 - m(3, 1) * s2 + m(3, 3) * s0,
+             -m(2, 0) * s4 + m(2, 1) * s2 - m(2, 3) * s0} *
+          scale,
+      float4{-m(1, 0) * c3 + m(1, 1) * c1 - m(1, 2) * c0,
+             m(0, 0) * c3 - m(0, 1) * c1 + m(0, 2) * c0,
+             -m(3, 0) * s3 + m(3, 1) * s1 - m(3, 2) * s0,
+             m(2, 0) * s3 - m(2, 1) * s1 + m(2, 2) * s0} *
+          scale};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float4x4 inverse_affine(const float4x4 &f4x4) {
+  // the inverse of the upper 3x3 has the rows `b x c`, `c x a` and `a x b`
+  // scaled by `1 / |a b c|`, where `a`, `b` and `c` are its columns
+#if defined(GRAPHMATH_BACKEND_DIRECTX)
+  // the rows of the transpose are the columns `a`, `b`, `c` and `t`
+  DirectX::XMMATRIX columns = DirectX::XMMatrixTranspose(f4x4.native);
+  DirectX::XMVECTOR a = columns.r[0];
+  DirectX::XMVECTOR b = columns.r[1];
+  DirectX::XMVECTOR c = columns.r[2];
+  DirectX::XMVECTOR t = columns.r[3];
+
+  DirectX::XMVECTOR b_c = DirectX::XMVector3Cross(b, c);
+  DirectX::XMVECTOR scale =
+      DirectX::XMVectorReciprocal(DirectX::XMVector3Dot(a, b_c));
+
+  DirectX::XMVECTOR rows[3] = {
+      DirectX::XMVectorMultiply(b_c, scale),
+      DirectX::XMVectorMultiply(DirectX::XMVector3Cross(c, a), scale),
+      DirectX::XMVectorMultiply(DirectX::XMVector3Cross(a, b), scale)};
+
+  // the translation is `-inverse(upper 3x3) * t`, moved into `w`
+  DirectX::XMMATRIX result;
+
+  for (int i = 0; i < 3; i++) {
+    DirectX::XMVECTOR translation =
+        DirectX::XMVectorNegate(DirectX::XMVector3Dot(rows[i], t));
+    result.r[i] =
+        DirectX::XMVectorSelect(rows[i], translation, DirectX::g_XMSelect0001);
+  }
+
+  result.r[3] = DirectX::g_XMIdentityR3;
+
+  return float4x4{result};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    float4x4::native_float4x4 result{};
+
+    sse::inverse_affine(f4x4.native.columns, result.columns);
+
+    return float4x4{result};
+  }
+#endif
+
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  float3 a{f4x4.native.columns[0].xyz};
+  float3 b{f4x4.native.columns[1].xyz};
+  float3 c{f4x4.native.columns[2].xyz};
+  float3 t{f4x4.native.columns[3].xyz};
+#else
+  float3 a{f4x4(0, 0), f4x4(1, 0), f4x4(2, 0)};
+  float3 b{f4x4(0, 1), f4x4(1, 1), f4x4(2, 1)};
+  float3 c{f4x4(0, 2), f4x4(1, 2), f4x4(2, 2)};
+  float3 t{f4x4(0, 3), f4x4(1, 3), f4x4(2, 3)};
+#endif
+
+  float3 b_c = cross(b, c);
+  float scale = 1.0f / dot(a, b_c);
+
+  float3 row0 = b_c * scale;
+  float3 row1 = cross(c, a) * scale;
+  float3 row2 = cross(a, b) * scale;
+
+  // the translation is `-inverse(upper 3x3) * t`
+  return float4x4{float4{row0, -dot(row0, t)}, float4{row1, -dot(row1, t)},
+                  float4{row2, -dot(row2, t)}, float4{0.0f, 0.0f, 0.0f, 1.0f}};
+#endif
+}
+
+inline void inverse(span<const float4x4> in, span<float4x4> out) {
+  assert(in.size() == out.size());
+
+  for (size_t i = 0; i < in.size(); i++) {
+    out[i] = inverse(in[i]);
+  }
+}
+
+inline void inverse_affine(span<const float4x4> in, span<float4x4> out) {
+  assert(in.size() == out.size());
+
+  for (size_t i = 0; i < in.size(); i++) {
+    out[i] = inverse_affine(in[i]);
+  }
+}
 }  // namespace graphmath
@@ -0,0 +1,403 @@
+//
+//  frustum.h
+//  CS 419
+//
+//  View frustums and culling of bounding volumes against them
+//
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "graphmath/aabb.h"
+#include "graphmath/backend.h"
+#include "graphmath/bounding_sphere.h"
+#include "graphmath/float3.h"
+#include "graphmath/float4.h"
+#include "graphmath/float4x4.h"
+#include "graphmath/span.h"
+
+#if defined(GRAPHMATH_BACKEND_AVX2)
+#include <immintrin.h>
+#endif
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+#include "graphmath/sse.h"
+#endif
+
+// Declarations
+
+namespace graphmath {
+/// @brief the six planes around what a camera sees
+struct frustum final {
+ public:
+  /// @brief Extract the planes of a view-projection matrix
+  /// The matrix maps the visible volume to `x` and `y` in `[-1, 1]` and `z`
+  /// in `[0, 1]`, like the projections of `transform.h`
+  /// @param view_projection the view-projection matrix
+  explicit frustum(const float4x4 &view_projection);
+
+  /// @brief the left, right, bottom, top, near and far planes as `(normal,
+  /// distance)`, with unit normals pointing inside: a point `p` is inside a
+  /// plane when `dot(normal, p) + distance >= 0`
+  float4 planes[6];
+};
+
+/// @brief Check if a box is at least partly inside a frustum
+/// The test is conservative: a box outside the frustum but near one of its
+/// edges, and inside every plane, counts as visible
+/// @param f the frustum
+/// @param box the box, not empty
+/// @returns false if `box` is fully outside a plane of `f`; true otherwise
+bool intersects(const frustum &f, const aabb &box);
+
+/// @brief Check if a sphere is at least partly inside a frustum
+/// Conservative like `intersects(const frustum &, const aabb &)`
+/// @param f the frustum
+/// @param sphere the sphere
+/// @returns false if `sphere` is fully outside a plane of `f`; true otherwise
+bool intersects(const frustum &f, const bounding_sphere &sphere);
+
+/// @brief Test many boxes against a frustum, 8 per iteration with AVX2
+/// @param f the frustum
+/// @param boxes the boxes, not empty
+/// @param visible one bit per box: bit `i % 8` of `visible[i / 8]` is
+/// `intersects(f, boxes[i])`, the bits past the last box are zero;
+/// `visible.size() == (boxes.size() + 7) / 8`
+void cull(const frustum &f, span<const aabb> boxes,
+          span<std::uint8_t> visible);
+
+/// @brief Test many spheres against a frustum, 8 per iteration with AVX2
+/// @param f the frustum
+/// @param spheres the spheres
+/// @param visible one bit per sphere, like `cull` of boxes;
+/// `visible.size() == (spheres.size() + 7) / 8`
+void cull(const frustum &f, span<const bounding_sphere> spheres,
+          span<std::uint8_t> visible);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+inline frustum::frustum(const float4x4 &view_projection) {
+  const float4x4 &m = view_projection;
+
+  float4 row0 = m.row(0);
+  float4 row1 = m.row(1);
+  float4 row2 = m.row(2);
+  float4 row3 = m.row(3);
+
+  // a clip space point `c` is inside when `-w <= x <= w`, `-w <= y <= w`
+  // and `0 <= z <= w`, and `c = m * p` turns each into a plane of `p`
+  planes[0] = row3 + row0;
+  planes[1] = row3 - row0;
+  planes[2] = row3 + row1;
+  planes[3] = row3 - row1;
+  planes[4] = row2;
+  planes[5] = row3 - row2;
+
+  for (float4 &plane : planes) {
+    plane = plane * (1.0f / length(float3{plane.x(), plane.y(), plane.z()}));
+  }
+}
+
+inline bool intersects(const frustum &f, const aabb &box) {
+  float3 c = center(box);
+  float3 e = half_extents(box);
+
+  // the corner furthest along the normal is `dot(|normal|, e)` past `c`
+  for (const float4 &plane : f.planes) {
+    float3 normal{plane.x(), plane.y(), plane.z()};
+
+    if (dot(normal, c) + dot(abs(normal), e) + plane.w() < 0.0f) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+inline bool intersects(const frustum &f, const bounding_sphere &sphere) {
+  float3 c = sphere.center();
+
+  for (const float4 &plane : f.planes) {
+    float3 normal{plane.x(), plane.y(), plane.z()};
+
+    if (dot(normal, c) + plane.w() + sphere.radius() < 0.0f) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+namespace detail {
+/// @brief Write the visibility bits of up to 8 volumes starting at `first`
+inline void write_visible(span<std::uint8_t> visible, size_t first,
+                          unsigned bits) {
+  std::uint8_t &byte = visible[first / 8];
+  unsigned shift = first % 8;
+
+  byte = static_cast<std::uint8_t>(shift == 0 ? bits : byte | bits << shift);
+}
+
+#if defined(GRAPHMATH_BACKEND_AVX2)
+/// @brief the planes of a frustum, each component broadcast to 8 lanes
+struct frustum_planes_x8 {
+  explicit frustum_planes_x8(const frustum &f) {
+    for (size_t i = 0; i < 6; i++) {
+      __m128 plane = f.planes[i].native;
+      __m128 magnitude = _mm_andnot_ps(_mm_set1_ps(-0.0f), plane);
+
+      normal_x[i] = _mm256_broadcastss_ps(sse::splat<0>(plane));
+      normal_y[i] = _mm256_broadcastss_ps(sse::splat<1>(plane));
+      normal_z[i] = _mm256_broadcastss_ps(sse::splat<2>(plane));
+      distance[i] = _mm256_broadcastss_ps(sse::splat<3>(plane));
+      abs_normal_x[i] = _mm256_broadcastss_ps(sse::splat<0>(magnitude));
+      abs_normal_y[i] = _mm256_broadcastss_ps(sse::splat<1>(magnitude));
+      abs_normal_z[i] = _mm256_broadcastss_ps(sse::splat<2>(magnitude));
+    }
+  }
+
+  __m256 normal_x[6], normal_y[6], normal_z[6], distance[6];
+  __m256 abs_normal_x[6], abs_normal_y[6], abs_normal_z[6];
+};
+#endif
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+/// @brief the planes of a frustum, each component broadcast to 4 lanes
+struct frustum_planes_x4 {
+  explicit frustum_planes_x4(const frustum &f) {
+    for (size_t i = 0; i < 6; i++) {
+      __m128 plane = f.planes[i].native;
+      __m128 magnitude = _mm_andnot_ps(_mm_set1_ps(-0.0f), plane);
+
+      normal_x[i] = sse::splat<0>(plane);
+      normal_y[i] = sse::splat<1>(plane);
+      normal_z[i] = sse::splat<2>(plane);
+      distance[i] = sse::splat<3>(plane);
+      abs_normal_x[i] = sse::splat<0>(magnitude);
+      abs_normal_y[i] = sse::splat<1>(magnitude);
+      abs_normal_z[i] = sse::splat<2>(magnitude);
+    }
+  }
+
+  __m128 normal_x[6], normal_y[6], normal_z[6], distance[6];
+  __m128 abs_normal_x[6], abs_normal_y[6], abs_normal_z[6];
+};
+#endif
+}  // namespace detail
+
+inline void cull(const frustum &f, span<const aabb> boxes,
+                 span<std::uint8_t> visible) {
+  assert(visible.size() == (boxes.size() + 7) / 8);
+
+  size_t i = 0;
+
+  // with `c` the center and `e` the half extents, a box is outside a plane
+  // when `dot(n, c) + dot(|n|, e) + d < 0`; both sides are doubled below to
+  // work on `upper + lower` and `upper - lower`
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (boxes.size() >= 8) {
+    detail::frustum_planes_x8 planes{f};
+
+    for (; i + 8 <= boxes.size(); i += 8) {
+      // each box is one `(lower | upper)` register, the transpose makes
+      // `(lower.x of 8 boxes)` and so on
+      const float *data = reinterpret_cast<const float *>(boxes.data() + i);
+      __m256 r[8];
+
+      for (size_t k = 0; k < 8; k++) {
+        r[k] = _mm256_loadu_ps(data + 8 * k);
+      }
+
+      __m256 x[2], y[2], z[2];
+
+      for (size_t half = 0; half < 2; half++) {
+        __m256 *q = r + 4 * half;
+
+        __m256 t0 = _mm256_unpacklo_ps(q[0], q[1]);
+        __m256 t1 = _mm256_unpackhi_ps(q[0], q[1]);
+        __m256 t2 = _mm256_unpacklo_ps(q[2], q[3]);
+        __m256 t3 = _mm256_unpackhi_ps(q[2], q[3]);
+
+        x[half] = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        y[half] = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        z[half] = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+      }
+
+      // 0x20: the lower halves of both, `lower`; 0x31: the upper halves
+      __m256 lower_x = _mm256_permute2f128_ps(x[0], x[1], 0x20);
+      __m256 lower_y = _mm256_permute2f128_ps(y[0], y[1], 0x20);
+      __m256 lower_z = _mm256_permute2f128_ps(z[0], z[1], 0x20);
+      __m256 upper_x = _mm256_permute2f128_ps(x[0], x[1], 0x31);
+      __m256 upper_y = _mm256_permute2f128_ps(y[0], y[1], 0x31);
+      __m256 upper_z = _mm256_permute2f128_ps(z[0], z[1], 0x31);
+
+      __m256 sum_x = _mm256_add_ps(upper_x, lower_x);
+      __m256 sum_y = _mm256_add_ps(upper_y, lower_y);
+      __m256 sum_z = _mm256_add_ps(upper_z, lower_z);
+      __m256 size_x = _mm256_sub_ps(upper_x, lower_x);
+      __m256 size_y = _mm256_sub_ps(upper_y, lower_y);
+      __m256 size_z = _mm256_sub_ps(upper_z, lower_z);
+
+      __m256 nearest = _mm256_set1_ps(0.0f);
+
+      for (size_t p = 0; p < 6; p++) {
+        __m256 d = _mm256_add_ps(planes.distance[p], planes.distance[p]);
+
+        d = _mm256_fmadd_ps(planes.normal_x[p], sum_x, d);
+        d = _mm256_fmadd_ps(planes.normal_y[p], sum_y, d);
+        d = _mm256_fmadd_ps(planes.normal_z[p], sum_z, d);
+        d = _mm256_fmadd_ps(planes.abs_normal_x[p], size_x, d);
+        d = _mm256_fmadd_ps(planes.abs_normal_y[p], size_y, d);
+        d = _mm256_fmadd_ps(planes.abs_normal_z[p], size_z, d);
+
+        nearest = p == 0 ? d : _mm256_min_ps(nearest, d);
+      }
+
+      __m256 inside = _mm256_cmp_ps(nearest, _mm256_setzero_ps(), _CMP_GE_OQ);
+      visible[i / 8] = static_cast<std::uint8_t>(_mm256_movemask_ps(inside));
+    }
+  }
+#endif
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (boxes.size() - i >= 4) {
+    detail::frustum_planes_x4 planes{f};
+
+    for (; i + 4 <= boxes.size(); i += 4) {
+      __m128 lower_x = boxes[i].lower.native;
+      __m128 lower_y = boxes[i + 1].lower.native;
+      __m128 lower_z = boxes[i + 2].lower.native;
+      __m128 lower_w = boxes[i + 3].lower.native;
+      __m128 upper_x = boxes[i].upper.native;
+      __m128 upper_y = boxes[i + 1].upper.native;
+      __m128 upper_z = boxes[i + 2].upper.native;
+      __m128 upper_w = boxes[i + 3].upper.native;
+
+      _MM_TRANSPOSE4_PS(lower_x, lower_y, lower_z, lower_w);
+      _MM_TRANSPOSE4_PS(upper_x, upper_y, upper_z, upper_w);
+
+      __m128 sum_x = _mm_add_ps(upper_x, lower_x);
+      __m128 sum_y = _mm_add_ps(upper_y, lower_y);
+      __m128 sum_z = _mm_add_ps(upper_z, lower_z);
+      __m128 size_x = _mm_sub_ps(upper_x, lower_x);
+      __m128 size_y = _mm_sub_ps(upper_y, lower_y);
+      __m128 size_z = _mm_sub_ps(upper_z, lower_z);
+
+      __m128 nearest = _mm_setzero_ps();
+
+      for (size_t p = 0; p < 6; p++) {
+        __m128 d = _mm_add_ps(planes.distance[p], planes.distance[p]);
+
+        d = sse::madd(planes.normal_x[p], sum_x, d);
+        d = sse::madd(planes.normal_y[p], sum_y, d);
+        d = sse::madd(planes.normal_z[p], sum_z, d);
+        d = sse::madd(planes.abs_normal_x[p], size_x, d);
+        d = sse::madd(planes.abs_normal_y[p], size_y, d);
+        d = sse::madd(planes.abs_normal_z[p], size_z, d);
+
+        nearest = p == 0 ? d : _mm_min_ps(nearest, d);
+      }
+
+      __m128 inside = _mm_cmpge_ps(nearest, _mm_setzero_ps());
+      detail::write_visible(visible, i,
+                            static_cast<unsigned>(_mm_movemask_ps(inside)));
+    }
+  }
+#endif
+
+  for (; i < boxes.size(); i++) {
+    detail::write_visible(visible, i, intersects(f, boxes[i]) ? 1 : 0);
+  }
+}
+
+inline void cull(const frustum &f, span<const bounding_sphere> spheres,
+                 span<std::uint8_t> visible) {
+  assert(visible.size() == (spheres.size() + 7) / 8);
+
+  size_t i = 0;
+
+  // a sphere is outside a plane when `dot(n, center) + d + radius < 0`
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if (spheres.size() >= 8) {
+    detail::frustum_planes_x8 planes{f};
+
+    for (; i + 8 <= spheres.size(); i += 8) {
+      // spheres `k` and `k + 4` share a register, the transpose of each half
+      // makes `(center.x of 8 spheres)` and so on
+      __m256 r[4];
+
+      for (size_t k = 0; k < 4; k++) {
+        r[k] = _mm256_insertf128_ps(
+            _mm256_castps128_ps256(spheres[i + k].center_radius.native),
+            spheres[i + k + 4].center_radius.native, 1);
+      }
+
+      __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+      __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+      __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+      __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+
+      __m256 center_x = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+      __m256 center_y = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+      __m256 center_z = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+      __m256 radius = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+
+      __m256 nearest = _mm256_setzero_ps();
+
+      for (size_t p = 0; p < 6; p++) {
+        __m256 d = _mm256_add_ps(planes.distance[p], radius);
+
+        d = _mm256_fmadd_ps(planes.normal_x[p], center_x, d);
+        d = _mm256_fmadd_ps(planes.normal_y[p], center_y, d);
+        d = _mm256_fmadd_ps(planes.normal_z[p], center_z, d);
+
+        nearest = p == 0 ? d : _mm256_min_ps(nearest, d);
+      }
+
+      __m256 inside = _mm256_cmp_ps(nearest, _mm256_setzero_ps(), _CMP_GE_OQ);
+      visible[i / 8] = static_cast<std::uint8_t>(_mm256_movemask_ps(inside));
+    }
+  }
+#endif
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (spheres.size() - i >= 4) {
+    detail::frustum_planes_x4 planes{f};
+
+    for (; i + 4 <= spheres.size(); i += 4) {
+      __m128 center_x = spheres[i].center_radius.native;
+      __m128 center_y = spheres[i + 1].center_radius.native;
+      __m128 center_z = spheres[i + 2].center_radius.native;
+      __m128 radius = spheres[i + 3].center_radius.native;
+
+      _MM_TRANSPOSE4_PS(center_x, center_y, center_z, radius);
+
+      __m128 nearest = _mm_setzero_ps();
+
+      for (size_t p = 0; p < 6; p++) {
+        __m128 d = _mm_add_ps(planes.distance[p], radius);
+
+        d = sse::madd(planes.normal_x[p], center_x, d);
+        d = sse::madd(planes.normal_y[p], center_y, d);
+        d = sse::madd(planes.normal_z[p], center_z, d);
+
+        nearest = p == 0 ? d : _mm_min_ps(nearest, d);
+      }
+
+      __m128 inside = _mm_cmpge_ps(nearest, _mm_setzero_ps());
+      detail::write_visible(visible, i,
+                            static_cast<unsigned>(_mm_movemask_ps(inside)));
+    }
+  }
+#endif
+
+  for (; i < spheres.size(); i++) {
+    detail::write_visible(visible, i, intersects(f, spheres[i]) ? 1 : 0);
+  }
+}
+}  // namespace graphmath
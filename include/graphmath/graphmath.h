@@ -1,7 +1,36 @@
 #pragma once
 
+#include "graphmath/aabb.h"
+#include "graphmath/aligned_allocator.h"
+#include "graphmath/backend.h"
+#include "graphmath/binary.h"
+#include "graphmath/bounding_sphere.h"
+#include "graphmath/bvh.h"
+#include "graphmath/double3.h"
+#include "graphmath/double4.h"
+#include "graphmath/double4x4.h"
+#include "graphmath/expression.h"
+#include "graphmath/fast.h"
 #include "graphmath/float3.h"
+#include "graphmath/float3_soa.h"
 #include "graphmath/float4.h"
+#include "graphmath/float4_soa.h"
 #include "graphmath/float4x4.h"
+#include "graphmath/frustum.h"
+#include "graphmath/half.h"
+#include "graphmath/int3.h"
+#include "graphmath/int4.h"
+#include "graphmath/mask.h"
 #include "graphmath/not_implemented.h"
+#include "graphmath/packed_float3.h"
+#include "graphmath/parse.h"
 #include "graphmath/print.h"
+#include "graphmath/quaternion.h"
+#include "graphmath/ray.h"
+#include "graphmath/ray_aabb.h"
+#include "graphmath/span.h"
+#include "graphmath/transform.h"
+#include "graphmath/transform_batch.h"
+#include "graphmath/transform_hierarchy.h"
+#include "graphmath/vec.h"
+#include "graphmath/wide.h"
@@ -0,0 +1,353 @@
+//
+//  half.h
+//  CS 419
+//
+//  Half precision storage for `float3` and `float4`
+//
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "graphmath/backend.h"
+#include "graphmath/float3.h"
+#include "graphmath/float4.h"
+#include "graphmath/span.h"
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+#include "graphmath/sse.h"
+#endif
+
+// Every processor with AVX2 has F16C, which the `avx2` backend enables with
+// `-mf16c`; MSVC has no macro for it and takes `/arch:AVX2` instead
+#if defined(GRAPHMATH_BACKEND_SSE) && \
+    (defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__)))
+#define GRAPHMATH_HAS_F16C
+#include <immintrin.h>
+#endif
+
+// Declarations
+
+namespace graphmath {
+/// @brief three IEEE 754 `binary16` numbers `(x, y, z)`, for vertex
+/// attributes that don't need the precision of `float`
+/// Arrays of `half3` are half the size of `packed_float3`, and are converted
+/// in bulk with `to_half` and `to_float`. Conversions round to the nearest
+/// `binary16`, ties to even; values past `65504` become infinite
+struct half3 final {
+ public:
+  /// @brief create a `half3` of zeroes
+  constexpr half3() = default;
+
+  /// @brief create a `half3` with values
+  /// @param x x
+  /// @param y y
+  /// @param z z
+  half3(float x, float y, float z);
+
+  /// @brief create a `half3` from a `float3`
+  /// @param f3 the `float3`
+  explicit half3(const float3 &f3);
+
+  /// @brief Get `x` of `half3`
+  /// @returns the `x` value of `half3`
+  float x() const;
+
+  /// @brief Get `y` of `half3`
+  /// @returns the `y` value of `half3`
+  float y() const;
+
+  /// @brief Get `z` of `half3`
+  /// @returns the `z` value of `half3`
+  float z() const;
+
+  /// @brief Convert to a `float3`
+  /// @returns the `float3`
+  float3 to_float3() const;
+
+  /// @brief the `binary16` bits of `x`, `y` and `z`
+  uint16_t native[3] = {0, 0, 0};
+};
+
+/// @brief four IEEE 754 `binary16` numbers `(x, y, z, w)`, like `half3`
+struct half4 final {
+ public:
+  /// @brief create a `half4` of zeroes
+  constexpr half4() = default;
+
+  /// @brief create a `half4` with values
+  /// @param x x
+  /// @param y y
+  /// @param z z
+  /// @param w w
+  half4(float x, float y, float z, float w);
+
+  /// @brief create a `half4` from a `float4`
+  /// @param f4 the `float4`
+  explicit half4(const float4 &f4);
+
+  /// @brief Get `x` of `half4`
+  /// @returns the `x` value of `half4`
+  float x() const;
+
+  /// @brief Get `y` of `half4`
+  /// @returns the `y` value of `half4`
+  float y() const;
+
+  /// @brief Get `z` of `half4`
+  /// @returns the `z` value of `half4`
+  float z() const;
+
+  /// @brief Get `w` of `half4`
+  /// @returns the `w` value of `half4`
+  float w() const;
+
+  /// @brief Convert to a `float4`
+  /// @returns the `float4`
+  float4 to_float4() const;
+
+  /// @brief the `binary16` bits of `x`, `y`, `z` and `w`
+  uint16_t native[4] = {0, 0, 0, 0};
+};
+
+static_assert(sizeof(half3) == 3 * sizeof(uint16_t),
+              "half3 must not be padded");
+static_assert(sizeof(half4) == 4 * sizeof(uint16_t),
+              "half4 must not be padded");
+static_assert(std::is_trivially_copyable_v<half3> &&
+                  std::is_trivially_copyable_v<half4>,
+              "half3 and half4 must be trivially copyable");
+static_assert(std::is_standard_layout_v<half3> &&
+                  std::is_standard_layout_v<half4>,
+              "half3 and half4 must be standard layout");
+
+/// @brief Convert many `float3` to `half3`, with F16C when available
+/// @param in the vectors
+/// @param out the half precision vectors, `out.size() == in.size()`
+void to_half(span<const float3> in, span<half3> out);
+
+/// @brief Convert many `float4` to `half4`, with F16C when available
+/// @param in the vectors
+/// @param out the half precision vectors, `out.size() == in.size()`
+void to_half(span<const float4> in, span<half4> out);
+
+/// @brief Convert many `half3` to `float3`, with F16C when available
+/// @param in the half precision vectors
+/// @param out the vectors, `out.size() == in.size()`
+void to_float(span<const half3> in, span<float3> out);
+
+/// @brief Convert many `half4` to `float4`, with F16C when available
+/// @param in the half precision vectors
+/// @param out the vectors, `out.size() == in.size()`
+void to_float(span<const half4> in, span<float4> out);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+namespace detail {
+/// @brief Round a `float` to `binary16` bits, to nearest with ties to even
+/// (Giesen, "float_to_half_fast3_rtne"); NaN becomes a quiet NaN
+inline uint16_t float_to_half(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  uint32_t sign = bits & 0x80000000u;
+  bits ^= sign;
+
+  uint32_t half;
+
+  if (bits >= 0x47800000u) {
+    // `65536` and up, infinity and NaN
+    half = bits > 0x7f800000u ? 0x7e00u : 0x7c00u;
+  } else if (bits < 0x38800000u) {
+    // below `2^-14`: adding `0.5f` rounds to a multiple of `2^-24`, the
+    // subnormal step of `binary16`, in the low bits of the mantissa
+    float magnitude;
+    std::memcpy(&magnitude, &bits, sizeof(magnitude));
+    magnitude += 0.5f;
+    std::memcpy(&bits, &magnitude, sizeof(bits));
+
+    half = bits - 0x3f000000u;
+  } else {
+    // rebias the exponent, and round the 13 dropped bits; a carry moves
+    // into the exponent, up to infinity
+    uint32_t odd = (bits >> 13) & 1;
+    bits += 0xc8000fffu + odd;
+
+    half = bits >> 13;
+  }
+
+  return static_cast<uint16_t>(half | sign >> 16);
+}
+
+/// @brief Widen `binary16` bits to a `float`, which is exact
+inline float half_to_float(uint16_t half) {
+  uint32_t bits = static_cast<uint32_t>(half & 0x7fffu) << 13;
+  uint32_t exponent = bits & 0x0f800000u;
+
+  // rebias the exponent
+  bits += 0x38000000u;
+
+  if (exponent == 0x0f800000u) {
+    // infinity and NaN keep the largest exponent
+    bits += 0x38000000u;
+  } else if (exponent == 0) {
+    // zero and subnormals: the value is `mantissa * 2^-24`, which float
+    // arithmetic normalizes
+    bits += 0x00800000u;
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    value -= 6.103515625e-05f;
+    std::memcpy(&bits, &value, sizeof(bits));
+  }
+
+  bits |= static_cast<uint32_t>(half & 0x8000u) << 16;
+
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+}  // namespace detail
+
+inline half3::half3(float x, float y, float z)
+    : native{detail::float_to_half(x), detail::float_to_half(y),
+             detail::float_to_half(z)} {}
+
+inline half3::half3(const float3 &f3) : half3(f3.x(), f3.y(), f3.z()) {}
+
+inline float half3::x() const { return detail::half_to_float(native[0]); }
+
+inline float half3::y() const { return detail::half_to_float(native[1]); }
+
+inline float half3::z() const { return detail::half_to_float(native[2]); }
+
+inline float3 half3::to_float3() const { return float3{x(), y(), z()}; }
+
+inline half4::half4(float x, float y, float z, float w)
+    : native{detail::float_to_half(x), detail::float_to_half(y),
+             detail::float_to_half(z), detail::float_to_half(w)} {}
+
+inline half4::half4(const float4 &f4)
+    : half4(f4.x(), f4.y(), f4.z(), f4.w()) {}
+
+inline float half4::x() const { return detail::half_to_float(native[0]); }
+
+inline float half4::y() const { return detail::half_to_float(native[1]); }
+
+inline float half4::z() const { return detail::half_to_float(native[2]); }
+
+inline float half4::w() const { return detail::half_to_float(native[3]); }
+
+inline float4 half4::to_float4() const {
+  return float4{x(), y(), z(), w()};
+}
+
+inline void to_half(span<const float3> in, span<half3> out) {
+  assert(in.size() == out.size());
+
+  size_t i = 0;
+
+#if defined(GRAPHMATH_HAS_F16C)
+  // each `xyz0` becomes 8 bytes, whose last 2 the next vector overwrites
+  for (; i + 1 < in.size(); i++) {
+    __m128i half = _mm_cvtps_ph(in[i].native, _MM_FROUND_TO_NEAREST_INT);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(out.data() + i), half);
+  }
+
+  for (; i < in.size(); i++) {
+    __m128i half = _mm_cvtps_ph(in[i].native, _MM_FROUND_TO_NEAREST_INT);
+    uint16_t lanes[8];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), half);
+    std::memcpy(out[i].native, lanes, sizeof(half3));
+  }
+#endif
+
+  for (; i < in.size(); i++) {
+    out[i] = half3{in[i]};
+  }
+}
+
+inline void to_half(span<const float4> in, span<half4> out) {
+  assert(in.size() == out.size());
+
+  size_t i = 0;
+
+#if defined(GRAPHMATH_HAS_F16C)
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  for (; i + 2 <= in.size(); i += 2) {
+    __m256 pair = _mm256_set_m128(in[i + 1].native, in[i].native);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out.data() + i),
+                     _mm256_cvtps_ph(pair, _MM_FROUND_TO_NEAREST_INT));
+  }
+#endif
+
+  for (; i < in.size(); i++) {
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(out.data() + i),
+                     _mm_cvtps_ph(in[i].native, _MM_FROUND_TO_NEAREST_INT));
+  }
+#endif
+
+  for (; i < in.size(); i++) {
+    out[i] = half4{in[i]};
+  }
+}
+
+inline void to_float(span<const half3> in, span<float3> out) {
+  assert(in.size() == out.size());
+
+  size_t i = 0;
+
+#if defined(GRAPHMATH_HAS_F16C)
+  // 8 bytes hold a vector and `x` of the next, which `w = 0` replaces
+  for (; i + 1 < in.size(); i++) {
+    __m128i half =
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in.data() + i));
+    out[i].native = _mm_blend_ps(_mm_cvtph_ps(half), _mm_setzero_ps(), 0x8);
+  }
+
+  for (; i < in.size(); i++) {
+    uint16_t lanes[8] = {};
+    std::memcpy(lanes, in[i].native, sizeof(half3));
+
+    __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lanes));
+    out[i].native = _mm_cvtph_ps(half);
+  }
+#endif
+
+  for (; i < in.size(); i++) {
+    out[i] = in[i].to_float3();
+  }
+}
+
+inline void to_float(span<const half4> in, span<float4> out) {
+  assert(in.size() == out.size());
+
+  size_t i = 0;
+
+#if defined(GRAPHMATH_HAS_F16C)
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  for (; i + 2 <= in.size(); i += 2) {
+    __m256 pair = _mm256_cvtph_ps(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(in.data() + i)));
+
+    out[i].native = _mm256_castps256_ps128(pair);
+    out[i + 1].native = _mm256_extractf128_ps(pair, 1);
+  }
+#endif
+
+  for (; i < in.size(); i++) {
+    out[i].native = _mm_cvtph_ps(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in.data() + i)));
+  }
+#endif
+
+  for (; i < in.size(); i++) {
+    out[i] = in[i].to_float4();
+  }
+}
+}  // namespace graphmath
@@ -0,0 +1,357 @@
+//
+//  int3.h
+//  CS 419
+//
+//  Three `int32_t` numbers, for grid cells and texel coordinates
+//
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "graphmath/backend.h"
+#include "graphmath/float3.h"
+#include "graphmath/vec.h"
+
+#if defined(GRAPHMATH_BACKEND_APPLE)
+#include <simd/simd.h>
+#elif defined(GRAPHMATH_BACKEND_SSE)
+#include "graphmath/sse.h"
+#else
+#include <array>
+#endif
+
+// Declarations
+
+namespace graphmath {
+/// @brief three `int32_t` numbers `(x, y, z)`
+template <>
+struct vec<int32_t, 3> final {
+ public:
+  /// @brief the type of the numbers
+  using value_type = int32_t;
+
+  /// @brief the number of numbers
+  static constexpr size_t size = 3;
+
+  /// @brief the native `int3` type
+  /// `simd::int3` on Apple Platform, `__m128i` (with `w` kept at zero) on
+  /// SSE4.1 capable platforms, and an array elsewhere
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  using native_int3 = simd::int3;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  using native_int3 = __m128i;
+#else
+  using native_int3 = std::array<int32_t, 3>;
+#endif
+
+  /// @brief create an `int3` of zeroes
+  GRAPHMATH_CONSTEXPR vec();
+
+  /// @brief create an `int3` with values
+  /// @param x x
+  /// @param y y
+  /// @param z z
+  GRAPHMATH_CONSTEXPR vec(int32_t x, int32_t y, int32_t z);
+
+  /// @brief copy constructor
+  /// @param other another `int3`
+  vec(const int3 &other) = default;
+
+  /// @brief create an `int3` with `native_int3`
+  /// @param native the native `int3` instance
+  GRAPHMATH_CONSTEXPR vec(const native_int3 &native);
+
+  /// @brief create an `int3` from a `float3`, rounding toward zero
+  /// @param f3 the `float3`, whose values must fit in `int32_t`
+  GRAPHMATH_CONSTEXPR explicit vec(const float3 &f3);
+
+  /// @brief Get `x` of `int3`
+  /// @returns the `x` value of `int3`
+  GRAPHMATH_CONSTEXPR int32_t x() const;
+
+  /// @brief Get `y` of `int3`
+  /// @returns the `y` value of `int3`
+  GRAPHMATH_CONSTEXPR int32_t y() const;
+
+  /// @brief Get `z` of `int3`
+  /// @returns the `z` value of `int3`
+  GRAPHMATH_CONSTEXPR int32_t z() const;
+
+  /// @brief Convert to a `float3`
+  /// @returns the `float3`
+  GRAPHMATH_CONSTEXPR float3 to_float3() const;
+
+  /// @brief Add one `a` to `b` from another
+  /// @param rhs `b`
+  /// @returns the result
+  GRAPHMATH_CONSTEXPR int3 operator+(const int3 &rhs) const;
+
+  /// @brief Subtract one `a` from `b` from another
+  /// @param rhs `b`
+  /// @returns the result
+  GRAPHMATH_CONSTEXPR int3 operator-(const int3 &rhs) const;
+
+  /// @brief Multiply all values of `int3` by a multiplier
+  /// @param rhs the multiplier
+  /// @returns the multiplied `int3`
+  GRAPHMATH_CONSTEXPR int3 operator*(int32_t rhs) const;
+
+  /// @brief Component-wise multiply `a`, `b`
+  /// @param rhs `b`
+  /// @returns the result
+  GRAPHMATH_CONSTEXPR int3 operator*(const int3 &rhs) const;
+
+  /// @brief Compare `this` with another `int3`
+  /// @param rhs the other `int3`
+  /// @returns true if equal; false otherwise
+  GRAPHMATH_CONSTEXPR bool operator==(const int3 &rhs) const;
+
+  /// @brief Compare `this` with another `int3`
+  /// @param rhs the other `int3`
+  /// @returns false if equal; true otherwise
+  GRAPHMATH_CONSTEXPR bool operator!=(const int3 &rhs) const;
+
+  native_int3 native;
+};
+
+static_assert(std::is_trivially_copyable_v<int3>,
+              "int3 must be trivially copyable");
+static_assert(std::is_standard_layout_v<int3>,
+              "int3 must be standard layout");
+static_assert(sizeof(int3) == sizeof(int3::native_int3),
+              "int3 must be the size of its native type");
+
+/// @brief Get the smaller of each pair of values
+/// @param a one `int3`
+/// @param b one `int3`
+/// @returns the component-wise minimum
+GRAPHMATH_CONSTEXPR int3 min(const int3 &a, const int3 &b);
+
+/// @brief Get the larger of each pair of values
+/// @param a one `int3`
+/// @param b one `int3`
+/// @returns the component-wise maximum
+GRAPHMATH_CONSTEXPR int3 max(const int3 &a, const int3 &b);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+inline GRAPHMATH_CONSTEXPR int3::vec()
+#if defined(GRAPHMATH_BACKEND_APPLE)
+    : native{simd::make_int3(0, 0, 0)} {
+}
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    : native{sse::make_epi32(0, 0, 0, 0)} {
+}
+#else
+    : native{{0, 0, 0}} {
+}
+#endif
+
+inline GRAPHMATH_CONSTEXPR int3::vec(int32_t x, int32_t y, int32_t z)
+#if defined(GRAPHMATH_BACKEND_APPLE)
+    : native{simd::make_int3(x, y, z)} {
+}
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    : native{sse::make_epi32(x, y, z, 0)} {
+}
+#else
+    : native{{x, y, z}} {
+}
+#endif
+
+inline GRAPHMATH_CONSTEXPR int3::vec(const native_int3 &values)
+    : native(values) {}
+
+namespace detail {
+/// @brief Truncate a `float3` to the native type of `int3`
+inline GRAPHMATH_CONSTEXPR int3::native_int3 truncate(const float3 &f3) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd_int(f3.native);
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!is_constant_evaluated()) {
+    return _mm_cvttps_epi32(f3.native);
+  }
+#endif
+
+  return int3{static_cast<int32_t>(f3.x()), static_cast<int32_t>(f3.y()),
+              static_cast<int32_t>(f3.z())}
+      .native;
+#endif
+}
+}  // namespace detail
+
+inline GRAPHMATH_CONSTEXPR int3::vec(const float3 &f3)
+    : native(detail::truncate(f3)) {}
+
+inline GRAPHMATH_CONSTEXPR int32_t int3::x() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.x;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::lane_epi32<0>(native);
+  }
+
+  return _mm_cvtsi128_si32(native);
+#else
+  return native[0];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR int32_t int3::y() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.y;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::lane_epi32<1>(native);
+  }
+
+  return _mm_extract_epi32(native, 1);
+#else
+  return native[1];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR int32_t int3::z() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.z;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::lane_epi32<2>(native);
+  }
+
+  return _mm_extract_epi32(native, 2);
+#else
+  return native[2];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float3 int3::to_float3() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float3{simd_float(native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float3{_mm_cvtepi32_ps(native)};
+  }
+#endif
+
+  return float3{static_cast<float>(x()), static_cast<float>(y()),
+                static_cast<float>(z())};
+#endif
+}
+
+// Below, the SSE backend returns early unless it is evaluated at compile time,
+// in which case it shares the lane-wise code of the other backends
+
+inline GRAPHMATH_CONSTEXPR int3 int3::operator+(const int3 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native + rhs.native;
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return int3{_mm_add_epi32(native, rhs.native)};
+  }
+#endif
+
+  return int3{x() + rhs.x(), y() + rhs.y(), z() + rhs.z()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR int3 int3::operator-(const int3 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native - rhs.native;
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return int3{_mm_sub_epi32(native, rhs.native)};
+  }
+#endif
+
+  return int3{x() - rhs.x(), y() - rhs.y(), z() - rhs.z()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR int3 int3::operator*(int32_t rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native * rhs;
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return int3{_mm_mullo_epi32(native, _mm_set1_epi32(rhs))};
+  }
+#endif
+
+  return int3{x() * rhs, y() * rhs, z() * rhs};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR int3 int3::operator*(const int3 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native * rhs.native;
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return int3{_mm_mullo_epi32(native, rhs.native)};
+  }
+#endif
+
+  return int3{x() * rhs.x(), y() * rhs.y(), z() * rhs.z()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool int3::operator==(const int3 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd::all(native == rhs.native);
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    // `w` is zero in both
+    __m128i different = _mm_xor_si128(native, rhs.native);
+    return _mm_testz_si128(different, different);
+  }
+#endif
+
+  return x() == rhs.x() && y() == rhs.y() && z() == rhs.z();
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool int3::operator!=(const int3 &rhs) const {
+  return !(*this == rhs);
+}
+
+inline GRAPHMATH_CONSTEXPR int3 min(const int3 &a, const int3 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return int3{simd::min(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return int3{_mm_min_epi32(a.native, b.native)};
+  }
+#endif
+
+  return int3{std::min(a.x(), b.x()), std::min(a.y(), b.y()),
+              std::min(a.z(), b.z())};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR int3 max(const int3 &a, const int3 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return int3{simd::max(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return int3{_mm_max_epi32(a.native, b.native)};
+  }
+#endif
+
+  return int3{std::max(a.x(), b.x()), std::max(a.y(), b.y()),
+              std::max(a.z(), b.z())};
+#endif
+}
+}  // namespace graphmath
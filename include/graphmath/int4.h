@@ -0,0 +1,377 @@
+//
+//  int4.h
+//  CS 419
+//
+//  Four `int32_t` numbers, for grid cells and texel coordinates
+//
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "graphmath/backend.h"
+#include "graphmath/float4.h"
+#include "graphmath/vec.h"
+
+#if defined(GRAPHMATH_BACKEND_APPLE)
+#include <simd/simd.h>
+#elif defined(GRAPHMATH_BACKEND_SSE)
+#include "graphmath/sse.h"
+#else
+#include <array>
+#endif
+
+// Declarations
+
+namespace graphmath {
+/// @brief four `int32_t` numbers `(x, y, z, w)`
+template <>
+struct vec<int32_t, 4> final {
+ public:
+  /// @brief the type of the numbers
+  using value_type = int32_t;
+
+  /// @brief the number of numbers
+  static constexpr size_t size = 4;
+
+  /// @brief the native `int4` type
+  /// `simd::int4` on Apple Platform, `__m128i` on SSE4.1 capable
+  /// platforms, and an array elsewhere
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  using native_int4 = simd::int4;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  using native_int4 = __m128i;
+#else
+  using native_int4 = std::array<int32_t, 4>;
+#endif
+
+  /// @brief create an `int4` of zeroes
+  GRAPHMATH_CONSTEXPR vec();
+
+  /// @brief create an `int4` with values
+  /// @param x x
+  /// @param y y
+  /// @param z z
+  /// @param w w
+  GRAPHMATH_CONSTEXPR vec(int32_t x, int32_t y, int32_t z, int32_t w);
+
+  /// @brief copy constructor
+  /// @param other another `int4`
+  vec(const int4 &other) = default;
+
+  /// @brief create an `int4` with `native_int4`
+  /// @param native the native `int4` instance
+  GRAPHMATH_CONSTEXPR vec(const native_int4 &native);
+
+  /// @brief create an `int4` from a `float4`, rounding toward zero
+  /// @param f4 the `float4`, whose values must fit in `int32_t`
+  GRAPHMATH_CONSTEXPR explicit vec(const float4 &f4);
+
+  /// @brief Get `x` of `int4`
+  /// @returns the `x` value of `int4`
+  GRAPHMATH_CONSTEXPR int32_t x() const;
+
+  /// @brief Get `y` of `int4`
+  /// @returns the `y` value of `int4`
+  GRAPHMATH_CONSTEXPR int32_t y() const;
+
+  /// @brief Get `z` of `int4`
+  /// @returns the `z` value of `int4`
+  GRAPHMATH_CONSTEXPR int32_t z() const;
+
+  /// @brief Get `w` of `int4`
+  /// @returns the `w` value of `int4`
+  GRAPHMATH_CONSTEXPR int32_t w() const;
+
+  /// @brief Convert to a `float4`
+  /// @returns the `float4`
+  GRAPHMATH_CONSTEXPR float4 to_float4() const;
+
+  /// @brief Add one `a` to `b` from another
+  /// @param rhs `b`
+  /// @returns the result
+  GRAPHMATH_CONSTEXPR int4 operator+(const int4 &rhs) const;
+
+  /// @brief Subtract one `a` from `b` from another
+  /// @param rhs `b`
+  /// @returns the result
+  GRAPHMATH_CONSTEXPR int4 operator-(const int4 &rhs) const;
+
+  /// @brief Multiply all values of `int4` by a multiplier
+  /// @param rhs the multiplier
+  /// @returns the multiplied `int4`
+  GRAPHMATH_CONSTEXPR int4 operator*(int32_t rhs) const;
+
+  /// @brief Component-wise multiply `a`, `b`
+  /// @param rhs `b`
+  /// @returns the result
+  GRAPHMATH_CONSTEXPR int4 operator*(const int4 &rhs) const;
+
+  /// @brief Compare `this` with another `int4`
+  /// @param rhs the other `int4`
+  /// @returns true if equal; false otherwise
+  GRAPHMATH_CONSTEXPR bool operator==(const int4 &rhs) const;
+
+  /// @brief Compare `this` with another `int4`
+  /// @param rhs the other `int4`
+  /// @returns false if equal; true otherwise
+  GRAPHMATH_CONSTEXPR bool operator!=(const int4 &rhs) const;
+
+  native_int4 native;
+};
+
+static_assert(std::is_trivially_copyable_v<int4>,
+              "int4 must be trivially copyable");
+static_assert(std::is_standard_layout_v<int4>,
+              "int4 must be standard layout");
+static_assert(sizeof(int4) == sizeof(int4::native_int4),
+              "int4 must be the size of its native type");
+
+/// @brief Get the smaller of each pair of values
+/// @param a one `int4`
+/// @param b one `int4`
+/// @returns the component-wise minimum
+GRAPHMATH_CONSTEXPR int4 min(const int4 &a, const int4 &b);
+
+/// @brief Get the larger of each pair of values
+/// @param a one `int4`
+/// @param b one `int4`
+/// @returns the component-wise maximum
+GRAPHMATH_CONSTEXPR int4 max(const int4 &a, const int4 &b);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+inline GRAPHMATH_CONSTEXPR int4::vec()
+#if defined(GRAPHMATH_BACKEND_APPLE)
+    : native{simd::make_int4(0, 0, 0, 0)} {
+}
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    : native{sse::make_epi32(0, 0, 0, 0)} {
+}
+#else
+    : native{{0, 0, 0, 0}} {
+}
+#endif
+
+inline GRAPHMATH_CONSTEXPR int4::vec(int32_t x, int32_t y, int32_t z,
+                                     int32_t w)
+#if defined(GRAPHMATH_BACKEND_APPLE)
+    : native{simd::make_int4(x, y, z, w)} {
+}
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    : native{sse::make_epi32(x, y, z, w)} {
+}
+#else
+    : native{{x, y, z, w}} {
+}
+#endif
+
+inline GRAPHMATH_CONSTEXPR int4::vec(const native_int4 &values)
+    : native(values) {}
+
+namespace detail {
+/// @brief Truncate a `float4` to the native type of `int4`
+inline GRAPHMATH_CONSTEXPR int4::native_int4 truncate(const float4 &f4) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd_int(f4.native);
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!is_constant_evaluated()) {
+    return _mm_cvttps_epi32(f4.native);
+  }
+#endif
+
+  return int4{static_cast<int32_t>(f4.x()), static_cast<int32_t>(f4.y()),
+              static_cast<int32_t>(f4.z()), static_cast<int32_t>(f4.w())}
+      .native;
+#endif
+}
+}  // namespace detail
+
+inline GRAPHMATH_CONSTEXPR int4::vec(const float4 &f4)
+    : native(detail::truncate(f4)) {}
+
+inline GRAPHMATH_CONSTEXPR int32_t int4::x() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.x;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::lane_epi32<0>(native);
+  }
+
+  return _mm_cvtsi128_si32(native);
+#else
+  return native[0];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR int32_t int4::y() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.y;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::lane_epi32<1>(native);
+  }
+
+  return _mm_extract_epi32(native, 1);
+#else
+  return native[1];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR int32_t int4::z() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.z;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::lane_epi32<2>(native);
+  }
+
+  return _mm_extract_epi32(native, 2);
+#else
+  return native[2];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR int32_t int4::w() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.w;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::lane_epi32<3>(native);
+  }
+
+  return _mm_extract_epi32(native, 3);
+#else
+  return native[3];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float4 int4::to_float4() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float4{simd_float(native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float4{_mm_cvtepi32_ps(native)};
+  }
+#endif
+
+  return float4{static_cast<float>(x()), static_cast<float>(y()),
+                static_cast<float>(z()), static_cast<float>(w())};
+#endif
+}
+
+// Below, the SSE backend returns early unless it is evaluated at compile time,
+// in which case it shares the lane-wise code of the other backends
+
+inline GRAPHMATH_CONSTEXPR int4 int4::operator+(const int4 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native + rhs.native;
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return int4{_mm_add_epi32(native, rhs.native)};
+  }
+#endif
+
+  return int4{x() + rhs.x(), y() + rhs.y(), z() + rhs.z(), w() + rhs.w()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR int4 int4::operator-(const int4 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native - rhs.native;
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return int4{_mm_sub_epi32(native, rhs.native)};
+  }
+#endif
+
+  return int4{x() - rhs.x(), y() - rhs.y(), z() - rhs.z(), w() - rhs.w()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR int4 int4::operator*(int32_t rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native * rhs;
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return int4{_mm_mullo_epi32(native, _mm_set1_epi32(rhs))};
+  }
+#endif
+
+  return int4{x() * rhs, y() * rhs, z() * rhs, w() * rhs};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR int4 int4::operator*(const int4 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native * rhs.native;
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return int4{_mm_mullo_epi32(native, rhs.native)};
+  }
+#endif
+
+  return int4{x() * rhs.x(), y() * rhs.y(), z() * rhs.z(), w() * rhs.w()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool int4::operator==(const int4 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd::all(native == rhs.native);
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    __m128i different = _mm_xor_si128(native, rhs.native);
+    return _mm_testz_si128(different, different);
+  }
+#endif
+
+  return x() == rhs.x() && y() == rhs.y() && z() == rhs.z() &&
+         w() == rhs.w();
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool int4::operator!=(const int4 &rhs) const {
+  return !(*this == rhs);
+}
+
+inline GRAPHMATH_CONSTEXPR int4 min(const int4 &a, const int4 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return int4{simd::min(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return int4{_mm_min_epi32(a.native, b.native)};
+  }
+#endif
+
+  return int4{std::min(a.x(), b.x()), std::min(a.y(), b.y()),
+              std::min(a.z(), b.z()), std::min(a.w(), b.w())};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR int4 max(const int4 &a, const int4 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return int4{simd::max(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return int4{_mm_max_epi32(a.native, b.native)};
+  }
+#endif
+
+  return int4{std::max(a.x(), b.x()), std::max(a.y(), b.y()),
+              std::max(a.z(), b.z()), std::max(a.w(), b.w())};
+#endif
+}
+}  // namespace graphmath
@@ -0,0 +1,895 @@
+//
+//  mask.h
+//  CS 419
+//
+//  Lane-wise comparisons of `float3` and `float4`, as masks
+//
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "graphmath/backend.h"
+#include "graphmath/float3.h"
+#include "graphmath/float4.h"
+#include "graphmath/vec.h"
+
+#if defined(GRAPHMATH_BACKEND_APPLE)
+#include <simd/simd.h>
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+#include <DirectXMath.h>
+#elif defined(GRAPHMATH_BACKEND_SSE)
+#include "graphmath/sse.h"
+#else
+#include <array>
+#endif
+
+// Declarations
+
+namespace graphmath {
+/// @brief three lanes of a comparison of `float3`, used as a mask
+/// Masks are combined with `&`, `|` and `!`, reduced with `any`, `all` and
+/// `bits`, and pick lanes with `select`, without branching on each lane. On
+/// the SIMD backends every lane is all ones or all zeroes, like the result
+/// of `_mm_cmplt_ps`; lane `w` of the native mask is unspecified
+template <>
+struct vec<bool, 3> final {
+ public:
+  /// @brief the type of the lanes
+  using value_type = bool;
+
+  /// @brief the number of lanes
+  static constexpr size_t size = 3;
+
+  /// @brief the native `bool3` type
+  /// `simd::int3` on Apple Platform, `DirectX::XMVECTOR` on Windows,
+  /// `__m128` on SSE4.1 capable platforms, and an array elsewhere
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  using native_bool3 = simd::int3;
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  using native_bool3 = DirectX::XMVECTOR;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  using native_bool3 = __m128;
+#else
+  using native_bool3 = std::array<bool, 3>;
+#endif
+
+  /// @brief create a `bool3` of false lanes
+  GRAPHMATH_CONSTEXPR vec();
+
+  /// @brief create a `bool3` with lanes
+  /// @param x x
+  /// @param y y
+  /// @param z z
+  GRAPHMATH_CONSTEXPR vec(bool x, bool y, bool z);
+
+  /// @brief copy constructor
+  /// @param other another `bool3`
+  vec(const bool3 &other) = default;
+
+  /// @brief create a `bool3` with `native_bool3`
+  /// @param native the native `bool3` instance
+  GRAPHMATH_CONSTEXPR vec(const native_bool3 &native);
+
+  /// @brief Get lane `x` of `bool3`
+  /// @returns true if lane `x` is set; false otherwise
+  GRAPHMATH_CONSTEXPR bool x() const;
+
+  /// @brief Get lane `y` of `bool3`
+  /// @returns true if lane `y` is set; false otherwise
+  GRAPHMATH_CONSTEXPR bool y() const;
+
+  /// @brief Get lane `z` of `bool3`
+  /// @returns true if lane `z` is set; false otherwise
+  GRAPHMATH_CONSTEXPR bool z() const;
+
+  /// @brief Get the lanes as bits, with `_mm_movemask_ps` on SSE
+  /// @returns bit `i` set if lane `i` is set, in `[0, 0x7]`
+  GRAPHMATH_CONSTEXPR int bits() const;
+
+  /// @brief Get the lanes set in both masks
+  /// @param rhs the other mask
+  /// @returns the result
+  GRAPHMATH_CONSTEXPR bool3 operator&(const bool3 &rhs) const;
+
+  /// @brief Get the lanes set in either mask
+  /// @param rhs the other mask
+  /// @returns the result
+  GRAPHMATH_CONSTEXPR bool3 operator|(const bool3 &rhs) const;
+
+  /// @brief Get the lanes that are not set
+  /// @returns the result
+  GRAPHMATH_CONSTEXPR bool3 operator!() const;
+
+  native_bool3 native;
+};
+
+static_assert(std::is_trivially_copyable_v<bool3>,
+              "bool3 must be trivially copyable");
+static_assert(sizeof(bool3) == sizeof(bool3::native_bool3),
+              "bool3 must be the size of its native type");
+
+/// @brief Check if any lane of a mask is set
+/// @param mask the mask
+/// @returns true if any lane is set; false otherwise
+GRAPHMATH_CONSTEXPR bool any(const bool3 &mask);
+
+/// @brief Check if all lanes of a mask are set
+/// @param mask the mask
+/// @returns true if all lanes are set; false otherwise
+GRAPHMATH_CONSTEXPR bool all(const bool3 &mask);
+
+/// @brief Pick lanes of `a` where `mask` is set and of `b` elsewhere, with
+/// one blend instruction
+/// @param mask the mask
+/// @param a the lanes where `mask` is set
+/// @param b the lanes where `mask` is not set
+/// @returns `mask ? a : b`, lane-wise
+GRAPHMATH_CONSTEXPR float3 select(const bool3 &mask, const float3 &a,
+                                  const float3 &b);
+
+/// @brief Compare two `float3` lane-wise, `a == b`
+/// @param a a
+/// @param b b
+/// @returns the mask of the lanes where `a == b`
+GRAPHMATH_CONSTEXPR bool3 equal(const float3 &a, const float3 &b);
+
+/// @brief Compare two `float3` lane-wise, `a != b`
+/// @param a a
+/// @param b b
+/// @returns the mask of the lanes where `a != b`
+GRAPHMATH_CONSTEXPR bool3 not_equal(const float3 &a, const float3 &b);
+
+/// @brief Compare two `float3` lane-wise, `a < b`
+/// @param a a
+/// @param b b
+/// @returns the mask of the lanes where `a < b`
+GRAPHMATH_CONSTEXPR bool3 less(const float3 &a, const float3 &b);
+
+/// @brief Compare two `float3` lane-wise, `a <= b`
+/// @param a a
+/// @param b b
+/// @returns the mask of the lanes where `a <= b`
+GRAPHMATH_CONSTEXPR bool3 less_equal(const float3 &a, const float3 &b);
+
+/// @brief Compare two `float3` lane-wise, `a > b`
+/// @param a a
+/// @param b b
+/// @returns the mask of the lanes where `a > b`
+GRAPHMATH_CONSTEXPR bool3 greater(const float3 &a, const float3 &b);
+
+/// @brief Compare two `float3` lane-wise, `a >= b`
+/// @param a a
+/// @param b b
+/// @returns the mask of the lanes where `a >= b`
+GRAPHMATH_CONSTEXPR bool3 greater_equal(const float3 &a, const float3 &b);
+
+/// @brief Compare two `float3` lane-wise, with a tolerance
+/// @param a a
+/// @param b b
+/// @param tolerance the largest difference of equal lanes, not negative
+/// @returns the mask of the lanes where `|a - b| <= tolerance`; lanes with
+/// NaN are never nearly equal
+bool3 nearly_equal(const float3 &a, const float3 &b, float tolerance);
+
+/// @brief four lanes of a comparison of `float4`, like `bool3`
+template <>
+struct vec<bool, 4> final {
+ public:
+  /// @brief the type of the lanes
+  using value_type = bool;
+
+  /// @brief the number of lanes
+  static constexpr size_t size = 4;
+
+  /// @brief the native `bool4` type
+  /// `simd::int4` on Apple Platform, `DirectX::XMVECTOR` on Windows,
+  /// `__m128` on SSE4.1 capable platforms, and an array elsewhere
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  using native_bool4 = simd::int4;
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  using native_bool4 = DirectX::XMVECTOR;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  using native_bool4 = __m128;
+#else
+  using native_bool4 = std::array<bool, 4>;
+#endif
+
+  /// @brief create a `bool4` of false lanes
+  GRAPHMATH_CONSTEXPR vec();
+
+  /// @brief create a `bool4` with lanes
+  /// @param x x
+  /// @param y y
+  /// @param z z
+  /// @param w w
+  GRAPHMATH_CONSTEXPR vec(bool x, bool y, bool z, bool w);
+
+  /// @brief copy constructor
+  /// @param other another `bool4`
+  vec(const bool4 &other) = default;
+
+  /// @brief create a `bool4` with `native_bool4`
+  /// @param native the native `bool4` instance
+  GRAPHMATH_CONSTEXPR vec(const native_bool4 &native);
+
+  /// @brief Get lane `x` of `bool4`
+  /// @returns true if lane `x` is set; false otherwise
+  GRAPHMATH_CONSTEXPR bool x() const;
+
+  /// @brief Get lane `y` of `bool4`
+  /// @returns true if lane `y` is set; false otherwise
+  GRAPHMATH_CONSTEXPR bool y() const;
+
+  /// @brief Get lane `z` of `bool4`
+  /// @returns true if lane `z` is set; false otherwise
+  GRAPHMATH_CONSTEXPR bool z() const;
+
+  /// @brief Get lane `w` of `bool4`
+  /// @returns true if lane `w` is set; false otherwise
+  GRAPHMATH_CONSTEXPR bool w() const;
+
+  /// @brief Get the lanes as bits, with `_mm_movemask_ps` on SSE
+  /// @returns bit `i` set if lane `i` is set, in `[0, 0xF]`
+  GRAPHMATH_CONSTEXPR int bits() const;
+
+  /// @brief Get the lanes set in both masks
+  /// @param rhs the other mask
+  /// @returns the result
+  GRAPHMATH_CONSTEXPR bool4 operator&(const bool4 &rhs) const;
+
+  /// @brief Get the lanes set in either mask
+  /// @param rhs the other mask
+  /// @returns the result
+  GRAPHMATH_CONSTEXPR bool4 operator|(const bool4 &rhs) const;
+
+  /// @brief Get the lanes that are not set
+  /// @returns the result
+  GRAPHMATH_CONSTEXPR bool4 operator!() const;
+
+  native_bool4 native;
+};
+
+static_assert(std::is_trivially_copyable_v<bool4>,
+              "bool4 must be trivially copyable");
+static_assert(sizeof(bool4) == sizeof(bool4::native_bool4),
+              "bool4 must be the size of its native type");
+
+/// @brief Check if any lane of a mask is set
+/// @param mask the mask
+/// @returns true if any lane is set; false otherwise
+GRAPHMATH_CONSTEXPR bool any(const bool4 &mask);
+
+/// @brief Check if all lanes of a mask are set
+/// @param mask the mask
+/// @returns true if all lanes are set; false otherwise
+GRAPHMATH_CONSTEXPR bool all(const bool4 &mask);
+
+/// @brief Pick lanes of `a` where `mask` is set and of `b` elsewhere, with
+/// one blend instruction
+/// @param mask the mask
+/// @param a the lanes where `mask` is set
+/// @param b the lanes where `mask` is not set
+/// @returns `mask ? a : b`, lane-wise
+GRAPHMATH_CONSTEXPR float4 select(const bool4 &mask, const float4 &a,
+                                  const float4 &b);
+
+/// @brief Compare two `float4` lane-wise, `a == b`
+/// @param a a
+/// @param b b
+/// @returns the mask of the lanes where `a == b`
+GRAPHMATH_CONSTEXPR bool4 equal(const float4 &a, const float4 &b);
+
+/// @brief Compare two `float4` lane-wise, `a != b`
+/// @param a a
+/// @param b b
+/// @returns the mask of the lanes where `a != b`
+GRAPHMATH_CONSTEXPR bool4 not_equal(const float4 &a, const float4 &b);
+
+/// @brief Compare two `float4` lane-wise, `a < b`
+/// @param a a
+/// @param b b
+/// @returns the mask of the lanes where `a < b`
+GRAPHMATH_CONSTEXPR bool4 less(const float4 &a, const float4 &b);
+
+/// @brief Compare two `float4` lane-wise, `a <= b`
+/// @param a a
+/// @param b b
+/// @returns the mask of the lanes where `a <= b`
+GRAPHMATH_CONSTEXPR bool4 less_equal(const float4 &a, const float4 &b);
+
+/// @brief Compare two `float4` lane-wise, `a > b`
+/// @param a a
+/// @param b b
+/// @returns the mask of the lanes where `a > b`
+GRAPHMATH_CONSTEXPR bool4 greater(const float4 &a, const float4 &b);
+
+/// @brief Compare two `float4` lane-wise, `a >= b`
+/// @param a a
+/// @param b b
+/// @returns the mask of the lanes where `a >= b`
+GRAPHMATH_CONSTEXPR bool4 greater_equal(const float4 &a, const float4 &b);
+
+/// @brief Compare two `float4` lane-wise, with a tolerance
+/// @param a a
+/// @param b b
+/// @param tolerance the largest difference of equal lanes, not negative
+/// @returns the mask of the lanes where `|a - b| <= tolerance`; lanes with
+/// NaN are never nearly equal
+bool4 nearly_equal(const float4 &a, const float4 &b, float tolerance);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+inline GRAPHMATH_CONSTEXPR bool3::vec()
+#if defined(GRAPHMATH_BACKEND_APPLE)
+    : native{simd::make_int3(0, 0, 0)} {
+}
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+    : native{DirectX::XMVectorFalseInt()} {
+}
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    : native{sse::make_mask(false, false, false, false)} {
+}
+#else
+    : native{{false, false, false}} {
+}
+#endif
+
+inline GRAPHMATH_CONSTEXPR bool3::vec(bool x, bool y, bool z)
+#if defined(GRAPHMATH_BACKEND_APPLE)
+    : native{simd::make_int3(-int{x}, -int{y}, -int{z})} {
+}
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+    : native{DirectX::XMVectorSetInt(x ? 0xFFFFFFFFu : 0u,
+                                     y ? 0xFFFFFFFFu : 0u,
+                                     z ? 0xFFFFFFFFu : 0u, 0u)} {
+}
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    : native{sse::make_mask(x, y, z, false)} {
+}
+#else
+    : native{{x, y, z}} {
+}
+#endif
+
+inline GRAPHMATH_CONSTEXPR bool3::vec(const native_bool3 &values)
+    : native(values) {}
+
+inline GRAPHMATH_CONSTEXPR bool bool3::x() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.x != 0;
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return DirectX::XMVectorGetIntX(native) != 0;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::mask_lane<0>(native);
+  }
+
+  return (_mm_movemask_ps(native) & 0x1) != 0;
+#else
+  return native[0];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool bool3::y() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.y != 0;
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return DirectX::XMVectorGetIntY(native) != 0;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::mask_lane<1>(native);
+  }
+
+  return (_mm_movemask_ps(native) & 0x2) != 0;
+#else
+  return native[1];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool bool3::z() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.z != 0;
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return DirectX::XMVectorGetIntZ(native) != 0;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::mask_lane<2>(native);
+  }
+
+  return (_mm_movemask_ps(native) & 0x4) != 0;
+#else
+  return native[2];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR int bool3::bits() const {
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return _mm_movemask_ps(native) & 0x7;
+  }
+#endif
+
+  return int{x()} | int{y()} << 1 | int{z()} << 2;
+}
+
+inline GRAPHMATH_CONSTEXPR bool3 bool3::operator&(const bool3 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return bool3{native & rhs.native};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return bool3{DirectX::XMVectorAndInt(native, rhs.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return bool3{_mm_and_ps(native, rhs.native)};
+  }
+#endif
+
+  return bool3{x() && rhs.x(), y() && rhs.y(), z() && rhs.z()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool3 bool3::operator|(const bool3 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return bool3{native | rhs.native};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return bool3{DirectX::XMVectorOrInt(native, rhs.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return bool3{_mm_or_ps(native, rhs.native)};
+  }
+#endif
+
+  return bool3{x() || rhs.x(), y() || rhs.y(), z() || rhs.z()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool3 bool3::operator!() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return bool3{~native};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return bool3{DirectX::XMVectorXorInt(native, DirectX::XMVectorTrueInt())};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return bool3{_mm_xor_ps(native, _mm_castsi128_ps(_mm_set1_epi32(-1)))};
+  }
+#endif
+
+  return bool3{!x(), !y(), !z()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool any(const bool3 &mask) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd::any(mask.native);
+#else
+  return mask.bits() != 0;
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool all(const bool3 &mask) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd::all(mask.native);
+#else
+  return mask.bits() == 0x7;
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float3 select(const bool3 &mask, const float3 &a,
+                                         const float3 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float3{simd::select(b.native, a.native, mask.native)};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return float3{DirectX::XMVectorSelect(b.native, a.native, mask.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float3{_mm_blendv_ps(b.native, a.native, mask.native)};
+  }
+#endif
+
+  return float3{mask.x() ? a.x() : b.x(), mask.y() ? a.y() : b.y(),
+                mask.z() ? a.z() : b.z()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool3 equal(const float3 &a, const float3 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return bool3{a.native == b.native};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return bool3{DirectX::XMVectorEqual(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return bool3{_mm_cmpeq_ps(a.native, b.native)};
+  }
+#endif
+
+  return bool3{a.x() == b.x(), a.y() == b.y(), a.z() == b.z()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool3 not_equal(const float3 &a, const float3 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return bool3{a.native != b.native};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return bool3{DirectX::XMVectorNotEqual(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return bool3{_mm_cmpneq_ps(a.native, b.native)};
+  }
+#endif
+
+  return bool3{a.x() != b.x(), a.y() != b.y(), a.z() != b.z()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool3 less(const float3 &a, const float3 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return bool3{a.native < b.native};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return bool3{DirectX::XMVectorLess(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return bool3{_mm_cmplt_ps(a.native, b.native)};
+  }
+#endif
+
+  return bool3{a.x() < b.x(), a.y() < b.y(), a.z() < b.z()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool3 less_equal(const float3 &a, const float3 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return bool3{a.native <= b.native};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return bool3{DirectX::XMVectorLessOrEqual(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return bool3{_mm_cmple_ps(a.native, b.native)};
+  }
+#endif
+
+  return bool3{a.x() <= b.x(), a.y() <= b.y(), a.z() <= b.z()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool3 greater(const float3 &a, const float3 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return bool3{a.native > b.native};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return bool3{DirectX::XMVectorGreater(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return bool3{_mm_cmpgt_ps(a.native, b.native)};
+  }
+#endif
+
+  return bool3{a.x() > b.x(), a.y() > b.y(), a.z() > b.z()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool3 greater_equal(const float3 &a,
+                                               const float3 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return bool3{a.native >= b.native};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return bool3{DirectX::XMVectorGreaterOrEqual(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return bool3{_mm_cmpge_ps(a.native, b.native)};
+  }
+#endif
+
+  return bool3{a.x() >= b.x(), a.y() >= b.y(), a.z() >= b.z()};
+#endif
+}
+
+inline bool3 nearly_equal(const float3 &a, const float3 &b, float tolerance) {
+  float3 bound{tolerance, tolerance, tolerance};
+  return less_equal(abs(a - b), bound);
+}
+
+inline GRAPHMATH_CONSTEXPR bool4::vec()
+#if defined(GRAPHMATH_BACKEND_APPLE)
+    : native{simd::make_int4(0, 0, 0, 0)} {
+}
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+    : native{DirectX::XMVectorFalseInt()} {
+}
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    : native{sse::make_mask(false, false, false, false)} {
+}
+#else
+    : native{{false, false, false, false}} {
+}
+#endif
+
+inline GRAPHMATH_CONSTEXPR bool4::vec(bool x, bool y, bool z, bool w)
+#if defined(GRAPHMATH_BACKEND_APPLE)
+    : native{simd::make_int4(-int{x}, -int{y}, -int{z}, -int{w})} {
+}
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+    : native{DirectX::XMVectorSetInt(x ? 0xFFFFFFFFu : 0u,
+                                     y ? 0xFFFFFFFFu : 0u,
+                                     z ? 0xFFFFFFFFu : 0u,
+                                     w ? 0xFFFFFFFFu : 0u)} {
+}
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    : native{sse::make_mask(x, y, z, w)} {
+}
+#else
+    : native{{x, y, z, w}} {
+}
+#endif
+
+inline GRAPHMATH_CONSTEXPR bool4::vec(const native_bool4 &values)
+    : native(values) {}
+
+inline GRAPHMATH_CONSTEXPR bool bool4::x() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.x != 0;
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return DirectX::XMVectorGetIntX(native) != 0;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::mask_lane<0>(native);
+  }
+
+  return (_mm_movemask_ps(native) & 0x1) != 0;
+#else
+  return native[0];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool bool4::y() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.y != 0;
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return DirectX::XMVectorGetIntY(native) != 0;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::mask_lane<1>(native);
+  }
+
+  return (_mm_movemask_ps(native) & 0x2) != 0;
+#else
+  return native[1];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool bool4::z() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.z != 0;
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return DirectX::XMVectorGetIntZ(native) != 0;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::mask_lane<2>(native);
+  }
+
+  return (_mm_movemask_ps(native) & 0x4) != 0;
+#else
+  return native[2];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool bool4::w() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return native.w != 0;
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return DirectX::XMVectorGetIntW(native) != 0;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  if (detail::is_constant_evaluated()) {
+    return sse::mask_lane<3>(native);
+  }
+
+  return (_mm_movemask_ps(native) & 0x8) != 0;
+#else
+  return native[3];
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR int bool4::bits() const {
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return _mm_movemask_ps(native);
+  }
+#endif
+
+  return int{x()} | int{y()} << 1 | int{z()} << 2 | int{w()} << 3;
+}
+
+inline GRAPHMATH_CONSTEXPR bool4 bool4::operator&(const bool4 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return bool4{native & rhs.native};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return bool4{DirectX::XMVectorAndInt(native, rhs.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return bool4{_mm_and_ps(native, rhs.native)};
+  }
+#endif
+
+  return bool4{x() && rhs.x(), y() && rhs.y(), z() && rhs.z(), w() && rhs.w()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool4 bool4::operator|(const bool4 &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return bool4{native | rhs.native};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return bool4{DirectX::XMVectorOrInt(native, rhs.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return bool4{_mm_or_ps(native, rhs.native)};
+  }
+#endif
+
+  return bool4{x() || rhs.x(), y() || rhs.y(), z() || rhs.z(), w() || rhs.w()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool4 bool4::operator!() const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return bool4{~native};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return bool4{DirectX::XMVectorXorInt(native, DirectX::XMVectorTrueInt())};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return bool4{_mm_xor_ps(native, _mm_castsi128_ps(_mm_set1_epi32(-1)))};
+  }
+#endif
+
+  return bool4{!x(), !y(), !z(), !w()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool any(const bool4 &mask) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd::any(mask.native);
+#else
+  return mask.bits() != 0;
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool all(const bool4 &mask) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return simd::all(mask.native);
+#else
+  return mask.bits() == 0xF;
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float4 select(const bool4 &mask, const float4 &a,
+                                         const float4 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float4{simd::select(b.native, a.native, mask.native)};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return float4{DirectX::XMVectorSelect(b.native, a.native, mask.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return float4{_mm_blendv_ps(b.native, a.native, mask.native)};
+  }
+#endif
+
+  return float4{mask.x() ? a.x() : b.x(), mask.y() ? a.y() : b.y(),
+                mask.z() ? a.z() : b.z(), mask.w() ? a.w() : b.w()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool4 equal(const float4 &a, const float4 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return bool4{a.native == b.native};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return bool4{DirectX::XMVectorEqual(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return bool4{_mm_cmpeq_ps(a.native, b.native)};
+  }
+#endif
+
+  return bool4{a.x() == b.x(), a.y() == b.y(), a.z() == b.z(), a.w() == b.w()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool4 not_equal(const float4 &a, const float4 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return bool4{a.native != b.native};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return bool4{DirectX::XMVectorNotEqual(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return bool4{_mm_cmpneq_ps(a.native, b.native)};
+  }
+#endif
+
+  return bool4{a.x() != b.x(), a.y() != b.y(), a.z() != b.z(), a.w() != b.w()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool4 less(const float4 &a, const float4 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return bool4{a.native < b.native};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return bool4{DirectX::XMVectorLess(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return bool4{_mm_cmplt_ps(a.native, b.native)};
+  }
+#endif
+
+  return bool4{a.x() < b.x(), a.y() < b.y(), a.z() < b.z(), a.w() < b.w()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool4 less_equal(const float4 &a, const float4 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return bool4{a.native <= b.native};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return bool4{DirectX::XMVectorLessOrEqual(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return bool4{_mm_cmple_ps(a.native, b.native)};
+  }
+#endif
+
+  return bool4{a.x() <= b.x(), a.y() <= b.y(), a.z() <= b.z(), a.w() <= b.w()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool4 greater(const float4 &a, const float4 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return bool4{a.native > b.native};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return bool4{DirectX::XMVectorGreater(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return bool4{_mm_cmpgt_ps(a.native, b.native)};
+  }
+#endif
+
+  return bool4{a.x() > b.x(), a.y() > b.y(), a.z() > b.z(), a.w() > b.w()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool4 greater_equal(const float4 &a,
+                                               const float4 &b) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return bool4{a.native >= b.native};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return bool4{DirectX::XMVectorGreaterOrEqual(a.native, b.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    return bool4{_mm_cmpge_ps(a.native, b.native)};
+  }
+#endif
+
+  return bool4{a.x() >= b.x(), a.y() >= b.y(), a.z() >= b.z(), a.w() >= b.w()};
+#endif
+}
+
+inline bool4 nearly_equal(const float4 &a, const float4 &b, float tolerance) {
+  float4 bound{tolerance, tolerance, tolerance, tolerance};
+  return less_equal(abs(a - b), bound);
+}
+}  // namespace graphmath
@@ -0,0 +1,181 @@
+//
+//  packed_float3.h
+//  CS 419
+//
+//  12 byte storage for `float3`
+//
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "graphmath/backend.h"
+#include "graphmath/float3.h"
+#include "graphmath/span.h"
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+#include "graphmath/sse.h"
+#endif
+
+// Declarations
+
+namespace graphmath {
+/// @brief three `float32` numbers `(x, y, z)` without padding, for vertex
+/// buffers and files
+/// `float3` is 16 bytes on the SIMD backends; arrays of `packed_float3` are a
+/// quarter smaller and are converted in bulk with `pack` and `unpack`
+struct packed_float3 final {
+ public:
+  /// @brief create a `packed_float3` of zeroes
+  constexpr packed_float3() = default;
+
+  /// @brief create a `packed_float3` with values
+  /// @param x x
+  /// @param y y
+  /// @param z z
+  constexpr packed_float3(float x, float y, float z);
+
+  /// @brief create a `packed_float3` from a `float3`
+  /// @param f3 the `float3`
+  GRAPHMATH_CONSTEXPR packed_float3(const float3 &f3);
+
+  /// @brief Get `x` of `packed_float3`
+  /// @returns the `x` value of `packed_float3`
+  constexpr float x() const;
+
+  /// @brief Get `y` of `packed_float3`
+  /// @returns the `y` value of `packed_float3`
+  constexpr float y() const;
+
+  /// @brief Get `z` of `packed_float3`
+  /// @returns the `z` value of `packed_float3`
+  constexpr float z() const;
+
+  /// @brief Convert to a `float3`
+  /// @returns the `float3`
+  GRAPHMATH_CONSTEXPR float3 unpack() const;
+
+  float native[3] = {0.0f, 0.0f, 0.0f};
+};
+
+static_assert(sizeof(packed_float3) == 3 * sizeof(float),
+              "packed_float3 must not be padded");
+static_assert(alignof(packed_float3) == alignof(float),
+              "packed_float3 must be aligned like float");
+static_assert(std::is_trivially_copyable_v<packed_float3>,
+              "packed_float3 must be trivially copyable");
+static_assert(std::is_standard_layout_v<packed_float3>,
+              "packed_float3 must be standard layout");
+
+/// @brief Convert many `float3` to `packed_float3`
+/// @param in the vectors
+/// @param out the packed vectors, `out.size() == in.size()`
+void pack(span<const float3> in, span<packed_float3> out);
+
+/// @brief Convert many `packed_float3` to `float3`
+/// @param in the packed vectors
+/// @param out the vectors, `out.size() == in.size()`
+void unpack(span<const packed_float3> in, span<float3> out);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+inline constexpr packed_float3::packed_float3(float x, float y, float z)
+    : native{x, y, z} {}
+
+inline GRAPHMATH_CONSTEXPR packed_float3::packed_float3(const float3 &f3)
+    : native{f3.x(), f3.y(), f3.z()} {}
+
+inline constexpr float packed_float3::x() const { return native[0]; }
+
+inline constexpr float packed_float3::y() const { return native[1]; }
+
+inline constexpr float packed_float3::z() const { return native[2]; }
+
+inline GRAPHMATH_CONSTEXPR float3 packed_float3::unpack() const {
+  return float3{native[0], native[1], native[2]};
+}
+
+inline void pack(span<const float3> in, span<packed_float3> out) {
+  assert(in.size() == out.size());
+
+  size_t i = 0;
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+  // four `xyz0` registers become three registers of `xyzx yzxy zxyz`
+  for (; i + 4 <= in.size(); i += 4) {
+    __m128i a0 = _mm_castps_si128(in[i + 0].native);
+    __m128i a1 = _mm_castps_si128(in[i + 1].native);
+    __m128i a2 = _mm_castps_si128(in[i + 2].native);
+    __m128i a3 = _mm_castps_si128(in[i + 3].native);
+
+    __m128i v0 = _mm_blend_epi16(a0, _mm_slli_si128(a1, 12), 0xC0);
+    __m128i v1 =
+        _mm_blend_epi16(_mm_srli_si128(a1, 4), _mm_slli_si128(a2, 8), 0xF0);
+    __m128i v2 =
+        _mm_blend_epi16(_mm_srli_si128(a2, 8), _mm_slli_si128(a3, 4), 0xFC);
+
+    __m128i *address = reinterpret_cast<__m128i *>(out.data() + i);
+
+    _mm_storeu_si128(address + 0, v0);
+    _mm_storeu_si128(address + 1, v1);
+    _mm_storeu_si128(address + 2, v2);
+  }
+#elif defined(GRAPHMATH_BACKEND_SCALAR)
+  // `float3` is unpadded as well
+  static_assert(sizeof(float3) == sizeof(packed_float3),
+                "the scalar float3 must not be padded");
+
+  if (!in.empty()) {
+    std::memcpy(static_cast<void *>(out.data()), in.data(),
+                in.size() * sizeof(float3));
+  }
+
+  i = in.size();
+#endif
+
+  for (; i < in.size(); i++) {
+    out[i] = packed_float3{in[i]};
+  }
+}
+
+inline void unpack(span<const packed_float3> in, span<float3> out) {
+  assert(in.size() == out.size());
+
+  size_t i = 0;
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+  // three registers of `xyzx yzxy zxyz` become four `xyz0` registers
+  for (; i + 4 <= in.size(); i += 4) {
+    const __m128i *address = reinterpret_cast<const __m128i *>(in.data() + i);
+
+    __m128i v0 = _mm_loadu_si128(address + 0);
+    __m128i v1 = _mm_loadu_si128(address + 1);
+    __m128i v2 = _mm_loadu_si128(address + 2);
+
+    __m128 zero = _mm_setzero_ps();
+
+    out[i + 0].native = _mm_blend_ps(_mm_castsi128_ps(v0), zero, 0x8);
+    out[i + 1].native = _mm_blend_ps(
+        _mm_castsi128_ps(_mm_alignr_epi8(v1, v0, 12)), zero, 0x8);
+    out[i + 2].native = _mm_blend_ps(
+        _mm_castsi128_ps(_mm_alignr_epi8(v2, v1, 8)), zero, 0x8);
+    out[i + 3].native = _mm_castsi128_ps(_mm_srli_si128(v2, 4));
+  }
+#elif defined(GRAPHMATH_BACKEND_SCALAR)
+  if (!in.empty()) {
+    std::memcpy(static_cast<void *>(out.data()), in.data(),
+                in.size() * sizeof(float3));
+  }
+
+  i = in.size();
+#endif
+
+  for (; i < in.size(); i++) {
+    out[i] = in[i].unpack();
+  }
+}
+}  // namespace graphmath
@@ -0,0 +1,433 @@
+//
+//  parse.h
+//  CS 419
+//
+//  Parsers of `float3` and `float4` text, one vector or whole buffers of
+//  vertex lines
+//
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "graphmath/float3.h"
+#include "graphmath/float3_soa.h"
+#include "graphmath/float4.h"
+#include "graphmath/float4_soa.h"
+
+// Declarations
+
+namespace graphmath {
+/// @brief the outcome of a parse
+struct parse_result final {
+  /// @brief where parsing stopped: past the parsed text, or at the start of
+  /// the line that failed
+  const char *ptr;
+
+  /// @brief the number of vectors parsed
+  size_t count;
+
+  /// @brief `std::errc{}` on success, `std::errc::invalid_argument` for a
+  /// missing or malformed number, `std::errc::result_out_of_range` for a
+  /// number out of the range of `float`
+  std::errc ec;
+};
+
+/// @brief Parse a `float3`
+///
+/// Components are read with `std::from_chars`, which has no locale, and are
+/// separated by spaces, tabs, commas, or the brackets `format_to` writes
+/// @param first the first character
+/// @param last one past the last character
+/// @param value the vector, set on success
+/// @returns `ptr` past the last component and `count == 1` on success
+parse_result parse(const char *first, const char *last, float3 &value);
+
+/// @brief Parse a `float4`, like a `float3`
+/// @param first the first character
+/// @param last one past the last character
+/// @param value the vector, set on success
+/// @returns `ptr` past the last component and `count == 1` on success
+parse_result parse(const char *first, const char *last, float4 &value);
+
+/// @brief Parse lines of `float3`, appending them to `out`
+///
+/// Each line holds a vector, parsed like by `parse`; numbers after the
+/// third are ignored, such as `w` in OBJ or normals in PLY. Blank lines and
+/// lines starting with `#` are skipped. With a `prefix`, only lines starting
+/// with that word are read, and the others are skipped, as in `"v"` for the
+/// positions of an OBJ file.
+///
+/// With more than one thread, the text is split at line boundaries and the
+/// parts are parsed at once into separate arrays, which are appended in
+/// order
+/// @param first the first character
+/// @param last one past the last character
+/// @param out the vectors; on failure, holds the lines before the bad one
+/// @param prefix the word starting the lines to read, or `nullptr`
+/// @param thread_count the maximum number of threads, including the calling
+/// thread
+/// @returns `ptr == last` on success
+parse_result parse_lines(const char *first, const char *last,
+                         std::vector<float3> &out,
+                         const char *prefix = nullptr,
+                         size_t thread_count = 1);
+
+/// @brief Parse lines of `float4` like lines of `float3`, appending them to
+/// `out`
+/// @param first the first character
+/// @param last one past the last character
+/// @param out the vectors; on failure, holds the lines before the bad one
+/// @param prefix the word starting the lines to read, or `nullptr`
+/// @param thread_count the maximum number of threads, including the calling
+/// thread
+/// @returns `ptr == last` on success
+parse_result parse_lines(const char *first, const char *last,
+                         std::vector<float4> &out,
+                         const char *prefix = nullptr,
+                         size_t thread_count = 1);
+
+/// @brief Parse lines of `float3` into structure-of-arrays storage,
+/// appending them to `out`
+/// @param first the first character
+/// @param last one past the last character
+/// @param out the vectors; on failure, holds the lines before the bad one
+/// @param prefix the word starting the lines to read, or `nullptr`
+/// @param thread_count the maximum number of threads, including the calling
+/// thread
+/// @returns `ptr == last` on success
+parse_result parse_lines(const char *first, const char *last,
+                         float3_soa &out, const char *prefix = nullptr,
+                         size_t thread_count = 1);
+
+/// @brief Parse lines of `float4` into structure-of-arrays storage,
+/// appending them to `out`
+/// @param first the first character
+/// @param last one past the last character
+/// @param out the vectors; on failure, holds the lines before the bad one
+/// @param prefix the word starting the lines to read, or `nullptr`
+/// @param thread_count the maximum number of threads, including the calling
+/// thread
+/// @returns `ptr == last` on success
+parse_result parse_lines(const char *first, const char *last,
+                         float4_soa &out, const char *prefix = nullptr,
+                         size_t thread_count = 1);
+
+/// @brief Find the first line starting at or after a position, to split text
+/// into parts that are parsed separately
+/// @param first the first character of the text
+/// @param position a position in `[first, last]`
+/// @param last one past the last character of the text
+/// @returns the start of the line, or `last`
+const char *line_boundary(const char *first, const char *position,
+                          const char *last);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+namespace detail {
+/// @brief the smallest text in bytes worth a thread
+constexpr size_t parse_parallel_size = 1 << 20;
+
+inline bool is_parse_separator(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == ',' || c == '[' ||
+         c == ']';
+}
+
+inline bool is_parse_space(char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+/// @brief Parse `Components` floats separated like in `parse`
+/// @returns where parsing stopped, with `count` 1 on success
+template <size_t Components>
+parse_result parse_components(const char *first, const char *last,
+                              float (&components)[Components]) {
+  const char *p = first;
+
+  for (size_t i = 0; i < Components; i++) {
+    while (p != last && is_parse_separator(*p)) {
+      p++;
+    }
+
+    // `from_chars` takes no `+`, which some exporters write
+    if (p != last && *p == '+') {
+      p++;
+    }
+
+    std::from_chars_result result = std::from_chars(p, last, components[i]);
+
+    if (result.ec == std::errc::result_out_of_range) {
+      // some standard libraries take subnormal floats for out of range;
+      // `double` holds them
+      double wide = 0.0;
+      std::from_chars_result wide_result = std::from_chars(p, last, wide);
+
+      if (wide_result.ec == std::errc{} &&
+          std::abs(wide) < std::numeric_limits<float>::min() &&
+          static_cast<float>(wide) != 0.0f) {
+        components[i] = static_cast<float>(wide);
+        result = wide_result;
+      }
+    }
+
+    if (result.ec != std::errc{}) {
+      return parse_result{p, 0, result.ec};
+    }
+
+    p = result.ptr;
+  }
+
+  return parse_result{p, 1, std::errc{}};
+}
+
+/// @brief how `parse_lines` appends to each kind of array
+template <typename Out>
+struct parse_traits;
+
+template <>
+struct parse_traits<std::vector<float3>> {
+  static constexpr size_t components = 3;
+
+  static void append(std::vector<float3> &out, const float (&c)[3]) {
+    out.push_back(float3{c[0], c[1], c[2]});
+  }
+
+  static void append(std::vector<float3> &out,
+                     const std::vector<float3> &values) {
+    out.insert(out.end(), values.begin(), values.end());
+  }
+};
+
+template <>
+struct parse_traits<std::vector<float4>> {
+  static constexpr size_t components = 4;
+
+  static void append(std::vector<float4> &out, const float (&c)[4]) {
+    out.push_back(float4{c[0], c[1], c[2], c[3]});
+  }
+
+  static void append(std::vector<float4> &out,
+                     const std::vector<float4> &values) {
+    out.insert(out.end(), values.begin(), values.end());
+  }
+};
+
+template <>
+struct parse_traits<float3_soa> {
+  static constexpr size_t components = 3;
+
+  static void append(float3_soa &out, const float (&c)[3]) {
+    size_t size = out.size();
+
+    out.resize(size + 1);
+    out.x()[size] = c[0];
+    out.y()[size] = c[1];
+    out.z()[size] = c[2];
+  }
+
+  static void append(float3_soa &out, const float3_soa &values) {
+    size_t size = out.size();
+
+    out.resize(size + values.size());
+    std::copy_n(values.x(), values.size(), out.x() + size);
+    std::copy_n(values.y(), values.size(), out.y() + size);
+    std::copy_n(values.z(), values.size(), out.z() + size);
+  }
+};
+
+template <>
+struct parse_traits<float4_soa> {
+  static constexpr size_t components = 4;
+
+  static void append(float4_soa &out, const float (&c)[4]) {
+    size_t size = out.size();
+
+    out.resize(size + 1);
+    out.x()[size] = c[0];
+    out.y()[size] = c[1];
+    out.z()[size] = c[2];
+    out.w()[size] = c[3];
+  }
+
+  static void append(float4_soa &out, const float4_soa &values) {
+    size_t size = out.size();
+
+    out.resize(size + values.size());
+    std::copy_n(values.x(), values.size(), out.x() + size);
+    std::copy_n(values.y(), values.size(), out.y() + size);
+    std::copy_n(values.z(), values.size(), out.z() + size);
+    std::copy_n(values.w(), values.size(), out.w() + size);
+  }
+};
+
+/// @brief Parse the lines of `[first, last)` on the calling thread
+template <typename Out>
+parse_result parse_range(const char *first, const char *last, Out &out,
+                         const char *prefix) {
+  constexpr size_t components = parse_traits<Out>::components;
+  size_t prefix_size = prefix != nullptr ? std::strlen(prefix) : 0;
+  size_t count = 0;
+
+  for (const char *line = first; line != last;) {
+    const char *end = static_cast<const char *>(
+        std::memchr(line, '\n', static_cast<size_t>(last - line)));
+    end = end != nullptr ? end : last;
+
+    const char *p = line;
+    while (p != end && is_parse_space(*p)) {
+      p++;
+    }
+
+    bool skip = p == end || *p == '#';
+
+    if (!skip && prefix != nullptr) {
+      // the prefix must be a whole word, so `v` doesn't take `vn` lines
+      skip = static_cast<size_t>(end - p) <= prefix_size ||
+             std::memcmp(p, prefix, prefix_size) != 0 ||
+             !is_parse_space(p[prefix_size]);
+      p += prefix_size;
+    }
+
+    if (!skip) {
+      float c[components];
+      parse_result result = parse_components(p, end, c);
+
+      if (result.ec != std::errc{}) {
+        return parse_result{line, count, result.ec};
+      }
+
+      parse_traits<Out>::append(out, c);
+      count++;
+    }
+
+    line = end != last ? end + 1 : last;
+  }
+
+  return parse_result{last, count, std::errc{}};
+}
+
+/// @brief Parse the lines of `[first, last)` on up to `thread_count`
+/// threads, a part of the text on each
+template <typename Out>
+parse_result parse_lines(const char *first, const char *last, Out &out,
+                         const char *prefix, size_t thread_count) {
+  size_t size = static_cast<size_t>(last - first);
+  size_t part_count = std::max(
+      size_t{1}, std::min(thread_count, size / parse_parallel_size));
+
+  if (part_count == 1) {
+    return parse_range(first, last, out, prefix);
+  }
+
+  std::vector<const char *> bounds(part_count + 1);
+  bounds[0] = first;
+  bounds[part_count] = last;
+
+  for (size_t part = 1; part < part_count; part++) {
+    bounds[part] = line_boundary(first, first + size * part / part_count, last);
+  }
+
+  std::vector<Out> parts(part_count);
+  std::vector<parse_result> results(part_count);
+  std::vector<std::thread> threads;
+  threads.reserve(part_count - 1);
+
+  const auto parse_part = [&](size_t part) {
+    results[part] =
+        parse_range(bounds[part], bounds[part + 1], parts[part], prefix);
+  };
+
+  for (size_t part = 1; part < part_count; part++) {
+    threads.emplace_back(parse_part, part);
+  }
+
+  parse_part(0);
+
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  size_t count = 0;
+
+  for (size_t part = 0; part < part_count; part++) {
+    parse_traits<Out>::append(out, parts[part]);
+    count += results[part].count;
+
+    if (results[part].ec != std::errc{}) {
+      return parse_result{results[part].ptr, count, results[part].ec};
+    }
+  }
+
+  return parse_result{last, count, std::errc{}};
+}
+}  // namespace detail
+
+inline parse_result parse(const char *first, const char *last,
+                          float3 &value) {
+  float c[3];
+  parse_result result = detail::parse_components(first, last, c);
+
+  if (result.ec == std::errc{}) {
+    value = float3{c[0], c[1], c[2]};
+  }
+
+  return result;
+}
+
+inline parse_result parse(const char *first, const char *last,
+                          float4 &value) {
+  float c[4];
+  parse_result result = detail::parse_components(first, last, c);
+
+  if (result.ec == std::errc{}) {
+    value = float4{c[0], c[1], c[2], c[3]};
+  }
+
+  return result;
+}
+
+inline parse_result parse_lines(const char *first, const char *last,
+                                std::vector<float3> &out, const char *prefix,
+                                size_t thread_count) {
+  return detail::parse_lines(first, last, out, prefix, thread_count);
+}
+
+inline parse_result parse_lines(const char *first, const char *last,
+                                std::vector<float4> &out, const char *prefix,
+                                size_t thread_count) {
+  return detail::parse_lines(first, last, out, prefix, thread_count);
+}
+
+inline parse_result parse_lines(const char *first, const char *last,
+                                float3_soa &out, const char *prefix,
+                                size_t thread_count) {
+  return detail::parse_lines(first, last, out, prefix, thread_count);
+}
+
+inline parse_result parse_lines(const char *first, const char *last,
+                                float4_soa &out, const char *prefix,
+                                size_t thread_count) {
+  return detail::parse_lines(first, last, out, prefix, thread_count);
+}
+
+inline const char *line_boundary(const char *first, const char *position,
+                                 const char *last) {
+  if (position == first || position[-1] == '\n') {
+    return position;
+  }
+
+  const char *end = static_cast<const char *>(
+      std::memchr(position, '\n', static_cast<size_t>(last - position)));
+
+  return end != nullptr ? end + 1 : last;
+}
+}  // namespace graphmath
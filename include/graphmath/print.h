@@ -1,10 +1,15 @@
 #pragma once
 
+#include <array>
+#include <charconv>
+#include <cstddef>
 #include <ostream>
+#include <type_traits>
 
 #include "graphmath/float3.h"
 #include "graphmath/float4.h"
 #include "graphmath/float4x4.h"
+#include "graphmath/span.h"
 
 namespace graphmath {
 namespace print {
@@ -20,6 +25,25 @@ constexpr CharT left_square{'['};
 template <typename CharT>
 constexpr CharT right_square{']'};
 
+template <typename CharT>
+constexpr CharT newline{'\n'};
+
+/// @brief the most characters `format_to` writes for one `float`, as in
+/// `-1.1754944e-38`
+constexpr size_t max_float_chars = 15;
+
+/// @brief the most characters `format_to` writes for a `float3`
+constexpr size_t max_float3_chars = 3 * max_float_chars + 6;
+
+/// @brief the most characters `format_to` writes for a `float4`
+constexpr size_t max_float4_chars = 4 * max_float_chars + 8;
+
+/// @brief the most characters `format_to` writes for a `float4x4`
+constexpr size_t max_float4x4_chars = 4 * max_float4_chars + 11;
+
+/// @brief the size of the buffer `write_text` fills before each call of its
+/// sink
+constexpr size_t text_buffer_size = 1 << 14;
 }  // namespace print
 
 /// @brief print a `float3` to an out stream
@@ -37,6 +61,64 @@ template <typename CharT>
 std::basic_ostream<CharT> &operator<<(std::basic_ostream<CharT> &out,
                                       const float4x4 &f4x4);
 
+/// @brief Format a `float3` without a stream or a locale
+///
+/// Same bracket layout as `operator<<`, with shortest round-trip digits:
+/// components are written with `std::to_chars`, in the shortest form that
+/// reads back to the same `float`, so the text differs from the stream's six
+/// significant digits (`0.33333334` rather than `0.333333`). No null
+/// character is written
+/// @param first the first character, with room for `print::max_float3_chars`
+/// @param f3 the value
+/// @returns one past the last character written
+char *format_to(char *first, const float3 &f3);
+
+/// @brief Format a `float4` without a stream or a locale, see
+/// `format_to(char *, const float3 &)`
+/// @param first the first character, with room for `print::max_float4_chars`
+/// @param f4 the value
+/// @returns one past the last character written
+char *format_to(char *first, const float4 &f4);
+
+/// @brief Format a `float4x4` without a stream or a locale, one row per line
+/// in the layout of `operator<<`, see `format_to(char *, const float3 &)`
+/// @param first the first character, with room for
+/// `print::max_float4x4_chars`
+/// @param f4x4 the value
+/// @returns one past the last character written
+char *format_to(char *first, const float4x4 &f4x4);
+
+/// @brief Write values as text, one per line as `format_to` formats them
+///
+/// The text is collected in a buffer of `print::text_buffer_size`
+/// characters, which is handed to `sink` each time it fills up and once at
+/// the end
+/// @param values the values
+/// @param sink called as `sink(const char *data, size_t size)`
+template <typename Sink,
+          typename = std::enable_if_t<
+              std::is_invocable_v<Sink &, const char *, size_t>>>
+void write_text(span<const float3> values, Sink &&sink);
+
+/// @brief Write values as text, one per line as `format_to` formats them
+/// @param values the values
+/// @param sink called as `sink(const char *data, size_t size)`
+template <typename Sink,
+          typename = std::enable_if_t<
+              std::is_invocable_v<Sink &, const char *, size_t>>>
+void write_text(span<const float4> values, Sink &&sink);
+
+/// @brief Write values as text to an out stream, with one `write` per
+/// buffer of text and no flush
+/// @param values the values
+/// @param out the stream
+void write_text(span<const float3> values, std::ostream &out);
+
+/// @brief Write values as text to an out stream, with one `write` per
+/// buffer of text and no flush
+/// @param values the values
+/// @param out the stream
+void write_text(span<const float4> values, std::ostream &out);
 }  // namespace graphmath
 
 namespace graphmath {
@@ -74,26 +156,28 @@ std::basic_ostream<CharT> &operator<<(std::basic_ostream<CharT> &out,
   using namespace print;
 
   const auto print_line = [&](size_t y) {
+    float4 row = f4x4.row(y);
+
     out << left_square<CharT>;
-    out << f4x4.get(y, 0) << comma<CharT> << space<CharT>;
-    out << f4x4.get(y, 1) << comma<CharT> << space<CharT>;
-    out << f4x4.get(y, 2) << comma<CharT> << space<CharT>;
-    out << f4x4.get(y, 3);
+    out << row.x() << comma<CharT> << space<CharT>;
+    out << row.y() << comma<CharT> << space<CharT>;
+    out << row.z() << comma<CharT> << space<CharT>;
+    out << row.w();
     out << right_square<CharT>;
   };
 
   out << left_square<CharT>;
 
   print_line(0);
-  out << comma<CharT> << std::endl;
+  out << comma<CharT> << newline<CharT>;
 
   out << space<CharT>;
   print_line(1);
-  out << comma<CharT> << std::endl;
+  out << comma<CharT> << newline<CharT>;
 
   out << space<CharT>;
   print_line(2);
-  out << comma<CharT> << std::endl;
+  out << comma<CharT> << newline<CharT>;
 
   out << space<CharT>;
   print_line(3);
@@ -101,4 +185,110 @@ std::basic_ostream<CharT> &operator<<(std::basic_ostream<CharT> &out,
 
   return out;
 }
+
+namespace detail {
+inline char *format_float(char *first, float value) {
+  return std::to_chars(first, first + print::max_float_chars, value).ptr;
+}
+
+inline char *format_separator(char *first) {
+  first[0] = ',';
+  first[1] = ' ';
+  return first + 2;
+}
+
+template <typename T, typename Sink>
+void write_text(span<const T> values, Sink &sink) {
+  constexpr size_t max_line_chars =
+      std::is_same_v<T, float3> ? print::max_float3_chars + 1
+                                : print::max_float4_chars + 1;
+
+  std::array<char, print::text_buffer_size> buffer;
+  char *last = buffer.data();
+
+  for (size_t i = 0; i < values.size(); i++) {
+    size_t room = static_cast<size_t>(buffer.data() + buffer.size() - last);
+
+    if (room < max_line_chars) {
+      sink(static_cast<const char *>(buffer.data()),
+           static_cast<size_t>(last - buffer.data()));
+      last = buffer.data();
+    }
+
+    last = graphmath::format_to(last, values[i]);
+    *last++ = '\n';
+  }
+
+  if (last != buffer.data()) {
+    sink(static_cast<const char *>(buffer.data()),
+         static_cast<size_t>(last - buffer.data()));
+  }
+}
+}  // namespace detail
+
+inline char *format_to(char *first, const float3 &f3) {
+  *first++ = '[';
+  first = detail::format_float(first, f3.x());
+  first = detail::format_separator(first);
+  first = detail::format_float(first, f3.y());
+  first = detail::format_separator(first);
+  first = detail::format_float(first, f3.z());
+  *first++ = ']';
+
+  return first;
+}
+
+inline char *format_to(char *first, const float4 &f4) {
+  *first++ = '[';
+  first = detail::format_float(first, f4.x());
+  first = detail::format_separator(first);
+  first = detail::format_float(first, f4.y());
+  first = detail::format_separator(first);
+  first = detail::format_float(first, f4.z());
+  first = detail::format_separator(first);
+  first = detail::format_float(first, f4.w());
+  *first++ = ']';
+
+  return first;
+}
+
+inline char *format_to(char *first, const float4x4 &f4x4) {
+  *first++ = '[';
+
+  for (size_t y = 0; y < 4; y++) {
+    if (y != 0) {
+      *first++ = ',';
+      *first++ = '\n';
+      *first++ = ' ';
+    }
+
+    first = format_to(first, f4x4.row(y));
+  }
+
+  *first++ = ']';
+
+  return first;
+}
+
+template <typename Sink, typename>
+void write_text(span<const float3> values, Sink &&sink) {
+  detail::write_text(values, sink);
+}
+
+template <typename Sink, typename>
+void write_text(span<const float4> values, Sink &&sink) {
+  detail::write_text(values, sink);
+}
+
+inline void write_text(span<const float3> values, std::ostream &out) {
+  write_text(values, [&](const char *data, size_t size) {
+    out.write(data, static_cast<std::streamsize>(size));
+  });
+}
+
+inline void write_text(span<const float4> values, std::ostream &out) {
+  write_text(values, [&](const char *data, size_t size) {
+    out.write(data, static_cast<std::streamsize>(size));
+  });
+}
 }  // namespace graphmath
@@ -0,0 +1,592 @@
+//
+//  quaternion.h
+//  CS 419
+//
+//  Rotations as unit quaternions
+//
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "graphmath/backend.h"
+#include "graphmath/float3.h"
+#include "graphmath/float4.h"
+#include "graphmath/float4x4.h"
+#include "graphmath/span.h"
+
+#if defined(GRAPHMATH_BACKEND_APPLE)
+#include <simd/simd.h>
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+#include <DirectXMath.h>
+#elif defined(GRAPHMATH_BACKEND_SSE)
+#include "graphmath/sse.h"
+#endif
+
+// Declarations
+
+namespace graphmath {
+/// @brief a rotation `(x, y, z, w)`, with the imaginary part in `xyz` and the
+/// real part in `w`, stored like a `float4`
+///
+/// `a * b` rotates by `b` and then by `a`, like `float4x4` multiplication
+struct quaternion final {
+ public:
+  /// @brief the native quaternion type, the native type of `float4`
+  using native_quaternion = float4::native_float4;
+
+  /// @brief create the identity rotation `(0, 0, 0, 1)`
+  GRAPHMATH_CONSTEXPR quaternion();
+
+  /// @brief create a `quaternion` with values
+  /// @param x x
+  /// @param y y
+  /// @param z z
+  /// @param w w, the real part
+  GRAPHMATH_CONSTEXPR quaternion(float x, float y, float z, float w);
+
+  /// @brief create a `quaternion` from the values of a `float4`
+  /// @param f4 the `float4`
+  GRAPHMATH_CONSTEXPR explicit quaternion(const float4 &f4);
+
+  /// @brief create a `quaternion` with a `native_quaternion`
+  /// @param native the native value
+  GRAPHMATH_CONSTEXPR quaternion(const native_quaternion &native);
+
+  /// @brief Get `x` of `quaternion`
+  /// @returns the `x` value of `quaternion`
+  GRAPHMATH_CONSTEXPR float x() const;
+
+  /// @brief Get `y` of `quaternion`
+  /// @returns the `y` value of `quaternion`
+  GRAPHMATH_CONSTEXPR float y() const;
+
+  /// @brief Get `z` of `quaternion`
+  /// @returns the `z` value of `quaternion`
+  GRAPHMATH_CONSTEXPR float z() const;
+
+  /// @brief Get `w` of `quaternion`
+  /// @returns the `w` value of `quaternion`
+  GRAPHMATH_CONSTEXPR float w() const;
+
+  /// @brief Get the values as a `float4`
+  /// @returns `(x, y, z, w)`
+  GRAPHMATH_CONSTEXPR float4 as_float4() const;
+
+  /// @brief Compose two rotations, the Hamilton product `a * b`
+  /// @param rhs `b`
+  /// @returns the rotation by `b` followed by `a`
+  quaternion operator*(const quaternion &rhs) const;
+
+  /// @brief Compare with another `quaternion`
+  /// @param rhs another `quaternion`
+  /// @returns true if equal; false otherwise
+  GRAPHMATH_CONSTEXPR bool operator==(const quaternion &rhs) const;
+
+  /// @brief Compare with another `quaternion`
+  /// @param rhs another `quaternion`
+  /// @returns true if not equal; false otherwise
+  GRAPHMATH_CONSTEXPR bool operator!=(const quaternion &rhs) const;
+
+  native_quaternion native;
+};
+
+static_assert(std::is_trivially_copyable_v<quaternion>,
+              "quaternion must be trivially copyable");
+static_assert(sizeof(quaternion) == sizeof(float4),
+              "quaternion must be the size of float4");
+static_assert(alignof(quaternion) == alignof(float4),
+              "quaternion must be aligned like float4");
+
+/// @brief Create a rotation around an axis
+/// @param axis the axis, must be normalized
+/// @param radians the angle, counterclockwise when looking down `axis`
+/// @returns the rotation
+quaternion from_axis_angle(const float3 &axis, float radians);
+
+/// @brief Compute the dot product of two `quaternion`
+/// @param a one `quaternion`
+/// @param b one `quaternion`
+/// @returns the result `float`
+GRAPHMATH_CONSTEXPR float dot(const quaternion &a, const quaternion &b);
+
+/// @brief Get the conjugate `(-x, -y, -z, w)`, the inverse of a unit
+/// `quaternion`
+/// @param q the `quaternion`
+/// @returns the conjugate
+quaternion conjugate(const quaternion &q);
+
+/// @brief Get the inverse of a `quaternion` that is not necessarily unit
+/// @param q the `quaternion`, not zero
+/// @returns the inverse
+quaternion inverse(const quaternion &q);
+
+/// @brief Get a unit version of a `quaternion`
+/// @param q the `quaternion`, not zero
+/// @returns the normalized `quaternion`
+quaternion normalize(const quaternion &q);
+
+/// @brief Rotate a vector
+/// @param q the rotation, must be normalized
+/// @param v the vector
+/// @returns the rotated vector
+float3 rotate(const quaternion &q, const float3 &v);
+
+/// @brief Interpolate along the shortest arc at constant angular velocity
+/// @param a the rotation at `t = 0`, must be normalized
+/// @param b the rotation at `t = 1`, must be normalized
+/// @param t the interpolation parameter in `[0, 1]`
+/// @returns the interpolated rotation
+quaternion slerp(const quaternion &a, const quaternion &b, float t);
+
+/// @brief Interpolate along the shortest arc by normalizing the linear
+/// interpolation, cheaper than `slerp` but not at constant angular velocity
+/// @param a the rotation at `t = 0`, must be normalized
+/// @param b the rotation at `t = 1`, must be normalized
+/// @param t the interpolation parameter in `[0, 1]`
+/// @returns the interpolated rotation
+quaternion nlerp(const quaternion &a, const quaternion &b, float t);
+
+/// @brief Convert a rotation to a matrix
+/// @param q the rotation, must be normalized
+/// @returns the rotation matrix, `to_float4x4(q) * float4{v, 0}` rotates `v`
+float4x4 to_float4x4(const quaternion &q);
+
+/// @brief Convert the rotation of a matrix to a `quaternion`
+/// @param m the matrix, its upper 3x3 must be a rotation
+/// @returns the normalized rotation
+quaternion from_float4x4(const float4x4 &m);
+
+/// @brief Interpolate many pairs of rotations with one `t`, e.g. to blend two
+/// animation poses
+///
+/// The angle is not computed with `acos` and `sin`: the weights are a
+/// polynomial in `dot(a, b)` and `t`, and the results stay within `5e-7` of the
+/// exact interpolation, as close as `slerp` itself
+/// @param a the rotations at `t = 0`, must be normalized
+/// @param b the rotations at `t = 1`, `b.size() == a.size()`, must be
+/// normalized
+/// @param t the interpolation parameter in `[0, 1]`
+/// @param out the results, `out.size() == a.size()`; may be `a` or `b`
+void slerp(span<const quaternion> a, span<const quaternion> b, float t,
+           span<quaternion> out);
+
+/// @brief Interpolate many pairs of rotations with `nlerp`
+/// @param a the rotations at `t = 0`, must be normalized
+/// @param b the rotations at `t = 1`, `b.size() == a.size()`, must be
+/// normalized
+/// @param t the interpolation parameter in `[0, 1]`
+/// @param out the results, `out.size() == a.size()`; may be `a` or `b`
+void nlerp(span<const quaternion> a, span<const quaternion> b, float t,
+           span<quaternion> out);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+inline GRAPHMATH_CONSTEXPR quaternion::quaternion()
+    : native{float4{0.0f, 0.0f, 0.0f, 1.0f}.native} {}
+
+inline GRAPHMATH_CONSTEXPR quaternion::quaternion(float x, float y, float z,
+                                                  float w)
+    : native{float4{x, y, z, w}.native} {}
+
+inline GRAPHMATH_CONSTEXPR quaternion::quaternion(const float4 &f4)
+    : native{f4.native} {}
+
+inline GRAPHMATH_CONSTEXPR quaternion::quaternion(
+    const native_quaternion &native)
+    : native{native} {}
+
+inline GRAPHMATH_CONSTEXPR float quaternion::x() const {
+  return as_float4().x();
+}
+
+inline GRAPHMATH_CONSTEXPR float quaternion::y() const {
+  return as_float4().y();
+}
+
+inline GRAPHMATH_CONSTEXPR float quaternion::z() const {
+  return as_float4().z();
+}
+
+inline GRAPHMATH_CONSTEXPR float quaternion::w() const {
+  return as_float4().w();
+}
+
+inline GRAPHMATH_CONSTEXPR float4 quaternion::as_float4() const {
+  return float4{native};
+}
+
+inline quaternion quaternion::operator*(const quaternion &rhs) const {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return quaternion{
+      simd_mul(simd_quaternion(native), simd_quaternion(rhs.native)).vector};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  // `XMQuaternionMultiply(a, b)` is the rotation by `a` followed by `b`
+  return quaternion{DirectX::XMQuaternionMultiply(rhs.native, native)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  // each lane of the product is `a.w * b` plus `a.x`, `a.y` and `a.z` times a
+  // reordered `b` with some signs flipped
+  const __m128 x_signs = _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+  const __m128 y_signs = _mm_set_ps(-0.0f, -0.0f, 0.0f, 0.0f);
+  const __m128 z_signs = _mm_set_ps(-0.0f, 0.0f, 0.0f, -0.0f);
+
+  __m128 b = rhs.native;
+  __m128 r = _mm_mul_ps(sse::splat<3>(native), b);
+
+  r = sse::madd(sse::splat<0>(native),
+                _mm_xor_ps(sse::swizzle<3, 2, 1, 0>(b), x_signs), r);
+  r = sse::madd(sse::splat<1>(native),
+                _mm_xor_ps(sse::swizzle<2, 3, 0, 1>(b), y_signs), r);
+  r = sse::madd(sse::splat<2>(native),
+                _mm_xor_ps(sse::swizzle<1, 0, 3, 2>(b), z_signs), r);
+
+  return quaternion{r};
+#else
+  const quaternion &a = *this;
+  const quaternion &b = rhs;
+
+  return quaternion{a.w() * b.x() + a.x() * b.w() + a.y() * b.z() -
+                        a.z() * b.y(),
+                    a.w() * b.y() - a.x() * b.z() + a.y() * b.w() +
+                        a.z() * b.x(),
+                    a.w() * b.z() + a.x() * b.y() - a.y() * b.x() +
+                        a.z() * b.w(),
+                    a.w() * b.w() - a.x() * b.x() - a.y() * b.y() -
+                        a.z() * b.z()};
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR bool quaternion::operator==(
+    const quaternion &rhs) const {
+  return as_float4() == rhs.as_float4();
+}
+
+inline GRAPHMATH_CONSTEXPR bool quaternion::operator!=(
+    const quaternion &rhs) const {
+  return !(*this == rhs);
+}
+
+inline quaternion from_axis_angle(const float3 &axis, float radians) {
+  float half = radians * 0.5f;
+
+  return quaternion{float4{axis * std::sin(half), std::cos(half)}};
+}
+
+inline GRAPHMATH_CONSTEXPR float dot(const quaternion &a, const quaternion &b) {
+  return dot(a.as_float4(), b.as_float4());
+}
+
+inline quaternion conjugate(const quaternion &q) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return quaternion{simd_conjugate(simd_quaternion(q.native)).vector};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return quaternion{DirectX::XMQuaternionConjugate(q.native)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return quaternion{
+      _mm_xor_ps(q.native, _mm_set_ps(0.0f, -0.0f, -0.0f, -0.0f))};
+#else
+  return quaternion{-q.x(), -q.y(), -q.z(), q.w()};
+#endif
+}
+
+inline quaternion inverse(const quaternion &q) {
+  return quaternion{conjugate(q).as_float4() * (1.0f / dot(q, q))};
+}
+
+inline quaternion normalize(const quaternion &q) {
+  return quaternion{normalize(q.as_float4())};
+}
+
+namespace detail {
+/// @brief Get `(x, y, z)` of a `quaternion`
+inline float3 imaginary(const quaternion &q) {
+#if defined(GRAPHMATH_BACKEND_SSE)
+  return float3{_mm_blend_ps(q.native, _mm_setzero_ps(), 0x8)};
+#else
+  return float3{q.x(), q.y(), q.z()};
+#endif
+}
+}  // namespace detail
+
+inline float3 rotate(const quaternion &q, const float3 &v) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float3{simd_act(simd_quaternion(q.native), v.native)};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return float3{DirectX::XMVector3Rotate(v.native, q.native)};
+#else
+  // q * v * conjugate(q) expanded, with u the imaginary part:
+  // v + w * t + cross(u, t), where t = 2 * cross(u, v)
+  float3 u = detail::imaginary(q);
+  float3 t = cross(u, v) * 2.0f;
+
+  return v + t * q.w() + cross(u, t);
+#endif
+}
+
+inline quaternion slerp(const quaternion &a, const quaternion &b, float t) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return quaternion{
+      simd_slerp(simd_quaternion(a.native), simd_quaternion(b.native), t)
+          .vector};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return quaternion{DirectX::XMQuaternionSlerp(a.native, b.native, t)};
+#else
+  float cosine = dot(a, b);
+  float4 to = b.as_float4();
+
+  // `b` and `-b` are the same rotation, take the shorter way
+  if (cosine < 0.0f) {
+    cosine = -cosine;
+    to = to * -1.0f;
+  }
+
+  // `sin(angle)` vanishes, the arc is too short to tell from a line
+  if (cosine > 0.9995f) {
+    return nlerp(a, quaternion{to}, t);
+  }
+
+  float angle = std::acos(cosine);
+  float scale = 1.0f / std::sin(angle);
+
+  return quaternion{a.as_float4() * (std::sin((1.0f - t) * angle) * scale) +
+                    to * (std::sin(t * angle) * scale)};
+#endif
+}
+
+inline quaternion nlerp(const quaternion &a, const quaternion &b, float t) {
+  float4 to = b.as_float4();
+
+  if (dot(a, b) < 0.0f) {
+    to = to * -1.0f;
+  }
+
+  return normalize(
+      quaternion{madd(to - a.as_float4(), float4{t, t, t, t}, a.as_float4())});
+}
+
+inline float4x4 to_float4x4(const quaternion &q) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float4x4{simd_matrix4x4(simd_quaternion(q.native))};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  using namespace DirectX;
+
+  // DirectXMath builds matrices for row vectors, the transpose of `float4x4`
+  return float4x4{XMMatrixTranspose(XMMatrixRotationQuaternion(q.native))};
+#else
+  float x = q.x(), y = q.y(), z = q.z(), w = q.w();
+
+  float xx = x * x, yy = y * y, zz = z * z;
+  float xy = x * y, xz = x * z, yz = y * z;
+  float wx = w * x, wy = w * y, wz = w * z;
+
+  return float4x4{
+      float4{1.0f - 2.0f * (yy + zz), 2.0f * (xy - wz), 2.0f * (xz + wy), 0.0f},
+      float4{2.0f * (xy + wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz - wx), 0.0f},
+      float4{2.0f * (xz - wy), 2.0f * (yz + wx), 1.0f - 2.0f * (xx + yy), 0.0f},
+      float4{0.0f, 0.0f, 0.0f, 1.0f}};
+#endif
+}
+
+inline quaternion from_float4x4(const float4x4 &m) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return quaternion{simd_quaternion(m.native).vector};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  using namespace DirectX;
+
+  return quaternion{XMQuaternionRotationMatrix(XMMatrixTranspose(m.native))};
+#else
+  // start from the largest of `4 w^2`, `4 x^2`, `4 y^2` and `4 z^2`, which
+  // keeps the division below away from zero
+  float trace = m(0, 0) + m(1, 1) + m(2, 2);
+  quaternion q;
+
+  if (trace > 0.0f) {
+    float s = std::sqrt(trace + 1.0f) * 2.0f;
+    q = quaternion{(m(2, 1) - m(1, 2)) / s, (m(0, 2) - m(2, 0)) / s,
+                   (m(1, 0) - m(0, 1)) / s, 0.25f * s};
+  } else if (m(0, 0) > m(1, 1) && m(0, 0) > m(2, 2)) {
+    float s = std::sqrt(1.0f + m(0, 0) - m(1, 1) - m(2, 2)) * 2.0f;
+    q = quaternion{0.25f * s, (m(0, 1) + m(1, 0)) / s,
+                   (m(0, 2) + m(2, 0)) / s, (m(2, 1) - m(1, 2)) / s};
+  } else if (m(1, 1) > m(2, 2)) {
+    float s = std::sqrt(1.0f + m(1, 1) - m(0, 0) - m(2, 2)) * 2.0f;
+    q = quaternion{(m(0, 1) + m(1, 0)) / s, 0.25f * s,
+                   (m(1, 2) + m(2, 1)) / s, (m(0, 2) - m(2, 0)) / s};
+  } else {
+    float s = std::sqrt(1.0f + m(2, 2) - m(0, 0) - m(1, 1)) * 2.0f;
+    q = quaternion{(m(0, 2) + m(2, 0)) / s, (m(1, 2) + m(2, 1)) / s,
+                   0.25f * s, (m(1, 0) - m(0, 1)) / s};
+  }
+
+  return normalize(q);
+#endif
+}
+
+namespace detail {
+/// @brief number of terms of the series used by the batched `slerp`
+constexpr size_t slerp_terms = 14;
+
+/// @brief Compute the coefficients of the series of
+/// `sin(t * angle) / sin(angle)` in `cos(angle) - 1`
+///
+/// `sin(t * angle) / sin(angle) = t * (1 + c[0] * (x - 1) * (1 + c[1] *
+/// (x - 1) * (...)))` where `x = cos(angle)` and
+/// `c[i] = (t^2 - (i + 1)^2) / ((i + 1) * (2 * i + 3))`. The last term is
+/// scaled to make up for the truncated ones, keeping the error near `1e-7` for
+/// angles up to 90 degrees, that is `x >= 0`.
+inline void slerp_coefficients(float t, float (&coefficients)[slerp_terms]) {
+  constexpr float truncation_scale = 1.88f;
+
+  for (size_t i = 0; i < slerp_terms; i++) {
+    float n = static_cast<float>(i + 1);
+    coefficients[i] = (t * t - n * n) / (n * (2.0f * n + 1.0f));
+  }
+
+  coefficients[slerp_terms - 1] *= truncation_scale;
+}
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+/// @brief the series of `slerp_coefficients` for one `t`, evaluated for four
+/// cosines at a time
+struct slerp_series {
+  slerp_series(const float (&from_coefficients)[slerp_terms],
+               const float (&to_coefficients)[slerp_terms], float t) {
+    for (size_t i = 0; i < slerp_terms; i++) {
+      from[i] = _mm_set1_ps(from_coefficients[i]);
+      to[i] = _mm_set1_ps(to_coefficients[i]);
+    }
+
+    from_scale = _mm_set1_ps(1.0f - t);
+    to_scale = _mm_set1_ps(t);
+  }
+
+  /// @brief Compute the weights of `a` and `b`
+  /// @param cosines the dot products of `a` and `b`
+  /// @param from_weights the weights of `a`
+  /// @param to_weights the weights of `b`, negated when the cosine is
+  /// negative to take the shorter way
+  void weights(__m128 cosines, __m128 &from_weights,
+               __m128 &to_weights) const {
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    __m128 sign = _mm_and_ps(cosines, _mm_set1_ps(-0.0f));
+    __m128 x_minus_one = _mm_sub_ps(_mm_xor_ps(cosines, sign), one);
+
+    from_weights = one;
+    to_weights = one;
+
+    for (size_t k = slerp_terms; k-- > 0;) {
+      from_weights =
+          sse::madd(_mm_mul_ps(from[k], x_minus_one), from_weights, one);
+      to_weights = sse::madd(_mm_mul_ps(to[k], x_minus_one), to_weights, one);
+    }
+
+    from_weights = _mm_mul_ps(from_weights, from_scale);
+    to_weights = _mm_xor_ps(_mm_mul_ps(to_weights, to_scale), sign);
+  }
+
+  __m128 from[slerp_terms];
+  __m128 to[slerp_terms];
+  __m128 from_scale;
+  __m128 to_scale;
+};
+#endif
+}  // namespace detail
+
+inline void slerp(span<const quaternion> a, span<const quaternion> b, float t,
+                  span<quaternion> out) {
+  assert(a.size() == b.size());
+  assert(a.size() == out.size());
+
+  float from_coefficients[detail::slerp_terms];
+  float to_coefficients[detail::slerp_terms];
+
+  detail::slerp_coefficients(1.0f - t, from_coefficients);
+  detail::slerp_coefficients(t, to_coefficients);
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+  detail::slerp_series series{from_coefficients, to_coefficients, t};
+
+  size_t i = 0;
+
+  // four rotations share the evaluation of the series, one per lane
+  for (; i + 4 <= a.size(); i += 4) {
+    __m128 from[4] = {a[i].native, a[i + 1].native, a[i + 2].native,
+                      a[i + 3].native};
+    __m128 to[4] = {b[i].native, b[i + 1].native, b[i + 2].native,
+                    b[i + 3].native};
+
+    // 0xF1, 0xF2, ...: dot `xyzw` and write the result to lane 0, 1, ...
+    __m128 cosines = _mm_or_ps(
+        _mm_or_ps(_mm_dp_ps(from[0], to[0], 0xF1),
+                  _mm_dp_ps(from[1], to[1], 0xF2)),
+        _mm_or_ps(_mm_dp_ps(from[2], to[2], 0xF4),
+                  _mm_dp_ps(from[3], to[3], 0xF8)));
+
+    __m128 from_weights, to_weights;
+    series.weights(cosines, from_weights, to_weights);
+
+    out[i].native =
+        sse::madd(sse::splat<0>(from_weights), from[0],
+                  _mm_mul_ps(sse::splat<0>(to_weights), to[0]));
+    out[i + 1].native =
+        sse::madd(sse::splat<1>(from_weights), from[1],
+                  _mm_mul_ps(sse::splat<1>(to_weights), to[1]));
+    out[i + 2].native =
+        sse::madd(sse::splat<2>(from_weights), from[2],
+                  _mm_mul_ps(sse::splat<2>(to_weights), to[2]));
+    out[i + 3].native =
+        sse::madd(sse::splat<3>(from_weights), from[3],
+                  _mm_mul_ps(sse::splat<3>(to_weights), to[3]));
+  }
+
+  for (; i < a.size(); i++) {
+    __m128 from = a[i].native;
+    __m128 to = b[i].native;
+
+    __m128 from_weights, to_weights;
+    series.weights(_mm_dp_ps(from, to, 0xFF), from_weights, to_weights);
+
+    out[i].native =
+        sse::madd(from_weights, from, _mm_mul_ps(to_weights, to));
+  }
+#else
+  for (size_t i = 0; i < a.size(); i++) {
+    float4 from = a[i].as_float4();
+    float4 to = b[i].as_float4();
+    float cosine = dot(from, to);
+
+    if (cosine < 0.0f) {
+      cosine = -cosine;
+      to = to * -1.0f;
+    }
+
+    float x_minus_one = cosine - 1.0f;
+    float from_weight = 1.0f;
+    float to_weight = 1.0f;
+
+    for (size_t k = detail::slerp_terms; k-- > 0;) {
+      from_weight = from_coefficients[k] * x_minus_one * from_weight + 1.0f;
+      to_weight = to_coefficients[k] * x_minus_one * to_weight + 1.0f;
+    }
+
+    out[i] = quaternion{from * ((1.0f - t) * from_weight) +
+                        to * (t * to_weight)};
+  }
+#endif
+}
+
+inline void nlerp(span<const quaternion> a, span<const quaternion> b, float t,
+                  span<quaternion> out) {
+  assert(a.size() == b.size());
+  assert(a.size() == out.size());
+
+  for (size_t i = 0; i < a.size(); i++) {
+    out[i] = nlerp(a[i], b[i], t);
+  }
+}
+}  // namespace graphmath
@@ -0,0 +1,667 @@
+//
+//  ray.h
+//  CS 419
+//
+//  Rays and ray-triangle intersection, one ray at a time or in packets
+//
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+
+#include "graphmath/backend.h"
+#include "graphmath/float3.h"
+#include "graphmath/span.h"
+
+#if defined(GRAPHMATH_BACKEND_AVX2)
+#include <immintrin.h>
+#elif defined(GRAPHMATH_BACKEND_SSE)
+#include "graphmath/sse.h"
+#else
+#include <array>
+#endif
+
+// Declarations
+
+namespace graphmath {
+/// @brief the points `origin + t * direction` for `t > 0`
+struct ray final {
+ public:
+  /// @brief create a ray at the origin with a zero direction, which hits
+  /// nothing
+  GRAPHMATH_CONSTEXPR ray() = default;
+
+  /// @brief create a ray
+  /// @param origin the origin
+  /// @param direction the direction, not necessarily normalized
+  GRAPHMATH_CONSTEXPR ray(const float3 &origin, const float3 &direction);
+
+  /// @brief Get a point on the ray
+  /// @param t the distance along the ray, in units of `direction`
+  /// @returns `origin + t * direction`
+  GRAPHMATH_CONSTEXPR float3 at(float t) const;
+
+  float3 origin;
+  float3 direction;
+};
+
+/// @brief where a ray hits a triangle
+struct triangle_hit final {
+  /// @brief the distance along the ray, in units of its direction; before a
+  /// test, the largest distance to look for hits at
+  float t = std::numeric_limits<float>::infinity();
+
+  /// @brief the barycentric coordinate of the second vertex
+  float u = 0.0f;
+
+  /// @brief the barycentric coordinate of the third vertex
+  float v = 0.0f;
+};
+
+/// @brief the index `intersect` returns when a ray hits no triangle
+constexpr size_t no_hit = static_cast<size_t>(-1);
+
+/// @brief the number of rays or triangles in a packet: 8 on the AVX2 backend
+/// and 4 elsewhere
+#if defined(GRAPHMATH_BACKEND_AVX2)
+constexpr size_t packet_lanes = 8;
+#else
+constexpr size_t packet_lanes = 4;
+#endif
+
+/// @brief `packet_lanes` rays, stored component by component
+struct alignas(32) ray_packet final {
+ public:
+  /// @brief create a packet of rays that hit nothing
+  ray_packet();
+
+  /// @brief Set a ray
+  /// @param lane the lane, below `packet_lanes`
+  /// @param r the ray
+  void set(size_t lane, const ray &r);
+
+  /// @brief Get a ray
+  /// @param lane the lane, below `packet_lanes`
+  /// @returns the ray
+  ray get(size_t lane) const;
+
+  float origin_x[packet_lanes];
+  float origin_y[packet_lanes];
+  float origin_z[packet_lanes];
+  float direction_x[packet_lanes];
+  float direction_y[packet_lanes];
+  float direction_z[packet_lanes];
+};
+
+/// @brief `packet_lanes` triangles, stored component by component as their
+/// first vertex and the two edges from it
+struct alignas(32) triangle_packet final {
+ public:
+  /// @brief create a packet of degenerate triangles, which nothing hits
+  triangle_packet();
+
+  /// @brief Set a triangle
+  /// @param lane the lane, below `packet_lanes`
+  /// @param a the first vertex
+  /// @param b the second vertex
+  /// @param c the third vertex
+  void set(size_t lane, const float3 &a, const float3 &b, const float3 &c);
+
+  float a_x[packet_lanes];
+  float a_y[packet_lanes];
+  float a_z[packet_lanes];
+  float edge1_x[packet_lanes];
+  float edge1_y[packet_lanes];
+  float edge1_z[packet_lanes];
+  float edge2_x[packet_lanes];
+  float edge2_y[packet_lanes];
+  float edge2_z[packet_lanes];
+};
+
+/// @brief where each ray of a packet hits, or each triangle of a packet is
+/// hit, like `triangle_hit`
+struct alignas(32) packet_hit final {
+ public:
+  /// @brief create hits that accept any distance
+  packet_hit();
+
+  float t[packet_lanes];
+  float u[packet_lanes];
+  float v[packet_lanes];
+};
+
+/// @brief Intersect a ray with a triangle (Möller–Trumbore)
+/// Both sides of the triangle are hit
+/// @param r the ray
+/// @param a the first vertex
+/// @param b the second vertex
+/// @param c the third vertex
+/// @param hit the hit; updated if the ray hits closer than `hit.t`
+/// @returns true if the ray hits closer than `hit.t`; false otherwise
+GRAPHMATH_CONSTEXPR bool intersect(const ray &r, const float3 &a,
+                                   const float3 &b, const float3 &c,
+                                   triangle_hit &hit);
+
+/// @brief Intersect a packet of rays with a triangle
+/// @param rays the rays
+/// @param a the first vertex
+/// @param b the second vertex
+/// @param c the third vertex
+/// @param hits the hits of each ray; updated where a ray hits closer
+/// @returns a mask whose bit `i` is set if ray `i` hits closer than
+/// `hits.t[i]`
+unsigned intersect(const ray_packet &rays, const float3 &a, const float3 &b,
+                   const float3 &c, packet_hit &hits);
+
+/// @brief Intersect a ray with a packet of triangles
+/// @param r the ray
+/// @param triangles the triangles
+/// @param hits the hits on each triangle; updated where the ray hits a
+/// triangle closer
+/// @returns a mask whose bit `i` is set if the ray hits triangle `i` closer
+/// than `hits.t[i]`
+unsigned intersect(const ray &r, const triangle_packet &triangles,
+                   packet_hit &hits);
+
+/// @brief Find the closest triangle a ray hits
+/// @param r the ray
+/// @param triangles the triangles, triangle `i` in lane `i % packet_lanes` of
+/// packet `i / packet_lanes`
+/// @param hit the hit; updated if the ray hits closer than `hit.t`
+/// @returns the index of the closest triangle hit closer than `hit.t`;
+/// `no_hit` otherwise
+size_t intersect(const ray &r, span<const triangle_packet> triangles,
+                 triangle_hit &hit);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+inline GRAPHMATH_CONSTEXPR ray::ray(const float3 &origin,
+                                    const float3 &direction)
+    : origin(origin), direction(direction) {}
+
+inline GRAPHMATH_CONSTEXPR float3 ray::at(float t) const {
+  return madd(direction, float3{t, t, t}, origin);
+}
+
+inline ray_packet::ray_packet()
+    : origin_x{}, origin_y{}, origin_z{}, direction_x{}, direction_y{},
+      direction_z{} {}
+
+inline void ray_packet::set(size_t lane, const ray &r) {
+  assert(lane < packet_lanes);
+
+  origin_x[lane] = r.origin.x();
+  origin_y[lane] = r.origin.y();
+  origin_z[lane] = r.origin.z();
+  direction_x[lane] = r.direction.x();
+  direction_y[lane] = r.direction.y();
+  direction_z[lane] = r.direction.z();
+}
+
+inline ray ray_packet::get(size_t lane) const {
+  assert(lane < packet_lanes);
+
+  return ray{float3{origin_x[lane], origin_y[lane], origin_z[lane]},
+             float3{direction_x[lane], direction_y[lane], direction_z[lane]}};
+}
+
+inline triangle_packet::triangle_packet()
+    : a_x{}, a_y{}, a_z{}, edge1_x{}, edge1_y{}, edge1_z{}, edge2_x{},
+      edge2_y{}, edge2_z{} {}
+
+inline void triangle_packet::set(size_t lane, const float3 &a,
+                                 const float3 &b, const float3 &c) {
+  assert(lane < packet_lanes);
+
+  float3 edge1 = b - a;
+  float3 edge2 = c - a;
+
+  a_x[lane] = a.x();
+  a_y[lane] = a.y();
+  a_z[lane] = a.z();
+  edge1_x[lane] = edge1.x();
+  edge1_y[lane] = edge1.y();
+  edge1_z[lane] = edge1.z();
+  edge2_x[lane] = edge2.x();
+  edge2_y[lane] = edge2.y();
+  edge2_z[lane] = edge2.z();
+}
+
+inline packet_hit::packet_hit() : u{}, v{} {
+  for (float &distance : t) {
+    distance = std::numeric_limits<float>::infinity();
+  }
+}
+
+inline GRAPHMATH_CONSTEXPR bool intersect(const ray &r, const float3 &a,
+                                          const float3 &b, const float3 &c,
+                                          triangle_hit &hit) {
+  float3 edge1 = b - a;
+  float3 edge2 = c - a;
+
+  // Cramer's rule on `origin + t * direction = a + u * edge1 + v * edge2`,
+  // a zero determinant means the ray is parallel to the triangle
+  float3 p = cross(r.direction, edge2);
+  float determinant = dot(edge1, p);
+
+  if (determinant == 0.0f) {
+    return false;
+  }
+
+  float inverse = 1.0f / determinant;
+  float3 s = r.origin - a;
+  float u = dot(s, p) * inverse;
+
+  if (u < 0.0f || u > 1.0f) {
+    return false;
+  }
+
+  float3 q = cross(s, edge1);
+  float v = dot(r.direction, q) * inverse;
+
+  if (v < 0.0f || u + v > 1.0f) {
+    return false;
+  }
+
+  float t = dot(edge2, q) * inverse;
+
+  if (!(t > 0.0f && t < hit.t)) {
+    return false;
+  }
+
+  hit.t = t;
+  hit.u = u;
+  hit.v = v;
+
+  return true;
+}
+
+namespace detail {
+/// @brief `packet_lanes` floats in one register
+struct packet_float final {
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  using native_packet_float = __m256;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  using native_packet_float = __m128;
+#else
+  using native_packet_float = std::array<float, packet_lanes>;
+#endif
+
+  static packet_float load(const float *address) {
+#if defined(GRAPHMATH_BACKEND_AVX2)
+    return packet_float{_mm256_load_ps(address)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    return packet_float{_mm_load_ps(address)};
+#else
+    packet_float result;
+
+    for (size_t i = 0; i < packet_lanes; i++) {
+      result.native[i] = address[i];
+    }
+
+    return result;
+#endif
+  }
+
+  static packet_float broadcast(float value) {
+#if defined(GRAPHMATH_BACKEND_AVX2)
+    return packet_float{_mm256_set1_ps(value)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    return packet_float{_mm_set1_ps(value)};
+#else
+    packet_float result;
+    result.native.fill(value);
+
+    return result;
+#endif
+  }
+
+  void store(float *address) const {
+#if defined(GRAPHMATH_BACKEND_AVX2)
+    _mm256_store_ps(address, native);
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    _mm_store_ps(address, native);
+#else
+    for (size_t i = 0; i < packet_lanes; i++) {
+      address[i] = native[i];
+    }
+#endif
+  }
+
+  native_packet_float native;
+};
+
+/// @brief `packet_lanes` booleans in one register, lanes of all ones or all
+/// zeroes with SIMD
+struct packet_mask final {
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  using native_packet_mask = __m256;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  using native_packet_mask = __m128;
+#else
+  using native_packet_mask = std::array<bool, packet_lanes>;
+#endif
+
+  native_packet_mask native;
+};
+
+inline packet_float operator+(const packet_float &a, const packet_float &b) {
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  return packet_float{_mm256_add_ps(a.native, b.native)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return packet_float{_mm_add_ps(a.native, b.native)};
+#else
+  packet_float result;
+
+  for (size_t i = 0; i < packet_lanes; i++) {
+    result.native[i] = a.native[i] + b.native[i];
+  }
+
+  return result;
+#endif
+}
+
+inline packet_float operator-(const packet_float &a, const packet_float &b) {
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  return packet_float{_mm256_sub_ps(a.native, b.native)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return packet_float{_mm_sub_ps(a.native, b.native)};
+#else
+  packet_float result;
+
+  for (size_t i = 0; i < packet_lanes; i++) {
+    result.native[i] = a.native[i] - b.native[i];
+  }
+
+  return result;
+#endif
+}
+
+inline packet_float operator*(const packet_float &a, const packet_float &b) {
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  return packet_float{_mm256_mul_ps(a.native, b.native)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return packet_float{_mm_mul_ps(a.native, b.native)};
+#else
+  packet_float result;
+
+  for (size_t i = 0; i < packet_lanes; i++) {
+    result.native[i] = a.native[i] * b.native[i];
+  }
+
+  return result;
+#endif
+}
+
+inline packet_float operator/(const packet_float &a, const packet_float &b) {
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  return packet_float{_mm256_div_ps(a.native, b.native)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return packet_float{_mm_div_ps(a.native, b.native)};
+#else
+  packet_float result;
+
+  for (size_t i = 0; i < packet_lanes; i++) {
+    result.native[i] = a.native[i] / b.native[i];
+  }
+
+  return result;
+#endif
+}
+
+/// @brief Lane-wise `a < b`, false where either is NaN
+inline packet_mask less(const packet_float &a, const packet_float &b) {
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  return packet_mask{_mm256_cmp_ps(a.native, b.native, _CMP_LT_OQ)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return packet_mask{_mm_cmplt_ps(a.native, b.native)};
+#else
+  packet_mask result;
+
+  for (size_t i = 0; i < packet_lanes; i++) {
+    result.native[i] = a.native[i] < b.native[i];
+  }
+
+  return result;
+#endif
+}
+
+/// @brief Lane-wise `a <= b`, false where either is NaN
+inline packet_mask less_equal(const packet_float &a, const packet_float &b) {
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  return packet_mask{_mm256_cmp_ps(a.native, b.native, _CMP_LE_OQ)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return packet_mask{_mm_cmple_ps(a.native, b.native)};
+#else
+  packet_mask result;
+
+  for (size_t i = 0; i < packet_lanes; i++) {
+    result.native[i] = a.native[i] <= b.native[i];
+  }
+
+  return result;
+#endif
+}
+
+/// @brief Lane-wise `a != b`, false where either is NaN
+inline packet_mask not_equal(const packet_float &a, const packet_float &b) {
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  return packet_mask{_mm256_cmp_ps(a.native, b.native, _CMP_NEQ_OQ)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return packet_mask{
+      _mm_andnot_ps(_mm_cmpunord_ps(a.native, b.native),
+                    _mm_cmpneq_ps(a.native, b.native))};
+#else
+  packet_mask result;
+
+  for (size_t i = 0; i < packet_lanes; i++) {
+    result.native[i] = a.native[i] < b.native[i] || a.native[i] > b.native[i];
+  }
+
+  return result;
+#endif
+}
+
+inline packet_mask operator&(const packet_mask &a, const packet_mask &b) {
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  return packet_mask{_mm256_and_ps(a.native, b.native)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return packet_mask{_mm_and_ps(a.native, b.native)};
+#else
+  packet_mask result;
+
+  for (size_t i = 0; i < packet_lanes; i++) {
+    result.native[i] = a.native[i] && b.native[i];
+  }
+
+  return result;
+#endif
+}
+
+/// @brief Lane-wise `mask ? a : b`
+inline packet_float select(const packet_mask &mask, const packet_float &a,
+                           const packet_float &b) {
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  return packet_float{_mm256_blendv_ps(b.native, a.native, mask.native)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return packet_float{_mm_blendv_ps(b.native, a.native, mask.native)};
+#else
+  packet_float result;
+
+  for (size_t i = 0; i < packet_lanes; i++) {
+    result.native[i] = mask.native[i] ? a.native[i] : b.native[i];
+  }
+
+  return result;
+#endif
+}
+
+/// @brief Get one bit per lane, lane `i` in bit `i`
+inline unsigned bits(const packet_mask &mask) {
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  return static_cast<unsigned>(_mm256_movemask_ps(mask.native));
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return static_cast<unsigned>(_mm_movemask_ps(mask.native));
+#else
+  unsigned result = 0;
+
+  for (size_t i = 0; i < packet_lanes; i++) {
+    result |= static_cast<unsigned>(mask.native[i]) << i;
+  }
+
+  return result;
+#endif
+}
+
+/// @brief Möller–Trumbore on each lane, like `intersect` of one ray and one
+/// triangle, with `edge1 = b - a` and `edge2 = c - a`
+/// @returns the lanes that hit closer than `t`, where `t`, `u` and `v` are
+/// updated
+inline packet_mask intersect(const packet_float (&origin)[3],
+                             const packet_float (&direction)[3],
+                             const packet_float (&a)[3],
+                             const packet_float (&edge1)[3],
+                             const packet_float (&edge2)[3], packet_float &t,
+                             packet_float &u, packet_float &v) {
+  const packet_float zero = packet_float::broadcast(0.0f);
+  const packet_float one = packet_float::broadcast(1.0f);
+
+  packet_float p[3] = {direction[1] * edge2[2] - direction[2] * edge2[1],
+                       direction[2] * edge2[0] - direction[0] * edge2[2],
+                       direction[0] * edge2[1] - direction[1] * edge2[0]};
+  packet_float determinant =
+      edge1[0] * p[0] + edge1[1] * p[1] + edge1[2] * p[2];
+  packet_float inverse = one / determinant;
+
+  packet_float s[3] = {origin[0] - a[0], origin[1] - a[1], origin[2] - a[2]};
+  packet_float new_u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * inverse;
+
+  packet_float q[3] = {s[1] * edge1[2] - s[2] * edge1[1],
+                       s[2] * edge1[0] - s[0] * edge1[2],
+                       s[0] * edge1[1] - s[1] * edge1[0]};
+  packet_float new_v =
+      (direction[0] * q[0] + direction[1] * q[1] + direction[2] * q[2]) *
+      inverse;
+  packet_float new_t =
+      (edge2[0] * q[0] + edge2[1] * q[1] + edge2[2] * q[2]) * inverse;
+
+  // every branch of the single ray test, at once
+  packet_mask hit = not_equal(determinant, zero) & less_equal(zero, new_u) &
+                    less_equal(new_u, one) & less_equal(zero, new_v) &
+                    less_equal(new_u + new_v, one) & less(zero, new_t) &
+                    less(new_t, t);
+
+  t = select(hit, new_t, t);
+  u = select(hit, new_u, u);
+  v = select(hit, new_v, v);
+
+  return hit;
+}
+}  // namespace detail
+
+inline unsigned intersect(const ray_packet &rays, const float3 &a,
+                          const float3 &b, const float3 &c,
+                          packet_hit &hits) {
+  using detail::packet_float;
+
+  float3 edge1 = b - a;
+  float3 edge2 = c - a;
+
+  const packet_float origin[3] = {packet_float::load(rays.origin_x),
+                                  packet_float::load(rays.origin_y),
+                                  packet_float::load(rays.origin_z)};
+  const packet_float direction[3] = {packet_float::load(rays.direction_x),
+                                     packet_float::load(rays.direction_y),
+                                     packet_float::load(rays.direction_z)};
+  const packet_float vertex[3] = {packet_float::broadcast(a.x()),
+                                  packet_float::broadcast(a.y()),
+                                  packet_float::broadcast(a.z())};
+  const packet_float edges1[3] = {packet_float::broadcast(edge1.x()),
+                                  packet_float::broadcast(edge1.y()),
+                                  packet_float::broadcast(edge1.z())};
+  const packet_float edges2[3] = {packet_float::broadcast(edge2.x()),
+                                  packet_float::broadcast(edge2.y()),
+                                  packet_float::broadcast(edge2.z())};
+
+  packet_float t = packet_float::load(hits.t);
+  packet_float u = packet_float::load(hits.u);
+  packet_float v = packet_float::load(hits.v);
+
+  detail::packet_mask hit =
+      detail::intersect(origin, direction, vertex, edges1, edges2, t, u, v);
+
+  t.store(hits.t);
+  u.store(hits.u);
+  v.store(hits.v);
+
+  return detail::bits(hit);
+}
+
+inline unsigned intersect(const ray &r, const triangle_packet &triangles,
+                          packet_hit &hits) {
+  using detail::packet_float;
+
+  const packet_float origin[3] = {packet_float::broadcast(r.origin.x()),
+                                  packet_float::broadcast(r.origin.y()),
+                                  packet_float::broadcast(r.origin.z())};
+  const packet_float direction[3] = {
+      packet_float::broadcast(r.direction.x()),
+      packet_float::broadcast(r.direction.y()),
+      packet_float::broadcast(r.direction.z())};
+  const packet_float vertex[3] = {packet_float::load(triangles.a_x),
+                                  packet_float::load(triangles.a_y),
+                                  packet_float::load(triangles.a_z)};
+  const packet_float edge1[3] = {packet_float::load(triangles.edge1_x),
+                                 packet_float::load(triangles.edge1_y),
+                                 packet_float::load(triangles.edge1_z)};
+  const packet_float edge2[3] = {packet_float::load(triangles.edge2_x),
+                                 packet_float::load(triangles.edge2_y),
+                                 packet_float::load(triangles.edge2_z)};
+
+  packet_float t = packet_float::load(hits.t);
+  packet_float u = packet_float::load(hits.u);
+  packet_float v = packet_float::load(hits.v);
+
+  detail::packet_mask hit =
+      detail::intersect(origin, direction, vertex, edge1, edge2, t, u, v);
+
+  t.store(hits.t);
+  u.store(hits.u);
+  v.store(hits.v);
+
+  return detail::bits(hit);
+}
+
+inline size_t intersect(const ray &r, span<const triangle_packet> triangles,
+                        triangle_hit &hit) {
+  size_t closest = no_hit;
+
+  for (size_t i = 0; i < triangles.size(); i++) {
+    packet_hit hits;
+    std::fill(std::begin(hits.t), std::end(hits.t), hit.t);
+
+    unsigned mask = intersect(r, triangles[i], hits);
+
+    // most packets miss entirely; otherwise keep the closest lane
+    if (mask == 0) {
+      continue;
+    }
+
+    for (size_t lane = 0; lane < packet_lanes; lane++) {
+      if (((mask >> lane) & 1) != 0 && hits.t[lane] < hit.t) {
+        hit.t = hits.t[lane];
+        hit.u = hits.u[lane];
+        hit.v = hits.v[lane];
+        closest = i * packet_lanes + lane;
+      }
+    }
+  }
+
+  return closest;
+}
+}  // namespace graphmath
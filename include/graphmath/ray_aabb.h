@@ -0,0 +1,277 @@
+//
+//  ray_aabb.h
+//  CS 419
+//
+//  Ray-box slab tests, against one box or 4 or 8 at a time
+//
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "graphmath/aabb.h"
+#include "graphmath/backend.h"
+#include "graphmath/float3.h"
+#include "graphmath/ray.h"
+
+#if defined(GRAPHMATH_BACKEND_AVX2)
+#include <immintrin.h>
+#endif
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+#include "graphmath/sse.h"
+#endif
+
+// Declarations
+
+namespace graphmath {
+/// @brief a ray prepared for box tests, with the inverse of its direction
+/// and the sign of each direction component computed once
+struct inverse_ray final {
+ public:
+  /// @brief Prepare a ray
+  /// @param r the ray, without NaN
+  explicit inverse_ray(const ray &r);
+
+  /// @brief the origin
+  float origin[3];
+
+  /// @brief `1 / direction`, `inf` for a zero component with its sign
+  float inverse_direction[3];
+
+  /// @brief bit `i` set if direction component `i` is negative, `-0.0f`
+  /// included
+  unsigned sign_mask;
+};
+
+/// @brief `Lanes` boxes, stored component by component
+/// @tparam Lanes the number of boxes, 4 or 8
+template <size_t Lanes>
+struct alignas(32) aabb_packet final {
+ public:
+  static_assert(Lanes == 4 || Lanes == 8, "an aabb_packet holds 4 or 8 boxes");
+
+  /// @brief create a packet of empty boxes, which no ray hits
+  aabb_packet();
+
+  /// @brief Set a box
+  /// @param lane the lane, below `Lanes`
+  /// @param box the box
+  void set(size_t lane, const aabb &box);
+
+  /// @brief Get a box
+  /// @param lane the lane, below `Lanes`
+  /// @returns the box
+  aabb get(size_t lane) const;
+
+  float lower_x[Lanes];
+  float lower_y[Lanes];
+  float lower_z[Lanes];
+  float upper_x[Lanes];
+  float upper_y[Lanes];
+  float upper_z[Lanes];
+};
+
+/// @brief Test a ray against a box with the slab test
+///
+/// A zero direction component gives `0 * inf = NaN` for a box face through
+/// the origin; the ray then lies in that face, which counts as inside its
+/// slab. Exit distances are rounded up by `2 * gamma(3)` (Ize, "Robust BVH
+/// Ray Traversal"), so rounding never makes a ray miss a box it touches.
+/// Empty boxes are never hit
+/// @param r the ray
+/// @param box the box
+/// @param t_max the farthest distance to look at
+/// @param t_near the distance the ray enters the box at, `0` from inside;
+/// set on a hit
+/// @returns true if the ray hits `box` between `0` and `t_max`
+bool ray_aabb_intersect(const inverse_ray &r, const aabb &box, float t_max,
+                        float &t_near);
+
+/// @brief Test a ray against 4 or 8 boxes in one SIMD pass, like the test of
+/// one box
+/// @param r the ray
+/// @param boxes the boxes
+/// @param t_max the farthest distance to look at
+/// @param t_near the distance the ray enters each box at
+/// @returns a mask whose bit `i` is set if the ray hits box `i` between `0`
+/// and `t_max`, where `t_near[i]` is meaningful
+template <size_t Lanes>
+unsigned ray_aabb_intersect(const inverse_ray &r,
+                            const aabb_packet<Lanes> &boxes, float t_max,
+                            float (&t_near)[Lanes]);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+namespace detail {
+/// @brief `1 + 2 * gamma(3)`, where `gamma(n) = n * eps / (1 - n * eps)`
+/// bounds the relative error of `n` rounded operations, and `eps` is half
+/// an ulp of `1`
+constexpr float slab_exit_scale =
+    1.0f + 2.0f * (3.0f * 0x1p-24f) / (1.0f - 3.0f * 0x1p-24f);
+
+/// @brief Test `Lanes` boxes against a ray, 4 lanes at a time with SSE
+/// The near face of each axis is picked by the sign of the direction, so an
+/// empty box, `lower = +inf` and `upper = -inf`, is entered at `+inf` and
+/// exited at `-inf`. `minps` and `maxps` return their second operand for a
+/// NaN, which keeps the distance of the other axes
+template <size_t Lanes>
+unsigned slab_test(const inverse_ray &r, const float *const (&lower)[3],
+                   const float *const (&upper)[3], float t_max,
+                   float *t_near) {
+  unsigned mask = 0;
+
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  if constexpr (Lanes == 8) {
+    __m256 entry = _mm256_setzero_ps();
+    __m256 exit = _mm256_set1_ps(t_max);
+
+    for (size_t axis = 0; axis < 3; axis++) {
+      bool negative = (r.sign_mask >> axis & 1) != 0;
+      __m256 origin = _mm256_set1_ps(r.origin[axis]);
+      __m256 inverse = _mm256_set1_ps(r.inverse_direction[axis]);
+      __m256 near =
+          _mm256_load_ps(negative ? upper[axis] : lower[axis]);
+      __m256 far = _mm256_load_ps(negative ? lower[axis] : upper[axis]);
+
+      entry = _mm256_max_ps(
+          _mm256_mul_ps(_mm256_sub_ps(near, origin), inverse), entry);
+      exit = _mm256_min_ps(_mm256_mul_ps(_mm256_sub_ps(far, origin), inverse),
+                           exit);
+    }
+
+    exit = _mm256_mul_ps(exit, _mm256_set1_ps(slab_exit_scale));
+
+    _mm256_storeu_ps(t_near, entry);
+    return static_cast<unsigned>(
+        _mm256_movemask_ps(_mm256_cmp_ps(entry, exit, _CMP_LE_OQ)));
+  }
+#endif
+
+  for (size_t first = 0; first < Lanes; first += 4) {
+#if defined(GRAPHMATH_BACKEND_SSE)
+    __m128 entry = _mm_setzero_ps();
+    __m128 exit = _mm_set1_ps(t_max);
+
+    for (size_t axis = 0; axis < 3; axis++) {
+      bool negative = (r.sign_mask >> axis & 1) != 0;
+      __m128 origin = _mm_set1_ps(r.origin[axis]);
+      __m128 inverse = _mm_set1_ps(r.inverse_direction[axis]);
+      __m128 near =
+          _mm_load_ps((negative ? upper[axis] : lower[axis]) + first);
+      __m128 far = _mm_load_ps((negative ? lower[axis] : upper[axis]) + first);
+
+      entry = _mm_max_ps(_mm_mul_ps(_mm_sub_ps(near, origin), inverse), entry);
+      exit = _mm_min_ps(_mm_mul_ps(_mm_sub_ps(far, origin), inverse), exit);
+    }
+
+    exit = _mm_mul_ps(exit, _mm_set1_ps(slab_exit_scale));
+
+    _mm_storeu_ps(t_near + first, entry);
+    mask |= static_cast<unsigned>(_mm_movemask_ps(_mm_cmple_ps(entry, exit)))
+            << first;
+#else
+    for (size_t i = first; i < first + 4; i++) {
+      float entry = 0.0f;
+      float exit = t_max;
+
+      for (size_t axis = 0; axis < 3; axis++) {
+        bool negative = (r.sign_mask >> axis & 1) != 0;
+        float near = negative ? upper[axis][i] : lower[axis][i];
+        float far = negative ? lower[axis][i] : upper[axis][i];
+        float t0 = (near - r.origin[axis]) * r.inverse_direction[axis];
+        float t1 = (far - r.origin[axis]) * r.inverse_direction[axis];
+
+        // like `maxps` and `minps`, `entry` and `exit` stay for a NaN
+        entry = t0 > entry ? t0 : entry;
+        exit = t1 < exit ? t1 : exit;
+      }
+
+      exit *= slab_exit_scale;
+
+      t_near[i] = entry;
+      mask |= static_cast<unsigned>(entry <= exit) << i;
+    }
+#endif
+  }
+
+  return mask;
+}
+}  // namespace detail
+
+inline inverse_ray::inverse_ray(const ray &r)
+    : origin{r.origin.x(), r.origin.y(), r.origin.z()},
+      inverse_direction{1.0f / r.direction.x(), 1.0f / r.direction.y(),
+                        1.0f / r.direction.z()},
+      sign_mask{static_cast<unsigned>(std::signbit(r.direction.x())) |
+                static_cast<unsigned>(std::signbit(r.direction.y())) << 1 |
+                static_cast<unsigned>(std::signbit(r.direction.z())) << 2} {}
+
+template <size_t Lanes>
+aabb_packet<Lanes>::aabb_packet() {
+  for (size_t lane = 0; lane < Lanes; lane++) {
+    set(lane, aabb{});
+  }
+}
+
+template <size_t Lanes>
+void aabb_packet<Lanes>::set(size_t lane, const aabb &box) {
+  assert(lane < Lanes);
+
+  lower_x[lane] = box.lower.x();
+  lower_y[lane] = box.lower.y();
+  lower_z[lane] = box.lower.z();
+  upper_x[lane] = box.upper.x();
+  upper_y[lane] = box.upper.y();
+  upper_z[lane] = box.upper.z();
+}
+
+template <size_t Lanes>
+aabb aabb_packet<Lanes>::get(size_t lane) const {
+  assert(lane < Lanes);
+
+  return aabb{float3{lower_x[lane], lower_y[lane], lower_z[lane]},
+              float3{upper_x[lane], upper_y[lane], upper_z[lane]}};
+}
+
+inline bool ray_aabb_intersect(const inverse_ray &r, const aabb &box,
+                               float t_max, float &t_near) {
+  const float lower[3] = {box.lower.x(), box.lower.y(), box.lower.z()};
+  const float upper[3] = {box.upper.x(), box.upper.y(), box.upper.z()};
+
+  float entry = 0.0f;
+  float exit = t_max;
+
+  for (size_t axis = 0; axis < 3; axis++) {
+    bool negative = (r.sign_mask >> axis & 1) != 0;
+    float near = negative ? upper[axis] : lower[axis];
+    float far = negative ? lower[axis] : upper[axis];
+    float t0 = (near - r.origin[axis]) * r.inverse_direction[axis];
+    float t1 = (far - r.origin[axis]) * r.inverse_direction[axis];
+
+    entry = t0 > entry ? t0 : entry;
+    exit = t1 < exit ? t1 : exit;
+  }
+
+  if (!(entry <= exit * detail::slab_exit_scale)) {
+    return false;
+  }
+
+  t_near = entry;
+  return true;
+}
+
+template <size_t Lanes>
+unsigned ray_aabb_intersect(const inverse_ray &r,
+                            const aabb_packet<Lanes> &boxes, float t_max,
+                            float (&t_near)[Lanes]) {
+  const float *const lower[3] = {boxes.lower_x, boxes.lower_y, boxes.lower_z};
+  const float *const upper[3] = {boxes.upper_x, boxes.upper_y, boxes.upper_z};
+
+  return detail::slab_test<Lanes>(r, lower, upper, t_max, t_near);
+}
+}  // namespace graphmath
@@ -0,0 +1,137 @@
+//
+//  span.h
+//  CS 419
+//
+//  A non owning view of contiguous values, modeled after C++20 `std::span`
+//
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Declarations
+
+namespace graphmath {
+/// @brief a pointer and a count, used by the batch APIs
+/// @tparam T the value type, `const` for read only views
+template <typename T>
+class span final {
+ public:
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using iterator = T *;
+
+  /// @brief create an empty span
+  constexpr span() noexcept = default;
+
+  /// @brief create a span of `size` values starting at `data`
+  /// @param data the first value
+  /// @param size the number of values
+  constexpr span(T *data, size_t size) noexcept;
+
+  /// @brief create a span over a contiguous container (`std::vector`,
+  /// `std::array`, ...)
+  /// @param container the container
+  template <typename Container,
+            typename = std::enable_if_t<std::is_convertible_v<
+                decltype(std::declval<Container &>().data()), T *>>>
+  constexpr span(Container &container) noexcept;
+
+  /// @brief create a read only span from a mutable span
+  /// @param other the mutable span
+  template <typename U,
+            typename = std::enable_if_t<std::is_convertible_v<U *, T *>>>
+  constexpr span(const span<U> &other) noexcept;
+
+  /// @brief Get the first value
+  /// @returns the first value
+  constexpr T *data() const noexcept;
+
+  /// @brief Get the number of values
+  /// @returns the number of values
+  constexpr size_t size() const noexcept;
+
+  /// @brief Check if there are no values
+  /// @returns true if empty; false otherwise
+  constexpr bool empty() const noexcept;
+
+  /// @brief Get the value at `index`
+  /// @param index the index, `index < size()`
+  /// @returns the value
+  constexpr T &operator[](size_t index) const;
+
+  /// @brief Get a view of `count` values starting at `offset`
+  /// @param offset the first value, `offset <= size()`
+  /// @param count the number of values, clipped to the end of the span
+  /// @returns the view
+  constexpr span subspan(size_t offset, size_t count) const;
+
+  constexpr iterator begin() const noexcept;
+
+  constexpr iterator end() const noexcept;
+
+ private:
+  T *data_ = nullptr;
+  size_t size_ = 0;
+};
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+template <typename T>
+constexpr span<T>::span(T *data, size_t size) noexcept
+    : data_(data), size_(size) {}
+
+template <typename T>
+template <typename Container, typename>
+constexpr span<T>::span(Container &container) noexcept
+    : data_(container.data()), size_(container.size()) {}
+
+template <typename T>
+template <typename U, typename>
+constexpr span<T>::span(const span<U> &other) noexcept
+    : data_(other.data()), size_(other.size()) {}
+
+template <typename T>
+constexpr T *span<T>::data() const noexcept {
+  return data_;
+}
+
+template <typename T>
+constexpr size_t span<T>::size() const noexcept {
+  return size_;
+}
+
+template <typename T>
+constexpr bool span<T>::empty() const noexcept {
+  return size_ == 0;
+}
+
+template <typename T>
+constexpr T &span<T>::operator[](size_t index) const {
+  assert(index < size_);
+
+  return data_[index];
+}
+
+template <typename T>
+constexpr span<T> span<T>::subspan(size_t offset, size_t count) const {
+  assert(offset <= size_);
+
+  size_t remaining = size_ - offset;
+  return span{data_ + offset, count < remaining ? count : remaining};
+}
+
+template <typename T>
+constexpr typename span<T>::iterator span<T>::begin() const noexcept {
+  return data_;
+}
+
+template <typename T>
+constexpr typename span<T>::iterator span<T>::end() const noexcept {
+  return data_ + size_;
+}
+}  // namespace graphmath
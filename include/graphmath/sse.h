@@ -0,0 +1,407 @@
+//
+//  sse.h
+//  CS 419
+//
+//  Helpers shared by the SSE4.1 implementations of `float3`, `float4` and
+//  `float4x4`
+//
+#pragma once
+
+#include <smmintrin.h>
+
+#include <cstdint>
+
+#include "graphmath/backend.h"
+
+#if defined(__FMA__)
+#include <immintrin.h>
+#endif
+
+// Declarations
+
+namespace graphmath {
+namespace sse {
+/// @brief Compute `a * b + c`
+/// Fused into a single instruction when FMA is available
+/// @param a a
+/// @param b b
+/// @param c c
+/// @returns `a * b + c`
+__m128 madd(__m128 a, __m128 b, __m128 c);
+
+/// @brief Approximate `1 / sqrt(v)`: the 12 bit hardware estimate refined by
+/// one Newton-Raphson step
+/// @param v the values, positive and finite
+/// @returns `1 / sqrt(v)` with a relative error below `2^-21`
+__m128 rsqrt(__m128 v);
+
+/// @brief Approximate `1 / v`: the 12 bit hardware estimate refined by one
+/// Newton-Raphson step
+/// @param v the values, nonzero with `|v| < 2^126` so that `1 / v` is normal
+/// @returns `1 / v` with a relative error below `2^-21`
+__m128 rcp(__m128 v);
+
+/// @brief Read one lane of a vector, also during constant evaluation
+/// @tparam Lane the lane to read, in `[0, 4)`
+/// @param v the vector
+/// @returns `v[Lane]`
+template <int Lane>
+constexpr float lane(__m128 v);
+
+/// @brief Create a vector of four `int32_t`, also during constant evaluation
+/// @param x lane 0
+/// @param y lane 1
+/// @param z lane 2
+/// @param w lane 3
+/// @returns `(x, y, z, w)`
+constexpr __m128i make_epi32(int32_t x, int32_t y, int32_t z, int32_t w);
+
+/// @brief Read one `int32_t` lane of a vector, also during constant
+/// evaluation
+/// @tparam Lane the lane to read, in `[0, 4)`
+/// @param v the vector
+/// @returns lane `Lane` of `v`
+template <int Lane>
+constexpr int32_t lane_epi32(__m128i v);
+
+/// @brief Create a comparison mask, also during constant evaluation
+/// @param x lane 0
+/// @param y lane 1
+/// @param z lane 2
+/// @param w lane 3
+/// @returns a vector whose lanes are all ones where true, zero elsewhere
+constexpr __m128 make_mask(bool x, bool y, bool z, bool w);
+
+/// @brief Read one lane of a comparison mask, also during constant evaluation
+/// @tparam Lane the lane to read, in `[0, 4)`
+/// @param mask the mask
+/// @returns true if the lane is set; false otherwise
+template <int Lane>
+constexpr bool mask_lane(__m128 mask);
+
+/// @brief Broadcast one lane of a vector to all four lanes
+/// @tparam Lane the lane to broadcast, in `[0, 4)`
+/// @param v the vector
+/// @returns `(v[Lane], v[Lane], v[Lane], v[Lane])`
+template <int Lane>
+__m128 splat(__m128 v);
+
+/// @brief Reorder the lanes of a vector
+/// @tparam X the lane of `v` written to lane 0
+/// @tparam Y the lane of `v` written to lane 1
+/// @tparam Z the lane of `v` written to lane 2
+/// @tparam W the lane of `v` written to lane 3
+/// @param v the vector
+/// @returns `(v[X], v[Y], v[Z], v[W])`
+template <int X, int Y, int Z, int W>
+__m128 swizzle(__m128 v);
+
+/// @brief Pick two lanes of `a` followed by two lanes of `b`
+/// @param a a
+/// @param b b
+/// @returns `(a[X], a[Y], b[Z], b[W])`
+template <int X, int Y, int Z, int W>
+__m128 shuffle(__m128 a, __m128 b);
+
+/// @brief Multiply a column major matrix by a column vector
+/// Each lane of `v` is broadcast and multiplied by its column, then the
+/// scaled columns are accumulated
+/// @param columns the four columns of the matrix
+/// @param v the column vector
+/// @returns `columns * v`
+__m128 multiply(const __m128 (&columns)[4], __m128 v);
+
+/// @brief Compute the determinant of a column major matrix
+/// @param columns the four columns of the matrix
+/// @returns the determinant in all four lanes
+__m128 determinant(const __m128 (&columns)[4]);
+
+/// @brief Invert a column major matrix by block-wise cofactor expansion
+/// The result is not finite if the matrix is singular
+/// @param columns the four columns of the matrix
+/// @param out the four columns of the inverse; may be `columns`
+/// @returns the determinant in all four lanes
+__m128 inverse(const __m128 (&columns)[4], __m128 (&out)[4]);
+
+/// @brief Invert a column major affine matrix, whose last row is
+/// `(0, 0, 0, 1)`
+/// @param columns the four columns of the matrix
+/// @param out the four columns of the inverse; may be `columns`
+void inverse_affine(const __m128 (&columns)[4], __m128 (&out)[4]);
+}  // namespace sse
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+namespace sse {
+inline __m128 madd(__m128 a, __m128 b, __m128 c) {
+#if defined(__FMA__)
+  return _mm_fmadd_ps(a, b, c);
+#else
+  return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+inline __m128 rsqrt(__m128 v) {
+  __m128 y = _mm_rsqrt_ps(v);
+
+  // y * (1.5 - 0.5 * v * y * y)
+  __m128 half_v_y = _mm_mul_ps(_mm_mul_ps(v, _mm_set1_ps(0.5f)), y);
+  return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(half_v_y, y)));
+}
+
+inline __m128 rcp(__m128 v) {
+  __m128 y = _mm_rcp_ps(v);
+
+  // y + y * (1 - v * y)
+  __m128 error = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(v, y));
+  return madd(y, error, y);
+}
+
+template <int Lane>
+constexpr float lane(__m128 v) {
+  static_assert(Lane >= 0 && Lane < 4, "lane must be in [0, 4)");
+
+#if defined(_MSC_VER) && !defined(__clang__)
+  return v.m128_f32[Lane];
+#else
+  return v[Lane];
+#endif
+}
+
+constexpr __m128i make_epi32(int32_t x, int32_t y, int32_t z, int32_t w) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  __m128i v{};
+  v.m128i_i32[0] = x;
+  v.m128i_i32[1] = y;
+  v.m128i_i32[2] = z;
+  v.m128i_i32[3] = w;
+  return v;
+#else
+  // `__m128i` holds two `long long`; the cast reinterprets four `int`
+  return (__m128i)(__v4si){x, y, z, w};
+#endif
+}
+
+template <int Lane>
+constexpr int32_t lane_epi32(__m128i v) {
+  static_assert(Lane >= 0 && Lane < 4, "lane must be in [0, 4)");
+
+#if defined(_MSC_VER) && !defined(__clang__)
+  return v.m128i_i32[Lane];
+#else
+  return ((__v4si)v)[Lane];
+#endif
+}
+
+constexpr __m128 make_mask(bool x, bool y, bool z, bool w) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  __m128 mask{};
+  mask.m128_u32[0] = x ? 0xFFFFFFFFu : 0u;
+  mask.m128_u32[1] = y ? 0xFFFFFFFFu : 0u;
+  mask.m128_u32[2] = z ? 0xFFFFFFFFu : 0u;
+  mask.m128_u32[3] = w ? 0xFFFFFFFFu : 0u;
+  return mask;
+#else
+  return (__m128)(__v4si){-int{x}, -int{y}, -int{z}, -int{w}};
+#endif
+}
+
+template <int Lane>
+constexpr bool mask_lane(__m128 mask) {
+  static_assert(Lane >= 0 && Lane < 4, "lane must be in [0, 4)");
+
+#if defined(_MSC_VER) && !defined(__clang__)
+  return mask.m128_u32[Lane] != 0;
+#else
+  return ((__v4si)mask)[Lane] != 0;
+#endif
+}
+
+template <int Lane>
+inline __m128 splat(__m128 v) {
+  static_assert(Lane >= 0 && Lane < 4, "lane must be in [0, 4)");
+
+  return _mm_shuffle_ps(v, v, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+}
+
+template <int X, int Y, int Z, int W>
+inline __m128 swizzle(__m128 v) {
+  return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X));
+}
+
+template <int X, int Y, int Z, int W>
+inline __m128 shuffle(__m128 a, __m128 b) {
+  return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+}
+
+inline __m128 multiply(const __m128 (&columns)[4], __m128 v) {
+  __m128 result = _mm_mul_ps(columns[0], splat<0>(v));
+
+  result = madd(columns[1], splat<1>(v), result);
+  result = madd(columns[2], splat<2>(v), result);
+  result = madd(columns[3], splat<3>(v), result);
+
+  return result;
+}
+
+// The inverse splits the matrix into four 2x2 blocks
+//
+//   | a b |
+//   | c d |
+//
+// each held in one register as `(m00, m01, m10, m11)`. The columns of a
+// column major matrix are the rows of its transpose, and since
+// `inverse(transpose(m)) == transpose(inverse(m))`, working on columns as if
+// they were rows produces the columns of the inverse.
+
+namespace detail {
+/// @brief Multiply two 2x2 blocks, `a * b`
+inline __m128 mat2_multiply(__m128 a, __m128 b) {
+  return madd(a, swizzle<0, 3, 0, 3>(b),
+              _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+}
+
+/// @brief Multiply the adjugate of a 2x2 block by another, `adj(a) * b`
+inline __m128 mat2_adjugate_multiply(__m128 a, __m128 b) {
+  return _mm_sub_ps(_mm_mul_ps(swizzle<3, 3, 0, 0>(a), b),
+                    _mm_mul_ps(swizzle<1, 1, 2, 2>(a), swizzle<2, 3, 0, 1>(b)));
+}
+
+/// @brief Multiply a 2x2 block by the adjugate of another, `a * adj(b)`
+inline __m128 mat2_multiply_adjugate(__m128 a, __m128 b) {
+  return _mm_sub_ps(_mm_mul_ps(a, swizzle<3, 0, 3, 0>(b)),
+                    _mm_mul_ps(swizzle<1, 0, 3, 2>(a), swizzle<2, 1, 2, 1>(b)));
+}
+
+/// @brief Compute the determinants of the four 2x2 blocks
+/// @returns `(|a|, |b|, |c|, |d|)`
+inline __m128 mat2_determinants(const __m128 (&columns)[4]) {
+  return _mm_sub_ps(_mm_mul_ps(shuffle<0, 2, 0, 2>(columns[0], columns[2]),
+                               shuffle<1, 3, 1, 3>(columns[1], columns[3])),
+                    _mm_mul_ps(shuffle<1, 3, 1, 3>(columns[0], columns[2]),
+                               shuffle<0, 2, 0, 2>(columns[1], columns[3])));
+}
+
+/// @brief Compute `trace(adj(a) * b * adj(d) * c)` from `adj(a) * b` and
+/// `adj(d) * c`
+/// @returns the trace in all four lanes
+inline __m128 mat2_trace(__m128 a_b, __m128 d_c) {
+  __m128 trace = _mm_mul_ps(a_b, swizzle<0, 2, 1, 3>(d_c));
+
+  trace = _mm_hadd_ps(trace, trace);
+  return _mm_hadd_ps(trace, trace);
+}
+}  // namespace detail
+
+inline __m128 determinant(const __m128 (&columns)[4]) {
+  using namespace detail;
+
+  __m128 a = _mm_movelh_ps(columns[0], columns[1]);
+  __m128 b = _mm_movehl_ps(columns[1], columns[0]);
+  __m128 c = _mm_movelh_ps(columns[2], columns[3]);
+  __m128 d = _mm_movehl_ps(columns[3], columns[2]);
+
+  __m128 sub = mat2_determinants(columns);
+
+  // |m| = |a| |d| + |b| |c| - trace(adj(a) b adj(d) c)
+  __m128 result = _mm_mul_ps(splat<0>(sub), splat<3>(sub));
+
+  result = madd(splat<1>(sub), splat<2>(sub), result);
+  return _mm_sub_ps(result, mat2_trace(mat2_adjugate_multiply(a, b),
+                                       mat2_adjugate_multiply(d, c)));
+}
+
+inline __m128 inverse(const __m128 (&columns)[4], __m128 (&out)[4]) {
+  using namespace detail;
+
+  __m128 a = _mm_movelh_ps(columns[0], columns[1]);
+  __m128 b = _mm_movehl_ps(columns[1], columns[0]);
+  __m128 c = _mm_movelh_ps(columns[2], columns[3]);
+  __m128 d = _mm_movehl_ps(columns[3], columns[2]);
+
+  __m128 sub = mat2_determinants(columns);
+  __m128 det_a = splat<0>(sub);
+  __m128 det_b = splat<1>(sub);
+  __m128 det_c = splat<2>(sub);
+  __m128 det_d = splat<3>(sub);
+
+  __m128 a_b = mat2_adjugate_multiply(a, b);
+  __m128 d_c = mat2_adjugate_multiply(d, c);
+
+  // with `inverse(m) = 1 / |m| * | x y |`, the adjugates of the blocks are
+  //                              | z w |
+  //
+  //   adj(x) = |d| a - b adj(d) c
+  //   adj(y) = |b| c - d adj(adj(a) b)
+  //   adj(z) = |c| b - a adj(adj(d) c)
+  //   adj(w) = |a| d - c adj(a) b
+  __m128 x = _mm_sub_ps(_mm_mul_ps(det_d, a), mat2_multiply(b, d_c));
+  __m128 y = _mm_sub_ps(_mm_mul_ps(det_b, c), mat2_multiply_adjugate(d, a_b));
+  __m128 z = _mm_sub_ps(_mm_mul_ps(det_c, b), mat2_multiply_adjugate(a, d_c));
+  __m128 w = _mm_sub_ps(_mm_mul_ps(det_a, d), mat2_multiply(c, a_b));
+
+  __m128 det = _mm_mul_ps(det_a, det_d);
+
+  det = madd(det_b, det_c, det);
+  det = _mm_sub_ps(det, mat2_trace(a_b, d_c));
+
+  // the signs of the adjugate of a 2x2 block
+  __m128 scale = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+
+  x = _mm_mul_ps(x, scale);
+  y = _mm_mul_ps(y, scale);
+  z = _mm_mul_ps(z, scale);
+  w = _mm_mul_ps(w, scale);
+
+  // adjugate the blocks and put them back together
+  out[0] = shuffle<3, 1, 3, 1>(x, y);
+  out[1] = shuffle<2, 0, 2, 0>(x, y);
+  out[2] = shuffle<3, 1, 3, 1>(z, w);
+  out[3] = shuffle<2, 0, 2, 0>(z, w);
+
+  return det;
+}
+
+inline void inverse_affine(const __m128 (&columns)[4], __m128 (&out)[4]) {
+  __m128 a = columns[0];
+  __m128 b = columns[1];
+  __m128 c = columns[2];
+  __m128 t = columns[3];
+
+  __m128 a_yzx = swizzle<1, 2, 0, 3>(a);
+  __m128 b_yzx = swizzle<1, 2, 0, 3>(b);
+  __m128 c_yzx = swizzle<1, 2, 0, 3>(c);
+
+  // the rows of the inverse of the upper 3x3 are `b x c`, `c x a` and
+  // `a x b`, scaled by `1 / |a b c|`
+  __m128 row0 = _mm_sub_ps(_mm_mul_ps(b, c_yzx), _mm_mul_ps(b_yzx, c));
+  __m128 row1 = _mm_sub_ps(_mm_mul_ps(c, a_yzx), _mm_mul_ps(c_yzx, a));
+  __m128 row2 = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+  __m128 row3 = _mm_setzero_ps();
+
+  row0 = swizzle<1, 2, 0, 3>(row0);
+  row1 = swizzle<1, 2, 0, 3>(row1);
+  row2 = swizzle<1, 2, 0, 3>(row2);
+
+  // 0x7F: dot `xyz` and broadcast the result to all four lanes
+  __m128 scale = _mm_div_ps(_mm_set1_ps(1.0f), _mm_dp_ps(a, row0, 0x7F));
+
+  _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+  out[0] = _mm_mul_ps(row0, scale);
+  out[1] = _mm_mul_ps(row1, scale);
+  out[2] = _mm_mul_ps(row2, scale);
+
+  // the translation is `-inverse(upper 3x3) * t`; the `w` of `t` is 1 and
+  // becomes the `w` of the result
+  __m128 translation = _mm_mul_ps(out[0], splat<0>(t));
+
+  translation = madd(out[1], splat<1>(t), translation);
+  translation = madd(out[2], splat<2>(t), translation);
+
+  out[3] = _mm_blend_ps(_mm_sub_ps(_mm_setzero_ps(), translation), t, 0x8);
+}
+}  // namespace sse
+}  // namespace graphmath
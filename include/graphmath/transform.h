@@ -0,0 +1,282 @@
+//
+//  transform.h
+//  CS 419
+//
+//  Builders of model, view and projection `float4x4` matrices
+//
+#pragma once
+
+#include <cmath>
+
+#include "graphmath/backend.h"
+#include "graphmath/float3.h"
+#include "graphmath/float4.h"
+#include "graphmath/float4x4.h"
+
+#if defined(GRAPHMATH_BACKEND_APPLE)
+#include <simd/simd.h>
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+#include <DirectXMath.h>
+#elif defined(GRAPHMATH_BACKEND_SSE)
+#include "graphmath/sse.h"
+#endif
+
+// Declarations
+
+namespace graphmath {
+// The matrices below multiply column vectors (`m * float4{p, 1.0f}`) in a
+// right-handed space. Cameras look down `-z`, and projections map the view
+// volume to `x` and `y` in `[-1, 1]` and `z` in `[0, 1]`, like Metal and
+// Direct3D
+
+/// @brief Create a matrix that moves points by `offset`
+/// @param offset the offset
+/// @returns the translation matrix
+GRAPHMATH_CONSTEXPR float4x4 translation(const float3 &offset);
+
+/// @brief Create a matrix that scales each axis
+/// @param scale the scale of `x`, `y` and `z`
+/// @returns the scaling matrix
+GRAPHMATH_CONSTEXPR float4x4 scaling(const float3 &scale);
+
+/// @brief Create a matrix that rotates counterclockwise around an axis,
+/// looking from the tip of the axis towards the origin
+/// @param axis the axis, must be normalized
+/// @param radians the angle in radians
+/// @returns the rotation matrix
+float4x4 rotation_axis_angle(const float3 &axis, float radians);
+
+/// @brief Create a view matrix for a camera at `eye` looking at `target`
+/// @param eye the position of the camera
+/// @param target the point in the center of the view, not `eye`
+/// @param up the up direction, not parallel to `target - eye`
+/// @returns the view matrix
+float4x4 look_at(const float3 &eye, const float3 &target, const float3 &up);
+
+/// @brief Create a perspective projection matrix
+/// @param fov_y the vertical field of view in radians, in `(0, pi)`
+/// @param aspect the width of the view divided by its height
+/// @param near_z the distance to the near plane, positive
+/// @param far_z the distance to the far plane, greater than `near_z`
+/// @returns the projection matrix
+float4x4 perspective(float fov_y, float aspect, float near_z, float far_z);
+
+/// @brief Create an orthographic projection matrix
+/// @param left the `x` of the left plane
+/// @param right the `x` of the right plane, not `left`
+/// @param bottom the `y` of the bottom plane
+/// @param top the `y` of the top plane, not `bottom`
+/// @param near_z the distance to the near plane
+/// @param far_z the distance to the far plane, not `near_z`
+/// @returns the projection matrix
+GRAPHMATH_CONSTEXPR float4x4 orthographic(float left, float right,
+                                          float bottom, float top,
+                                          float near_z, float far_z);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+namespace detail {
+/// @brief Create a `float4x4` from its columns, without the transpose of the
+/// rows constructor on the backends that store columns
+inline GRAPHMATH_CONSTEXPR float4x4 from_columns(const float4 &column0,
+                                                 const float4 &column1,
+                                                 const float4 &column2,
+                                                 const float4 &column3) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float4x4{simd_matrix(column0.native, column1.native, column2.native,
+                              column3.native)};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  using namespace DirectX;
+
+  return float4x4{XMMatrixTranspose(XMMATRIX{column0.native, column1.native,
+                                             column2.native, column3.native})};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return float4x4{float4x4::native_float4x4{
+      {column0.native, column1.native, column2.native, column3.native}}};
+#else
+  return float4x4{float4x4::native_float4x4{
+      {column0.x(), column0.y(), column0.z(), column0.w(), column1.x(),
+       column1.y(), column1.z(), column1.w(), column2.x(), column2.y(),
+       column2.z(), column2.w(), column3.x(), column3.y(), column3.z(),
+       column3.w()}}};
+#endif
+}
+}  // namespace detail
+
+inline GRAPHMATH_CONSTEXPR float4x4 translation(const float3 &offset) {
+#if defined(GRAPHMATH_BACKEND_DIRECTX)
+  using namespace DirectX;
+
+  return float4x4{
+      XMMatrixTranspose(XMMatrixTranslationFromVector(offset.native))};
+#else
+  return detail::from_columns(float4{1.0f, 0.0f, 0.0f, 0.0f},
+                              float4{0.0f, 1.0f, 0.0f, 0.0f},
+                              float4{0.0f, 0.0f, 1.0f, 0.0f},
+                              float4{offset, 1.0f});
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float4x4 scaling(const float3 &scale) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float4x4{simd_diagonal_matrix(simd::make_float4(scale.native, 1.0f))};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  return float4x4{DirectX::XMMatrixScalingFromVector(scale.native)};
+#else
+#if defined(GRAPHMATH_BACKEND_SSE)
+  if (!detail::is_constant_evaluated()) {
+    __m128 zero = _mm_setzero_ps();
+
+    return detail::from_columns(
+        float4{_mm_blend_ps(zero, scale.native, 0x1)},
+        float4{_mm_blend_ps(zero, scale.native, 0x2)},
+        float4{_mm_blend_ps(zero, scale.native, 0x4)},
+        float4{0.0f, 0.0f, 0.0f, 1.0f});
+  }
+#endif
+
+  return detail::from_columns(float4{scale.x(), 0.0f, 0.0f, 0.0f},
+                              float4{0.0f, scale.y(), 0.0f, 0.0f},
+                              float4{0.0f, 0.0f, scale.z(), 0.0f},
+                              float4{0.0f, 0.0f, 0.0f, 1.0f});
+#endif
+}
+
+inline float4x4 rotation_axis_angle(const float3 &axis, float radians) {
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  return float4x4{simd_matrix4x4(simd_quaternion(radians, axis.native))};
+#elif defined(GRAPHMATH_BACKEND_DIRECTX)
+  using namespace DirectX;
+
+  return float4x4{
+      XMMatrixTranspose(XMMatrixRotationNormal(axis.native, radians))};
+#else
+  float c = std::cos(radians);
+  float s = std::sin(radians);
+
+  // column `i` is `(1 - c) * axis[i] * axis + c * e_i + s * cross(axis, e_i)`
+#if defined(GRAPHMATH_BACKEND_SSE)
+  __m128 a = axis.native;
+  __m128 scaled = _mm_mul_ps(a, _mm_set1_ps(1.0f - c));
+  __m128 sine = _mm_mul_ps(a, _mm_set1_ps(s));
+  __m128 cosine = _mm_set1_ps(c);
+
+  // `cross(axis, e_i)` is `(0, z, -y)`, `(-z, 0, x)` and `(y, -x, 0)`; lane 3
+  // of `axis` is zero and fills the gaps, lane `i` is then replaced by `c`
+  __m128 cross_x = _mm_xor_ps(sse::swizzle<3, 2, 1, 3>(sine),
+                              _mm_set_ps(0.0f, -0.0f, 0.0f, 0.0f));
+  __m128 cross_y = _mm_xor_ps(sse::swizzle<2, 3, 0, 3>(sine),
+                              _mm_set_ps(0.0f, 0.0f, 0.0f, -0.0f));
+  __m128 cross_z = _mm_xor_ps(sse::swizzle<1, 0, 3, 3>(sine),
+                              _mm_set_ps(0.0f, 0.0f, -0.0f, 0.0f));
+
+  return detail::from_columns(
+      float4{sse::madd(sse::splat<0>(scaled), a,
+                       _mm_blend_ps(cross_x, cosine, 0x1))},
+      float4{sse::madd(sse::splat<1>(scaled), a,
+                       _mm_blend_ps(cross_y, cosine, 0x2))},
+      float4{sse::madd(sse::splat<2>(scaled), a,
+                       _mm_blend_ps(cross_z, cosine, 0x4))},
+      float4{0.0f, 0.0f, 0.0f, 1.0f});
+#else
+  float x = axis.x(), y = axis.y(), z = axis.z();
+  float t = 1.0f - c;
+
+  return detail::from_columns(
+      float4{t * x * x + c, t * x * y + s * z, t * x * z - s * y, 0.0f},
+      float4{t * x * y - s * z, t * y * y + c, t * y * z + s * x, 0.0f},
+      float4{t * x * z + s * y, t * y * z - s * x, t * z * z + c, 0.0f},
+      float4{0.0f, 0.0f, 0.0f, 1.0f});
+#endif
+#endif
+}
+
+inline float4x4 look_at(const float3 &eye, const float3 &target,
+                        const float3 &up) {
+#if defined(GRAPHMATH_BACKEND_DIRECTX)
+  using namespace DirectX;
+
+  return float4x4{XMMatrixTranspose(
+      XMMatrixLookAtRH(eye.native, target.native, up.native))};
+#else
+  // the rows of the rotation are the axes of the camera: right, up and back
+  float3 forward = normalize(target - eye);
+  float3 right = normalize(cross(forward, up));
+  float3 camera_up = cross(right, forward);
+
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  simd::float4x4 rows =
+      simd_matrix(simd::make_float4(right.native, -dot(right, eye)),
+                  simd::make_float4(camera_up.native, -dot(camera_up, eye)),
+                  simd::make_float4(-forward.native, dot(forward, eye)),
+                  simd::float4{0.0f, 0.0f, 0.0f, 1.0f});
+
+  return float4x4{simd::transpose(rows)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  // lane 3 of the axes is zero, so the transpose leaves the last column zero
+  __m128 columns[4] = {right.native, camera_up.native,
+                       _mm_sub_ps(_mm_setzero_ps(), forward.native),
+                       _mm_setzero_ps()};
+
+  _MM_TRANSPOSE4_PS(columns[0], columns[1], columns[2], columns[3]);
+
+  // the translation moves `eye` to the origin: `-(rotation * eye)`
+  columns[3] = _mm_sub_ps(_mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f),
+                          sse::multiply(columns, eye.native));
+
+  return float4x4{float4x4::native_float4x4{
+      {columns[0], columns[1], columns[2], columns[3]}}};
+#else
+  return float4x4{float4{right, -dot(right, eye)},
+                  float4{camera_up, -dot(camera_up, eye)},
+                  float4{forward * -1.0f, dot(forward, eye)},
+                  float4{0.0f, 0.0f, 0.0f, 1.0f}};
+#endif
+#endif
+}
+
+inline float4x4 perspective(float fov_y, float aspect, float near_z,
+                            float far_z) {
+#if defined(GRAPHMATH_BACKEND_DIRECTX)
+  using namespace DirectX;
+
+  return float4x4{XMMatrixTranspose(
+      XMMatrixPerspectiveFovRH(fov_y, aspect, near_z, far_z))};
+#else
+  float y_scale = 1.0f / std::tan(fov_y * 0.5f);
+  float x_scale = y_scale / aspect;
+  float z_scale = far_z / (near_z - far_z);
+
+  // `-z` of the view space becomes `w`, `z` is `0` at `near_z` and `1` at
+  // `far_z` after the division by `w`
+  return detail::from_columns(float4{x_scale, 0.0f, 0.0f, 0.0f},
+                              float4{0.0f, y_scale, 0.0f, 0.0f},
+                              float4{0.0f, 0.0f, z_scale, -1.0f},
+                              float4{0.0f, 0.0f, near_z * z_scale, 0.0f});
+#endif
+}
+
+inline GRAPHMATH_CONSTEXPR float4x4 orthographic(float left, float right,
+                                                 float bottom, float top,
+                                                 float near_z, float far_z) {
+#if defined(GRAPHMATH_BACKEND_DIRECTX)
+  using namespace DirectX;
+
+  return float4x4{XMMatrixTranspose(XMMatrixOrthographicOffCenterRH(
+      left, right, bottom, top, near_z, far_z))};
+#else
+  float width = 1.0f / (right - left);
+  float height = 1.0f / (top - bottom);
+  float depth = 1.0f / (near_z - far_z);
+
+  return detail::from_columns(
+      float4{2.0f * width, 0.0f, 0.0f, 0.0f},
+      float4{0.0f, 2.0f * height, 0.0f, 0.0f},
+      float4{0.0f, 0.0f, depth, 0.0f},
+      float4{-(right + left) * width, -(top + bottom) * height, near_z * depth,
+             1.0f});
+#endif
+}
+}  // namespace graphmath
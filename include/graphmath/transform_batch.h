@@ -0,0 +1,272 @@
+//
+//  transform_batch.h
+//  CS 419
+//
+//  Apply one `float4x4` to many `float3`
+//
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "graphmath/backend.h"
+#include "graphmath/float3.h"
+#include "graphmath/float4.h"
+#include "graphmath/float4x4.h"
+#include "graphmath/span.h"
+
+#if defined(GRAPHMATH_BACKEND_AVX2)
+#include <immintrin.h>
+#endif
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+#include "graphmath/sse.h"
+#endif
+
+// Declarations
+
+namespace graphmath {
+/// @brief outputs of at least this many bytes are written with non-temporal
+/// stores, which bypass the cache so that a large batch does not evict the
+/// data around it
+constexpr size_t transform_stream_threshold = 1 << 20;
+
+/// @brief Transform points, `m * (p, 1)` with the resulting `w` dropped
+/// @param m the matrix
+/// @param in the points
+/// @param out the results, `out.size() == in.size()`; may be `in`
+void transform_points(const float4x4 &m, span<const float3> in,
+                      span<float3> out);
+
+/// @brief Transform direction vectors, `m * (v, 0)` with the resulting `w`
+/// dropped
+/// @param m the matrix
+/// @param in the vectors
+/// @param out the results, `out.size() == in.size()`; may be `in`
+void transform_vectors(const float4x4 &m, span<const float3> in,
+                       span<float3> out);
+
+/// @brief Transform points and divide by the resulting `w`, e.g. to map
+/// points to normalized device coordinates with a projection matrix
+/// @param m the matrix
+/// @param in the points
+/// @param out the results, `out.size() == in.size()`; may be `in`
+void transform_and_project(const float4x4 &m, span<const float3> in,
+                           span<float3> out);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+namespace detail {
+/// @brief how `transform_batch` treats its inputs
+enum class transform_mode { point, vector, project };
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+/// @brief Transform one `float3` held in an `__m128`
+/// For `point` and `vector` the `w` row of `columns` must be zero
+template <transform_mode Mode>
+inline __m128 transform_one(const __m128 (&columns)[4], __m128 p) {
+  __m128 r = Mode == transform_mode::vector
+                 ? _mm_mul_ps(columns[0], sse::splat<0>(p))
+                 : sse::madd(columns[0], sse::splat<0>(p), columns[3]);
+
+  r = sse::madd(columns[1], sse::splat<1>(p), r);
+  r = sse::madd(columns[2], sse::splat<2>(p), r);
+
+  if (Mode == transform_mode::project) {
+    r = _mm_div_ps(r, sse::splat<3>(r));
+    r = _mm_blend_ps(r, _mm_setzero_ps(), 0x8);
+  }
+
+  return r;
+}
+
+template <bool Stream>
+inline void store_one(float3 *address, __m128 value) {
+  if (Stream) {
+    _mm_stream_ps(reinterpret_cast<float *>(address), value);
+  } else {
+    address->native = value;
+  }
+}
+#endif
+
+#if defined(GRAPHMATH_BACKEND_AVX2) && defined(__AVX512F__)
+/// @brief number of `float3` per wide register
+constexpr size_t transform_lanes = 4;
+
+using transform_wide = __m512;
+
+inline transform_wide transform_broadcast(__m128 column) {
+  return _mm512_broadcast_f32x4(column);
+}
+
+inline transform_wide transform_load(const float3 *address) {
+  return _mm512_loadu_ps(reinterpret_cast<const float *>(address));
+}
+
+template <bool Stream>
+inline void transform_store(float3 *address, transform_wide value) {
+  if (Stream) {
+    _mm512_stream_ps(reinterpret_cast<float *>(address), value);
+  } else {
+    _mm512_storeu_ps(reinterpret_cast<float *>(address), value);
+  }
+}
+
+template <int Lane>
+inline transform_wide transform_splat(transform_wide v) {
+  return _mm512_permute_ps(v, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+}
+
+inline transform_wide transform_mul(transform_wide a, transform_wide b) {
+  return _mm512_mul_ps(a, b);
+}
+
+inline transform_wide transform_madd(transform_wide a, transform_wide b,
+                                     transform_wide c) {
+  return _mm512_fmadd_ps(a, b, c);
+}
+
+inline transform_wide transform_finish_project(transform_wide r) {
+  r = _mm512_div_ps(r, transform_splat<3>(r));
+  return _mm512_maskz_mov_ps(0x7777, r);
+}
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+constexpr size_t transform_lanes = 2;
+
+using transform_wide = __m256;
+
+inline transform_wide transform_broadcast(__m128 column) {
+  return _mm256_broadcast_ps(&column);
+}
+
+inline transform_wide transform_load(const float3 *address) {
+  return _mm256_loadu_ps(reinterpret_cast<const float *>(address));
+}
+
+template <bool Stream>
+inline void transform_store(float3 *address, transform_wide value) {
+  if (Stream) {
+    _mm256_stream_ps(reinterpret_cast<float *>(address), value);
+  } else {
+    _mm256_storeu_ps(reinterpret_cast<float *>(address), value);
+  }
+}
+
+template <int Lane>
+inline transform_wide transform_splat(transform_wide v) {
+  return _mm256_permute_ps(v, _MM_SHUFFLE(Lane, Lane, Lane, Lane));
+}
+
+inline transform_wide transform_mul(transform_wide a, transform_wide b) {
+  return _mm256_mul_ps(a, b);
+}
+
+inline transform_wide transform_madd(transform_wide a, transform_wide b,
+                                     transform_wide c) {
+  return _mm256_fmadd_ps(a, b, c);
+}
+
+inline transform_wide transform_finish_project(transform_wide r) {
+  r = _mm256_div_ps(r, transform_splat<3>(r));
+  return _mm256_blend_ps(r, _mm256_setzero_ps(), 0x88);
+}
+#endif
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+template <transform_mode Mode, bool Stream>
+inline void transform_range(const __m128 (&columns)[4], const float3 *in,
+                            float3 *out, size_t count) {
+  size_t i = 0;
+
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  constexpr size_t wide_bytes = transform_lanes * sizeof(float3);
+
+  // non-temporal stores of wide registers must be aligned to their width
+  while (i < count && reinterpret_cast<uintptr_t>(out + i) % wide_bytes != 0) {
+    store_one<Stream>(out + i, transform_one<Mode>(columns, in[i].native));
+    i++;
+  }
+
+  const transform_wide c0 = transform_broadcast(columns[0]);
+  const transform_wide c1 = transform_broadcast(columns[1]);
+  const transform_wide c2 = transform_broadcast(columns[2]);
+  const transform_wide c3 = transform_broadcast(columns[3]);
+
+  for (; i + transform_lanes <= count; i += transform_lanes) {
+    transform_wide p = transform_load(in + i);
+    transform_wide r = Mode == transform_mode::vector
+                           ? transform_mul(c0, transform_splat<0>(p))
+                           : transform_madd(c0, transform_splat<0>(p), c3);
+
+    r = transform_madd(c1, transform_splat<1>(p), r);
+    r = transform_madd(c2, transform_splat<2>(p), r);
+
+    if (Mode == transform_mode::project) {
+      r = transform_finish_project(r);
+    }
+
+    transform_store<Stream>(out + i, r);
+  }
+#endif
+
+  for (; i < count; i++) {
+    store_one<Stream>(out + i, transform_one<Mode>(columns, in[i].native));
+  }
+}
+#endif
+
+template <transform_mode Mode>
+inline void transform_batch(const float4x4 &m, span<const float3> in,
+                            span<float3> out) {
+  assert(in.size() == out.size());
+
+#if defined(GRAPHMATH_BACKEND_SSE)
+  __m128 columns[4] = {m.native.columns[0], m.native.columns[1],
+                       m.native.columns[2], m.native.columns[3]};
+
+  // the `w` of a `float3` is zero; unless it is needed for the perspective
+  // divide, drop the `w` row so the results keep a zero `w`
+  if (Mode != transform_mode::project) {
+    for (__m128 &column : columns) {
+      column = _mm_blend_ps(column, _mm_setzero_ps(), 0x8);
+    }
+  }
+
+  if (in.size() * sizeof(float3) >= transform_stream_threshold) {
+    transform_range<Mode, true>(columns, in.data(), out.data(), in.size());
+    _mm_sfence();
+  } else {
+    transform_range<Mode, false>(columns, in.data(), out.data(), in.size());
+  }
+#else
+  const float w = Mode == transform_mode::vector ? 0.0f : 1.0f;
+
+  for (size_t i = 0; i < in.size(); i++) {
+    float4 r = m * float4{in[i], w};
+    float3 result{r.x(), r.y(), r.z()};
+
+    out[i] = Mode == transform_mode::project ? result / r.w() : result;
+  }
+#endif
+}
+}  // namespace detail
+
+inline void transform_points(const float4x4 &m, span<const float3> in,
+                             span<float3> out) {
+  detail::transform_batch<detail::transform_mode::point>(m, in, out);
+}
+
+inline void transform_vectors(const float4x4 &m, span<const float3> in,
+                              span<float3> out) {
+  detail::transform_batch<detail::transform_mode::vector>(m, in, out);
+}
+
+inline void transform_and_project(const float4x4 &m, span<const float3> in,
+                                  span<float3> out) {
+  detail::transform_batch<detail::transform_mode::project>(m, in, out);
+}
+}  // namespace graphmath
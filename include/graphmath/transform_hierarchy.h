@@ -0,0 +1,317 @@
+//
+//  transform_hierarchy.h
+//  CS 419
+//
+//  World matrices of a scene graph, recomputed only below changed nodes
+//
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "graphmath/float4x4.h"
+#include "graphmath/span.h"
+
+// Declarations
+
+namespace graphmath {
+/// @brief a forest of local transforms and the world transforms they make
+///
+/// Nodes are stored flat, each after its parent, so one pass in index order
+/// visits parents before their children. `set_local` marks a node dirty and
+/// `update` recomputes the world matrix of dirty nodes and their
+/// descendants, `world = parent world * local`; the other nodes keep theirs.
+/// Subtrees that do not share a dirty ancestor are independent, and `update`
+/// processes them on several threads
+class transform_hierarchy final {
+ public:
+  /// @brief the parent of the nodes at the top of the hierarchy
+  static constexpr size_t no_parent = static_cast<size_t>(-1);
+
+  /// @brief create an empty hierarchy
+  transform_hierarchy() = default;
+
+  /// @brief Reserve memory for `count` nodes
+  /// @param count the number of nodes
+  void reserve(size_t count);
+
+  /// @brief Add a node, dirty until the next `update`
+  /// @param local the transform relative to the parent
+  /// @param parent an existing node, or `no_parent`
+  /// @returns the index of the node, `size() - 1`
+  size_t add(const float4x4 &local, size_t parent = no_parent);
+
+  /// @brief Get the number of nodes
+  /// @returns the number of nodes
+  size_t size() const;
+
+  /// @brief Get the parent of a node
+  /// @param node the node
+  /// @returns the parent, `no_parent` at the top of the hierarchy
+  size_t parent(size_t node) const;
+
+  /// @brief Get the transform of a node relative to its parent
+  /// @param node the node
+  /// @returns the local transform
+  const float4x4 &local(size_t node) const;
+
+  /// @brief Set the transform of a node relative to its parent, which marks
+  /// it dirty until the next `update`
+  /// @param node the node
+  /// @param local the local transform
+  void set_local(size_t node, const float4x4 &local);
+
+  /// @brief Get the transform of a node relative to the world, as of the
+  /// last `update`
+  /// @param node the node
+  /// @returns the world transform
+  const float4x4 &world(size_t node) const;
+
+  /// @brief Get the world transforms of every node, as of the last `update`
+  /// @returns the world transforms, indexed by node
+  span<const float4x4> worlds() const;
+
+  /// @brief Recompute the world transforms of the dirty nodes and their
+  /// descendants, on up to `std::thread::hardware_concurrency()` threads
+  void update();
+
+  /// @brief Recompute the world transforms of the dirty nodes and their
+  /// descendants
+  /// @param thread_count the maximum number of threads, including the
+  /// calling thread; `1` runs on the calling thread only
+  void update(size_t thread_count);
+
+ private:
+  /// @brief Split the nodes into the ones above large subtrees and groups of
+  /// small subtrees, to be updated in parallel
+  void plan();
+
+  /// @brief Recompute the world transform of a node if it is dirty
+  void update_node(size_t node);
+
+  std::vector<float4x4> locals_;
+  std::vector<float4x4> worlds_;
+  std::vector<size_t> parents_;
+  std::vector<unsigned char> dirty_;
+  bool changed_ = false;
+
+  // `order_[0, task_begins_[0])` holds the nodes above large subtrees in
+  // index order, then task `t` is `order_[task_begins_[t], task_begins_[t +
+  // 1])`, a group of whole subtrees, also in index order
+  std::vector<size_t> order_;
+  std::vector<size_t> task_begins_;
+  size_t planned_size_ = 0;
+};
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+namespace detail {
+/// @brief the smallest number of nodes per task worth a thread
+constexpr size_t min_hierarchy_task_size = 4096;
+
+/// @brief the largest number of tasks `update` splits the nodes into
+constexpr size_t max_hierarchy_tasks = 256;
+}  // namespace detail
+
+inline void transform_hierarchy::reserve(size_t count) {
+  locals_.reserve(count);
+  worlds_.reserve(count);
+  parents_.reserve(count);
+  dirty_.reserve(count);
+}
+
+inline size_t transform_hierarchy::add(const float4x4 &local, size_t parent) {
+  assert(parent == no_parent || parent < size());
+
+  locals_.push_back(local);
+  worlds_.push_back(local);
+  parents_.push_back(parent);
+  dirty_.push_back(1);
+  changed_ = true;
+
+  return size() - 1;
+}
+
+inline size_t transform_hierarchy::size() const { return locals_.size(); }
+
+inline size_t transform_hierarchy::parent(size_t node) const {
+  assert(node < size());
+  return parents_[node];
+}
+
+inline const float4x4 &transform_hierarchy::local(size_t node) const {
+  assert(node < size());
+  return locals_[node];
+}
+
+inline void transform_hierarchy::set_local(size_t node,
+                                           const float4x4 &local) {
+  assert(node < size());
+
+  locals_[node] = local;
+  dirty_[node] = 1;
+  changed_ = true;
+}
+
+inline const float4x4 &transform_hierarchy::world(size_t node) const {
+  assert(node < size());
+  return worlds_[node];
+}
+
+inline span<const float4x4> transform_hierarchy::worlds() const {
+  return span<const float4x4>{worlds_.data(), worlds_.size()};
+}
+
+inline void transform_hierarchy::update() {
+  update(std::max(std::thread::hardware_concurrency(), 1u));
+}
+
+inline void transform_hierarchy::update(size_t thread_count) {
+  if (!changed_) {
+    return;
+  }
+
+  // parents come first, so one pass carries the flags down to every
+  // descendant and counts the matrices to recompute
+  size_t dirty_count = 0;
+
+  for (size_t i = 0; i < size(); i++) {
+    size_t parent = parents_[i];
+
+    if (parent != no_parent && dirty_[parent]) {
+      dirty_[i] = 1;
+    }
+
+    dirty_count += dirty_[i];
+  }
+
+  // a thread only pays off with enough matrices to multiply
+  thread_count = std::min(thread_count,
+                          dirty_count / detail::min_hierarchy_task_size);
+
+  if (thread_count > 1 && planned_size_ != size()) {
+    plan();
+  }
+
+  size_t task_count = thread_count > 1 ? task_begins_.size() - 1 : 0;
+  thread_count = std::min(thread_count, task_count);
+
+  if (thread_count <= 1) {
+    for (size_t i = 0; i < size(); i++) {
+      update_node(i);
+    }
+  } else {
+    // the nodes above the tasks go first, every task reads their worlds
+    for (size_t k = 0; k < task_begins_.front(); k++) {
+      update_node(order_[k]);
+    }
+
+    std::atomic<size_t> next_task{0};
+
+    const auto work = [&]() {
+      for (size_t task = next_task++; task < task_count; task = next_task++) {
+        for (size_t k = task_begins_[task]; k < task_begins_[task + 1]; k++) {
+          update_node(order_[k]);
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+
+    for (size_t i = 1; i < thread_count; i++) {
+      threads.emplace_back(work);
+    }
+
+    work();
+
+    for (std::thread &thread : threads) {
+      thread.join();
+    }
+  }
+
+  std::fill(dirty_.begin(), dirty_.end(), 0);
+  changed_ = false;
+}
+
+inline void transform_hierarchy::plan() {
+  const size_t count = size();
+  const size_t task_size = std::max(detail::min_hierarchy_task_size,
+                                    count / detail::max_hierarchy_tasks);
+
+  // children come after their parents, so a reverse pass sums up subtrees
+  std::vector<size_t> subtree_sizes(count, 1);
+
+  for (size_t i = count; i-- > 0;) {
+    if (parents_[i] != no_parent) {
+      subtree_sizes[parents_[i]] += subtree_sizes[i];
+    }
+  }
+
+  // a subtree of at most `task_size` nodes under a larger one (or at the top)
+  // joins the open task, or opens a new one when the open task is full. Task
+  // `0` holds the nodes above them. `task_sizes` counts the nodes visited so
+  // far, while `task_totals` counts whole subtrees as soon as their roots join
+  // a task, since with breadth-first order most of their nodes come later
+  std::vector<size_t> tasks(count);
+  std::vector<size_t> task_sizes{0};
+  std::vector<size_t> task_totals{0};
+  size_t open_task = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    size_t parent = parents_[i];
+
+    if (subtree_sizes[i] > task_size) {
+      tasks[i] = 0;
+    } else if (parent == no_parent || tasks[parent] == 0) {
+      if (open_task == 0 ||
+          task_totals[open_task] + subtree_sizes[i] > task_size) {
+        open_task = task_sizes.size();
+        task_sizes.push_back(0);
+        task_totals.push_back(0);
+      }
+
+      tasks[i] = open_task;
+      task_totals[open_task] += subtree_sizes[i];
+    } else {
+      tasks[i] = tasks[parent];
+    }
+
+    task_sizes[tasks[i]]++;
+  }
+
+  // a stable counting sort by task keeps the nodes of each task in index
+  // order, parents before children
+  std::vector<size_t> begins(task_sizes.size() + 1, 0);
+
+  for (size_t task = 0; task < task_sizes.size(); task++) {
+    begins[task + 1] = begins[task] + task_sizes[task];
+  }
+
+  task_begins_.assign(begins.begin() + 1, begins.end());
+  order_.resize(count);
+
+  for (size_t i = 0; i < count; i++) {
+    order_[begins[tasks[i]]++] = i;
+  }
+
+  planned_size_ = count;
+}
+
+inline void transform_hierarchy::update_node(size_t node) {
+  if (!dirty_[node]) {
+    return;
+  }
+
+  size_t parent = parents_[node];
+
+  worlds_[node] = parent == no_parent ? locals_[node]
+                                      : worlds_[parent] * locals_[node];
+}
+}  // namespace graphmath
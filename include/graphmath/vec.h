@@ -0,0 +1,61 @@
+//
+//  vec.h
+//  CS 419
+//
+//  The `vec` and `mat` templates behind the vector and matrix types
+//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Declarations
+
+namespace graphmath {
+/// @brief `N` numbers of type `T`
+/// There is no generic definition: each width is specialized on its own, so
+/// that every type keeps the best native type of each backend. Generic code
+/// can rely on `value_type`, `size`, `native`, the accessors `x()` to `w()`
+/// and the arithmetic operators, which every specialization has
+/// @tparam T the type of the numbers
+/// @tparam N the number of numbers
+template <typename T, size_t N>
+struct vec;
+
+/// @brief a `Rows` by `Columns` matrix of `T`, specialized like `vec`
+/// @tparam T the type of the numbers
+/// @tparam Rows the number of rows
+/// @tparam Columns the number of columns
+template <typename T, size_t Rows, size_t Columns>
+struct mat;
+
+/// @brief three `float` numbers, see `graphmath/float3.h`
+using float3 = vec<float, 3>;
+
+/// @brief four `float` numbers, see `graphmath/float4.h`
+using float4 = vec<float, 4>;
+
+/// @brief a 4x4 `float` matrix, see `graphmath/float4x4.h`
+using float4x4 = mat<float, 4, 4>;
+
+/// @brief three `double` numbers, see `graphmath/double3.h`
+using double3 = vec<double, 3>;
+
+/// @brief four `double` numbers, see `graphmath/double4.h`
+using double4 = vec<double, 4>;
+
+/// @brief a 4x4 `double` matrix, see `graphmath/double4x4.h`
+using double4x4 = mat<double, 4, 4>;
+
+/// @brief three `int32_t` numbers, see `graphmath/int3.h`
+using int3 = vec<int32_t, 3>;
+
+/// @brief four `int32_t` numbers, see `graphmath/int4.h`
+using int4 = vec<int32_t, 4>;
+
+/// @brief a mask of three lanes, see `graphmath/mask.h`
+using bool3 = vec<bool, 3>;
+
+/// @brief a mask of four lanes, see `graphmath/mask.h`
+using bool4 = vec<bool, 4>;
+}  // namespace graphmath
@@ -0,0 +1,391 @@
+//
+//  wide.h
+//  CS 419
+//
+//  The widest `float` vector of the backend, used by batch kernels
+//
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "graphmath/backend.h"
+
+#if defined(GRAPHMATH_BACKEND_AVX2)
+#include <immintrin.h>
+#elif defined(GRAPHMATH_BACKEND_SSE)
+#include "graphmath/sse.h"
+#else
+#include <array>
+#endif
+
+// Declarations
+
+namespace graphmath {
+/// @brief `wide_float::lanes` `float32` numbers processed together
+///
+/// 16 lanes (`__m512`) on the AVX2 backend when AVX-512F is enabled,
+/// 8 lanes (`__m256`) on the AVX2 backend, 4 lanes (`__m128`) on the SSE
+/// backend and 4 lanes of plain `float` elsewhere
+struct wide_float final {
+ public:
+  /// @brief the native wide type
+#if defined(GRAPHMATH_BACKEND_AVX2) && defined(__AVX512F__)
+  using native_wide_float = __m512;
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  using native_wide_float = __m256;
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  using native_wide_float = __m128;
+#else
+  using native_wide_float = std::array<float, 4>;
+#endif
+
+  /// @brief number of `float` in a `wide_float`
+  static constexpr size_t lanes = sizeof(native_wide_float) / sizeof(float);
+
+  /// @brief create a `wide_float` of zeroes
+  wide_float();
+
+  /// @brief create a `wide_float` with the same value in every lane
+  /// @param value the value
+  wide_float(float value);
+
+  /// @brief create a `wide_float` with a `native_wide_float`
+  /// @param values the native instance
+  wide_float(const native_wide_float &values);
+
+  /// @brief Load `lanes` consecutive floats, `address` need not be aligned
+  /// @param address the first float
+  /// @returns the loaded `wide_float`
+  static wide_float load(const float *address);
+
+  /// @brief Store `lanes` consecutive floats, `address` need not be aligned
+  /// @param address the first float
+  void store(float *address) const;
+
+  /// @brief Lane-wise `a + b`
+  /// @param rhs `b`
+  /// @returns the result
+  wide_float operator+(const wide_float &rhs) const;
+
+  /// @brief Lane-wise `a - b`
+  /// @param rhs `b`
+  /// @returns the result
+  wide_float operator-(const wide_float &rhs) const;
+
+  /// @brief Lane-wise `a * b`
+  /// @param rhs `b`
+  /// @returns the result
+  wide_float operator*(const wide_float &rhs) const;
+
+  /// @brief Lane-wise `a / b`
+  /// @param rhs `b`
+  /// @returns the result
+  wide_float operator/(const wide_float &rhs) const;
+
+  native_wide_float native;
+};
+
+/// @brief Lane-wise `a * b + c`, fused when the backend has FMA
+/// @param a a
+/// @param b b
+/// @param c c
+/// @returns the result
+wide_float madd(const wide_float &a, const wide_float &b, const wide_float &c);
+
+/// @brief Lane-wise square root
+/// @param value the `wide_float`
+/// @returns the result
+wide_float sqrt(const wide_float &value);
+
+/// @brief Lane-wise minimum
+/// @param a one `wide_float`
+/// @param b one `wide_float`
+/// @returns the result
+wide_float min(const wide_float &a, const wide_float &b);
+
+/// @brief Lane-wise maximum
+/// @param a one `wide_float`
+/// @param b one `wide_float`
+/// @returns the result
+wide_float max(const wide_float &a, const wide_float &b);
+
+/// @brief Lane-wise clamp
+/// @param value the value to clamp
+/// @param low the low bound (inclusive)
+/// @param high the high bound (inclusive)
+/// @returns the result
+wide_float clamp(const wide_float &value, const wide_float &low,
+                 const wide_float &high);
+
+/// @brief Run `kernel` over `size` elements of structure-of-arrays streams,
+/// `wide_float::lanes` elements at a time
+///
+/// The trailing `size % wide_float::lanes` elements are copied to a zero
+/// padded buffer, so `kernel` always sees full `wide_float`s and never reads
+/// or writes past `size`. An output may alias an input.
+///
+/// @param inputs the input streams
+/// @param outputs the output streams
+/// @param size the number of elements in every stream
+/// @param kernel called as `kernel(const wide_float (&)[Inputs],
+/// wide_float (&)[Outputs])`
+template <size_t Inputs, size_t Outputs, typename Kernel>
+void for_each_wide(const float *const (&inputs)[Inputs],
+                   float *const (&outputs)[Outputs], size_t size,
+                   Kernel kernel);
+}  // namespace graphmath
+
+// Implementations
+
+namespace graphmath {
+inline wide_float::wide_float()
+#if defined(GRAPHMATH_BACKEND_AVX2) && defined(__AVX512F__)
+    : native{_mm512_setzero_ps()} {
+}
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+    : native{_mm256_setzero_ps()} {
+}
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    : native{_mm_setzero_ps()} {
+}
+#else
+    : native{} {
+}
+#endif
+
+inline wide_float::wide_float(float value)
+#if defined(GRAPHMATH_BACKEND_AVX2) && defined(__AVX512F__)
+    : native{_mm512_set1_ps(value)} {
+}
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+    : native{_mm256_set1_ps(value)} {
+}
+#elif defined(GRAPHMATH_BACKEND_SSE)
+    : native{_mm_set1_ps(value)} {
+}
+#else
+{
+  native.fill(value);
+}
+#endif
+
+inline wide_float::wide_float(const native_wide_float &values)
+    : native(values) {}
+
+inline wide_float wide_float::load(const float *address) {
+#if defined(GRAPHMATH_BACKEND_AVX2) && defined(__AVX512F__)
+  return wide_float{_mm512_loadu_ps(address)};
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  return wide_float{_mm256_loadu_ps(address)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return wide_float{_mm_loadu_ps(address)};
+#else
+  native_wide_float values;
+  std::copy(address, address + lanes, values.begin());
+
+  return wide_float{values};
+#endif
+}
+
+inline void wide_float::store(float *address) const {
+#if defined(GRAPHMATH_BACKEND_AVX2) && defined(__AVX512F__)
+  _mm512_storeu_ps(address, native);
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  _mm256_storeu_ps(address, native);
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  _mm_storeu_ps(address, native);
+#else
+  std::copy(native.begin(), native.end(), address);
+#endif
+}
+
+inline wide_float wide_float::operator+(const wide_float &rhs) const {
+#if defined(GRAPHMATH_BACKEND_AVX2) && defined(__AVX512F__)
+  return wide_float{_mm512_add_ps(native, rhs.native)};
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  return wide_float{_mm256_add_ps(native, rhs.native)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return wide_float{_mm_add_ps(native, rhs.native)};
+#else
+  native_wide_float result;
+
+  for (size_t i = 0; i < lanes; i++) {
+    result[i] = native[i] + rhs.native[i];
+  }
+
+  return wide_float{result};
+#endif
+}
+
+inline wide_float wide_float::operator-(const wide_float &rhs) const {
+#if defined(GRAPHMATH_BACKEND_AVX2) && defined(__AVX512F__)
+  return wide_float{_mm512_sub_ps(native, rhs.native)};
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  return wide_float{_mm256_sub_ps(native, rhs.native)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return wide_float{_mm_sub_ps(native, rhs.native)};
+#else
+  native_wide_float result;
+
+  for (size_t i = 0; i < lanes; i++) {
+    result[i] = native[i] - rhs.native[i];
+  }
+
+  return wide_float{result};
+#endif
+}
+
+inline wide_float wide_float::operator*(const wide_float &rhs) const {
+#if defined(GRAPHMATH_BACKEND_AVX2) && defined(__AVX512F__)
+  return wide_float{_mm512_mul_ps(native, rhs.native)};
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  return wide_float{_mm256_mul_ps(native, rhs.native)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return wide_float{_mm_mul_ps(native, rhs.native)};
+#else
+  native_wide_float result;
+
+  for (size_t i = 0; i < lanes; i++) {
+    result[i] = native[i] * rhs.native[i];
+  }
+
+  return wide_float{result};
+#endif
+}
+
+inline wide_float wide_float::operator/(const wide_float &rhs) const {
+#if defined(GRAPHMATH_BACKEND_AVX2) && defined(__AVX512F__)
+  return wide_float{_mm512_div_ps(native, rhs.native)};
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  return wide_float{_mm256_div_ps(native, rhs.native)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return wide_float{_mm_div_ps(native, rhs.native)};
+#else
+  native_wide_float result;
+
+  for (size_t i = 0; i < lanes; i++) {
+    result[i] = native[i] / rhs.native[i];
+  }
+
+  return wide_float{result};
+#endif
+}
+
+inline wide_float madd(const wide_float &a, const wide_float &b,
+                       const wide_float &c) {
+#if defined(GRAPHMATH_BACKEND_AVX2) && defined(__AVX512F__)
+  return wide_float{_mm512_fmadd_ps(a.native, b.native, c.native)};
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  return wide_float{_mm256_fmadd_ps(a.native, b.native, c.native)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return wide_float{sse::madd(a.native, b.native, c.native)};
+#else
+  return a * b + c;
+#endif
+}
+
+inline wide_float sqrt(const wide_float &value) {
+#if defined(GRAPHMATH_BACKEND_AVX2) && defined(__AVX512F__)
+  return wide_float{_mm512_sqrt_ps(value.native)};
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  return wide_float{_mm256_sqrt_ps(value.native)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return wide_float{_mm_sqrt_ps(value.native)};
+#else
+  wide_float::native_wide_float result;
+
+  for (size_t i = 0; i < wide_float::lanes; i++) {
+    result[i] = std::sqrt(value.native[i]);
+  }
+
+  return wide_float{result};
+#endif
+}
+
+inline wide_float min(const wide_float &a, const wide_float &b) {
+#if defined(GRAPHMATH_BACKEND_AVX2) && defined(__AVX512F__)
+  return wide_float{_mm512_min_ps(a.native, b.native)};
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  return wide_float{_mm256_min_ps(a.native, b.native)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return wide_float{_mm_min_ps(a.native, b.native)};
+#else
+  wide_float::native_wide_float result;
+
+  for (size_t i = 0; i < wide_float::lanes; i++) {
+    result[i] = std::min(a.native[i], b.native[i]);
+  }
+
+  return wide_float{result};
+#endif
+}
+
+inline wide_float max(const wide_float &a, const wide_float &b) {
+#if defined(GRAPHMATH_BACKEND_AVX2) && defined(__AVX512F__)
+  return wide_float{_mm512_max_ps(a.native, b.native)};
+#elif defined(GRAPHMATH_BACKEND_AVX2)
+  return wide_float{_mm256_max_ps(a.native, b.native)};
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  return wide_float{_mm_max_ps(a.native, b.native)};
+#else
+  wide_float::native_wide_float result;
+
+  for (size_t i = 0; i < wide_float::lanes; i++) {
+    result[i] = std::max(a.native[i], b.native[i]);
+  }
+
+  return wide_float{result};
+#endif
+}
+
+inline wide_float clamp(const wide_float &value, const wide_float &low,
+                        const wide_float &high) {
+  return min(max(value, low), high);
+}
+
+template <size_t Inputs, size_t Outputs, typename Kernel>
+inline void for_each_wide(const float *const (&inputs)[Inputs],
+                          float *const (&outputs)[Outputs], size_t size,
+                          Kernel kernel) {
+  constexpr size_t lanes = wide_float::lanes;
+
+  wide_float in[Inputs];
+  wide_float out[Outputs];
+
+  size_t i = 0;
+
+  for (; i + lanes <= size; i += lanes) {
+    for (size_t k = 0; k < Inputs; k++) {
+      in[k] = wide_float::load(inputs[k] + i);
+    }
+
+    kernel(in, out);
+
+    for (size_t k = 0; k < Outputs; k++) {
+      out[k].store(outputs[k] + i);
+    }
+  }
+
+  if (i == size) {
+    return;
+  }
+
+  const size_t remaining = size - i;
+  float buffer[lanes];
+
+  for (size_t k = 0; k < Inputs; k++) {
+    std::fill(buffer, buffer + lanes, 0.0f);
+    std::copy(inputs[k] + i, inputs[k] + size, buffer);
+    in[k] = wide_float::load(buffer);
+  }
+
+  kernel(in, out);
+
+  for (size_t k = 0; k < Outputs; k++) {
+    out[k].store(buffer);
+    std::copy(buffer, buffer + remaining, outputs[k] + i);
+  }
+}
+}  // namespace graphmath
@@ -0,0 +1,87 @@
+#include "graphmath/aabb.h"
+
+#include "graphmath/transform.h"
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+#if defined(GRAPHMATH_HAS_CONSTEXPR)
+static_assert(empty(aabb{}), "empty");
+static_assert(!empty(merge(aabb{}, float3{1, 2, 3})), "merge");
+static_assert(contains(aabb{float3{0, 0, 0}, float3{1, 1, 1}},
+                       float3{1, 0.5f, 0}),
+              "contains");
+#endif
+
+TEST(Aabb, Merge) {
+  aabb box = merge(aabb{}, float3{1, -2, 3});
+  box = merge(box, float3{-1, 4, 2});
+
+  float3 expect_lower{-1, -2, 2};
+  float3 expect_upper{1, 4, 3};
+
+  EXPECT_FLOAT3_EQ(box.lower, expect_lower);
+  EXPECT_FLOAT3_EQ(box.upper, expect_upper);
+
+  aabb other{float3{0, 0, 0}, float3{2, 1, 5}};
+  box = merge(box, other);
+  expect_lower = float3{-1, -2, 0};
+  expect_upper = float3{2, 4, 5};
+
+  EXPECT_FLOAT3_EQ(box.lower, expect_lower);
+  EXPECT_FLOAT3_EQ(box.upper, expect_upper);
+  EXPECT_TRUE(empty(aabb{}));
+  EXPECT_FALSE(empty(box));
+}
+
+TEST(Aabb, CenterAndExtents) {
+  aabb box{float3{-1, 0, 2}, float3{3, 4, 4}};
+
+  float3 c = center(box);
+  float3 e = half_extents(box);
+  float3 expect_center{1, 2, 3};
+  float3 expect_extents{2, 2, 1};
+
+  EXPECT_FLOAT3_EQ(c, expect_center);
+  EXPECT_FLOAT3_EQ(e, expect_extents);
+}
+
+TEST(Aabb, ContainsAndIntersects) {
+  aabb box{float3{0, 0, 0}, float3{1, 1, 1}};
+
+  EXPECT_TRUE(contains(box, float3{0.5f, 0.5f, 0.5f}));
+  EXPECT_TRUE(contains(box, float3{1, 1, 0}));
+  EXPECT_FALSE(contains(box, float3{0.5f, 1.5f, 0.5f}));
+
+  EXPECT_TRUE(intersects(box, aabb{float3{1, 1, 1}, float3{2, 2, 2}}));
+  EXPECT_TRUE(intersects(box, aabb{float3{-1, 0.2f, 0.2f},
+                                   float3{2, 0.8f, 0.8f}}));
+  EXPECT_FALSE(intersects(box, aabb{float3{0, 0, 1.5f}, float3{1, 1, 2}}));
+  EXPECT_FALSE(intersects(box, aabb{}));
+}
+
+TEST(Aabb, Transform) {
+  aabb box{float3{-1, -2, -3}, float3{1, 2, 3}};
+  float4x4 m = translation(float3{10, 0, 0}) *
+               rotation_axis_angle(float3{0, 0, 1}, 1.5707963f);
+
+  // the corners of the transformed box, merged one by one
+  aabb expect;
+
+  for (int corner = 0; corner < 8; corner++) {
+    float4 p{corner & 1 ? 1.0f : -1.0f, corner & 2 ? 2.0f : -2.0f,
+             corner & 4 ? 3.0f : -3.0f, 1.0f};
+    float4 moved = m * p;
+    expect = merge(expect, float3{moved.x(), moved.y(), moved.z()});
+  }
+
+  aabb result = transform(m, box);
+
+  EXPECT_NEAR(result.lower.x(), expect.lower.x(), 1e-5f);
+  EXPECT_NEAR(result.lower.y(), expect.lower.y(), 1e-5f);
+  EXPECT_NEAR(result.lower.z(), expect.lower.z(), 1e-5f);
+  EXPECT_NEAR(result.upper.x(), expect.upper.x(), 1e-5f);
+  EXPECT_NEAR(result.upper.y(), expect.upper.y(), 1e-5f);
+  EXPECT_NEAR(result.upper.z(), expect.upper.z(), 1e-5f);
+}
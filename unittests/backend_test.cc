@@ -0,0 +1,44 @@
+#include "graphmath/backend.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+using namespace graphmath;
+
+TEST(Backend, ExactlyOneSelected) {
+  int selected = 0;
+
+#if defined(GRAPHMATH_BACKEND_SCALAR)
+  selected++;
+#endif
+#if defined(GRAPHMATH_BACKEND_SSE) && !defined(GRAPHMATH_BACKEND_AVX2)
+  selected++;
+#endif
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  selected++;
+#endif
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  selected++;
+#endif
+#if defined(GRAPHMATH_BACKEND_DIRECTX)
+  selected++;
+#endif
+
+  EXPECT_EQ(selected, 1);
+}
+
+TEST(Backend, Traits) {
+  std::string name = current_backend_traits::name;
+
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  EXPECT_EQ(name, "avx2");
+  EXPECT_EQ(current_backend_traits::float_lanes, 8u);
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  EXPECT_EQ(name, "sse");
+  EXPECT_EQ(current_backend_traits::float_lanes, 4u);
+#elif defined(GRAPHMATH_BACKEND_SCALAR)
+  EXPECT_EQ(name, "scalar");
+  EXPECT_EQ(current_backend_traits::float_lanes, 1u);
+#endif
+}
@@ -0,0 +1,208 @@
+#include "graphmath/binary.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+static std::string temp_path(const char *name) {
+  return ::testing::TempDir() + "graphmath_" + name + ".bin";
+}
+
+static std::vector<char> read_file(const std::string &path) {
+  std::vector<char> bytes;
+  std::FILE *file = std::fopen(path.c_str(), "rb");
+
+  for (int c = std::fgetc(file); c != EOF; c = std::fgetc(file)) {
+    bytes.push_back(static_cast<char>(c));
+  }
+
+  std::fclose(file);
+  return bytes;
+}
+
+static void write_file(const std::string &path,
+                       const std::vector<char> &bytes) {
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  std::fwrite(bytes.data(), 1, bytes.size(), file);
+  std::fclose(file);
+}
+
+static bool aligned(const void *pointer) {
+  return reinterpret_cast<uintptr_t>(pointer) % binary_alignment == 0;
+}
+
+TEST(Binary, RoundTrip) {
+  std::string path = temp_path("round_trip");
+
+  std::vector<float3> points;
+  std::vector<float4> colors;
+  std::vector<float4x4> palette;
+
+  for (int i = 0; i < 5000; i++) {
+    float f = static_cast<float>(i);
+    points.push_back(float3{f, -f, f * 0.5f});
+    colors.push_back(float4{f, 1.0f, 2.0f, -f});
+  }
+
+  for (int i = 0; i < 7; i++) {
+    float f = static_cast<float>(i);
+    palette.push_back(float4x4{float4{f, 1, 2, 3}, float4{4, f, 6, 7},
+                               float4{8, 9, f, 11}, float4{12, 13, 14, f}});
+  }
+
+  float3_soa soa3{points.data(), 37};
+  float4_soa soa4{colors.data(), 100};
+
+  binary_writer writer;
+  ASSERT_TRUE(writer.open(path.c_str()));
+
+  writer.add("points", span<const float3>{points});
+  writer.add("colors", span<const float4>{colors});
+  writer.add("palette", span<const float4x4>{palette});
+  writer.add("soa3", soa3);
+  writer.add("soa4", soa4);
+  writer.add("empty", span<const float4>{});
+
+  ASSERT_TRUE(writer.close());
+  ASSERT_FALSE(writer.is_open());
+
+  binary_reader reader{path.c_str()};
+  ASSERT_TRUE(reader.is_open());
+  ASSERT_EQ(reader.version(), binary_version);
+  ASSERT_EQ(reader.size(), 6u);
+  ASSERT_EQ(reader.find("missing"), no_chunk);
+
+  size_t index = reader.find("points");
+  ASSERT_EQ(index, 0u);
+  ASSERT_EQ(reader.chunk(index).kind, binary_kind::packed_float3);
+
+  span<const packed_float3> read_points = reader.packed_float3s(index);
+  ASSERT_EQ(read_points.size(), points.size());
+  ASSERT_TRUE(aligned(read_points.data()));
+
+  for (size_t i = 0; i < points.size(); i++) {
+    float3 value = read_points[i].unpack();
+    EXPECT_FLOAT3_EQ(value, points[i]);
+  }
+
+  span<const float4> read_colors = reader.float4s(reader.find("colors"));
+  ASSERT_EQ(read_colors.size(), colors.size());
+  ASSERT_TRUE(aligned(read_colors.data()));
+
+  for (size_t i = 0; i < colors.size(); i++) {
+    EXPECT_FLOAT4_EQ(read_colors[i], colors[i]);
+  }
+
+#if !defined(GRAPHMATH_BACKEND_DIRECTX)
+  span<const float4x4> read_palette =
+      reader.float4x4s(reader.find("palette"));
+  ASSERT_EQ(read_palette.size(), palette.size());
+
+  for (size_t i = 0; i < palette.size(); i++) {
+    for (size_t y = 0; y < 4; y++) {
+      for (size_t x = 0; x < 4; x++) {
+        EXPECT_EQ(read_palette[i](y, x), palette[i](y, x));
+      }
+    }
+  }
+#endif
+
+  float4 zero{0, 0, 0, 0};
+  std::vector<float4x4> copied_palette(palette.size(),
+                                       float4x4{zero, zero, zero, zero});
+  reader.float4x4s(reader.find("palette"),
+                   span<float4x4>{copied_palette.data(),
+                                  copied_palette.size()});
+
+  for (size_t i = 0; i < palette.size(); i++) {
+    for (size_t y = 0; y < 4; y++) {
+      for (size_t x = 0; x < 4; x++) {
+        EXPECT_EQ(copied_palette[i](y, x), palette[i](y, x));
+      }
+    }
+  }
+
+  float3_soa_view read_soa3 = reader.soa_float3s(reader.find("soa3"));
+  ASSERT_EQ(read_soa3.x.size(), soa3.size());
+  ASSERT_TRUE(aligned(read_soa3.x.data()));
+  ASSERT_TRUE(aligned(read_soa3.y.data()));
+  ASSERT_TRUE(aligned(read_soa3.z.data()));
+
+  for (size_t i = 0; i < soa3.size(); i++) {
+    EXPECT_EQ(read_soa3.x[i], soa3.x()[i]);
+    EXPECT_EQ(read_soa3.y[i], soa3.y()[i]);
+    EXPECT_EQ(read_soa3.z[i], soa3.z()[i]);
+  }
+
+  float4_soa_view read_soa4 = reader.soa_float4s(reader.find("soa4"));
+  ASSERT_EQ(read_soa4.w.size(), soa4.size());
+
+  for (size_t i = 0; i < soa4.size(); i++) {
+    EXPECT_EQ(read_soa4.x[i], soa4.x()[i]);
+    EXPECT_EQ(read_soa4.y[i], soa4.y()[i]);
+    EXPECT_EQ(read_soa4.z[i], soa4.z()[i]);
+    EXPECT_EQ(read_soa4.w[i], soa4.w()[i]);
+  }
+
+  ASSERT_TRUE(reader.float4s(reader.find("empty")).empty());
+
+  binary_reader moved = std::move(reader);
+  ASSERT_FALSE(reader.is_open());
+  ASSERT_TRUE(moved.is_open());
+  ASSERT_EQ(moved.size(), 6u);
+
+  moved.close();
+  ASSERT_FALSE(moved.is_open());
+  std::remove(path.c_str());
+}
+
+TEST(Binary, RejectsInvalidFiles) {
+  std::string path = temp_path("invalid");
+  std::vector<float4> values(100, float4{1, 2, 3, 4});
+
+  {
+    binary_writer writer{path.c_str()};
+    writer.add("values", span<const float4>{values});
+  }
+
+  std::vector<char> bytes = read_file(path);
+  binary_reader reader;
+  ASSERT_TRUE(reader.open(path.c_str()));
+  reader.close();
+
+  ASSERT_FALSE(reader.open(temp_path("missing").c_str()));
+
+  std::vector<char> truncated(bytes.begin(), bytes.end() - 100);
+  write_file(path, truncated);
+  ASSERT_FALSE(reader.open(path.c_str()));
+
+  std::vector<char> bad_magic = bytes;
+  bad_magic[0] = 'X';
+  write_file(path, bad_magic);
+  ASSERT_FALSE(reader.open(path.c_str()));
+
+  std::vector<char> newer = bytes;
+  newer[8] = static_cast<char>(binary_version + 1);
+  write_file(path, newer);
+  ASSERT_FALSE(reader.open(path.c_str()));
+
+  // a count past the end of the file
+  std::vector<char> too_long = bytes;
+  size_t table = bytes.size() - 16 - sizeof(binary_chunk);
+  too_long[table + 8 + 7] = 0x7f;
+  write_file(path, too_long);
+  ASSERT_FALSE(reader.open(path.c_str()));
+
+  write_file(path, bytes);
+  ASSERT_TRUE(reader.open(path.c_str()));
+  ASSERT_EQ(reader.float4s(0).size(), values.size());
+
+  reader.close();
+  std::remove(path.c_str());
+}
@@ -0,0 +1,62 @@
+#include "graphmath/bounding_sphere.h"
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+#if defined(GRAPHMATH_HAS_CONSTEXPR)
+static_assert(bounding_sphere{float3{1, 2, 3}, 4}.radius() == 4.0f,
+              "radius");
+static_assert(contains(bounding_sphere{float3{0, 0, 0}, 1}, float3{0, 1, 0}),
+              "contains");
+#endif
+
+TEST(BoundingSphere, Construct) {
+  bounding_sphere sphere{float3{1, 2, 3}, 4};
+
+  float3 c = sphere.center();
+  float3 expect{1, 2, 3};
+
+  EXPECT_FLOAT3_EQ(c, expect);
+  EXPECT_FLOAT_EQ(sphere.radius(), 4.0f);
+
+  bounding_sphere around{aabb{float3{-1, -2, -2}, float3{1, 2, 2}}};
+  c = around.center();
+  expect = float3{0, 0, 0};
+
+  EXPECT_FLOAT3_EQ(c, expect);
+  EXPECT_FLOAT_EQ(around.radius(), 3.0f);
+}
+
+TEST(BoundingSphere, ContainsAndIntersects) {
+  bounding_sphere sphere{float3{0, 0, 0}, 2};
+
+  EXPECT_TRUE(contains(sphere, float3{1, 1, 1}));
+  EXPECT_FALSE(contains(sphere, float3{2, 1, 0}));
+
+  EXPECT_TRUE(intersects(sphere, bounding_sphere{float3{3, 0, 0}, 1}));
+  EXPECT_FALSE(intersects(sphere, bounding_sphere{float3{3, 1, 0}, 1}));
+}
+
+TEST(BoundingSphere, Merge) {
+  bounding_sphere a{float3{0, 0, 0}, 1};
+  bounding_sphere b{float3{4, 0, 0}, 1};
+
+  bounding_sphere merged = merge(a, b);
+  float3 c = merged.center();
+  float3 expect{2, 0, 0};
+
+  EXPECT_FLOAT3_EQ(c, expect);
+  EXPECT_FLOAT_EQ(merged.radius(), 3.0f);
+
+  // a sphere inside the other merges to the larger one
+  merged = merge(a, bounding_sphere{float3{0.5f, 0, 0}, 0.25f});
+  c = merged.center();
+  expect = float3{0, 0, 0};
+
+  EXPECT_FLOAT3_EQ(c, expect);
+  EXPECT_FLOAT_EQ(merged.radius(), 1.0f);
+}
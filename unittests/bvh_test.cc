@@ -0,0 +1,160 @@
+#include "graphmath/bvh.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+namespace {
+/// @brief small random triangles in a cube, with a cluster of identical ones
+std::vector<float3> random_triangles(size_t count) {
+  std::mt19937 engine{419};
+  std::uniform_real_distribution<float> position{-10.0f, 10.0f};
+  std::uniform_real_distribution<float> offset{-0.5f, 0.5f};
+  std::vector<float3> vertices;
+
+  for (size_t i = 0; i < count; i++) {
+    float3 center{position(engine), position(engine), position(engine)};
+
+    if (i % 50 == 0) {
+      center = float3{1, 2, 3};
+    }
+
+    for (size_t k = 0; k < 3; k++) {
+      vertices.push_back(
+          center + float3{offset(engine), offset(engine), offset(engine)});
+    }
+  }
+
+  return vertices;
+}
+
+std::vector<ray> random_rays(size_t count) {
+  std::mt19937 engine{421};
+  std::uniform_real_distribution<float> position{-12.0f, 12.0f};
+  std::vector<ray> rays;
+
+  for (size_t i = 0; i < count; i++) {
+    float3 origin{position(engine), position(engine), position(engine)};
+    float3 target{position(engine), position(engine), position(engine)};
+
+    // some rays run along an axis, with zero direction components
+    if (i % 10 == 0) {
+      target = float3{origin.x(), origin.y(), target.z()};
+    }
+
+    rays.push_back(ray{origin, target - origin});
+  }
+
+  return rays;
+}
+
+/// @brief Check that every primitive is in one leaf, and every child box
+/// contains its primitives
+void expect_valid(const bvh &tree, span<const aabb> bounds) {
+  std::vector<int> seen(bounds.size(), 0);
+  std::vector<std::uint32_t> stack{0};
+
+  while (!stack.empty()) {
+    const bvh::node &n = tree.nodes()[stack.back()];
+    stack.pop_back();
+
+    for (size_t slot = 0; slot < 4; slot++) {
+      aabb box = n.bounds.get(slot);
+
+      if (n.counts[slot] == 0) {
+        if (n.children[slot] != 0) {
+          stack.push_back(n.children[slot]);
+        } else {
+          EXPECT_TRUE(empty(box));
+        }
+
+        continue;
+      }
+
+      EXPECT_LE(n.counts[slot], 4u);
+
+      for (size_t i = n.children[slot]; i < n.children[slot] + n.counts[slot];
+           i++) {
+        std::uint32_t primitive = tree.primitives()[i];
+        seen[primitive]++;
+
+        EXPECT_EQ(merge(box, bounds[primitive]).lower, box.lower);
+        EXPECT_EQ(merge(box, bounds[primitive]).upper, box.upper);
+      }
+    }
+  }
+
+  for (int count : seen) {
+    EXPECT_EQ(count, 1);
+  }
+}
+}  // namespace
+
+TEST(Bvh, Empty) {
+  bvh tree;
+  tree.build(span<const aabb>{});
+  triangle_hit hit;
+
+  EXPECT_TRUE(tree.nodes().empty());
+  EXPECT_EQ(tree.closest_hit(ray{float3{}, float3{0, 0, 1}},
+                             span<const float3>{}, hit),
+            no_hit);
+}
+
+TEST(Bvh, BuildIsValid) {
+  // enough boxes to bin on several threads
+  std::vector<float3> vertices = random_triangles(200000);
+  std::vector<aabb> bounds;
+
+  for (size_t i = 0; i < vertices.size(); i += 3) {
+    aabb box = merge(aabb{}, vertices[i]);
+    box = merge(box, vertices[i + 1]);
+    bounds.push_back(merge(box, vertices[i + 2]));
+  }
+
+  for (size_t thread_count : {1, 4}) {
+    bvh tree;
+    tree.build(bounds, thread_count);
+
+    expect_valid(tree, bounds);
+  }
+}
+
+TEST(Bvh, MatchesLinearScan) {
+  std::vector<float3> vertices = random_triangles(5000);
+  std::vector<ray> rays = random_rays(500);
+
+  for (size_t thread_count : {1, 4}) {
+    bvh tree;
+    tree.build(vertices, thread_count);
+
+    for (const ray &r : rays) {
+      triangle_hit expect;
+      size_t expect_index = no_hit;
+
+      for (size_t i = 0; i < vertices.size() / 3; i++) {
+        if (intersect(r, vertices[3 * i], vertices[3 * i + 1],
+                      vertices[3 * i + 2], expect)) {
+          expect_index = i;
+        }
+      }
+
+      triangle_hit hit;
+      size_t index = tree.closest_hit(r, vertices, hit);
+
+      EXPECT_EQ(index, expect_index);
+      EXPECT_FLOAT_EQ(hit.t, expect.t);
+      EXPECT_EQ(tree.any_hit(r, vertices), expect_index != no_hit);
+
+      if (expect_index != no_hit) {
+        // nothing is hit before the closest hit
+        EXPECT_FALSE(tree.any_hit(r, vertices, expect.t * 0.999f));
+      }
+    }
+  }
+}
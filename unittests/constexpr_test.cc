@@ -0,0 +1,138 @@
+#include <limits>
+
+#include "graphmath/backend.h"
+#include "graphmath/double4x4.h"
+#include "graphmath/float3.h"
+#include "graphmath/float4.h"
+#include "graphmath/float4x4.h"
+#include "graphmath/int3.h"
+#include "graphmath/int4.h"
+#include "graphmath/mask.h"
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+#if defined(GRAPHMATH_HAS_CONSTEXPR)
+namespace {
+constexpr float3 a{1, 2, 3};
+constexpr float3 b{4, 5, 6};
+
+constexpr float4x4 matrix{float4{2, 0, 1, 3}, float4{1, 3, 0, 2},
+                          float4{0, 1, 4, 1}, float4{3, 2, 1, 0}};
+
+// a table baked at compile time, the use case `constexpr` exists for
+constexpr float4x4 scales[3] = {float4x4{1.0f}, float4x4{2.0f} * matrix,
+                                transpose(matrix) * float4x4{0.5f}};
+}  // namespace
+
+static_assert(a + b == float3{5, 7, 9}, "float3 + float3");
+static_assert(b - a == float3{3, 3, 3}, "float3 - float3");
+static_assert(a - 1.0f == float3{0, 1, 2}, "float3 - float");
+static_assert(a * 2.0f == float3{2, 4, 6}, "float3 * float");
+static_assert(a * b == float3{4, 10, 18}, "float3 * float3");
+static_assert(b / 2.0f == float3{2, 2.5f, 3}, "float3 / float");
+static_assert(a != b, "float3 != float3");
+static_assert(dot(a, b) == 32.0f, "dot(float3, float3)");
+static_assert(cross(a, b) == float3{-3, 6, -3}, "cross");
+static_assert(clamp(b, a, float3{4.5f, 4.5f, 4.5f}) == float3{4, 4.5f, 4.5f},
+              "clamp");
+
+static_assert(float4{a, 4} == float4{1, 2, 3, 4}, "float4 from float3");
+static_assert(float4{1, 2, 3, 4} + float4{1, 1, 1, 1} == float4{2, 3, 4, 5},
+              "float4 + float4");
+static_assert(float4{1, 2, 3, 4} * 2.0f == float4{2, 4, 6, 8},
+              "float4 * float");
+static_assert(dot(float4{1, 2, 3, 4}, float4{1, 2, 3, 4}) == 30.0f,
+              "dot(float4, float4)");
+
+static_assert(matrix(3, 0) == 3.0f, "float4x4 get");
+static_assert(matrix.row(1) == float4{1, 3, 0, 2}, "float4x4 row");
+static_assert(matrix.column(2) == float4{1, 0, 4, 1}, "float4x4 column");
+static_assert(transpose(matrix)(0, 3) == 3.0f, "transpose");
+static_assert(matrix * float4{1, 1, 1, 1} == float4{6, 6, 6, 6},
+              "float4x4 * float4");
+static_assert((float4x4{1.0f} * matrix)(2, 2) == 4.0f, "float4x4 * float4x4");
+static_assert(determinant(matrix) == -120.0f, "determinant");
+static_assert(inverse(float4x4{2.0f})(1, 1) == 0.5f, "inverse");
+static_assert(scales[1](0, 0) == 4.0f, "table");
+
+static_assert(double3{1, 2, 3} + double3{4, 5, 6} == double3{5, 7, 9},
+              "double3 + double3");
+static_assert(dot(double3{1, 2, 3}, double3{4, 5, 6}) == 32.0,
+              "dot(double3, double3)");
+static_assert(cross(double3{1, 2, 3}, double3{4, 5, 6}) == double3{-3, 6, -3},
+              "cross(double3, double3)");
+static_assert(double3{a} == double3{1, 2, 3}, "double3 from float3");
+static_assert(double3{1, 2, 3}.to_float3() == a, "double3 to float3");
+static_assert(double4{double3{1, 2, 3}} * 2.0 == double4{2, 4, 6, 2},
+              "double4 * double");
+static_assert((double4x4{matrix} * double4x4{2.0})(3, 0) == 6.0,
+              "double4x4 * double4x4");
+static_assert(transpose(double4x4{matrix})(0, 3) == 3.0, "transpose");
+static_assert(relative(double4x4{1.0}, double3{1, 2, 3})(1, 3) == -2.0f,
+              "relative");
+
+static_assert(int3{1, 2, 3} * int3{2, 2, 2} == int3{2, 4, 6}, "int3 * int3");
+static_assert(max(int4{1, 5, 3, 7}, int4{4, 2, 6, 0}) == int4{4, 5, 6, 7},
+              "max(int4, int4)");
+static_assert(int3{float3{1.5f, -1.5f, 2}} == int3{1, -1, 2},
+              "int3 from float3");
+
+static_assert(less(a, float3{2, 2, 2}).bits() == 0x1, "less");
+static_assert(all(greater_equal(b, a)), "all");
+static_assert(!any(equal(a, b)), "any");
+static_assert(select(bool3{true, false, true}, a, b) == float3{1, 5, 3},
+              "select");
+static_assert(min(a, float3{2, 2, 2}) == float3{1, 2, 2}, "min");
+static_assert(min(float3{std::numeric_limits<float>::quiet_NaN(), 1, 1}, a)
+                      .x() == a.x(),
+              "min keeps the second operand for a NaN, like minps");
+static_assert(max(float4{1, 2, 3, 4}, float4{4, 3, 2, 1}) ==
+                  float4{4, 3, 3, 4},
+              "max");
+#endif
+
+TEST(Constexpr, MatchesRuntime) {
+#if defined(GRAPHMATH_HAS_CONSTEXPR)
+  // the same expressions evaluated at run time take the SIMD path
+  float4x4 runtime_matrix = matrix;
+  float4x4 runtime_scales[3] = {float4x4{1.0f}, float4x4{2.0f} * runtime_matrix,
+                                transpose(runtime_matrix) * float4x4{0.5f}};
+
+  for (size_t i = 0; i < 3; i++) {
+    for (size_t y = 0; y < 4; y++) {
+      for (size_t x = 0; x < 4; x++) {
+        EXPECT_FLOAT_EQ(scales[i](y, x), runtime_scales[i](y, x));
+      }
+    }
+  }
+
+  constexpr float4x4 constant_inverse = inverse(matrix);
+  constexpr float4x4 constant_inverse_affine = inverse_affine(
+      float4x4{float4{0, -2, 0, 5}, float4{1, 0, 0, -3}, float4{0, 0, 4, 1},
+               float4{0, 0, 0, 1}});
+
+  float4x4 runtime_inverse = inverse(runtime_matrix);
+  float4x4 runtime_inverse_affine = inverse_affine(
+      float4x4{float4{0, -2, 0, 5}, float4{1, 0, 0, -3}, float4{0, 0, 4, 1},
+               float4{0, 0, 0, 1}});
+
+  for (size_t y = 0; y < 4; y++) {
+    for (size_t x = 0; x < 4; x++) {
+      EXPECT_NEAR(constant_inverse(y, x), runtime_inverse(y, x), 1e-5f);
+      EXPECT_NEAR(constant_inverse_affine(y, x), runtime_inverse_affine(y, x),
+                  1e-5f);
+    }
+  }
+
+  constexpr float3 constant_cross = cross(a, b);
+  float3 runtime_a = a;
+  float3 runtime_cross = cross(runtime_a, b);
+
+  EXPECT_FLOAT3_EQ(constant_cross, runtime_cross);
+#else
+  GTEST_SKIP() << "the " << current_backend_traits::name
+               << " backend is not constexpr";
+#endif
+}
@@ -0,0 +1,86 @@
+#include "graphmath/double3.h"
+
+#include <cmath>
+#include <limits>
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+TEST(Double3, Constructor) {
+  double3 zeros;
+  double3 values{1, 2, 3};
+
+  EXPECT_EQ(zeros.x(), 0.0);
+  EXPECT_EQ(zeros.y(), 0.0);
+  EXPECT_EQ(zeros.z(), 0.0);
+
+  EXPECT_EQ(values.x(), 1.0);
+  EXPECT_EQ(values.y(), 2.0);
+  EXPECT_EQ(values.z(), 3.0);
+
+  double3 from_float{float3{0.1f, -2, 1e30f}};
+  EXPECT_EQ(from_float.x(), static_cast<double>(0.1f));
+  EXPECT_EQ(from_float.y(), -2.0);
+  EXPECT_EQ(from_float.z(), static_cast<double>(1e30f));
+
+  float3 rounded = double3{0.1, -2, 1e30}.to_float3();
+  float3 expected{0.1f, -2, 1e30f};
+  EXPECT_EQ(rounded, expected);
+}
+
+TEST(Double3, Arithmetic) {
+  double3 a{1, 2, 3};
+  double3 b{4, 5, 6};
+
+  EXPECT_EQ(a + b, (double3{5, 7, 9}));
+  EXPECT_EQ(b - a, (double3{3, 3, 3}));
+  EXPECT_EQ(a * 2.0, (double3{2, 4, 6}));
+  EXPECT_EQ(a * b, (double3{4, 10, 18}));
+  EXPECT_EQ(b / 2.0, (double3{2, 2.5, 3}));
+  EXPECT_EQ(madd(a, b, a), (double3{5, 12, 21}));
+  EXPECT_NE(a, b);
+
+  EXPECT_EQ(dot(a, b), 32.0);
+  EXPECT_EQ(cross(a, b), (double3{-3, 6, -3}));
+  EXPECT_EQ(length(double3{2, 3, 6}), 7.0);
+
+  double3 normalized = normalize(double3{1, 1, 1});
+  EXPECT_DOUBLE_EQ(normalized.x(), 1.0 / std::sqrt(3.0));
+  EXPECT_DOUBLE_EQ(normalized.z(), 1.0 / std::sqrt(3.0));
+
+  // dividing by zero keeps `w` at zero, which `==` ignores either way
+  double3 infinite = a / 0.0;
+  EXPECT_TRUE(std::isinf(infinite.x()));
+}
+
+TEST(Double3, MultiplyByInfinity) {
+  double infinity = std::numeric_limits<double>::infinity();
+  double3 a{1, 0, -1};
+  double3 b = a * infinity;
+
+  EXPECT_EQ(b.x(), infinity);
+  EXPECT_TRUE(std::isnan(b.y()));
+  EXPECT_EQ(b.z(), -infinity);
+  EXPECT_EQ(length(double3{1, 2, 3} * infinity), infinity);
+
+  // the unused lane stays zero
+#if defined(GRAPHMATH_BACKEND_AVX2)
+  EXPECT_EQ(avx::lane<3>(b.native), 0.0);
+#endif
+}
+
+TEST(Double3, RelativeKeepsPrecision) {
+  // 10000 km from the origin, a float has a step of 1 m
+  double3 camera{1e7, 2e7, -1e7};
+  double3 position = camera + double3{0.001, -0.25, 3.5};
+
+  float3 offset = relative(position, camera);
+  EXPECT_NEAR(offset.x(), 0.001f, 1e-6f);
+  EXPECT_NEAR(offset.y(), -0.25f, 1e-6f);
+  EXPECT_NEAR(offset.z(), 3.5f, 1e-6f);
+
+  float3 naive = position.to_float3() - camera.to_float3();
+  EXPECT_NE(naive, offset);
+}
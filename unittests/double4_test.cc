@@ -0,0 +1,49 @@
+#include "graphmath/double4.h"
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+TEST(Double4, Constructor) {
+  double4 zeros;
+  double4 values{1, 2, 3, 4};
+
+  EXPECT_EQ(zeros, (double4{0, 0, 0, 0}));
+  EXPECT_EQ(values.x(), 1.0);
+  EXPECT_EQ(values.y(), 2.0);
+  EXPECT_EQ(values.z(), 3.0);
+  EXPECT_EQ(values.w(), 4.0);
+
+  EXPECT_EQ((double4{double3{1, 2, 3}}), (double4{1, 2, 3, 1}));
+  EXPECT_EQ((double4{double3{1, 2, 3}, 0.0}), (double4{1, 2, 3, 0}));
+
+  double4 from_float{float4{0.1f, 2, 3, -4}};
+  EXPECT_EQ(from_float.x(), static_cast<double>(0.1f));
+  EXPECT_EQ(from_float.w(), -4.0);
+
+  float4 rounded = double4{0.1, 2, 3, -4}.to_float4();
+  float4 expected{0.1f, 2, 3, -4};
+  EXPECT_EQ(rounded, expected);
+}
+
+TEST(Double4, Arithmetic) {
+  double4 a{1, 2, 3, 4};
+  double4 b{5, 6, 7, 8};
+
+  EXPECT_EQ(a + b, (double4{6, 8, 10, 12}));
+  EXPECT_EQ(b - a, (double4{4, 4, 4, 4}));
+  EXPECT_EQ(a * 2.0, (double4{2, 4, 6, 8}));
+  EXPECT_EQ(a * b, (double4{5, 12, 21, 32}));
+  EXPECT_EQ(madd(a, b, a), (double4{6, 14, 24, 36}));
+  EXPECT_NE(a, (double4{1, 2, 3, 5}));
+
+  EXPECT_EQ(dot(a, b), 70.0);
+  EXPECT_EQ(length(double4{1, 1, 1, 1}), 2.0);
+
+  double4 normalized = normalize(double4{2, 0, 0, 2});
+  EXPECT_DOUBLE_EQ(normalized.x(), 1.0 / std::sqrt(2.0));
+  EXPECT_DOUBLE_EQ(normalized.w(), 1.0 / std::sqrt(2.0));
+}
@@ -0,0 +1,97 @@
+#include "graphmath/double4x4.h"
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+static const double4x4 matrix{double4{0, 1, 2, 3}, double4{4, 5, 6, 7},
+                              double4{8, 9, 10, 11}, double4{12, 13, 14, 15}};
+
+TEST(Double4x4, Construction) {
+  double counter = 0;
+
+  for (size_t y = 0; y < 4; y++) {
+    for (size_t x = 0; x < 4; x++) {
+      EXPECT_EQ(matrix(y, x), counter++);
+    }
+  }
+
+  double4x4 identity{1.0};
+  identity.set(1, 2, 5.0);
+
+  for (size_t y = 0; y < 4; y++) {
+    for (size_t x = 0; x < 4; x++) {
+      double expected = y == 1 && x == 2 ? 5.0 : (y == x ? 1.0 : 0.0);
+      EXPECT_EQ(identity.get(y, x), expected);
+    }
+  }
+}
+
+TEST(Double4x4, RowsAndColumns) {
+  for (size_t i = 0; i < 4; i++) {
+    double first = static_cast<double>(i);
+
+    EXPECT_EQ(matrix.row(i),
+              (double4{first * 4, first * 4 + 1, first * 4 + 2,
+                       first * 4 + 3}));
+    EXPECT_EQ(matrix.column(i),
+              (double4{first, first + 4, first + 8, first + 12}));
+  }
+
+  double4x4 transposed = transpose(matrix);
+
+  for (size_t y = 0; y < 4; y++) {
+    for (size_t x = 0; x < 4; x++) {
+      EXPECT_EQ(transposed(y, x), matrix(x, y));
+    }
+  }
+}
+
+TEST(Double4x4, Multiply) {
+  EXPECT_EQ((matrix * double4{1, 1, 1, 1}), (double4{6, 22, 38, 54}));
+
+  double4x4 product = matrix * transpose(matrix);
+  float4x4 float_matrix = matrix.to_float4x4();
+  float4x4 float_product = float_matrix * transpose(float_matrix);
+
+  for (size_t y = 0; y < 4; y++) {
+    for (size_t x = 0; x < 4; x++) {
+      EXPECT_EQ(product(y, x), static_cast<double>(float_product(y, x)));
+    }
+  }
+
+  EXPECT_EQ((double4x4{1.0} * matrix)(2, 3), 11.0);
+}
+
+TEST(Double4x4, Conversions) {
+  float4x4 rounded = matrix.to_float4x4();
+  double4x4 widened{rounded};
+
+  for (size_t y = 0; y < 4; y++) {
+    for (size_t x = 0; x < 4; x++) {
+      EXPECT_EQ(rounded(y, x), static_cast<float>(matrix(y, x)));
+      EXPECT_EQ(widened(y, x), matrix(y, x));
+    }
+  }
+}
+
+TEST(Double4x4, Relative) {
+  double3 camera{1e7, -3e7, 5e6};
+
+  double4x4 transform{double4{0, -1, 0, camera.x() + 0.125},
+                      double4{1, 0, 0, camera.y() - 2.5},
+                      double4{0, 0, 2, camera.z() + 0.001},
+                      double4{0, 0, 0, 1}};
+
+  float4x4 local = relative(transform, camera);
+  float4 point = local * float4{1, 0, 0, 1};
+
+  EXPECT_FLOAT_EQ(point.x(), 0.125f);
+  EXPECT_FLOAT_EQ(point.y(), 1.0f - 2.5f);
+  EXPECT_FLOAT_EQ(point.z(), 0.001f);
+  EXPECT_FLOAT_EQ(point.w(), 1.0f);
+
+  EXPECT_FLOAT_EQ(local(0, 1), -1.0f);
+  EXPECT_FLOAT_EQ(local(2, 2), 2.0f);
+}
@@ -0,0 +1,120 @@
+#include "graphmath/expression.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+using graphmath::expr::evaluate;
+using graphmath::expr::lazy;
+
+namespace {
+template <typename T>
+std::vector<T> make_vectors(size_t count, float offset) {
+  std::vector<T> values;
+
+  for (size_t i = 0; i < count; i++) {
+    float f = static_cast<float>(i) * 0.25f + offset;
+
+    if constexpr (std::is_same_v<T, float3>) {
+      values.push_back(float3{f, 2 * f - 5, 7 - f});
+    } else {
+      values.push_back(float4{f, 2 * f - 5, 7 - f, f - 3});
+    }
+  }
+
+  return values;
+}
+}  // namespace
+
+TEST(Expression, Float3) {
+  float3 a{1, 2, 3};
+  float3 b{-4, 0.5, 6};
+  float3 c{2, 2, -1};
+
+  float3 fused = evaluate(lazy(a) * 2.0f + b - c);
+  float3 expect = a * 2.0f + b - c;
+  EXPECT_FLOAT3_EQ(fused, expect);
+
+  float3 reversed = evaluate(c + lazy(a) * b);
+  expect = a * b + c;
+  EXPECT_FLOAT3_EQ(reversed, expect);
+
+  float3 scaled = evaluate(3.0f * lazy(a) - b * c);
+  expect = a * 3.0f - b * c;
+  EXPECT_FLOAT3_EQ(scaled, expect);
+
+  float3 divided = evaluate((lazy(a) + b) / 4.0f);
+  expect = (a + b) / 4.0f;
+  EXPECT_FLOAT3_EQ(divided, expect);
+}
+
+TEST(Expression, Float4) {
+  float4 a{1, 2, 3, 4};
+  float4 b{-4, 0.5, 6, 1};
+  float4 c{2, 2, -1, 8};
+
+  float4 fused = evaluate(lazy(a) * 2.0f + b - c);
+  float4 expect = a * 2.0f + b - c;
+  EXPECT_FLOAT4_EQ(fused, expect);
+
+  float4 chained = evaluate(lazy(a) * b * c + a);
+  expect = a * b * c + a;
+  EXPECT_FLOAT4_EQ(chained, expect);
+
+  float4 divided = evaluate(lazy(a) / 2.0f);
+  expect = a * 0.5f;
+  EXPECT_FLOAT4_EQ(divided, expect);
+}
+
+TEST(Expression, Float3SoA) {
+  // sizes around the width of `wide_float` to cover the scalar tail
+  for (size_t size : {0, 1, 7, 16, 37}) {
+    std::vector<float3> a = make_vectors<float3>(size, 1);
+    std::vector<float3> b = make_vectors<float3>(size, -2);
+    float3 c{0.5, -1, 2};
+
+    float3_soa a_soa{a.data(), a.size()};
+    float3_soa b_soa{b.data(), b.size()};
+    float3_soa out;
+
+    evaluate(lazy(a_soa) * 2.0f + b_soa - c, out);
+
+    ASSERT_EQ(out.size(), size);
+
+    for (size_t i = 0; i < size; i++) {
+      float3 expect = a[i] * 2.0f + b[i] - c;
+      EXPECT_FLOAT3_EQ(out.get(i), expect);
+    }
+
+    // the output may be one of the inputs
+    evaluate((lazy(a_soa) - b_soa) / 2.0f, a_soa);
+
+    for (size_t i = 0; i < size; i++) {
+      float3 expect = (a[i] - b[i]) / 2.0f;
+      EXPECT_FLOAT3_EQ(a_soa.get(i), expect);
+    }
+  }
+}
+
+TEST(Expression, Float4SoA) {
+  for (size_t size : {3, 16, 21}) {
+    std::vector<float4> a = make_vectors<float4>(size, 1);
+    std::vector<float4> b = make_vectors<float4>(size, -2);
+    float4 c{0.5, -1, 2, 4};
+
+    float4_soa a_soa{a.data(), a.size()};
+    float4_soa b_soa{b.data(), b.size()};
+    float4_soa out;
+
+    evaluate(lazy(a_soa) * b_soa + c * 0.5f, out);
+
+    ASSERT_EQ(out.size(), size);
+
+    for (size_t i = 0; i < size; i++) {
+      float4 expect = a[i] * b[i] + c * 0.5f;
+      EXPECT_FLOAT4_EQ(out.get(i), expect);
+    }
+  }
+}
@@ -0,0 +1,118 @@
+#include "graphmath/fast.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+namespace {
+// the documented bound of `graphmath::fast`, `2^-21`
+constexpr float tolerance = 4.8e-7f;
+
+void expect_relative_near(float actual, float expected) {
+  EXPECT_NEAR(actual, expected, std::fabs(expected) * tolerance);
+}
+}  // namespace
+
+TEST(Fast, Rsqrt) {
+  for (float value : {1e-30f, 0.001f, 0.5f, 1.0f, 2.0f, 3.0f, 1234.5f, 1e30f}) {
+    expect_relative_near(fast::rsqrt(value), 1.0f / std::sqrt(value));
+  }
+}
+
+TEST(Fast, Rcp) {
+  for (float value : {-1e30f, -3.0f, 1e-30f, 0.001f, 1.0f, 7.0f, 1e30f}) {
+    expect_relative_near(fast::rcp(value), 1.0f / value);
+  }
+}
+
+TEST(Fast, Float3) {
+  float3 f3{1, 2, 3};
+  float3 normalized = fast::normalize(f3);
+  float3 expected = normalize(f3);
+
+  expect_relative_near(normalized.x(), expected.x());
+  expect_relative_near(normalized.y(), expected.y());
+  expect_relative_near(normalized.z(), expected.z());
+
+  expect_relative_near(fast::length(f3), length(f3));
+  EXPECT_EQ(fast::length(float3{0, 0, 0}), 0.0f);
+}
+
+TEST(Fast, Float4) {
+  float4 f4{1, -2, 3, 4};
+  float4 normalized = fast::normalize(f4);
+  float4 expected = normalize(f4);
+
+  expect_relative_near(normalized.x(), expected.x());
+  expect_relative_near(normalized.y(), expected.y());
+  expect_relative_near(normalized.z(), expected.z());
+  expect_relative_near(normalized.w(), expected.w());
+
+  expect_relative_near(fast::length(f4), length(f4));
+  EXPECT_EQ(fast::length(float4{0, 0, 0, 0}), 0.0f);
+}
+
+TEST(Fast, Wide) {
+  float values[wide_float::lanes];
+  float rsqrts[wide_float::lanes];
+  float rcps[wide_float::lanes];
+
+  for (size_t i = 0; i < wide_float::lanes; i++) {
+    values[i] = 0.75f + static_cast<float>(i) * 3.5f;
+  }
+
+  fast::rsqrt(wide_float::load(values)).store(rsqrts);
+  fast::rcp(wide_float::load(values)).store(rcps);
+
+  for (size_t i = 0; i < wide_float::lanes; i++) {
+    expect_relative_near(rsqrts[i], 1.0f / std::sqrt(values[i]));
+    expect_relative_near(rcps[i], 1.0f / values[i]);
+  }
+}
+
+TEST(Fast, SoA) {
+  std::vector<float4> values;
+
+  for (size_t i = 0; i < 37; i++) {
+    float f = static_cast<float>(i);
+    values.push_back(float4{f + 1, 2 * f - 5, 7 - f, 0.5f * f});
+  }
+
+  values[3] = float4{0, 0, 0, 0};
+
+  std::vector<float3> values3;
+
+  for (const float4 &value : values) {
+    values3.push_back(float3{value.x(), value.y(), value.z()});
+  }
+
+  float3_soa soa3{values3.data(), values3.size()};
+  float4_soa soa4{values.data(), values.size()};
+  std::vector<float> lengths3(values.size());
+  std::vector<float> lengths4(values.size());
+
+  fast::length(soa3, lengths3.data());
+  fast::length(soa4, lengths4.data());
+
+  EXPECT_EQ(lengths3[3], 0.0f);
+  EXPECT_EQ(lengths4[3], 0.0f);
+
+  fast::normalize(soa3, soa3);
+  fast::normalize(soa4, soa4);
+
+  for (size_t i = 0; i < values.size(); i++) {
+    expect_relative_near(lengths3[i], length(values3[i]));
+    expect_relative_near(lengths4[i], length(values[i]));
+
+    if (i == 3) {
+      continue;
+    }
+
+    EXPECT_NEAR(length(soa3.get(i)), 1.0f, tolerance * 2);
+    EXPECT_NEAR(length(soa4.get(i)), 1.0f, tolerance * 2);
+  }
+}
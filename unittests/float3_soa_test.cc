@@ -0,0 +1,109 @@
+#include "graphmath/float3_soa.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+namespace {
+std::vector<float3> make_float3s(size_t count) {
+  std::vector<float3> values;
+
+  for (size_t i = 0; i < count; i++) {
+    float f = static_cast<float>(i);
+    values.push_back(float3{f + 1, 2 * f - 5, 7 - f});
+  }
+
+  return values;
+}
+}  // namespace
+
+TEST(Float3SoA, LoadStore) {
+  std::vector<float3> values = make_float3s(37);
+  float3_soa soa{values.data(), values.size()};
+
+  ASSERT_EQ(soa.size(), values.size());
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(soa.x()) % default_alignment, 0u);
+
+  for (size_t i = 0; i < values.size(); i++) {
+    EXPECT_FLOAT3_EQ(soa.get(i), values[i]);
+    EXPECT_FLOAT_EQ(soa.y()[i], values[i].y());
+  }
+
+  std::vector<float3> stored(values.size());
+  soa.store(stored.data());
+
+  for (size_t i = 0; i < values.size(); i++) {
+    EXPECT_EQ(stored[i], values[i]);
+  }
+}
+
+TEST(Float3SoA, Cross) {
+  std::vector<float3> a = make_float3s(37);
+  std::vector<float3> b = make_float3s(40);
+  b.erase(b.begin(), b.begin() + 3);
+
+  float3_soa result;
+  cross(float3_soa{a.data(), a.size()}, float3_soa{b.data(), b.size()},
+        result);
+
+  ASSERT_EQ(result.size(), a.size());
+
+  for (size_t i = 0; i < a.size(); i++) {
+    EXPECT_FLOAT3_EQ(result.get(i), cross(a[i], b[i]));
+  }
+}
+
+TEST(Float3SoA, Dot) {
+  std::vector<float3> a = make_float3s(37);
+  std::vector<float> result(a.size());
+
+  float3_soa soa{a.data(), a.size()};
+  dot(soa, soa, result.data());
+
+  for (size_t i = 0; i < a.size(); i++) {
+    EXPECT_FLOAT_EQ(result[i], dot(a[i], a[i]));
+  }
+}
+
+TEST(Float3SoA, NormalizeInPlace) {
+  std::vector<float3> a = make_float3s(37);
+  float3_soa soa{a.data(), a.size()};
+
+  normalize(soa, soa);
+
+  for (size_t i = 0; i < a.size(); i++) {
+    EXPECT_FLOAT3_EQ(soa.get(i), normalize(a[i]));
+  }
+}
+
+TEST(Float3SoA, Length) {
+  std::vector<float3> a = make_float3s(37);
+  std::vector<float> result(a.size());
+
+  length(float3_soa{a.data(), a.size()}, result.data());
+
+  for (size_t i = 0; i < a.size(); i++) {
+    EXPECT_FLOAT_EQ(result[i], length(a[i]));
+  }
+}
+
+TEST(Float3SoA, ClampAndSqrt) {
+  std::vector<float3> a = make_float3s(37);
+  float3 low{0, 0, 0};
+  float3 high{9, 9, 9};
+
+  float3_soa clamped;
+  clamp(float3_soa{a.data(), a.size()}, low, high, clamped);
+
+  float3_soa roots;
+  sqrt(clamped, roots);
+
+  for (size_t i = 0; i < a.size(); i++) {
+    EXPECT_FLOAT3_EQ(clamped.get(i), clamp(a[i], low, high));
+    EXPECT_FLOAT3_EQ(roots.get(i), sqrt(clamp(a[i], low, high)));
+  }
+}
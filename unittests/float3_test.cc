@@ -1,5 +1,8 @@
 #include "graphmath/float3.h"
 
+#include <cmath>
+#include <limits>
+
 #include "gtest/gtest.h"
 #include "helpers.h"
 
@@ -72,6 +75,23 @@ TEST(Float3, MultiplyByFloat) {
   EXPECT_FLOAT3_EQ(b, expected);
 }
 
+TEST(Float3, MultiplyByInfinity) {
+  float infinity = std::numeric_limits<float>::infinity();
+  float3 a{1, 0, -1};
+  float3 b = a * infinity;
+
+  EXPECT_EQ(b.x(), infinity);
+  EXPECT_TRUE(std::isnan(b.y()));
+  EXPECT_EQ(b.z(), -infinity);
+
+  // the unused lane stays zero
+#if defined(GRAPHMATH_BACKEND_DIRECTX)
+  EXPECT_EQ(DirectX::XMVectorGetW(b.native), 0.0f);
+#elif defined(GRAPHMATH_BACKEND_SSE)
+  EXPECT_EQ(_mm_cvtss_f32(_mm_shuffle_ps(b.native, b.native, 0xFF)), 0.0f);
+#endif
+}
+
 TEST(Float3, MultiplyByFloat3) {
   float3 a{1, 1, 1};
   float3 b{2, 2, 2};
@@ -149,3 +169,12 @@ TEST(Float3, Magnitude) {
   float3 f3{1, 1, 1};
   EXPECT_FLOAT_EQ(length(f3), 1.7320508f);
 }
+
+TEST(Float3, Madd) {
+  float3 a{1, 2, 3};
+  float3 b{4, 5, 6};
+  float3 c{-1, 0.5, 2};
+
+  float3 expect{3, 10.5, 20};
+  EXPECT_FLOAT3_EQ(madd(a, b, c), expect);
+}
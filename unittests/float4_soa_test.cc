@@ -0,0 +1,62 @@
+#include "graphmath/float4_soa.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+namespace {
+std::vector<float4> make_float4s(size_t count) {
+  std::vector<float4> values;
+
+  for (size_t i = 0; i < count; i++) {
+    float f = static_cast<float>(i);
+    values.push_back(float4{f + 1, 2 * f - 5, 7 - f, 0.5f * f});
+  }
+
+  return values;
+}
+}  // namespace
+
+TEST(Float4SoA, LoadStore) {
+  std::vector<float4> values = make_float4s(37);
+  float4_soa soa{values.data(), values.size()};
+
+  ASSERT_EQ(soa.size(), values.size());
+
+  std::vector<float4> stored(values.size());
+  soa.store(stored.data());
+
+  for (size_t i = 0; i < values.size(); i++) {
+    EXPECT_FLOAT4_EQ(soa.get(i), values[i]);
+    EXPECT_EQ(stored[i], values[i]);
+  }
+}
+
+TEST(Float4SoA, Dot) {
+  std::vector<float4> a = make_float4s(37);
+  std::vector<float> result(a.size());
+
+  float4_soa soa{a.data(), a.size()};
+  dot(soa, soa, result.data());
+
+  for (size_t i = 0; i < a.size(); i++) {
+    EXPECT_FLOAT_EQ(result[i], dot(a[i], a[i]));
+  }
+}
+
+TEST(Float4SoA, NormalizeAndLength) {
+  std::vector<float4> a = make_float4s(37);
+  std::vector<float> lengths(a.size());
+
+  float4_soa normalized;
+  normalize(float4_soa{a.data(), a.size()}, normalized);
+  length(float4_soa{a.data(), a.size()}, lengths.data());
+
+  for (size_t i = 0; i < a.size(); i++) {
+    EXPECT_FLOAT4_EQ(normalized.get(i), normalize(a[i]));
+    EXPECT_FLOAT_EQ(lengths[i], length(a[i]));
+  }
+}
@@ -102,3 +102,12 @@ TEST(Float4, Length) {
 
   EXPECT_FLOAT_EQ(length(f4), expected);
 }
+
+TEST(Float4, Madd) {
+  float4 a{1, 2, 3, 4};
+  float4 b{4, 5, 6, 7};
+  float4 c{-1, 0.5, 2, -28};
+
+  float4 expect{3, 10.5, 20, 0};
+  EXPECT_FLOAT4_EQ(madd(a, b, c), expect);
+}
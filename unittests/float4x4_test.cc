@@ -1,5 +1,7 @@
 #include "graphmath/float4x4.h"
 
+#include <vector>
+
 #include "graphmath/print.h"
 #include "gtest/gtest.h"
 #include "helpers.h"
@@ -19,6 +21,70 @@ TEST(Float4x4, Construction) {
   }
 }
 
+TEST(Float4x4, RowsAndColumns) {
+  float4x4 matrix{float4{0, 1, 2, 3}, float4{4, 5, 6, 7}, float4{8, 9, 10, 11},
+                  float4{12, 13, 14, 15}};
+
+  for (size_t i = 0; i < 4; i++) {
+    float first = static_cast<float>(i);
+
+    float4 row = matrix.row(i);
+    float4 expect_row{first * 4, first * 4 + 1, first * 4 + 2, first * 4 + 3};
+    EXPECT_FLOAT4_EQ(row, expect_row);
+
+    float4 column = matrix.column(i);
+    float4 expect_column{first, first + 4, first + 8, first + 12};
+    EXPECT_FLOAT4_EQ(column, expect_column);
+  }
+
+  float4x4 rows{0.0f};
+  float4x4 columns{0.0f};
+
+  for (size_t i = 0; i < 4; i++) {
+    rows.set_row(i, matrix.row(i));
+    columns.set_column(i, matrix.column(i));
+  }
+
+  rows.set_row(2, float4{-1, -2, -3, -4});
+  columns.set_column(1, float4{-1, -2, -3, -4});
+
+  for (size_t y = 0; y < 4; y++) {
+    for (size_t x = 0; x < 4; x++) {
+      float expect_rows = y == 2 ? -1.0f - x : matrix(y, x);
+      float expect_columns = x == 1 ? -1.0f - y : matrix(y, x);
+
+      EXPECT_FLOAT_EQ(rows(y, x), expect_rows);
+      EXPECT_FLOAT_EQ(columns(y, x), expect_columns);
+    }
+  }
+}
+
+TEST(Float4x4, Element) {
+  float4x4 matrix{1.0f};
+
+  matrix(1, 3) = 5.0f;
+  matrix(2, 0) = matrix(1, 3);
+  matrix(0, 0) += 2.0f;
+  matrix(3, 3) *= 4.0f;
+  matrix(2, 2) -= 3.0f;
+  matrix(1, 1) /= 2.0f;
+
+  float4x4 expect{float4{3, 0, 0, 0}, float4{0, 0.5f, 0, 5},
+                  float4{5, 0, -2, 0}, float4{0, 0, 0, 4}};
+
+  for (size_t y = 0; y < 4; y++) {
+    for (size_t x = 0; x < 4; x++) {
+      EXPECT_FLOAT_EQ(matrix(y, x), expect(y, x));
+    }
+  }
+
+  // a `const` matrix reads by value
+  const float4x4 &view = matrix;
+  float value = view(1, 3);
+
+  EXPECT_FLOAT_EQ(value, 5.0f);
+}
+
 TEST(Float4x4, Identity) {
   float4x4 matrix{1.0f};
   float4 vector{1, 2, 3, 4};
@@ -60,7 +126,8 @@ TEST(Float4x4, Transpose) {
   float counter = 0.0f;
 
   for (size_t row = 0; row < 4; row++) {
-    rows[row] = float4{counter++, counter++, counter++, counter++};
+    rows[row] = float4{counter, counter + 1, counter + 2, counter + 3};
+    counter += 4;
   }
 
   float4x4 matrix{rows[0], rows[1], rows[2], rows[3]};
@@ -72,3 +139,97 @@ TEST(Float4x4, Transpose) {
     }
   }
 }
+
+TEST(Float4x4, Determinant) {
+  float4x4 matrix{float4{2, 0, 1, 3}, float4{1, 3, 0, 2}, float4{0, 1, 4, 1},
+                  float4{3, 2, 1, 0}};
+  float4x4 singular{float4{0, 1, 2, 3}, float4{4, 5, 6, 7},
+                    float4{8, 9, 10, 11}, float4{12, 13, 14, 15}};
+
+  EXPECT_FLOAT_EQ(determinant(matrix), -120.0f);
+  EXPECT_FLOAT_EQ(determinant(float4x4{2.0f}), 16.0f);
+  EXPECT_NEAR(determinant(singular), 0.0f, 1e-3f);
+}
+
+TEST(Float4x4, Inverse) {
+  float4x4 matrix{float4{2, 0, 1, 3}, float4{1, 3, 0, 2}, float4{0, 1, 4, 1},
+                  float4{3, 2, 1, 0}};
+
+  float4x4 result = inverse(matrix) * matrix;
+  float4x4 identity{1.0f};
+
+  for (size_t y = 0; y < 4; y++) {
+    for (size_t x = 0; x < 4; x++) {
+      EXPECT_NEAR(result.get(y, x), identity.get(y, x), 1e-5f);
+    }
+  }
+}
+
+TEST(Float4x4, InverseAffine) {
+  float4x4 matrix{float4{0, -2, 0, 5}, float4{1, 0, 0, -3},
+                  float4{0, 0, 4, 1}, float4{0, 0, 0, 1}};
+
+  float4x4 result = inverse_affine(matrix);
+  float4x4 expected = inverse(matrix);
+
+  for (size_t y = 0; y < 4; y++) {
+    for (size_t x = 0; x < 4; x++) {
+      EXPECT_NEAR(result.get(y, x), expected.get(y, x), 1e-5f);
+    }
+  }
+}
+
+TEST(Float4x4, InverseBatch) {
+  std::vector<float4x4> matrices;
+
+  for (size_t i = 0; i < 5; i++) {
+    float offset = static_cast<float>(i);
+
+    matrices.push_back(float4x4{
+        float4{2 + offset, 0, 1, 3}, float4{1, 3, 0, 2 - offset},
+        float4{0, 1, 4, 1}, float4{3, 2, offset, 1}});
+  }
+
+  std::vector<float4x4> inverses(matrices.size(), float4x4{0.0f});
+  std::vector<float4x4> in_place = matrices;
+
+  inverse(matrices, inverses);
+  inverse(in_place, in_place);
+
+  for (size_t i = 0; i < matrices.size(); i++) {
+    float4x4 expected = inverse(matrices[i]);
+
+    for (size_t y = 0; y < 4; y++) {
+      for (size_t x = 0; x < 4; x++) {
+        EXPECT_FLOAT_EQ(inverses[i].get(y, x), expected.get(y, x));
+        EXPECT_FLOAT_EQ(in_place[i].get(y, x), expected.get(y, x));
+      }
+    }
+  }
+}
+
+TEST(Float4x4, InverseAffineBatch) {
+  std::vector<float4x4> matrices;
+
+  for (size_t i = 0; i < 5; i++) {
+    float offset = static_cast<float>(i);
+
+    matrices.push_back(
+        float4x4{float4{1 + offset, 0, 0, offset}, float4{0, 2, 0, 1},
+                 float4{1, 0, 1, -offset}, float4{0, 0, 0, 1}});
+  }
+
+  std::vector<float4x4> inverses(matrices.size(), float4x4{0.0f});
+
+  inverse_affine(matrices, inverses);
+
+  for (size_t i = 0; i < matrices.size(); i++) {
+    float4x4 expected = inverse_affine(matrices[i]);
+
+    for (size_t y = 0; y < 4; y++) {
+      for (size_t x = 0; x < 4; x++) {
+        EXPECT_FLOAT_EQ(inverses[i].get(y, x), expected.get(y, x));
+      }
+    }
+  }
+}
@@ -0,0 +1,133 @@
+#include "graphmath/frustum.h"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "graphmath/transform.h"
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+namespace {
+/// @brief a camera at `(0, 0, 5)` looking at the origin, seeing `z` from `4`
+/// down to `-5`
+frustum make_frustum() {
+  float4x4 view = look_at(float3{0, 0, 5}, float3{0, 0, 0}, float3{0, 1, 0});
+  float4x4 projection = perspective(1.0f, 1.5f, 1.0f, 10.0f);
+
+  return frustum{projection * view};
+}
+
+/// @brief the smallest signed distance of a box to the planes, twice
+float box_margin(const frustum &f, const aabb &box) {
+  float3 c = center(box);
+  float3 e = half_extents(box);
+  float margin = INFINITY;
+
+  for (const float4 &plane : f.planes) {
+    margin = std::fmin(margin, plane.x() * c.x() + plane.y() * c.y() +
+                                   plane.z() * c.z() + plane.w() +
+                                   std::abs(plane.x()) * e.x() +
+                                   std::abs(plane.y()) * e.y() +
+                                   std::abs(plane.z()) * e.z());
+  }
+
+  return margin;
+}
+
+float sphere_margin(const frustum &f, const bounding_sphere &sphere) {
+  float3 c = sphere.center();
+  float margin = INFINITY;
+
+  for (const float4 &plane : f.planes) {
+    margin = std::fmin(margin, plane.x() * c.x() + plane.y() * c.y() +
+                                   plane.z() * c.z() + plane.w() +
+                                   sphere.radius());
+  }
+
+  return margin;
+}
+
+bool visible_bit(const std::vector<std::uint8_t> &visible, size_t i) {
+  return (visible[i / 8] >> (i % 8)) & 1;
+}
+}  // namespace
+
+TEST(Frustum, Planes) {
+  frustum f = make_frustum();
+
+  // normals have unit length and the origin is inside every plane
+  for (const float4 &plane : f.planes) {
+    EXPECT_NEAR(length(float3{plane.x(), plane.y(), plane.z()}), 1.0f, 1e-5f);
+    EXPECT_GT(plane.w(), 0.0f);
+  }
+
+  // the near plane is at `z = 4`, the far one at `z = -5`
+  EXPECT_NEAR(f.planes[4].z(), -1.0f, 1e-5f);
+  EXPECT_NEAR(f.planes[4].w(), 4.0f, 1e-4f);
+  EXPECT_NEAR(f.planes[5].z(), 1.0f, 1e-5f);
+  EXPECT_NEAR(f.planes[5].w(), 5.0f, 1e-4f);
+}
+
+TEST(Frustum, Intersects) {
+  frustum f = make_frustum();
+
+  EXPECT_TRUE(intersects(f, aabb{float3{-1, -1, -1}, float3{1, 1, 1}}));
+  EXPECT_TRUE(intersects(f, aabb{float3{-1, -1, 3}, float3{1, 1, 6}}));
+  EXPECT_FALSE(intersects(f, aabb{float3{-1, -1, 4.5f}, float3{1, 1, 6}}));
+  EXPECT_FALSE(intersects(f, aabb{float3{20, -1, -1}, float3{21, 1, 1}}));
+  EXPECT_FALSE(intersects(f, aabb{float3{-1, -1, -8}, float3{1, 1, -6}}));
+
+  EXPECT_TRUE(intersects(f, bounding_sphere{float3{0, 0, 0}, 1}));
+  EXPECT_TRUE(intersects(f, bounding_sphere{float3{0, 0, 5}, 1.5f}));
+  EXPECT_FALSE(intersects(f, bounding_sphere{float3{0, 0, 5}, 0.5f}));
+  EXPECT_FALSE(intersects(f, bounding_sphere{float3{0, 20, 0}, 1}));
+}
+
+TEST(Frustum, CullMatchesIntersects) {
+  frustum f = make_frustum();
+
+  std::mt19937 engine{419};
+  std::uniform_real_distribution<float> position{-12.0f, 12.0f};
+  std::uniform_real_distribution<float> size{0.0f, 2.0f};
+
+  // counts around and between the 8 and 4 wide loops
+  for (size_t count : {0, 1, 3, 4, 7, 8, 13, 1000, 1003}) {
+    std::vector<aabb> boxes;
+    std::vector<bounding_sphere> spheres;
+
+    for (size_t i = 0; i < count; i++) {
+      float3 c{position(engine), position(engine), position(engine)};
+      float3 e{size(engine), size(engine), size(engine)};
+
+      boxes.push_back(aabb{c - e, c + e});
+      spheres.push_back(bounding_sphere{c, size(engine)});
+    }
+
+    std::vector<std::uint8_t> box_visible((count + 7) / 8, 0xFF);
+    std::vector<std::uint8_t> sphere_visible((count + 7) / 8, 0xFF);
+
+    cull(f, boxes, box_visible);
+    cull(f, spheres, sphere_visible);
+
+    for (size_t i = 0; i < count; i++) {
+      // the batches round differently right on a plane
+      if (std::abs(box_margin(f, boxes[i])) > 1e-4f) {
+        EXPECT_EQ(visible_bit(box_visible, i), intersects(f, boxes[i]));
+      }
+
+      if (std::abs(sphere_margin(f, spheres[i])) > 1e-4f) {
+        EXPECT_EQ(visible_bit(sphere_visible, i), intersects(f, spheres[i]));
+      }
+    }
+
+    // the bits past the last volume are zero
+    for (size_t i = count; i < box_visible.size() * 8; i++) {
+      EXPECT_FALSE(visible_bit(box_visible, i));
+      EXPECT_FALSE(visible_bit(sphere_visible, i));
+    }
+  }
+}
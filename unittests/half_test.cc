@@ -0,0 +1,139 @@
+#include "graphmath/half.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+using detail::float_to_half;
+using detail::half_to_float;
+
+static_assert(sizeof(half3) == 6);
+static_assert(sizeof(half4) == 8);
+
+TEST(Half, Construction) {
+  half3 zero;
+  half3 values{1, -2, 0.5f};
+  half4 from_float4{float4{0.25f, 65504, -0.0f, 3}};
+
+  float3 expected{1, -2, 0.5f};
+  float3 converted = values.to_float3();
+
+  EXPECT_EQ(zero.x(), 0.0f);
+  EXPECT_FLOAT3_EQ(converted, expected);
+  EXPECT_EQ(from_float4.x(), 0.25f);
+  EXPECT_EQ(from_float4.y(), 65504.0f);
+  EXPECT_TRUE(std::signbit(from_float4.z()));
+  EXPECT_EQ(from_float4.w(), 3.0f);
+  EXPECT_EQ(values.native[0], 0x3c00);
+}
+
+TEST(Half, Rounding) {
+  constexpr float inf = std::numeric_limits<float>::infinity();
+
+  // `1 + 2^-11` lies halfway between `1` and `1 + 2^-10`: ties to even
+  EXPECT_EQ(float_to_half(1.0f + 0x1p-11f), 0x3c00);
+  EXPECT_EQ(float_to_half(1.0f + 3 * 0x1p-11f), 0x3c02);
+  EXPECT_EQ(float_to_half(1.0f + 0x1p-11f + 0x1p-20f), 0x3c01);
+
+  EXPECT_EQ(float_to_half(65504.0f), 0x7bff);
+  EXPECT_EQ(float_to_half(65519.0f), 0x7bff);
+  EXPECT_EQ(float_to_half(65520.0f), 0x7c00);
+  EXPECT_EQ(float_to_half(-inf), 0xfc00);
+  EXPECT_EQ(float_to_half(1e10f), 0x7c00);
+
+  // subnormals are multiples of `2^-24`
+  EXPECT_EQ(float_to_half(0x1p-24f), 0x0001);
+  EXPECT_EQ(float_to_half(0x1p-25f), 0x0000);
+  EXPECT_EQ(float_to_half(0x1.8p-25f), 0x0001);
+  EXPECT_EQ(float_to_half(-0x1p-14f), 0x8400);
+  EXPECT_EQ(float_to_half(0x1p-14f - 0x1p-24f), 0x03ff);
+
+  EXPECT_EQ(float_to_half(std::numeric_limits<float>::quiet_NaN()) & 0x7e00,
+            0x7e00);
+}
+
+TEST(Half, EveryHalfRoundTrips) {
+  for (uint32_t bits = 0; bits <= 0xffff; bits++) {
+    uint16_t half = static_cast<uint16_t>(bits);
+    float value = half_to_float(half);
+
+    if ((half & 0x7c00) == 0x7c00 && (half & 0x03ff) != 0) {
+      ASSERT_TRUE(std::isnan(value)) << bits;
+      continue;
+    }
+
+    ASSERT_EQ(float_to_half(value), half) << bits;
+  }
+
+  EXPECT_EQ(half_to_float(0x0001), 0x1p-24f);
+  EXPECT_EQ(half_to_float(0x7c00), std::numeric_limits<float>::infinity());
+}
+
+/// @brief floats over the whole range of `binary16`, and past it
+static std::vector<float> sample_floats(size_t count) {
+  std::mt19937 generator{23};
+  std::uniform_real_distribution<float> exponent{-30.0f, 20.0f};
+  std::bernoulli_distribution negative{0.5};
+  std::vector<float> values;
+
+  for (size_t i = 0; i < count; i++) {
+    float value = std::exp2(exponent(generator));
+    values.push_back(negative(generator) ? -value : value);
+  }
+
+  values[0] = 0.0f;
+  values[1] = std::numeric_limits<float>::infinity();
+  values[2] = 65520.0f;
+  return values;
+}
+
+TEST(Half, BulkMatchesScalar) {
+  std::vector<float> samples = sample_floats(4 * 67);
+
+  // every size up to 67 covers the tails of the vector loops
+  for (size_t count = 0; count <= 67; count++) {
+    std::vector<float3> f3s;
+    std::vector<float4> f4s;
+
+    for (size_t i = 0; i < count; i++) {
+      const float *s = samples.data() + 4 * i;
+      f3s.push_back(float3{s[0], s[1], s[2]});
+      f4s.push_back(float4{s[0], s[1], s[2], s[3]});
+    }
+
+    std::vector<half3> h3s(count);
+    std::vector<half4> h4s(count);
+    to_half(f3s, h3s);
+    to_half(f4s, h4s);
+
+    std::vector<float3> back3(count);
+    std::vector<float4> back4(count);
+    to_float(h3s, back3);
+    to_float(h4s, back4);
+
+    for (size_t i = 0; i < count; i++) {
+      half3 expected3{f3s[i]};
+      half4 expected4{f4s[i]};
+
+      for (size_t c = 0; c < 3; c++) {
+        ASSERT_EQ(h3s[i].native[c], expected3.native[c]) << count << " " << i;
+      }
+
+      for (size_t c = 0; c < 4; c++) {
+        ASSERT_EQ(h4s[i].native[c], expected4.native[c]) << count << " " << i;
+      }
+
+      float3 scalar3 = expected3.to_float3();
+      float4 scalar4 = expected4.to_float4();
+
+      ASSERT_EQ(back3[i], scalar3);
+      ASSERT_EQ(back4[i], scalar4);
+    }
+  }
+}
@@ -0,0 +1,37 @@
+#include "graphmath/int3.h"
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+TEST(Int3, Constructor) {
+  int3 zeros;
+  int3 values{1, -2, 3};
+
+  EXPECT_EQ(zeros, (int3{0, 0, 0}));
+  EXPECT_EQ(values.x(), 1);
+  EXPECT_EQ(values.y(), -2);
+  EXPECT_EQ(values.z(), 3);
+
+  // rounds toward zero
+  EXPECT_EQ((int3{float3{1.9f, -1.9f, 2.5f}}), (int3{1, -1, 2}));
+
+  float3 widened = values.to_float3();
+  float3 expected{1, -2, 3};
+  EXPECT_EQ(widened, expected);
+}
+
+TEST(Int3, Arithmetic) {
+  int3 a{1, 2, 3};
+  int3 b{4, -5, 6};
+
+  EXPECT_EQ(a + b, (int3{5, -3, 9}));
+  EXPECT_EQ(a - b, (int3{-3, 7, -3}));
+  EXPECT_EQ(a * 3, (int3{3, 6, 9}));
+  EXPECT_EQ(a * b, (int3{4, -10, 18}));
+  EXPECT_NE(a, b);
+
+  EXPECT_EQ(min(a, b), (int3{1, -5, 3}));
+  EXPECT_EQ(max(a, b), (int3{4, 2, 6}));
+}
@@ -0,0 +1,38 @@
+#include "graphmath/int4.h"
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+TEST(Int4, Constructor) {
+  int4 zeros;
+  int4 values{1, -2, 3, -4};
+
+  EXPECT_EQ(zeros, (int4{0, 0, 0, 0}));
+  EXPECT_EQ(values.x(), 1);
+  EXPECT_EQ(values.y(), -2);
+  EXPECT_EQ(values.z(), 3);
+  EXPECT_EQ(values.w(), -4);
+
+  // rounds toward zero
+  EXPECT_EQ((int4{float4{1.9f, -1.9f, 2.5f, -0.5f}}), (int4{1, -1, 2, 0}));
+
+  float4 widened = values.to_float4();
+  float4 expected{1, -2, 3, -4};
+  EXPECT_EQ(widened, expected);
+}
+
+TEST(Int4, Arithmetic) {
+  int4 a{1, 2, 3, 4};
+  int4 b{4, -5, 6, -7};
+
+  EXPECT_EQ(a + b, (int4{5, -3, 9, -3}));
+  EXPECT_EQ(a - b, (int4{-3, 7, -3, 11}));
+  EXPECT_EQ(a * 3, (int4{3, 6, 9, 12}));
+  EXPECT_EQ(a * b, (int4{4, -10, 18, -28}));
+  EXPECT_NE(a, (int4{1, 2, 3, 5}));
+
+  EXPECT_EQ(min(a, b), (int4{1, -5, 3, -7}));
+  EXPECT_EQ(max(a, b), (int4{4, 2, 6, 4}));
+}
@@ -0,0 +1,141 @@
+#include "graphmath/mask.h"
+
+#include <cmath>
+#include <limits>
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+TEST(Mask, Lanes) {
+  bool3 none;
+  bool3 some{true, false, true};
+
+  EXPECT_FALSE(none.x() || none.y() || none.z());
+  EXPECT_TRUE(some.x());
+  EXPECT_FALSE(some.y());
+  EXPECT_TRUE(some.z());
+  EXPECT_EQ(some.bits(), 0x5);
+
+  bool4 last{false, false, false, true};
+  EXPECT_EQ(last.bits(), 0x8);
+  EXPECT_TRUE(last.w());
+}
+
+TEST(Mask, Logic) {
+  bool3 a{true, true, false};
+  bool3 b{true, false, false};
+
+  EXPECT_EQ((a & b).bits(), 0x1);
+  EXPECT_EQ((a | b).bits(), 0x3);
+  EXPECT_EQ((!a).bits(), 0x4);
+
+  EXPECT_TRUE(any(a));
+  EXPECT_FALSE(all(a));
+  EXPECT_TRUE(all(a | !a));
+  EXPECT_FALSE(any(a & !a));
+
+  bool4 c{true, true, true, false};
+  EXPECT_FALSE(all(c));
+  EXPECT_TRUE(all(c | bool4{false, false, false, true}));
+  EXPECT_EQ((!c).bits(), 0x8);
+}
+
+TEST(Mask, Compare) {
+  float3 a{1, 2, 3};
+  float3 b{3, 2, 1};
+
+  EXPECT_EQ(equal(a, b).bits(), 0x2);
+  EXPECT_EQ(not_equal(a, b).bits(), 0x5);
+  EXPECT_EQ(less(a, b).bits(), 0x1);
+  EXPECT_EQ(less_equal(a, b).bits(), 0x3);
+  EXPECT_EQ(greater(a, b).bits(), 0x4);
+  EXPECT_EQ(greater_equal(a, b).bits(), 0x6);
+
+  float4 c{1, 2, 3, 4};
+  float4 d{4, 3, 3, 1};
+
+  EXPECT_EQ(equal(c, d).bits(), 0x4);
+  EXPECT_EQ(not_equal(c, d).bits(), 0xB);
+  EXPECT_EQ(less(c, d).bits(), 0x3);
+  EXPECT_EQ(less_equal(c, d).bits(), 0x7);
+  EXPECT_EQ(greater(c, d).bits(), 0x8);
+  EXPECT_EQ(greater_equal(c, d).bits(), 0xC);
+
+  // NaN is unordered: only `not_equal` is set
+  float nan = std::numeric_limits<float>::quiet_NaN();
+  float3 with_nan{nan, 0, 0};
+  EXPECT_FALSE(equal(with_nan, with_nan).x());
+  EXPECT_TRUE(not_equal(with_nan, with_nan).x());
+  EXPECT_FALSE(less_equal(with_nan, with_nan).x());
+}
+
+TEST(Mask, Select) {
+  float3 a{1, 2, 3};
+  float3 b{-1, -2, -3};
+
+  float3 picked = select(bool3{true, false, true}, a, b);
+  float3 expected{1, -2, 3};
+  EXPECT_EQ(picked, expected);
+
+  // clamp negative lanes to zero without a branch
+  float4 c{-1, 2, -3, 4};
+  float4 clamped = select(less(c, float4{0, 0, 0, 0}), float4{0, 0, 0, 0}, c);
+  float4 expected_clamped{0, 2, 0, 4};
+  EXPECT_EQ(clamped, expected_clamped);
+}
+
+TEST(Mask, MinMaxAbs) {
+  float3 a{1, -5, 3};
+  float3 b{4, 2, -6};
+
+  EXPECT_EQ(min(a, b), (float3{1, -5, -6}));
+  EXPECT_EQ(max(a, b), (float3{4, 2, 3}));
+  EXPECT_EQ(abs(a), (float3{1, 5, 3}));
+
+  float4 c{1, -5, 3, -0.0f};
+  float4 d{4, 2, -6, -7};
+
+  EXPECT_EQ(min(c, d), (float4{1, -5, -6, -7}));
+  EXPECT_EQ(max(c, d), (float4{4, 2, 3, -0.0f}));
+  EXPECT_EQ(abs(c), (float4{1, 5, 3, 0}));
+  EXPECT_FALSE(std::signbit(abs(c).w()));
+}
+
+TEST(Mask, MinMaxNaN) {
+  // like `minps` and `maxps`, the second operand wins for a NaN
+  float nan = std::numeric_limits<float>::quiet_NaN();
+  float3 a{nan, 1, 1};
+  float3 b{1, nan, 1};
+
+  float3 low = min(a, b);
+  float3 high = max(a, b);
+
+#if defined(GRAPHMATH_BACKEND_APPLE)
+  EXPECT_EQ(low, (float3{1, 1, 1}));
+  EXPECT_EQ(high, (float3{1, 1, 1}));
+#else
+  EXPECT_EQ(low.x(), 1.0f);
+  EXPECT_TRUE(std::isnan(low.y()));
+  EXPECT_EQ(high.x(), 1.0f);
+  EXPECT_TRUE(std::isnan(high.y()));
+
+  float4 c = min(float4{nan, 1, 1, 1}, float4{1, nan, 1, nan});
+  EXPECT_EQ(c.x(), 1.0f);
+  EXPECT_TRUE(std::isnan(c.y()));
+  EXPECT_TRUE(std::isnan(c.w()));
+#endif
+}
+
+TEST(Mask, NearlyEqual) {
+  float3 a{1, 2, 3};
+  float3 b{1.0005f, 2.1f, 3};
+
+  EXPECT_EQ(nearly_equal(a, b, 1e-3f).bits(), 0x5);
+  EXPECT_TRUE(all(nearly_equal(a, b, 0.2f)));
+  EXPECT_FALSE(any(nearly_equal(a, b + float3{1, 1, 1}, 0.2f)));
+
+  float4 c{0, 0, 0, 1};
+  EXPECT_EQ(nearly_equal(c, float4{0.01f, -0.01f, 1, 1}, 0.05f).bits(), 0xB);
+}
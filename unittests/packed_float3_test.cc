@@ -0,0 +1,62 @@
+#include "graphmath/packed_float3.h"
+
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+static_assert(std::is_trivially_copyable_v<float3>);
+static_assert(std::is_trivially_copyable_v<float4>);
+static_assert(std::is_trivially_copyable_v<float4x4>);
+static_assert(sizeof(packed_float3) == 12);
+
+TEST(PackedFloat3, Construction) {
+  packed_float3 zero;
+  packed_float3 values{1, 2, 3};
+  packed_float3 from_float3{float3{4, 5, 6}};
+
+  EXPECT_FLOAT_EQ(zero.x(), 0.0f);
+  EXPECT_FLOAT_EQ(zero.y(), 0.0f);
+  EXPECT_FLOAT_EQ(zero.z(), 0.0f);
+
+  float3 unpacked = values.unpack();
+  float3 expected{1, 2, 3};
+
+  EXPECT_FLOAT3_EQ(unpacked, expected);
+
+  EXPECT_FLOAT_EQ(from_float3.x(), 4.0f);
+  EXPECT_FLOAT_EQ(from_float3.y(), 5.0f);
+  EXPECT_FLOAT_EQ(from_float3.z(), 6.0f);
+}
+
+TEST(PackedFloat3, PackUnpack) {
+  // cover the vectorized loops and their tails
+  for (size_t count = 0; count < 11; count++) {
+    std::vector<float3> values;
+
+    for (size_t i = 0; i < count; i++) {
+      float base = static_cast<float>(i * 3);
+      values.push_back(float3{base, base + 1, base + 2});
+    }
+
+    std::vector<packed_float3> packed(count);
+    std::vector<float3> unpacked(count);
+
+    pack(values, packed);
+    unpack(packed, unpacked);
+
+    for (size_t i = 0; i < count; i++) {
+      float base = static_cast<float>(i * 3);
+
+      EXPECT_FLOAT_EQ(packed[i].x(), base);
+      EXPECT_FLOAT_EQ(packed[i].y(), base + 1);
+      EXPECT_FLOAT_EQ(packed[i].z(), base + 2);
+
+      EXPECT_FLOAT3_EQ(unpacked[i], values[i]);
+      EXPECT_EQ(unpacked[i], values[i]);
+    }
+  }
+}
@@ -0,0 +1,226 @@
+#include "graphmath/parse.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using std::string;
+using namespace graphmath;
+
+static parse_result parse_string(const string &text, float3 &value) {
+  return parse(text.data(), text.data() + text.size(), value);
+}
+
+template <typename Out>
+static parse_result parse_lines_string(const string &text, Out &out,
+                                       const char *prefix = nullptr,
+                                       size_t thread_count = 1) {
+  return parse_lines(text.data(), text.data() + text.size(), out, prefix,
+                     thread_count);
+}
+
+/// @brief `count` lines of distinct vectors, about 40 bytes each
+static string sample_lines(size_t count) {
+  string text;
+
+  for (size_t i = 0; i < count; i++) {
+    char line[print::max_float4_chars + 1];
+    float f = static_cast<float>(i);
+    char *last = format_to(line, float4{f, -f * 0.25f, f * 1e-3f, 1.0f});
+    *last++ = '\n';
+
+    text.append(line, last);
+  }
+
+  return text;
+}
+
+TEST(Parse, Float3) {
+  float3 value;
+  float3 expected{1, -2.5f, 30};
+
+  for (const char *text : {"1 -2.5 3e1", "1,-2.5,30", "[1, -2.5, 30]",
+                           "  1\t-2.5 , +30 tail"}) {
+    parse_result result = parse_string(text, value);
+
+    ASSERT_EQ(result.ec, std::errc{}) << text;
+    ASSERT_EQ(result.count, 1u);
+    EXPECT_FLOAT3_EQ(value, expected);
+  }
+
+  string text = "[0.1, 2, 3] rest";
+  parse_result result = parse_string(text, value);
+  ASSERT_EQ(string(result.ptr), "] rest");
+}
+
+TEST(Parse, Float4) {
+  string text = "1 2 3 4";
+  float4 value;
+  float4 expected{1, 2, 3, 4};
+
+  parse_result result = parse(text.data(), text.data() + text.size(), value);
+
+  ASSERT_EQ(result.ec, std::errc{});
+  ASSERT_EQ(result.ptr, text.data() + text.size());
+  EXPECT_FLOAT4_EQ(value, expected);
+}
+
+TEST(Parse, Errors) {
+  float3 value{7, 8, 9};
+  float3 unchanged{7, 8, 9};
+
+  parse_result result = parse_string("1 2", value);
+  ASSERT_EQ(result.ec, std::errc::invalid_argument);
+  ASSERT_EQ(result.count, 0u);
+
+  result = parse_string("1 x 3", value);
+  ASSERT_EQ(result.ec, std::errc::invalid_argument);
+
+  result = parse_string("1 1e99 3", value);
+  ASSERT_EQ(result.ec, std::errc::result_out_of_range);
+
+  EXPECT_FLOAT3_EQ(value, unchanged);
+}
+
+TEST(Parse, RoundTripsFormat) {
+  float3 values[] = {float3{0.1f, 1.0f / 3.0f, -1e-38f},
+                     float3{3.4028235e38f, -0.0f, 123456.79f}};
+
+  for (const float3 &value : values) {
+    char text[print::max_float3_chars];
+    char *last = format_to(text, value);
+
+    float3 parsed;
+    parse_result result = parse(text, last, parsed);
+
+    ASSERT_EQ(result.ec, std::errc{});
+    ASSERT_EQ(result.ptr, last - 1);
+    EXPECT_EQ(parsed, value);
+  }
+}
+
+TEST(Parse, ObjLines) {
+  string text =
+      "# exported\n"
+      "o cube\n"
+      "v 1 2 3\n"
+      "vn 0 0 1\n"
+      "vt 0.5 0.5\n"
+      "\n"
+      "  v -1 -2 -3 1.0\r\n"
+      "v 4 5 6";
+
+  std::vector<float3> positions;
+  parse_result result = parse_lines_string(text, positions, "v");
+
+  ASSERT_EQ(result.ec, std::errc{});
+  ASSERT_EQ(result.ptr, text.data() + text.size());
+  ASSERT_EQ(result.count, 3u);
+  ASSERT_EQ(positions.size(), 3u);
+
+  float3 second{-1, -2, -3};
+  float3 third{4, 5, 6};
+  EXPECT_FLOAT3_EQ(positions[1], second);
+  EXPECT_FLOAT3_EQ(positions[2], third);
+
+  std::vector<float3> normals;
+  result = parse_lines_string(text, normals, "vn");
+
+  ASSERT_EQ(result.ec, std::errc{});
+  ASSERT_EQ(normals.size(), 1u);
+}
+
+TEST(Parse, CsvLines) {
+  string text = "1,2,3,4\r\n5,6,7,8\n\n# comment\n9,10,11,12\n";
+
+  std::vector<float4> values;
+  float4_soa soa;
+
+  ASSERT_EQ(parse_lines_string(text, values).count, 3u);
+  ASSERT_EQ(parse_lines_string(text, soa).count, 3u);
+  ASSERT_EQ(soa.size(), 3u);
+
+  for (size_t i = 0; i < values.size(); i++) {
+    float4 from_soa = soa.get(i);
+    EXPECT_FLOAT4_EQ(from_soa, values[i]);
+  }
+
+  float4 last{9, 10, 11, 12};
+  EXPECT_FLOAT4_EQ(values[2], last);
+}
+
+TEST(Parse, BadLine) {
+  string text = "1 2 3\n4 5 6\n7 8\n9 10 11\n";
+
+  std::vector<float3> values;
+  parse_result result = parse_lines_string(text, values);
+
+  ASSERT_EQ(result.ec, std::errc::invalid_argument);
+  ASSERT_EQ(result.count, 2u);
+  ASSERT_EQ(values.size(), 2u);
+  ASSERT_EQ(result.ptr, text.data() + 12);
+}
+
+TEST(Parse, LineBoundary) {
+  string text = "ab\ncd\n";
+  const char *first = text.data();
+  const char *last = first + text.size();
+
+  ASSERT_EQ(line_boundary(first, first, last), first);
+  ASSERT_EQ(line_boundary(first, first + 1, last), first + 3);
+  ASSERT_EQ(line_boundary(first, first + 3, last), first + 3);
+  ASSERT_EQ(line_boundary(first, first + 4, last), last);
+  ASSERT_EQ(line_boundary(first, last, last), last);
+}
+
+TEST(Parse, Parallel) {
+  string text = sample_lines(100000);
+
+  std::vector<float3> serial;
+  std::vector<float3> parallel;
+  float3_soa soa;
+
+  parse_result serial_result = parse_lines_string(text, serial);
+  parse_result parallel_result =
+      parse_lines_string(text, parallel, nullptr, 4);
+  parse_result soa_result = parse_lines_string(text, soa, nullptr, 4);
+
+  ASSERT_EQ(serial_result.ec, std::errc{});
+  ASSERT_EQ(parallel_result.ec, std::errc{});
+  ASSERT_EQ(soa_result.ec, std::errc{});
+  ASSERT_EQ(parallel_result.count, 100000u);
+  ASSERT_EQ(parallel.size(), 100000u);
+  ASSERT_EQ(soa.size(), 100000u);
+
+  for (size_t i = 0; i < serial.size(); i++) {
+    float f = static_cast<float>(i);
+    float3 expected{f, -f * 0.25f, f * 1e-3f};
+    float3 from_soa = soa.get(i);
+
+    ASSERT_EQ(serial[i], expected);
+    ASSERT_EQ(parallel[i], expected);
+    ASSERT_EQ(from_soa, expected);
+  }
+
+  // a bad line in the last part keeps the lines of the parts before it
+  size_t bad = text.size() - 100;
+  bad = static_cast<size_t>(
+      line_boundary(text.data(), text.data() + bad, text.data() + text.size()) -
+      text.data());
+  text.insert(bad, "x\n");
+
+  std::vector<float3> partial;
+  parse_result result = parse_lines_string(text, partial, nullptr, 4);
+
+  ASSERT_EQ(result.ec, std::errc::invalid_argument);
+  ASSERT_EQ(result.ptr, text.data() + bad);
+  ASSERT_EQ(result.count, partial.size());
+  ASSERT_EQ(std::count(text.data(), text.data() + bad, '\n'),
+            static_cast<std::ptrdiff_t>(partial.size()));
+}
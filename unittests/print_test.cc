@@ -1,6 +1,9 @@
 #include "graphmath/print.h"
 
+#include <cstdio>
+#include <limits>
 #include <sstream>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -44,3 +47,107 @@ TEST(Print, Float4x4) {
 
   ASSERT_EQ(result, expected);
 }
+
+template <typename T>
+string format(const T &t) {
+  std::vector<char> buffer(max_float4x4_chars);
+  char *last = format_to(buffer.data(), t);
+
+  return string(buffer.data(), last);
+}
+
+// short values only, see `FormatDiffersFromStream`
+TEST(Print, FormatMatchesStream) {
+  float3 f3{1, -2.5f, 0.125f};
+  float4 f4{-1, 2, 1e-3f, 1e20f};
+  float4x4 matrix{float4{0, 1, 2, 3}, float4{4, 5, 6, 7}, float4{8, 9, 10, 11},
+                  float4{12, 13, 14, 15}};
+
+  ASSERT_EQ(format(f3), to_string(f3));
+  ASSERT_EQ(format(f4), to_string(f4));
+  ASSERT_EQ(format(matrix), to_string(matrix));
+}
+
+TEST(Print, FormatDiffersFromStream) {
+  // `<<` writes six significant digits, `format_to` the shortest round trip
+  float3 f3{1.0f / 3, 1e-7f, 123456789.0f};
+
+  EXPECT_EQ(to_string(f3), "[0.333333, 1e-07, 1.23457e+08]");
+  EXPECT_EQ(format(f3), "[0.33333334, 1e-07, 123456792]");
+}
+
+TEST(Print, FormatRoundTrips) {
+  float values[] = {0.1f, 1.0f / 3.0f, -1.1754944e-38f, 3.4028235e38f,
+                    std::numeric_limits<float>::denorm_min()};
+
+  for (float value : values) {
+    float3 f3{value, -value, value * 0.5f};
+    string text = format(f3);
+
+    ASSERT_LE(text.size(), max_float3_chars);
+
+    float x = 0, y = 0, z = 0;
+    ASSERT_EQ(std::sscanf(text.c_str(), "[%f, %f, %f]", &x, &y, &z), 3);
+
+    float3 parsed{x, y, z};
+    EXPECT_EQ(parsed, f3);
+  }
+}
+
+TEST(Print, FormatLongest) {
+  float value = -1.1754944e-38f;
+  float4 f4{value, value, value, value};
+  float4x4 matrix{f4, f4, f4, f4};
+
+  ASSERT_EQ(format(f4).size(), max_float4_chars - 4);
+  ASSERT_EQ(format(matrix).size(), max_float4x4_chars - 16);
+}
+
+TEST(Print, WriteText) {
+  std::vector<float3> values;
+
+  for (int i = 0; i < 5000; i++) {
+    values.push_back(float3{i * 0.1f, -i * 1e-7f, i * 3e5f});
+  }
+
+  string expected;
+
+  for (const float3 &value : values) {
+    expected += format(value);
+    expected += '\n';
+  }
+
+  string result;
+  size_t calls = 0;
+
+  write_text(values, [&](const char *data, size_t size) {
+    ASSERT_LE(size, text_buffer_size);
+    result.append(data, size);
+    calls++;
+  });
+
+  ASSERT_EQ(result, expected);
+  ASSERT_GT(calls, 1u);
+
+  stringstream ss;
+  write_text(values, ss);
+
+  ASSERT_EQ(ss.str(), expected);
+}
+
+TEST(Print, WriteTextFloat4) {
+  std::vector<float4> values{float4{1, 2, 3, 4}, float4{-0.5f, 0, 7, 8}};
+  stringstream ss;
+
+  write_text(values, ss);
+
+  ASSERT_EQ(ss.str(), "[1, 2, 3, 4]\n[-0.5, 0, 7, 8]\n");
+}
+
+TEST(Print, WriteTextEmpty) {
+  size_t calls = 0;
+
+  write_text(span<const float3>{}, [&](const char *, size_t) { calls++; });
+
+  ASSERT_EQ(calls, 0u);
+}
@@ -0,0 +1,154 @@
+#include "graphmath/quaternion.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+namespace {
+constexpr float pi = 3.14159265358979f;
+
+#define EXPECT_QUATERNION_NEAR(a, b, tolerance) \
+  {                                             \
+    EXPECT_NEAR(a.x(), b.x(), tolerance);       \
+    EXPECT_NEAR(a.y(), b.y(), tolerance);       \
+    EXPECT_NEAR(a.z(), b.z(), tolerance);       \
+    EXPECT_NEAR(a.w(), b.w(), tolerance);       \
+  }
+
+#define EXPECT_FLOAT3_NEAR(a, b, tolerance) \
+  {                                         \
+    EXPECT_NEAR(a.x(), b.x(), tolerance);   \
+    EXPECT_NEAR(a.y(), b.y(), tolerance);   \
+    EXPECT_NEAR(a.z(), b.z(), tolerance);   \
+  }
+
+std::vector<quaternion> make_rotations(size_t count, float offset) {
+  std::vector<quaternion> rotations;
+
+  for (size_t i = 0; i < count; i++) {
+    float f = static_cast<float>(i) + offset;
+    float3 axis = normalize(float3{std::sin(f), std::cos(3 * f), 0.5f});
+    rotations.push_back(from_axis_angle(axis, f * 0.7f));
+  }
+
+  return rotations;
+}
+}  // namespace
+
+TEST(Quaternion, Construction) {
+  quaternion identity;
+  quaternion expected{0, 0, 0, 1};
+
+  EXPECT_EQ(identity, expected);
+  EXPECT_NE(identity, quaternion(float4{1, 2, 3, 4}));
+  EXPECT_FLOAT_EQ(quaternion(float4{1, 2, 3, 4}).z(), 3);
+}
+
+TEST(Quaternion, Multiply) {
+  quaternion a{1, 2, 3, 4};
+  quaternion b{-5, 6, 0.5, 2};
+
+  quaternion product = a * b;
+  quaternion expected{-35, 12.5, 24, -0.5};
+
+  EXPECT_QUATERNION_NEAR(product, expected, 1e-5f);
+}
+
+TEST(Quaternion, Rotate) {
+  quaternion q = from_axis_angle(float3{0, 0, 1}, pi / 2);
+  float3 rotated = rotate(q, float3{1, 0, 0});
+  float3 expected{0, 1, 0};
+
+  EXPECT_FLOAT3_NEAR(rotated, expected, 1e-6f);
+
+  // composing rotations matches rotating twice
+  quaternion r = from_axis_angle(normalize(float3{1, 1, 0}), 0.3f);
+  float3 v{0.5, -2, 3};
+
+  float3 composed = rotate(q * r, v);
+  float3 twice = rotate(q, rotate(r, v));
+
+  EXPECT_FLOAT3_NEAR(composed, twice, 1e-5f);
+}
+
+TEST(Quaternion, ConjugateInverse) {
+  quaternion q = from_axis_angle(normalize(float3{1, 2, 3}), 1.2f);
+  quaternion identity;
+
+  quaternion product = q * conjugate(q);
+  EXPECT_QUATERNION_NEAR(product, identity, 1e-6f);
+
+  quaternion scaled{q.as_float4() * 3.0f};
+  quaternion scaled_product = scaled * inverse(scaled);
+  EXPECT_QUATERNION_NEAR(scaled_product, identity, 1e-6f);
+}
+
+TEST(Quaternion, Float4x4) {
+  quaternion q = from_axis_angle(normalize(float3{1, -2, 0.5}), 2.5f);
+  float4x4 m = to_float4x4(q);
+  float3 v{3, -1, 2};
+
+  float4 by_matrix = m * float4{v, 0};
+  float3 expected = rotate(q, v);
+
+  EXPECT_FLOAT3_NEAR(by_matrix, expected, 1e-5f);
+  EXPECT_FLOAT_EQ(m.get(3, 3), 1);
+
+  // round trips up to the sign, for each branch of the conversion
+  for (float angle : {0.5f, 3.0f}) {
+    for (float3 axis : {float3{1, 0, 0}, float3{0, 1, 0}, float3{0, 0, 1}}) {
+      quaternion original = from_axis_angle(axis, angle);
+      quaternion round_trip = from_float4x4(to_float4x4(original));
+
+      EXPECT_NEAR(std::fabs(dot(original, round_trip)), 1.0f, 1e-6f);
+    }
+  }
+}
+
+TEST(Quaternion, Slerp) {
+  quaternion a = from_axis_angle(float3{0, 1, 0}, 0.2f);
+  quaternion b = from_axis_angle(float3{0, 1, 0}, 1.4f);
+
+  quaternion halfway = slerp(a, b, 0.5f);
+  quaternion expected = from_axis_angle(float3{0, 1, 0}, 0.8f);
+  EXPECT_QUATERNION_NEAR(halfway, expected, 1e-6f);
+
+  // `-b` is the same rotation as `b`, the result must not take the long way
+  quaternion negated{b.as_float4() * -1.0f};
+  quaternion shortest = slerp(a, negated, 0.5f);
+  EXPECT_NEAR(std::fabs(dot(shortest, expected)), 1.0f, 1e-6f);
+
+  quaternion lerped = nlerp(a, b, 0.5f);
+  EXPECT_QUATERNION_NEAR(lerped, expected, 1e-6f);
+
+  EXPECT_QUATERNION_NEAR(slerp(a, a, 0.3f), a, 1e-6f);
+}
+
+TEST(Quaternion, SlerpBatch) {
+  std::vector<quaternion> a = make_rotations(33, 0.25f);
+  std::vector<quaternion> b = make_rotations(33, 1.5f);
+  std::vector<quaternion> slerped(a.size());
+  std::vector<quaternion> nlerped(a.size());
+
+  for (float t : {0.0f, 0.3f, 1.0f}) {
+    slerp(a, b, t, slerped);
+    nlerp(a, b, t, nlerped);
+
+    for (size_t i = 0; i < a.size(); i++) {
+      quaternion expected = slerp(a[i], b[i], t);
+      EXPECT_QUATERNION_NEAR(slerped[i], expected, 1e-6f);
+
+      quaternion expected_nlerp = nlerp(a[i], b[i], t);
+      EXPECT_QUATERNION_NEAR(nlerped[i], expected_nlerp, 1e-7f);
+    }
+  }
+
+  // the output may be an input
+  slerp(a, b, 0.5f, a);
+  quaternion expected = slerp(make_rotations(1, 0.25f)[0], b[0], 0.5f);
+  EXPECT_QUATERNION_NEAR(a[0], expected, 1e-6f);
+}
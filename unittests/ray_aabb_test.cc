@@ -0,0 +1,133 @@
+#include "graphmath/ray_aabb.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+namespace {
+const aabb unit_box{float3{0, 0, 0}, float3{1, 1, 1}};
+
+bool hits(const ray &r, const aabb &box, float &t_near) {
+  return ray_aabb_intersect(inverse_ray{r}, box, INFINITY, t_near);
+}
+
+/// @brief Test packets of `Lanes` random boxes against the single box test
+template <size_t Lanes>
+void expect_packets_match() {
+  std::mt19937 engine{419};
+  std::uniform_real_distribution<float> position{-4.0f, 4.0f};
+  std::uniform_real_distribution<float> size{0.0f, 2.0f};
+
+  for (size_t round = 0; round < 500; round++) {
+    aabb_packet<Lanes> boxes;
+    std::vector<aabb> singles;
+
+    // the last lane keeps an empty box
+    for (size_t lane = 0; lane + 1 < Lanes; lane++) {
+      float3 lower{position(engine), position(engine), position(engine)};
+      float3 extent{size(engine), size(engine), size(engine)};
+
+      singles.push_back(aabb{lower, lower + extent});
+      boxes.set(lane, singles.back());
+    }
+
+    singles.push_back(aabb{});
+
+    float3 origin{position(engine), position(engine), position(engine)};
+    float3 direction{position(engine), position(engine), position(engine)};
+
+    // axis aligned rays, with zero direction components, now and then
+    if (round % 4 == 0) {
+      direction = float3{0, direction.y(), 0};
+    }
+
+    inverse_ray r{ray{origin, direction}};
+    float t_max = round % 3 == 0 ? 2.0f : INFINITY;
+    float t_near[Lanes];
+
+    unsigned mask = ray_aabb_intersect(r, boxes, t_max, t_near);
+
+    for (size_t lane = 0; lane < Lanes; lane++) {
+      float expect_t = 0.0f;
+      bool expect = ray_aabb_intersect(r, singles[lane], t_max, expect_t);
+
+      EXPECT_EQ((mask >> lane) & 1, expect ? 1u : 0u);
+
+      if (expect) {
+        EXPECT_FLOAT_EQ(t_near[lane], expect_t);
+      }
+    }
+  }
+}
+}  // namespace
+
+TEST(RayAabb, InverseRay) {
+  inverse_ray r{ray{float3{1, 2, 3}, float3{2, -0.0f, -4}}};
+
+  EXPECT_FLOAT_EQ(r.origin[2], 3.0f);
+  EXPECT_FLOAT_EQ(r.inverse_direction[0], 0.5f);
+  EXPECT_EQ(r.inverse_direction[1], -INFINITY);
+  EXPECT_FLOAT_EQ(r.inverse_direction[2], -0.25f);
+  EXPECT_EQ(r.sign_mask, 0b110u);
+}
+
+TEST(RayAabb, Single) {
+  float t_near = -1.0f;
+
+  EXPECT_TRUE(hits(ray{float3{-1, 0.5f, 0.5f}, float3{1, 0, 0}}, unit_box,
+                   t_near));
+  EXPECT_FLOAT_EQ(t_near, 1.0f);
+
+  EXPECT_TRUE(hits(ray{float3{3, 3, 3}, float3{-1, -1, -1}}, unit_box,
+                   t_near));
+  EXPECT_FLOAT_EQ(t_near, 2.0f);
+
+  // from inside, the box is entered at `0`
+  EXPECT_TRUE(hits(ray{float3{0.5f, 0.5f, 0.5f}, float3{0, 1, 0}}, unit_box,
+                   t_near));
+  EXPECT_FLOAT_EQ(t_near, 0.0f);
+
+  // behind, beside, and beyond `t_max`
+  EXPECT_FALSE(hits(ray{float3{2, 0.5f, 0.5f}, float3{1, 0, 0}}, unit_box,
+                    t_near));
+  EXPECT_FALSE(hits(ray{float3{-1, 1.5f, 0.5f}, float3{1, 0, 0}}, unit_box,
+                    t_near));
+  EXPECT_FALSE(ray_aabb_intersect(
+      inverse_ray{ray{float3{-1, 0.5f, 0.5f}, float3{1, 0, 0}}}, unit_box,
+      0.5f, t_near));
+
+  // no ray hits an empty box
+  EXPECT_FALSE(hits(ray{float3{0, 0, 0}, float3{1, 1, 1}}, aabb{}, t_near));
+  EXPECT_FALSE(hits(ray{float3{0, 0, 0}, float3{-1, 0, 0}}, aabb{}, t_near));
+}
+
+TEST(RayAabb, ZeroDirectionComponents) {
+  float t_near = -1.0f;
+
+  // inside the slabs of the zero components, or outside
+  EXPECT_TRUE(hits(ray{float3{0.5f, 0.5f, -2}, float3{0, 0, 1}}, unit_box,
+                   t_near));
+  EXPECT_FLOAT_EQ(t_near, 2.0f);
+  EXPECT_FALSE(hits(ray{float3{1.5f, 0.5f, -2}, float3{0, 0, 1}}, unit_box,
+                    t_near));
+  EXPECT_FALSE(hits(ray{float3{0.5f, 0.5f, -2}, float3{0, -0.0f, 1}},
+                    aabb{float3{0, 1, 0}, float3{1, 2, 1}}, t_near));
+
+  // in the plane of a face, `0 * inf` is NaN and counts as inside the slab
+  EXPECT_TRUE(hits(ray{float3{0, 0.5f, -2}, float3{0, 0, 1}}, unit_box,
+                   t_near));
+  EXPECT_FLOAT_EQ(t_near, 2.0f);
+  EXPECT_TRUE(hits(ray{float3{1, 1, -2}, float3{-0.0f, 0, 1}}, unit_box,
+                   t_near));
+  EXPECT_FLOAT_EQ(t_near, 2.0f);
+}
+
+TEST(RayAabb, Packets) {
+  expect_packets_match<4>();
+  expect_packets_match<8>();
+}
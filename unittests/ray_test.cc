@@ -0,0 +1,165 @@
+#include "graphmath/ray.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+namespace {
+struct triangle {
+  float3 a, b, c;
+};
+
+/// @brief random triangles around the origin and rays through the region
+/// they occupy, about half of them hitting
+std::vector<triangle> random_triangles(std::mt19937 &engine, size_t count) {
+  std::uniform_real_distribution<float> position{-1.0f, 1.0f};
+  std::vector<triangle> triangles;
+
+  for (size_t i = 0; i < count; i++) {
+    float3 a{position(engine), position(engine), position(engine)};
+    float3 b{position(engine), position(engine), position(engine)};
+    float3 c{position(engine), position(engine), position(engine)};
+
+    triangles.push_back(triangle{a, b, c});
+  }
+
+  return triangles;
+}
+
+ray random_ray(std::mt19937 &engine) {
+  std::uniform_real_distribution<float> position{-0.5f, 0.5f};
+  float3 target{position(engine), position(engine), position(engine)};
+  float3 origin{position(engine), position(engine), 4.0f};
+
+  return ray{origin, target - origin};
+}
+}  // namespace
+
+#if defined(GRAPHMATH_HAS_CONSTEXPR)
+static_assert(ray{float3{1, 2, 3}, float3{0, 0, -1}}.at(2.0f) ==
+                  float3{1, 2, 1},
+              "at");
+#endif
+
+TEST(Ray, At) {
+  ray r{float3{1, 2, 3}, float3{0, 2, -1}};
+
+  float3 point = r.at(1.5f);
+  float3 expect{1, 5, 1.5f};
+
+  EXPECT_FLOAT3_EQ(point, expect);
+}
+
+TEST(Ray, IntersectTriangle) {
+  float3 a{-1, -1, 0};
+  float3 b{1, -1, 0};
+  float3 c{-1, 1, 0};
+
+  triangle_hit hit;
+
+  EXPECT_TRUE(intersect(ray{float3{-0.5f, 0, 2}, float3{0, 0, -1}}, a, b, c,
+                        hit));
+  EXPECT_FLOAT_EQ(hit.t, 2.0f);
+  EXPECT_FLOAT_EQ(hit.u, 0.25f);
+  EXPECT_FLOAT_EQ(hit.v, 0.5f);
+
+  // a farther hit does not replace a closer one
+  EXPECT_FALSE(intersect(ray{float3{-0.5f, 0, 4}, float3{0, 0, -1}}, a, b, c,
+                         hit));
+  EXPECT_FLOAT_EQ(hit.t, 2.0f);
+
+  // both sides hit, but not behind the origin, outside, or parallel
+  hit = triangle_hit{};
+  EXPECT_TRUE(intersect(ray{float3{-0.5f, 0, -1}, float3{0, 0, 2}}, a, b, c,
+                        hit));
+  EXPECT_FLOAT_EQ(hit.t, 0.5f);
+
+  hit = triangle_hit{};
+  EXPECT_FALSE(intersect(ray{float3{-0.5f, 0, -1}, float3{0, 0, -1}}, a, b,
+                         c, hit));
+  EXPECT_FALSE(intersect(ray{float3{0.5f, 0.5f, 1}, float3{0, 0, -1}}, a, b,
+                         c, hit));
+  EXPECT_FALSE(intersect(ray{float3{0, 0, 1}, float3{1, 0, 0}}, a, b, c, hit));
+}
+
+TEST(Ray, PacketsMatchSingleRays) {
+  std::mt19937 engine{419};
+  std::vector<triangle> triangles = random_triangles(engine, 64);
+
+  for (size_t round = 0; round < 64; round++) {
+    // a packet of rays against each triangle
+    ray_packet rays;
+    std::vector<ray> singles;
+
+    for (size_t lane = 0; lane < packet_lanes; lane++) {
+      singles.push_back(random_ray(engine));
+      rays.set(lane, singles.back());
+    }
+
+    packet_hit hits;
+    std::vector<triangle_hit> expect(packet_lanes);
+
+    for (const triangle &tri : triangles) {
+      unsigned mask = intersect(rays, tri.a, tri.b, tri.c, hits);
+
+      for (size_t lane = 0; lane < packet_lanes; lane++) {
+        bool hit = intersect(singles[lane], tri.a, tri.b, tri.c, expect[lane]);
+        EXPECT_EQ((mask >> lane) & 1, hit ? 1u : 0u);
+      }
+    }
+
+    for (size_t lane = 0; lane < packet_lanes; lane++) {
+      EXPECT_NEAR(hits.t[lane], expect[lane].t, 1e-4f);
+      EXPECT_NEAR(hits.u[lane], expect[lane].u, 1e-4f);
+      EXPECT_NEAR(hits.v[lane], expect[lane].v, 1e-4f);
+    }
+  }
+}
+
+TEST(Ray, TrianglePacketsMatchSingleTriangles) {
+  std::mt19937 engine{419};
+
+  // a count that leaves the last packet partly empty
+  std::vector<triangle> triangles = random_triangles(engine, 61);
+  std::vector<triangle_packet> packets(
+      (triangles.size() + packet_lanes - 1) / packet_lanes);
+
+  for (size_t i = 0; i < triangles.size(); i++) {
+    const triangle &tri = triangles[i];
+    packets[i / packet_lanes].set(i % packet_lanes, tri.a, tri.b, tri.c);
+  }
+
+  for (size_t round = 0; round < 256; round++) {
+    ray r = random_ray(engine);
+
+    triangle_hit expect;
+    size_t expect_index = no_hit;
+
+    for (size_t i = 0; i < triangles.size(); i++) {
+      const triangle &tri = triangles[i];
+
+      if (intersect(r, tri.a, tri.b, tri.c, expect)) {
+        expect_index = i;
+      }
+    }
+
+    triangle_hit hit;
+    size_t index = intersect(r, packets, hit);
+
+    // the closest two hits may swap when they are about as close
+    if (index != expect_index) {
+      ASSERT_NE(index, no_hit);
+      ASSERT_NE(expect_index, no_hit);
+      EXPECT_NEAR(hit.t, expect.t, 1e-4f);
+    } else if (index != no_hit) {
+      EXPECT_NEAR(hit.t, expect.t, 1e-4f);
+      EXPECT_NEAR(hit.u, expect.u, 1e-4f);
+      EXPECT_NEAR(hit.v, expect.v, 1e-4f);
+    }
+  }
+}
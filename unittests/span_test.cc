@@ -0,0 +1,43 @@
+#include "graphmath/span.h"
+
+#include <array>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace graphmath;
+
+TEST(Span, FromContainer) {
+  std::vector<int> values{1, 2, 3, 4};
+  span<int> mutable_view{values};
+  span<const int> view = mutable_view;
+
+  ASSERT_EQ(view.size(), 4u);
+  EXPECT_EQ(view.data(), values.data());
+  EXPECT_EQ(view[2], 3);
+
+  mutable_view[0] = 10;
+  EXPECT_EQ(values[0], 10);
+
+  int sum = 0;
+
+  for (int value : view) {
+    sum += value;
+  }
+
+  EXPECT_EQ(sum, 19);
+}
+
+TEST(Span, Subspan) {
+  std::array<int, 5> values{0, 1, 2, 3, 4};
+  span<const int> view{values};
+
+  span<const int> middle = view.subspan(1, 3);
+  ASSERT_EQ(middle.size(), 3u);
+  EXPECT_EQ(middle[0], 1);
+
+  span<const int> clipped = view.subspan(3, 10);
+  EXPECT_EQ(clipped.size(), 2u);
+
+  EXPECT_TRUE(view.subspan(5, 1).empty());
+}
@@ -0,0 +1,82 @@
+#include "graphmath/transform_batch.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+namespace {
+const float4x4 matrix{float4{1, 2, 0, 5}, float4{0, 1, 3, -2},
+                      float4{2, 0, 1, 1}, float4{0.5f, 0, 0.25f, 2}};
+
+std::vector<float3> make_points(size_t count) {
+  std::vector<float3> points;
+
+  for (size_t i = 0; i < count; i++) {
+    float f = static_cast<float>(i % 97);
+    points.push_back(float3{f, 1 - f, 0.5f * f});
+  }
+
+  return points;
+}
+
+float3 drop_w(const float4 &f4) { return float3{f4.x(), f4.y(), f4.z()}; }
+}  // namespace
+
+TEST(TransformBatch, Points) {
+  std::vector<float3> points = make_points(37);
+  std::vector<float3> result(points.size());
+
+  transform_points(matrix, points, result);
+
+  for (size_t i = 0; i < points.size(); i++) {
+    EXPECT_FLOAT3_EQ(result[i], drop_w(matrix * float4{points[i], 1}));
+  }
+}
+
+TEST(TransformBatch, VectorsInPlace) {
+  std::vector<float3> vectors = make_points(37);
+  std::vector<float3> expected;
+
+  for (const float3 &v : vectors) {
+    expected.push_back(drop_w(matrix * float4{v, 0}));
+  }
+
+  transform_vectors(matrix, vectors, vectors);
+
+  for (size_t i = 0; i < vectors.size(); i++) {
+    EXPECT_FLOAT3_EQ(vectors[i], expected[i]);
+  }
+}
+
+TEST(TransformBatch, Project) {
+  std::vector<float3> points = make_points(37);
+  std::vector<float3> result(points.size());
+
+  transform_and_project(matrix, points, result);
+
+  for (size_t i = 0; i < points.size(); i++) {
+    float4 clip = matrix * float4{points[i], 1};
+    float3 expected = drop_w(clip) / clip.w();
+
+    EXPECT_FLOAT3_EQ(result[i], expected);
+  }
+}
+
+TEST(TransformBatch, StreamingStores) {
+  // large enough to take the non-temporal path, offset by one element so the
+  // output starts unaligned to a wide register
+  const size_t count = transform_stream_threshold / sizeof(float3) + 5;
+
+  std::vector<float3> points = make_points(count + 1);
+  std::vector<float3> result(count + 1);
+
+  transform_points(matrix, span<const float3>{points.data() + 1, count},
+                   span<float3>{result.data() + 1, count});
+
+  for (size_t i = 1; i <= count; i++) {
+    EXPECT_FLOAT3_EQ(result[i], drop_w(matrix * float4{points[i], 1}));
+  }
+}
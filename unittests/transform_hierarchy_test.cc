@@ -0,0 +1,155 @@
+#include "graphmath/transform_hierarchy.h"
+
+#include <vector>
+
+#include "graphmath/transform.h"
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+namespace {
+#define EXPECT_FLOAT4X4_NEAR(a, b, tolerance)             \
+  {                                                       \
+    for (size_t y = 0; y < 4; y++) {                      \
+      for (size_t x = 0; x < 4; x++) {                    \
+        EXPECT_NEAR(a(y, x), b(y, x), tolerance);         \
+      }                                                   \
+    }                                                     \
+  }
+
+float4x4 make_local(size_t i) {
+  float f = static_cast<float>(i % 17);
+  return translation(float3{f * 0.01f, 0.02f, -f * 0.005f}) *
+         rotation_axis_angle(normalize(float3{1.0f, f, 2.0f}), 0.001f * f);
+}
+
+/// @brief a forest of `count` nodes, with a few large trees, many small ones
+/// and some chains
+transform_hierarchy make_hierarchy(size_t count) {
+  transform_hierarchy hierarchy;
+  hierarchy.reserve(count);
+
+  for (size_t i = 0; i < count; i++) {
+    size_t parent = transform_hierarchy::no_parent;
+
+    if (i % 97 != 0) {
+      parent = i % 5 == 0 ? i - 1 : (i * 7919) % i;
+    }
+
+    hierarchy.add(make_local(i), parent);
+  }
+
+  return hierarchy;
+}
+
+/// @brief the world matrices, computed from scratch
+std::vector<float4x4> reference_worlds(const transform_hierarchy &hierarchy) {
+  std::vector<float4x4> worlds;
+
+  for (size_t i = 0; i < hierarchy.size(); i++) {
+    size_t parent = hierarchy.parent(i);
+
+    worlds.push_back(parent == transform_hierarchy::no_parent
+                         ? hierarchy.local(i)
+                         : worlds[parent] * hierarchy.local(i));
+  }
+
+  return worlds;
+}
+}  // namespace
+
+TEST(TransformHierarchy, Update) {
+  transform_hierarchy hierarchy;
+
+  size_t root = hierarchy.add(translation(float3{1, 0, 0}));
+  size_t arm = hierarchy.add(translation(float3{0, 2, 0}), root);
+  size_t hand = hierarchy.add(scaling(float3{2, 2, 2}), arm);
+  size_t other = hierarchy.add(translation(float3{0, 0, 5}));
+
+  EXPECT_EQ(hierarchy.size(), 4);
+  EXPECT_EQ(hierarchy.parent(hand), arm);
+  EXPECT_EQ(hierarchy.parent(other), transform_hierarchy::no_parent);
+
+  hierarchy.update();
+
+  float4 point = hierarchy.world(hand) * float4{1, 1, 1, 1};
+  float4 expect{3, 4, 2, 1};
+
+  EXPECT_FLOAT4_EQ(point, expect);
+
+  // moving the root moves its descendants, not the other tree
+  hierarchy.set_local(root, translation(float3{-1, 0, 0}));
+  hierarchy.update();
+
+  point = hierarchy.world(hand) * float4{1, 1, 1, 1};
+  expect = float4{1, 4, 2, 1};
+
+  EXPECT_FLOAT4_EQ(point, expect);
+
+  float4 other_point = hierarchy.worlds()[other] * float4{0, 0, 0, 1};
+  float4 expect_other{0, 0, 5, 1};
+
+  EXPECT_FLOAT4_EQ(other_point, expect_other);
+}
+
+TEST(TransformHierarchy, MatchesReference) {
+  transform_hierarchy hierarchy = make_hierarchy(50000);
+
+  for (size_t thread_count : {1, 4}) {
+    hierarchy.update(thread_count);
+
+    std::vector<float4x4> expect = reference_worlds(hierarchy);
+
+    for (size_t i = 0; i < hierarchy.size(); i++) {
+      EXPECT_FLOAT4X4_NEAR(hierarchy.world(i), expect[i], 1e-4f);
+    }
+
+    // dirty a few nodes, some of them under others
+    for (size_t i = 3; i < hierarchy.size(); i += 1013) {
+      hierarchy.set_local(i, make_local(i + 1) * hierarchy.local(i));
+    }
+
+    hierarchy.update(thread_count);
+    expect = reference_worlds(hierarchy);
+
+    for (size_t i = 0; i < hierarchy.size(); i++) {
+      EXPECT_FLOAT4X4_NEAR(hierarchy.world(i), expect[i], 1e-4f);
+    }
+
+    // adding nodes splits the work again
+    for (size_t i = 0; i < 1000; i++) {
+      hierarchy.add(make_local(i), (i * 31) % hierarchy.size());
+    }
+  }
+}
+
+TEST(TransformHierarchy, BreadthFirst) {
+  // many small trees added level by level, so most nodes of a tree come
+  // after the roots of the other trees
+  transform_hierarchy hierarchy;
+  std::vector<size_t> level;
+
+  for (size_t i = 0; i < 64; i++) {
+    level.push_back(hierarchy.add(make_local(i)));
+  }
+
+  for (size_t depth = 0; depth < 8; depth++) {
+    std::vector<size_t> next;
+
+    for (size_t parent : level) {
+      next.push_back(hierarchy.add(make_local(parent), parent));
+      next.push_back(hierarchy.add(make_local(parent + 1), parent));
+    }
+
+    level = next;
+  }
+
+  hierarchy.update(4);
+
+  std::vector<float4x4> expect = reference_worlds(hierarchy);
+
+  for (size_t i = 0; i < hierarchy.size(); i++) {
+    EXPECT_FLOAT4X4_NEAR(hierarchy.world(i), expect[i], 1e-4f);
+  }
+}
@@ -0,0 +1,130 @@
+#include "graphmath/transform.h"
+
+#include <cmath>
+
+#include "graphmath/quaternion.h"
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+namespace {
+constexpr float pi = 3.14159265358979f;
+
+#define EXPECT_FLOAT4_NEAR(a, b, tolerance) \
+  {                                         \
+    EXPECT_NEAR(a.x(), b.x(), tolerance);   \
+    EXPECT_NEAR(a.y(), b.y(), tolerance);   \
+    EXPECT_NEAR(a.z(), b.z(), tolerance);   \
+    EXPECT_NEAR(a.w(), b.w(), tolerance);   \
+  }
+
+float4 project(const float4x4 &m, const float3 &p) {
+  float4 clip = m * float4{p, 1.0f};
+  return clip * (1.0f / clip.w());
+}
+}  // namespace
+
+#if defined(GRAPHMATH_HAS_CONSTEXPR)
+static_assert(translation(float3{1, 2, 3})(2, 3) == 3.0f, "translation");
+static_assert(scaling(float3{1, 2, 3})(1, 1) == 2.0f, "scaling");
+static_assert(orthographic(-2, 2, -1, 1, 0, 4)(2, 2) == -0.25f,
+              "orthographic");
+#endif
+
+TEST(Transform, Translation) {
+  float4x4 m = translation(float3{1, 2, 3});
+
+  float4 point = m * float4{4, 5, 6, 1};
+  float4 vector = m * float4{4, 5, 6, 0};
+  float4 expect_point{5, 7, 9, 1};
+  float4 expect_vector{4, 5, 6, 0};
+
+  EXPECT_FLOAT4_EQ(point, expect_point);
+  EXPECT_FLOAT4_EQ(vector, expect_vector);
+
+  float4x4 expect{float4{1, 0, 0, 1}, float4{0, 1, 0, 2}, float4{0, 0, 1, 3},
+                  float4{0, 0, 0, 1}};
+
+  for (size_t y = 0; y < 4; y++) {
+    for (size_t x = 0; x < 4; x++) {
+      EXPECT_FLOAT_EQ(m(y, x), expect(y, x));
+    }
+  }
+}
+
+TEST(Transform, Scaling) {
+  float4x4 m = scaling(float3{2, 3, 4});
+
+  for (size_t y = 0; y < 4; y++) {
+    for (size_t x = 0; x < 4; x++) {
+      float expect = y != x ? 0.0f : y == 3 ? 1.0f : static_cast<float>(y + 2);
+      EXPECT_FLOAT_EQ(m(y, x), expect);
+    }
+  }
+}
+
+TEST(Transform, RotationAxisAngle) {
+  // a quarter turn around `z` takes `x` to `y`
+  float4 rotated = rotation_axis_angle(float3{0, 0, 1}, pi / 2) *
+                   float4{1, 0, 0, 1};
+  float4 expect{0, 1, 0, 1};
+
+  EXPECT_FLOAT4_NEAR(rotated, expect, 1e-6f);
+
+  float3 axis = normalize(float3{1, -2, 3});
+  float4x4 m = rotation_axis_angle(axis, 1.3f);
+  float4x4 q = to_float4x4(from_axis_angle(axis, 1.3f));
+
+  for (size_t y = 0; y < 4; y++) {
+    for (size_t x = 0; x < 4; x++) {
+      EXPECT_NEAR(m(y, x), q(y, x), 1e-6f);
+    }
+  }
+}
+
+TEST(Transform, LookAt) {
+  float3 eye{1, 2, 3};
+  float3 target{4, 2, -1};
+  float4x4 view = look_at(eye, target, float3{0, 1, 0});
+
+  // the eye moves to the origin and the target to `-z`, 5 units away
+  float4 expect_eye{0, 0, 0, 1};
+  float4 expect_target{0, 0, -5, 1};
+  float4 viewed_eye = view * float4{eye, 1.0f};
+  float4 viewed_target = view * float4{target, 1.0f};
+
+  EXPECT_FLOAT4_NEAR(viewed_eye, expect_eye, 1e-5f);
+  EXPECT_FLOAT4_NEAR(viewed_target, expect_target, 1e-5f);
+
+  // up stays up
+  float4 viewed_up = view * float4{0, 1, 0, 0};
+  float4 expect_up{0, 1, 0, 0};
+
+  EXPECT_FLOAT4_NEAR(viewed_up, expect_up, 1e-6f);
+  EXPECT_NEAR(determinant(view), 1.0f, 1e-5f);
+}
+
+TEST(Transform, Perspective) {
+  float4x4 m = perspective(pi / 2, 2.0f, 1.0f, 10.0f);
+
+  float4 near_corner = project(m, float3{2, 1, -1});
+  float4 far_center = project(m, float3{0, 0, -10});
+  float4 expect_near_corner{1, 1, 0, 1};
+  float4 expect_far_center{0, 0, 1, 1};
+
+  EXPECT_FLOAT4_NEAR(near_corner, expect_near_corner, 1e-6f);
+  EXPECT_FLOAT4_NEAR(far_center, expect_far_center, 1e-6f);
+}
+
+TEST(Transform, Orthographic) {
+  float4x4 m = orthographic(-2, 6, -1, 3, 1, 5);
+
+  float4 low = m * float4{-2, -1, -1, 1};
+  float4 high = m * float4{6, 3, -5, 1};
+  float4 expect_low{-1, -1, 0, 1};
+  float4 expect_high{1, 1, 1, 1};
+
+  EXPECT_FLOAT4_NEAR(low, expect_low, 1e-6f);
+  EXPECT_FLOAT4_NEAR(high, expect_high, 1e-6f);
+}
@@ -0,0 +1,45 @@
+#include "graphmath/vec.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "graphmath/double3.h"
+#include "graphmath/double4x4.h"
+#include "graphmath/float3.h"
+#include "graphmath/float4x4.h"
+#include "graphmath/int3.h"
+#include "gtest/gtest.h"
+#include "helpers.h"
+
+using namespace graphmath;
+
+static_assert(std::is_same_v<float3, vec<float, 3>>, "float3");
+static_assert(std::is_same_v<float4, vec<float, 4>>, "float4");
+static_assert(std::is_same_v<float4x4, mat<float, 4, 4>>, "float4x4");
+static_assert(std::is_same_v<double3::value_type, double>, "value_type");
+static_assert(int4::size == 4, "size");
+static_assert(double4x4::rows == 4 && double4x4::columns == 4, "rows");
+
+/// @brief Sum the values of any three component `vec`
+template <typename T>
+static T sum(const vec<T, 3> &v) {
+  return v.x() + v.y() + v.z();
+}
+
+/// @brief Linearly interpolate any `vec`
+template <typename T, size_t N>
+static vec<T, N> lerp(const vec<T, N> &a, const vec<T, N> &b, T t) {
+  return a + (b - a) * t;
+}
+
+TEST(Vec, GenericCode) {
+  EXPECT_EQ(sum(float3{1, 2, 3}), 6.0f);
+  EXPECT_EQ(sum(double3{1, 2, 3}), 6.0);
+  EXPECT_EQ(sum(int3{1, 2, 3}), 6);
+
+  EXPECT_EQ(lerp(float3{0, 0, 0}, float3{2, 4, 8}, 0.5f), (float3{1, 2, 4}));
+  EXPECT_EQ(lerp(double4{0, 0, 0, 0}, double4{2, 4, 8, 16}, 0.25),
+            (double4{0.5, 1, 2, 4}));
+  EXPECT_EQ(lerp(int3{0, 0, 0}, int3{2, 4, 8}, 2), (int3{4, 8, 16}));
+}
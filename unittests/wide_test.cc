@@ -0,0 +1,59 @@
+#include "graphmath/wide.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace graphmath;
+
+TEST(WideFloat, Arithmetic) {
+  std::vector<float> a(wide_float::lanes);
+  std::vector<float> b(wide_float::lanes);
+  std::vector<float> result(wide_float::lanes);
+
+  for (size_t i = 0; i < wide_float::lanes; i++) {
+    a[i] = static_cast<float>(i + 1);
+    b[i] = 2.0f;
+  }
+
+  wide_float wa = wide_float::load(a.data());
+  wide_float wb = wide_float::load(b.data());
+
+  madd(wa, wb, wide_float{1.0f}).store(result.data());
+
+  for (size_t i = 0; i < wide_float::lanes; i++) {
+    EXPECT_FLOAT_EQ(result[i], a[i] * 2.0f + 1.0f);
+  }
+
+  clamp(wa, wide_float{2.0f}, wide_float{3.0f}).store(result.data());
+
+  for (size_t i = 0; i < wide_float::lanes; i++) {
+    EXPECT_FLOAT_EQ(result[i], i == 0 ? 2.0f : i == 1 ? 2.0f : 3.0f);
+  }
+}
+
+TEST(WideFloat, ForEachWideTail) {
+  // not a multiple of any lane count, so every width runs a tail
+  const size_t size = 2 * wide_float::lanes + 3;
+
+  std::vector<float> a(size);
+  std::vector<float> b(size);
+  std::vector<float> result(size + 1, -1.0f);
+
+  for (size_t i = 0; i < size; i++) {
+    a[i] = static_cast<float>(i);
+    b[i] = static_cast<float>(2 * i);
+  }
+
+  for_each_wide({a.data(), b.data()}, {result.data()}, size,
+                [](const wide_float(&in)[2], wide_float(&out)[1]) {
+                  out[0] = in[0] + in[1];
+                });
+
+  for (size_t i = 0; i < size; i++) {
+    EXPECT_FLOAT_EQ(result[i], static_cast<float>(3 * i));
+  }
+
+  // the element after the last one must not be written
+  EXPECT_FLOAT_EQ(result[size], -1.0f);
+}